@@ -0,0 +1,56 @@
+/**
+ * @file     cycleCounter.h (SolderingStation_V4_MK20M7/Project_Headers/cycleCounter.h)
+ * @brief    Access to DWT cycle counter
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef HEADER_CYCLECOUNTER_H_
+#define HEADER_CYCLECOUNTER_H_
+
+#include "derivative.h"
+#include "system.h"
+
+namespace USBDM {
+
+/**
+ * Free-running count of processor cycles using the DWT cycle counter (DWT_CYCCNT).
+ *
+ * The counter wraps every 2^32 cycles (~59 s at 72 MHz) so only
+ * differences between counts should be used.
+ */
+class CycleCounter {
+
+public:
+   /**
+    * Enable cycle counter.
+    * This is harmless if the counter is already running (e.g. under a debugger).
+    */
+   static void enable() {
+      CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+      DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+   }
+
+   /**
+    * Get current count
+    *
+    * @return Cycle count
+    */
+   static uint32_t getCount() {
+      return DWT->CYCCNT;
+   }
+
+   /**
+    * Get frequency of the counter
+    *
+    * @return Frequency in Hz
+    */
+   static float getFrequency() {
+      return SystemCoreClock;
+   }
+};
+
+} // End namespace USBDM
+
+#endif /* HEADER_CYCLECOUNTER_H_ */
@@ -223,6 +223,58 @@ public:
       return transmit(address, txSize, data);
    }
 
+   /**
+    * Start transmission of message without waiting for completion.
+    * Requires I2cMode_Interrupt.
+    * Completion may be detected with isBusy() or by the callback set by setCallback().
+    * The callback may start another transaction.
+    *
+    * @note The data must remain unchanged until the transaction completes
+    * @note Any previous transaction must be complete
+    *
+    * @param[in]  address  Address of slave to communicate with (should include LSB = R/W bit = 0)
+    * @param[in]  size     Size of transmission data
+    * @param[in]  data     Data to transmit
+    *
+    * @return E_NO_ERROR on successful start of transaction
+    */
+   ErrorCode startTransmit(uint8_t address, uint16_t size, const uint8_t data[]);
+
+   /**
+    * Start transmission of message without waiting for completion.
+    * Requires I2cMode_Interrupt.
+    *
+    * @note The data must remain unchanged until the transaction completes
+    * @note Any previous transaction must be complete
+    *
+    * @param[in]  address  Address of slave to communicate with (should include LSB = R/W bit = 0)
+    * @param[in]  data     Data to transmit (size of transmission is inferred from array size).
+    *
+    * @return E_NO_ERROR on successful start of transaction
+    */
+   template<unsigned txSize>
+   ErrorCode startTransmit(uint8_t address, const uint8_t (&data)[txSize]) {
+      return startTransmit(address, txSize, data);
+   }
+
+   /**
+    * Indicates a transaction is in progress
+    *
+    * @return true if busy
+    */
+   bool isBusy() const {
+      return state != i2c_idle;
+   }
+
+   /**
+    * Get result of last transaction
+    *
+    * @return E_NO_ERROR on success
+    */
+   ErrorCode getErrorCode() const {
+      return errorCode;
+   }
+
    /**
     * Receive message
     *
@@ -556,7 +608,7 @@ public:
       thisPtr = this;
 
       if (i2cMode&I2C_C1_IICIE_MASK) {
-         NVIC_EnableIRQ(Info::irqNums[0]);
+         enableNvicInterrupts(Info::irqLevel);
       }
       // Enable I2C peripheral
       i2c->C1 = I2C_C1_IICEN_MASK|i2cMode;
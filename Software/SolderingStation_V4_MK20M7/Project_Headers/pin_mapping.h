@@ -4210,10 +4210,10 @@ public:
    static constexpr uint32_t irqCount  = sizeofArray(irqNums);
 
    //! Class based callback handler has been installed in vector table
-   static constexpr bool irqHandlerInstalled = 0;
+   static constexpr bool irqHandlerInstalled = 1;
 
    //! Default IRQ level
-   static constexpr NvicPriority irqLevel =  NvicPriority_NotInstalled;
+   static constexpr NvicPriority irqLevel =  NvicPriority_Low;
 
    //! Number of DMA channels implemented
    static constexpr unsigned NumChannels = 16;
@@ -4930,8 +4930,8 @@ public:
       static constexpr PinInfo  info[] = {
    
             //      Signal                 Pin                                  portInfo    gpioBit                 PCR value
-            /*   0: FTM1_QD_PHA          = --                             */  { NoPortInfo, UNMAPPED_PCR, (PcrValue)0          },
-            /*   1: FTM1_QD_PHB          = --                             */  { NoPortInfo, UNMAPPED_PCR, (PcrValue)0          },
+            /*   0: FTM1_QD_PHA          = PTB0(p35)                      */  { PortBInfo,  0,            (PcrValue)0x00600UL  },
+            /*   1: FTM1_QD_PHB          = PTB1(p36)                      */  { PortBInfo,  1,            (PcrValue)0x00600UL  },
       };
 
       /**
@@ -5200,10 +5200,10 @@ public:
    static constexpr uint32_t irqCount  = sizeofArray(irqNums);
 
    //! Class based callback handler has been installed in vector table
-   static constexpr bool irqHandlerInstalled = 0;
+   static constexpr bool irqHandlerInstalled = 1;
 
    //! Default IRQ level
-   static constexpr NvicPriority irqLevel =  NvicPriority_NotInstalled;
+   static constexpr NvicPriority irqLevel =  NvicPriority_Low;
 
    /**
     * Get input clock frequency
@@ -5709,10 +5709,10 @@ public:
    static constexpr uint32_t irqCount  = sizeofArray(irqNums);
 
    //! Class based callback handler has been installed in vector table
-   static constexpr bool irqHandlerInstalled = 0;
+   static constexpr bool irqHandlerInstalled = 1;
 
    //! Default IRQ level
-   static constexpr NvicPriority irqLevel =  NvicPriority_NotInstalled;
+   static constexpr NvicPriority irqLevel =  NvicPriority_Normal;
 
    /**
     * Get input clock frequency
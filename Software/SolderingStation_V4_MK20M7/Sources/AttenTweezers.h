@@ -12,7 +12,7 @@
 
 #include "Measurement.h"
 #include "Averaging.h"
-#include "PidController.h"
+#include "SelectableController.h"
 #include "TakeBackHalfController.h"
 
 /**
@@ -34,9 +34,9 @@ private:
    ThermocoupleAveraging   leftThermocouple;
    ThermocoupleAveraging   rightThermocouple;
 
-   /// Loop controller
-   PidController leftController{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
-   PidController rightController{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+   /// Loop controllers (selected by tip settings, each heater has half the power)
+   SelectableController leftController{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY, nominalMaxPower/2};
+   SelectableController rightController{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY, nominalMaxPower/2};
 
 //   TakeBackHalfController leftController{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
 //   TakeBackHalfController rightController{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
@@ -63,10 +63,13 @@ public:
     *   - Controller (PID etc)
     *
     * @param targetTemperature Target temperature
+    * @param interval          Time since last update
     */
-   virtual void updateController(float targetTemperature) override {
+   virtual void updateController(float targetTemperature, USBDM::Seconds interval) override {
 
       // Run PIDs
+      leftController.setInterval(interval);
+      rightController.setInterval(interval);
       float leftDc  = leftController.newSample(targetTemperature, getLeftTemperature());
       float rightDc = rightController.newSample(targetTemperature, getRightTemperature());
 
@@ -143,7 +146,7 @@ public:
 
       float thermocoupleVoltage_mV  = 1000*leftThermocouple.getThermocoupleVoltage();
 
-      console.writeln(calibrationIndex, " : TC = ", thermocoupleVoltage_mV);
+      dmaConsole.writeln(calibrationIndex, " : TC = ", thermocoupleVoltage_mV);
 
       if ((thermocoupleVoltage_mV < 4) || (thermocoupleVoltage_mV > 9)) {
          return false;
@@ -200,6 +203,9 @@ public:
       settings->setCalibrationPoint(CalibrationIndex_400,  400.0,  7.9);   // T = 400.000, M = 7.551??
 
       settings->setInitialPidControlValues(1.1,0.1,1.0,20.0);
+
+      // Thermal model of each heater C(J/K)  G(W/K)
+      settings->setInitialModelValues(1.2,    0.020);
    }
 
    /**
@@ -217,15 +223,14 @@ public:
    /**
     * Get the sequence of ADC measurements to do
     *
-    * @return Sequence array terminated by MuxSelect_Complete sentinel
+    * @param channelMask   Mask indicating which channel
+    * @param tipPresent    Indicates tip is present in tool
+    *
+    * @return Schedule ordered for measurement (constructed at compile time)
     */
-   virtual MuxSelect const *getMeasurementSequence() const override {
-      static const MuxSelect sequence[] = {
-            Measurement1_LeftThermocouple,
-            Measurement2_RightThermocouple,
-            MuxSelect_Complete,
-      };
-      return sequence;
+   static constexpr MeasurementSchedule getMeasurementSchedule(uint8_t channelMask, bool tipPresent) {
+      (void)tipPresent;
+      return MeasurementSchedule(channelMask, Measurement1_LeftThermocouple, Measurement2_RightThermocouple);
    };
 
    /**
@@ -274,19 +279,28 @@ public:
       using namespace USBDM;
 
       if (doHeading) {
-         console.write("Time,");
+         dmaConsole.write("Time,");
          leftController.reportHeading(ch);
       }
 
       // Time-stamp
-      console.setFloatFormat(2, Padding_LeadingSpaces, 3);
-      console.write(leftController.getElapsedTime());
+      dmaConsole.setFloatFormat(2, Padding_LeadingSpaces, 3);
+      dmaConsole.write(leftController.getElapsedTime());
       leftController.report();
 
-      console.writeln(",", getInstantTemperature());
-      console.resetFormat();
+      dmaConsole.writeln(",", getInstantTemperature());
+      dmaConsole.resetFormat();
    }
 
+   /**
+    * Fill in controller and tool values of telemetry frame
+    *
+    * @param frame Frame to update
+    */
+   virtual void getTelemetry(TelemetryFrame &frame) const override {
+      // Only the left heater is logged (as for report())
+      leftController.getTelemetry(frame);
+   }
 };
 
 #endif /* ATTEN_TWEEZERS_H */
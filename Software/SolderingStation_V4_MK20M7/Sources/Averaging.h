@@ -8,9 +8,11 @@
 #ifndef SOURCES_AVERAGING_H_
 #define SOURCES_AVERAGING_H_
 
+#include <type_traits>
 #include "hardware.h"
 #include "Peripherals.h"
 #include "NonvolatileSettings.h"
+#include "FixedPoint.h"
 
 class AdcAverage {
 private:
@@ -234,6 +236,96 @@ public:
    }
 };
 
+/**
+ * Class representing a modified moving average for ADC values using fixed-point arithmetic.
+ * This is equivalent to MovingAverage<N> but the accumulator is Q15 (see FixedPoint.h).
+ *
+ * A(i) = A(i-1) + (s(i) - A(i-1))/N
+ *
+ * @tparam N is the weighting in above equation.
+ */
+template<unsigned N>
+class FixedMovingAverage : protected AdcAverage {
+
+private:
+   /// Sample accumulator (Q15)
+   int32_t accumulator = 0;
+
+   bool initial = true;
+
+   FixedMovingAverage(const FixedMovingAverage &other) = delete;
+   FixedMovingAverage(FixedMovingAverage &&other) = delete;
+   FixedMovingAverage& operator=(const FixedMovingAverage &other) = delete;
+   FixedMovingAverage& operator=(FixedMovingAverage &&other) = delete;
+
+public:
+   /**
+    * Constructor
+    */
+   FixedMovingAverage() {}
+
+   /**
+    * Destructor
+    */
+   virtual ~FixedMovingAverage() {}
+
+   /**
+    * Reset average
+    */
+   void reset() {
+      accumulator = 0;
+      initial     = true;
+   }
+
+   /**
+    * Add ADC sample to weighted average
+    *
+    * @param value to add
+    */
+   void accumulate(int value) {
+
+      lastSample = value;
+
+      int32_t sample = value<<FixedPoint::ADC_FRACTION_BITS;
+
+      if (initial) {
+         accumulator = sample;
+         initial     = false;
+      }
+      else {
+         accumulator += (sample - accumulator)/int32_t(N);
+      }
+   }
+
+   /**
+    * Calculate the weighted average of the ADC samples
+    *
+    * @return Sample average (Q15)
+    */
+   int32_t getAveragedAdcSamplesQ15() const {
+      return accumulator;
+   }
+
+   /**
+    * Calculate the weighted average of the ADC samples
+    *
+    * @return Sample average
+    */
+   float getAveragedAdcSamples() const {
+      return accumulator * (1.0f/(1<<FixedPoint::ADC_FRACTION_BITS));
+   }
+
+   /**
+    * Calculate the weighted average of the ADC sample voltages
+    *
+    * @return Voltage average
+    */
+   float getAveragedAdcVoltage() const {
+      // Convert ADC samples averaged over window to voltage
+      return convertToAdcVoltage(getAveragedAdcSamples());
+   }
+};
+
 /**
  * Class representing dummy average for ADC values.
  *
@@ -298,23 +390,79 @@ public:
 using AveragingMethod = MovingAverage<10>; // 10*10ms = declining weights over 100ms average
 //using AveragingMethod = DummyAverage;
 
+/**
+ * Arithmetic used to convert ADC samples to temperature
+ */
+enum TemperatureArithmetic {
+   TemperatureArithmetic_Float,  ///< Single precision floating point (suits targets with FPU)
+   TemperatureArithmetic_Fixed,  ///< Fixed-point Q15 samples, Q16 temperatures (suits targets without FPU)
+};
+
+// Two methods for temperature conversion in tip sensors
+constexpr TemperatureArithmetic TEMPERATURE_ARITHMETIC = TemperatureArithmetic_Float;
+//constexpr TemperatureArithmetic TEMPERATURE_ARITHMETIC = TemperatureArithmetic_Fixed;
+
 /**
  * Class representing a modified moving average for Temperature values.
  *
  * A(i) = (s(i) + (N-1)A(i-1))/N = S(i)/N + (N-1)s(i-1)/N + (N-1)(N-1)S(i-2)/N*N ...
  *
- * @tparam N is the weighting in above equation.
+ * @tparam N            is the weighting in above equation.
+ * @tparam arithmetic   Arithmetic used for averaging and conversion
  */
-template<unsigned N>
-class TemperatureAverage : public MovingAverage<N> {
+template<unsigned N, TemperatureArithmetic arithmetic=TemperatureArithmetic_Float>
+class TemperatureAverage : public std::conditional_t<arithmetic==TemperatureArithmetic_Fixed, FixedMovingAverage<N>, MovingAverage<N>> {
+
+private:
+   using super = std::conditional_t<arithmetic==TemperatureArithmetic_Fixed, FixedMovingAverage<N>, MovingAverage<N>>;
+
+   /// Temperature calculated from average - updated when the average or calibration changes
+   float temperature = 0.0;
+
+protected:
+   /**
+    * Calculates the averaged temperature
+    *
+    * @return Temperature in Celsius
+    */
+   virtual float calculateTemperature() const = 0;
+
+   /**
+    * Update temperature from average.
+    * Used when the average or calibration changes.
+    */
+   void updateTemperature() {
+      temperature = calculateTemperature();
+   }
 
 public:
    /**
-    * Returns the averaged temperature
+    * Reset average
+    */
+   void reset() {
+      super::reset();
+      updateTemperature();
+   }
+
+   /**
+    * Add ADC sample to weighted average and update temperature
+    *
+    * @param value to add
+    */
+   void accumulate(int value) {
+      super::accumulate(value);
+      updateTemperature();
+   }
+
+   /**
+    * Returns the averaged temperature.
+    * This is calculated when a sample is added so is inexpensive.
     *
     * @return Temperature in Celsius
     */
-   virtual float getTemperature() const = 0;
+   float getTemperature() const {
+      return temperature;
+   }
 
    /**
     * Returns the temperature from the last sample
@@ -345,11 +493,158 @@ public:
 
 };
 
+/**
+ * Temperature table for a NTC thermistor MF58 10k B3950
+ * measured as in ThermistorMF58Average.
+ *
+ * The table is indexed by ADC sample and is generated at compile time from the
+ * Steinhart-Hart curve fit. Linear interpolation between entries is within 0.1 C of
+ * the curve fit up to 120 C.
+ */
+class ThermistorMF58Table {
+
+public:
+   /// Maximum ADC value possible for this measurement
+   static constexpr uint32_t ADC_MAXIMUM = USBDM::FixedGainAdc::getSingleEndedMaximum(ADC_RESOLUTION);
+
+   /// log2 of the number of ADC samples between table entries
+   static constexpr unsigned SAMPLE_SHIFT = 8;
+
+   /// Number of table entries - covers range of valid ADC samples (<90% of maximum)
+   static constexpr unsigned TABLE_SIZE = (unsigned(ADC_MAXIMUM*0.9)>>SAMPLE_SHIFT)+2;
+
+   /**
+    * Converts log of thermistor resistance to temperature using the Steinhart-Hart curve fit
+    *
+    * @param logResistance Natural log of thermistor resistance in ohms
+    *
+    * @return Corresponding temperature in Celsius
+    */
+   static constexpr float logResistanceToCelsius(float logResistance) {
+
+      // Value from curve fitting see spreadsheet
+      // Sensor curve fitting.ods
+      constexpr float A_constant = 1.80554E-03; //1.29869E-03;
+      constexpr float B_constant = 8.15458E-05; //1.89836E-04;
+      constexpr float C_constant = 9.43826E-06; //3.45639E-06;
+
+      constexpr float KelvinToCelsius = -274.15;
+
+      // Used to calculate log(R)^N
+      float power = logResistance;
+
+      // Used to calculate 1/T in Kelvin
+      float reciprocalTemperature = A_constant;
+
+      reciprocalTemperature += B_constant * power;
+      power *= logResistance;
+      reciprocalTemperature += C_constant * power;
+
+      float temperatureInKelvin = 1/reciprocalTemperature;
+
+      return temperatureInKelvin + KelvinToCelsius;
+   }
+
+   /**
+    * Converts thermistor resistance to temperature (run-time)
+    *
+    * @param resistance Thermistor resistance in ohms
+    *
+    * @return Corresponding temperature in Celsius
+    */
+   static float convertNtcResistanceToCelsius(float resistance) {
+      return logResistanceToCelsius(log(resistance));
+   }
+
+   /**
+    * Converts thermistor resistance to temperature (compile-time)
+    * Used to calculate the table as log() is not constexpr.
+    *
+    * @param resistance Thermistor resistance in ohms
+    *
+    * @return Corresponding temperature in Celsius
+    */
+   static constexpr float calculateNtcResistanceToCelsius(float resistance) {
+      return logResistanceToCelsius(FixedPoint::ln(resistance));
+   }
+
+   /**
+    * Constructor - calculates table
+    * The default gain of the measurement path is used.
+    */
+   constexpr ThermistorMF58Table() : temperatures{} {
+      for (unsigned index=0; index<TABLE_SIZE; index++) {
+         // A sample of zero corresponds to a shorted thermistor - use nearest value
+         double sample      = (index == 0)?1:(index<<SAMPLE_SHIFT);
+         double voltage     = sample*(ADC_REF_VOLTAGE/ADC_MAXIMUM)*LOW_GAIN_MEASUREMENT_RATIO_BOOST_OFF;
+         double resistance  = BIAS_RESISTOR_VALUE / ((BIAS_VOLTAGE/voltage) - 1);
+         temperatures[index] = FixedPoint::toFixed(calculateNtcResistanceToCelsius(resistance), FixedPoint::TEMPERATURE_FRACTION_BITS);
+      }
+   }
+
+   /**
+    * Convert ADC sample to temperature by interpolation
+    *
+    * @param sample ADC sample (Q15)
+    *
+    * @return Temperature (Q16)
+    */
+   int32_t convert(uint32_t sample) const {
+      constexpr unsigned SHIFT = FixedPoint::ADC_FRACTION_BITS+SAMPLE_SHIFT;
+
+      unsigned index = sample>>SHIFT;
+      if (index > TABLE_SIZE-2) {
+         // Extrapolate from last interval
+         index = TABLE_SIZE-2;
+      }
+      // Position in interval (Q16)
+      int64_t fraction = (int64_t(sample) - (int64_t(index)<<SHIFT))>>(SHIFT-16);
+
+      int32_t low  = temperatures[index];
+      int32_t high = temperatures[index+1];
+      return low + int32_t(((high-low)*fraction)>>16);
+   }
+
+   /**
+    * Convert ADC sample to temperature by interpolation
+    *
+    * @param sample ADC sample
+    *
+    * @return Temperature in Celsius
+    */
+   float convert(float sample) const {
+      float    position = sample*(1.0f/(1<<SAMPLE_SHIFT));
+      unsigned index    = unsigned(position);
+      if (index > TABLE_SIZE-2) {
+         // Extrapolate from last interval
+         index = TABLE_SIZE-2;
+      }
+      float low  = FixedPoint::toCelsius(temperatures[index]);
+      float high = FixedPoint::toCelsius(temperatures[index+1]);
+      return low + (high-low)*(position-index);
+   }
+
+private:
+   /// Temperature for each (ADC sample>>SAMPLE_SHIFT) (Q16)
+   int32_t temperatures[TABLE_SIZE];
+};
+
+/// Temperature table for MF58 NTC thermistor - generated at compile time and located in ROM
+inline constexpr ThermistorMF58Table thermistorMF58Table;
+
 /**
  * Class representing an average customised for a NTC thermistor
  * MF58 10k B3950
+ *
+ * Conversion to temperature uses a table (see ThermistorMF58Table).
+ *
+ * @tparam arithmetic   Arithmetic used for averaging and conversion
  */
-class ThermistorMF58Average : public TemperatureAverage<40> {
+template<TemperatureArithmetic arithmetic=TEMPERATURE_ARITHMETIC>
+class ThermistorMF58Average : public TemperatureAverage<40, arithmetic> {
+
+private:
+   using super = TemperatureAverage<40, arithmetic>;
 
 public:
 
@@ -361,6 +656,12 @@ private:
    /// Maximum ADC value possible for this measurement
    static constexpr uint32_t ADC_MAXIMUM = USBDM::FixedGainAdc::getSingleEndedMaximum(ADC_RESOLUTION);
 
+   /// ADC sample corresponding to an open thermistor (Q15)
+   static constexpr int32_t OPEN_SAMPLE = FixedPoint::toFixed(2.99/ADC_REF_VOLTAGE*ADC_MAXIMUM, FixedPoint::ADC_FRACTION_BITS);
+
+   /// Scales ADC sample to default gain used by table (Q16)
+   uint32_t sampleScale = 1<<16;
+
    /**
     * Converts ADC voltage to thermistor resistance
     *
@@ -385,61 +686,67 @@ private:
    }
 
    /**
-    * Converts ADC voltage to temperature
+    * Converts ADC sample to temperature
     *
-    * @param voltage ADC voltage
+    * @param sample ADC sample (Q15)
     *
     * @return Corresponding temperature in Celsius
     */
-   float convertAdcVoltageToCelsius(float voltage) const {
-
-      // Convert ADC voltage to thermistor resistance
-      float resistance = convertAdcVoltageToNtcResistance(voltage);
+   float convertAdcSampleToCelsius(int32_t sample) const {
 
-      // Value from curve fitting see spreadsheet
-      // Sensor curve fitting.ods
-      constexpr float A_constant = 1.80554E-03; //1.29869E-03;
-      constexpr float B_constant = 8.15458E-05; //1.89836E-04;
-      constexpr float C_constant = 9.43826E-06; //3.45639E-06;
-
-      constexpr float KelvinToCelsius = -274.15;
-
-      // Used to calculate log(R)^N
-      float log_R_Nth = log(resistance);
-
-      float power;
-
-      // Used to calculate 1/T in Kelvin
-      float reciprocalTemperature;
+      if ((sample <= 0) || (sample > OPEN_SAMPLE)) {
+         // Assume ADC at limit => shorted or open resistor
+         return std::nanf("");
+      }
+      uint32_t scaledSample = (uint64_t(sample)*sampleScale)>>16;
 
-      reciprocalTemperature  = A_constant;
-      power  = log_R_Nth;
-      reciprocalTemperature += B_constant * power;
-      power *= log_R_Nth;
-      reciprocalTemperature += C_constant * power;
+      return FixedPoint::toCelsius(thermistorMF58Table.convert(scaledSample));
+   }
 
-      float temperatureInKelvin = 1/reciprocalTemperature;
+   /**
+    * Converts ADC sample to temperature
+    *
+    * @param sample ADC sample
+    *
+    * @return Corresponding temperature in Celsius
+    */
+   float convertAdcSampleToCelsius(float sample) const {
 
-      return temperatureInKelvin + KelvinToCelsius;
+      if ((sample <= 0) || (sample > (OPEN_SAMPLE>>FixedPoint::ADC_FRACTION_BITS))) {
+         // Assume ADC at limit => shorted or open resistor
+         return std::nanf("");
+      }
+      return thermistorMF58Table.convert(sample*sampleScale*(1.0f/(1<<16)));
    }
 
-public:
+protected:
    /**
-    * Returns the averaged thermistor temperature
+    * Calculates the averaged thermistor temperature
     *
     * @return  Thermistor temperature in Celsius
     */
-   virtual float getTemperature() const override {
-      return convertAdcVoltageToCelsius(getAveragedAdcVoltage());
+   virtual float calculateTemperature() const override {
+      if constexpr (arithmetic == TemperatureArithmetic_Fixed) {
+         return convertAdcSampleToCelsius(super::getAveragedAdcSamplesQ15());
+      }
+      else {
+         return convertAdcSampleToCelsius(super::getAveragedAdcSamples());
+      }
    }
 
+public:
    /**
     * Returns the thermistor temperature from the last sample
     *
     * @return  Thermistor temperature in Celsius
     */
    virtual float getInstantTemperature() const override {
-      return convertAdcVoltageToCelsius(getLastAdcVoltage());
+      if constexpr (arithmetic == TemperatureArithmetic_Fixed) {
+         return convertAdcSampleToCelsius(int32_t(super::getLastAdcSample()<<FixedPoint::ADC_FRACTION_BITS));
+      }
+      else {
+         return convertAdcSampleToCelsius(float(super::getLastAdcSample()));
+      }
    }
 
    /**
@@ -448,7 +755,16 @@ public:
     * @return
     */
    virtual float getResistance() const override {
-      return convertAdcVoltageToNtcResistance(getAveragedAdcVoltage());
+      return convertAdcVoltageToNtcResistance(super::getAveragedAdcVoltage());
+   }
+
+   /**
+    * Set calibration values for thermistor.
+    * Only the hardware calibration is used.
+    */
+   void setCalibrationValues() {
+      sampleScale = FixedPoint::toFixed(nvinit.hardwareCalibration.preAmplifierNoBoost/LOW_GAIN_MEASUREMENT_RATIO_BOOST_OFF, 16);
+      super::updateTemperature();
    }
 
    /**
@@ -465,7 +781,7 @@ public:
          return false;
       }
 
-      TemperatureAverage::accumulate(value);
+      super::accumulate(value);
       return true;
    }
 };
@@ -475,13 +791,14 @@ public:
  *
  * A(i) = (s(i) + (N-1)A(i-1))/N = S(i)/N + (N-1)s(i-1)/N + (N-1)(N-1)S(i-2)/N*N ...
  *
- * @tparam N is the weighting in above equation.
+ * @tparam N            is the weighting in above equation.
+ * @tparam arithmetic   Arithmetic used for averaging and conversion
  */
-template<unsigned N>
-class ThermocoupleAverage : public TemperatureAverage<N> {
+template<unsigned N, TemperatureArithmetic arithmetic=TEMPERATURE_ARITHMETIC>
+class ThermocoupleAverage : public TemperatureAverage<N, arithmetic> {
 
 private:
-   using super = TemperatureAverage<N>;
+   using super = TemperatureAverage<N, arithmetic>;
 
 private:
    // Temperature calibration values
@@ -490,6 +807,9 @@ private:
    // Thermocouple voltage calibration values
    float calibrationVoltages[3];
 
+   // Calibration values as ADC sample -> temperature for fixed-point conversion
+   FixedPoint::PiecewiseLinear linearConversion;
+
    /// Maximum ADC value possible for this measurement
    static constexpr uint32_t ADC_MAXIMUM = USBDM::FixedGainAdc::getSingleEndedMaximum(ADC_RESOLUTION);
 
@@ -514,6 +834,22 @@ public:
       return voltage * gain;
    }
 
+   /**
+    * Converts thermocouple voltage to ADC sample
+    * This is the inverse of convertAdcVoltageToThermocoupleVoltage()
+    *
+    * @param voltage Thermocouple voltage
+    *
+    * @return ADC sample
+    */
+   static float convertThermocoupleVoltageToAdcSample(float voltage) {
+
+      /// Gain of measurement path - Pre-amplifier x14.2
+      const float gain  = nvinit.hardwareCalibration.preAmplifierWithBoost;
+
+      return (voltage/gain) * (ADC_MAXIMUM/ADC_REF_VOLTAGE);
+   }
+
    /**
     * Converts ADC voltage to thermocouple relative temperature
     *
@@ -551,23 +887,34 @@ public:
       return temperature;
    }
 
-public:
+protected:
    /**
-    * Returns the averaged thermocouple temperature relative to the cold reference
+    * Calculates the averaged thermocouple temperature relative to the cold reference
     *
     * @return Thermocouple temperature in Celsius
     */
-   virtual float getTemperature() const override {
-      return convertAdcVoltageToCelsius(super::getAveragedAdcVoltage());
+   virtual float calculateTemperature() const override {
+      if constexpr (arithmetic == TemperatureArithmetic_Fixed) {
+         return FixedPoint::toCelsius(linearConversion.convert(super::getAveragedAdcSamplesQ15()));
+      }
+      else {
+         return convertAdcVoltageToCelsius(super::getAveragedAdcVoltage());
+      }
    }
 
+public:
    /**
     * Returns the thermocouple temperature relative to the cold reference for the last sample
     *
     * @return Thermocouple temperature in Celsius
     */
    virtual float getInstantTemperature() const override {
-      return convertAdcVoltageToCelsius(super::getLastAdcVoltage());
+      if constexpr (arithmetic == TemperatureArithmetic_Fixed) {
+         return FixedPoint::toCelsius(linearConversion.convert(super::getLastAdcSample()<<FixedPoint::ADC_FRACTION_BITS));
+      }
+      else {
+         return convertAdcVoltageToCelsius(super::getLastAdcVoltage());
+      }
    }
 
    /**
@@ -589,6 +936,17 @@ public:
          calibrationTemperatures[index] = tipSettings->getCalibrationTempValue(index);
          calibrationVoltages[index]     = tipSettings->getCalibrationMeasurementValue(index);
       }
+      if constexpr (arithmetic == TemperatureArithmetic_Fixed) {
+         // Interpolation from 0 mV at 0 C then calibration points (mV)
+         float samples[FixedPoint::PiecewiseLinear::NUM_POINTS]      = {0};
+         float temperatures[FixedPoint::PiecewiseLinear::NUM_POINTS] = {0};
+         for (CalibrationIndex index=CalibrationIndex_250; index<=CalibrationIndex_400; ++index) {
+            samples[index+1]      = convertThermocoupleVoltageToAdcSample(calibrationVoltages[index]/1000);
+            temperatures[index+1] = calibrationTemperatures[index];
+         }
+         linearConversion.setPoints(samples, temperatures);
+      }
+      super::updateTemperature();
    }
 
    /**
@@ -627,18 +985,18 @@ private:
       return 25 - (voltage-0.719)/.001715;
    }
 
-public:
-
+protected:
    /**
-    * Returns the averaged internal chip temperature
+    * Calculates the averaged internal chip temperature
     *
     * @return Chip temperature in Celsius
     */
-   virtual float getTemperature() const override {
+   virtual float calculateTemperature() const override {
 
       return convertAdcVoltageToCelsius(getAveragedAdcVoltage());
    }
 
+public:
    /**
     * Returns the temperature from the last sample
     *
@@ -655,16 +1013,22 @@ public:
  */
 class ZeroAverage : public TemperatureAverage<0> {
 
-public:
-   virtual float getTemperature() const override {
+protected:
+   virtual float calculateTemperature() const override {
       return 0.0;
    }
 };
 
 /**
  * Class representing an average customised for a Weller PTC Thermistor
+ *
+ * @tparam arithmetic   Arithmetic used for averaging and conversion
  */
-class WellerThermistorAverage : public TemperatureAverage<10> {
+template<TemperatureArithmetic arithmetic=TEMPERATURE_ARITHMETIC>
+class WellerThermistorAverage : public TemperatureAverage<10, arithmetic> {
+
+private:
+   using super = TemperatureAverage<10, arithmetic>;
 
 public:
    /// Measurement path being used - Pre-amplifier x14.2 + Bias
@@ -681,6 +1045,15 @@ private:
    // Thermistor resistance calibration values
    float calibrationResistances[3];
 
+   // Calibration values as ADC sample -> temperature for fixed-point conversion
+   FixedPoint::PiecewiseLinear linearConversion;
+
+   /// Resistance of thermistor at 0 C
+   static constexpr float R_AT_ZERO_CELSIUS = 22.0;
+
+   /// ADC sample corresponding to an open thermistor (Q15)
+   static constexpr int32_t OPEN_SAMPLE = FixedPoint::toFixed(2.99/ADC_REF_VOLTAGE*ADC_MAXIMUM, FixedPoint::ADC_FRACTION_BITS);
+
 private:
    /**
     * Converts a ADC voltage to thermistor resistance
@@ -708,6 +1081,25 @@ private:
       return BIAS_RESISTOR_VALUE / ((BIAS_VOLTAGE/voltage) - 1);
    }
 
+   /**
+    * Converts thermistor resistance to ADC sample
+    * This is the inverse of convertAdcVoltageToPtcResistance()
+    *
+    * @param resistance  PTC resistance
+    *
+    * @return ADC sample
+    */
+   static float convertPtcResistanceToAdcSample(float resistance) {
+
+      /// Gain of measurement path - Pre-amplifier x14.2
+      const float gain  = nvinit.hardwareCalibration.preAmplifierWithBoost;
+
+      // Voltage divider
+      float voltage = BIAS_VOLTAGE * resistance / (BIAS_RESISTOR_VALUE + resistance);
+
+      return (voltage/gain) * (ADC_MAXIMUM/ADC_REF_VOLTAGE);
+   }
+
    /**
     * Converts a ADC voltage to thermistor temperature
     * The ADC voltage is from the thermocouple amplifier with 1/TC_MEASUREMENT_RATIO gain measuring
@@ -723,7 +1115,7 @@ private:
       float Rptc = convertAdcVoltageToPtcResistance(voltage);
 
       // Simple linear interpolation with three calibration points
-      float lastR = 22.0;
+      float lastR = R_AT_ZERO_CELSIUS;
       float lastT = 0.0;
       unsigned index;
       for (index=0; index<2; index++) {
@@ -755,23 +1147,50 @@ private:
       return temperature;
    }
 
-public:
    /**
-    * Returns the averaged thermistor temperature
+    * Converts ADC sample to thermistor temperature using fixed-point arithmetic
+    *
+    * @param sample ADC sample (Q15)
+    *
+    * @return Temperature in Celsius
+    */
+   float convertAdcSampleToCelsius(int32_t sample) const {
+
+      if (sample > OPEN_SAMPLE) {
+         // Assume ADC at maximum => open resistor
+         return std::nanf("");
+      }
+      return FixedPoint::toCelsius(linearConversion.convert(sample));
+   }
+
+protected:
+   /**
+    * Calculates the averaged thermistor temperature
     *
     * @return Thermistor temperature in Celsius
     */
-   virtual float getTemperature() const override {
-      return convertAdcVoltageToCelsius(getAveragedAdcVoltage());
+   virtual float calculateTemperature() const override {
+      if constexpr (arithmetic == TemperatureArithmetic_Fixed) {
+         return convertAdcSampleToCelsius(super::getAveragedAdcSamplesQ15());
+      }
+      else {
+         return convertAdcVoltageToCelsius(super::getAveragedAdcVoltage());
+      }
    }
 
+public:
    /**
     * Returns the thermistor temperature from the last sample
     *
     * @return Thermistor temperature in Celsius
     */
    virtual float getInstantTemperature() const override {
-      return convertAdcVoltageToCelsius(getLastAdcVoltage());
+      if constexpr (arithmetic == TemperatureArithmetic_Fixed) {
+         return convertAdcSampleToCelsius(super::getLastAdcSample()<<FixedPoint::ADC_FRACTION_BITS);
+      }
+      else {
+         return convertAdcVoltageToCelsius(super::getLastAdcVoltage());
+      }
    }
 
    /**
@@ -780,7 +1199,7 @@ public:
     * @return
     */
    virtual float getResistance() const {
-      return convertAdcVoltageToPtcResistance(getAveragedAdcVoltage());
+      return convertAdcVoltageToPtcResistance(super::getAveragedAdcVoltage());
    }
 
    /**
@@ -793,6 +1212,19 @@ public:
          calibrationResistances[index]  = tipsettings->getCalibrationMeasurementValue(index);
          calibrationTemperatures[index] = tipsettings->getCalibrationTempValue(index);
       }
+      if constexpr (arithmetic == TemperatureArithmetic_Fixed) {
+         // Interpolation from R_AT_ZERO_CELSIUS at 0 C then calibration points.
+         // The divider is very nearly linear over the PTC range so interpolating
+         // on ADC samples rather than resistance introduces little error (<0.05 C).
+         float samples[FixedPoint::PiecewiseLinear::NUM_POINTS]      = {convertPtcResistanceToAdcSample(R_AT_ZERO_CELSIUS)};
+         float temperatures[FixedPoint::PiecewiseLinear::NUM_POINTS] = {0};
+         for (CalibrationIndex index=CalibrationIndex_250; index<=CalibrationIndex_400; ++index) {
+            samples[index+1]      = convertPtcResistanceToAdcSample(calibrationResistances[index]);
+            temperatures[index+1] = calibrationTemperatures[index];
+         }
+         linearConversion.setPoints(samples, temperatures);
+      }
+      super::updateTemperature();
    }
 
    /**
@@ -808,7 +1240,7 @@ public:
          // Thermistor open
          return false;
       }
-      TemperatureAverage::accumulate(value);
+      super::accumulate(value);
       return true;
    }
 };
@@ -7,6 +7,7 @@
 #include "BangBangController.h"
 #include "hardware.h"
 #include "Channel.h"
+#include "DmaConsole.h"
 
 using namespace USBDM;
 
@@ -72,8 +73,8 @@ float BangBangController::newSample(float targetTemperature, float actualTempera
  */
 void BangBangController::reportHeading(Channel &ch) {
 
-      console.setFloatFormat(3, Padding_LeadingSpaces, 3);
-      console.
+      dmaConsole.setFloatFormat(3, Padding_LeadingSpaces, 3);
+      dmaConsole.
          write("Time,Drive,").write(ch.getTipName()).
          writeln(",Inst. Temp,Error");
 }
@@ -89,16 +90,16 @@ void BangBangController::report(Channel &) {
    volatile float currentError  = fCurrentError;
 //   volatile float rawTipTemp    = ch.tipTemperature.getLastSample()/50; // Approximation!
 
-   console.setFloatFormat(2, Padding_LeadingSpaces, 3);
-   console.write(getElapsedTime()).write(", ");
+   dmaConsole.setFloatFormat(2, Padding_LeadingSpaces, 3);
+   dmaConsole.write(getElapsedTime()).write(", ");
 
-   console.setFloatFormat(1, Padding_LeadingSpaces, 4);
-   console.write(currentOutput).write(", ").write(currentInput);
-//   console.write(", ").write(rawTipTemp);
+   dmaConsole.setFloatFormat(1, Padding_LeadingSpaces, 4);
+   dmaConsole.write(currentOutput).write(", ").write(currentInput);
+//   dmaConsole.write(", ").write(rawTipTemp);
 
-   console.setFloatFormat(2, Padding_LeadingSpaces, 5);
-   console.write(",").write(currentError);
+   dmaConsole.setFloatFormat(2, Padding_LeadingSpaces, 5);
+   dmaConsole.write(",").write(currentError);
 
-   console.writeln();
-   console.resetFormat();
+   dmaConsole.writeln();
+   dmaConsole.resetFormat();
 }
@@ -149,6 +149,8 @@ public:
    BoundedInteger(int max, int initialValue) : LimitedInteger(max, initialValue) {
    }
 
+   using LimitedInteger::operator=;
+
 private:
    /**
     * Limit value to acceptable range
@@ -20,6 +20,7 @@
 #include "T12.h"
 #include "Jbc.h"
 #include "AttenTweezers.h"
+#include "ExecutionTiming.h"
 
 class StepResponseDriver;
 
@@ -68,6 +69,9 @@ private:
    // Desired temperature of tool (Celsius)
    int               targetTemperature   = 0;
 
+   // Drive applied to elements in the current half-cycle
+   DriveSelection    drive               = DriveSelection_Off;
+
    // Currently selected preset for the channel
    unsigned          preset              = 1;
 
@@ -93,7 +97,11 @@ private:
    JBC_C210          jbcC210Measurement{*this};
    AttenTweezers     attenMeasurement{*this};
 
-   int   stateChangedCountdown = 0;
+   /// Delay before a change of tip is written to NV storage
+   static constexpr USBDM::Seconds STATE_SAVE_DELAY = 10_s;
+
+   /// Time remaining before a change of tip is written to NV storage (0 if none pending)
+   USBDM::Seconds stateChangedCountdown = 0;
    const TipSettings *selectedTip;
    const TipSettings *lastSelectedTip = nullptr;
 
@@ -221,36 +229,24 @@ public:
    /**
     * Get the sequence of ADC measurements to do
     *
-    * @param[out] seq         Array of measurements to do
-    * @param[in]  channelMask Mask indicating which channel
-    *
-    * @return Number of measurements added to seq[]
+    * @return Selection for schedule of measurements (see MeasurementSchedule)
     */
-   unsigned getMeasurementSequence(MuxSelect seq[], uint8_t channelMask) {
-      static const MuxSelect identifySequence[] = {
-            MuxSelect_Identify,
-            MuxSelect_Complete,
-      };
-      MuxSelect const *newSequence;
+   ScheduleSelection getScheduleSelection() {
+      ScheduleSelection selection;
       if (!isRunning()  && (identifyCounter++ > 10)) {
          // Regularly check for tool change
-         newSequence = identifySequence;
+         selection = ScheduleSelection_Identify;
          identifyCounter = 0;
       }
       else if (getState() == ChannelState_noTool) {
          // No tool present - no measurements
-         return 0;
+         selection = ScheduleSelection_None;
       }
       else {
          // Get sequence dependent on tool type
-         newSequence = measurement->getMeasurementSequence();
-      }
-      unsigned sequenceLength;
-      for(sequenceLength=0; newSequence[sequenceLength] != MuxSelect_Complete; sequenceLength++) {
-         // Add channel information
-         seq[sequenceLength] = (MuxSelect)(newSequence[sequenceLength]|channelMask);
+         selection = MeasurementSchedule::getToolSelection(ironType, measurement->isTipPresent());
       }
-      return sequenceLength;
+      return selection;
    }
 
    /**
@@ -342,7 +338,7 @@ public:
       const TipSettings *ts = selectedTip;
       if ((ts == nullptr) || ts->isFree() || (ts->getIronType() != ironType)) {
          // Try last selected tip
-         if (lastSelectedTip->getIronType() == ironType) {
+         if ((lastSelectedTip != nullptr) && (lastSelectedTip->getIronType() == ironType)) {
             setTip(lastSelectedTip);
          }
          else {
@@ -363,6 +359,18 @@ public:
       measurement->setCalibrationValues(ts);
    }
 
+   /**
+    * Select relay autotuning in place of the controller for the tip.
+    * Autotuning starts when the channel is next made active.
+    *
+    * @param enable True to select autotuning
+    *
+    * @return Autotuner or nullptr if not available for the tool
+    */
+   RelayAutotuneController *selectAutotune(bool enable) {
+      return measurement->selectAutotune(enable);
+   }
+
    /**
     * Change selected tip for this channel
     *
@@ -397,8 +405,8 @@ public:
 
       selectedTip = tipSettings;
 
-      // Write change to NV storage 1000 ticks from now
-      stateChangedCountdown = 1000;
+      // Write change to NV storage STATE_SAVE_DELAY from now
+      stateChangedCountdown = STATE_SAVE_DELAY;
 //      USBDM::console.writeln("Save state pending");
 
       refreshControllerParameters();
@@ -669,15 +677,23 @@ public:
     *   - Temperature
     *   - Power
     *   - Controller
+    *
+    * @param interval Time since last update
     */
-   void updateController() {
-      if ((stateChangedCountdown > 0) && (--stateChangedCountdown == 0)) {
-         saveNonvolatileState();
+   void updateController(USBDM::Seconds interval) {
+      ExecutionTimer<TimingProbe_UpdateController> timer;
+
+      if (stateChangedCountdown > 0) {
+         // Count down by time since last update as updates are not at a fixed rate
+         stateChangedCountdown = float(stateChangedCountdown) - float(interval);
+         if (stateChangedCountdown <= 0) {
+            saveNonvolatileState();
+         }
       }
       {
       Debug3 db;
       // Update drive to heaters as needed
-      measurement->updateController(getTargetTemperature());
+      measurement->updateController(getTargetTemperature(), interval);
       }
       // Update current temperature from internal averages
       currentTemperature = measurement->getTemperature();
@@ -687,7 +703,17 @@ public:
     * Update drive to elements
     */
    void updateDrive() {
-      chDrive.write(measurement->getDrive());
+      drive = measurement->getDrive();
+      chDrive.write(drive);
+   }
+
+   /**
+    * Get drive applied to elements in the current half-cycle (by updateDrive())
+    *
+    * @return Drive selection
+    */
+   DriveSelection getDrive() const {
+      return drive;
    }
 
    /**
@@ -737,6 +763,15 @@ public:
       measurement->report(doHeading);
    }
 
+   /**
+    * Fill in controller and tool values of telemetry frame
+    *
+    * @param frame Frame to update
+    */
+   void getTelemetry(TelemetryFrame &frame) const {
+      measurement->getTelemetry(frame);
+   }
+
    /**
     * Set output duty cycle.
     * This is only applicable when in fixed power mode
@@ -0,0 +1,115 @@
+/*
+ * ChannelView.cpp
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#include "ChannelView.h"
+
+using namespace USBDM;
+
+FontVeryLargeReduced fontVeryLargeReduced;
+
+/**
+ * Prepare to redraw a widget.
+ * Sets clipping to the widget and clears it.
+ *
+ * @param oled    Display to draw on
+ * @param top     Top of widget
+ * @param bottom  Bottom of widget (inclusive)
+ */
+void ChannelView::beginWidget(Oled &oled, int top, int bottom) {
+   oled.setClip(left, top, right, bottom);
+   oled.drawRect(left, top, right, bottom, WriteMode_InverseWrite);
+}
+
+/**
+ * Force complete redraw on next update e.g. after screen has been cleared
+ */
+void ChannelView::invalidate() {
+   stateWidget.invalidate();
+   temperatureWidget.invalidate();
+   presetWidget.invalidate();
+   tipWidget.invalidate();
+   powerBarWidget.invalidate();
+}
+
+/**
+ * Redraw the widgets that have changed since the last update
+ *
+ * @param oled    Display to draw on
+ * @param values  Information to display
+ *
+ * @return Number of widgets redrawn
+ */
+unsigned ChannelView::update(Oled &oled, const Values &values) {
+
+   unsigned redrawn = 0;
+
+   if (stateWidget.update(values.stateName)) {
+      beginWidget(oled, STATE_TOP, STATE_BOTTOM);
+      oled.setFont(fontMedium);
+      oled.moveXY(left, 0).write(values.stateName);
+      redrawn++;
+   }
+
+   if (temperatureWidget.update({values.temperature, values.selected})) {
+      beginWidget(oled, TEMPERATURE_TOP, TEMPERATURE_BOTTOM);
+      oled.setPadding(Padding_LeadingSpaces).setWidth(3);
+      oled.setFont(fontVeryLargeReduced);
+      if (values.temperature == TEMPERATURE_NONE) {
+         oled.moveXY(left+6, 8).write("---");
+      }
+      else {
+         oled.moveXY(left+2, 8);
+         if (values.temperature == TEMPERATURE_LOW) {
+            oled.write("low");
+         }
+         else {
+            oled.write(values.temperature);
+            oled.setFont(fontMedium);
+            oled.moveXY(left+48, 14).write("C");
+         }
+      }
+      if (values.selected) {
+         oled.drawRect(left,  10, left+57,  10+fontVeryLargeReduced.HEIGHT-9, WriteMode_Xor);
+      }
+      redrawn++;
+   }
+
+   if (presetWidget.update({values.setback, values.preset, values.presetModified, values.presetTemperature})) {
+      beginWidget(oled, PRESET_TOP, PRESET_BOTTOM);
+      oled.setPadding(Padding_LeadingSpaces);
+      oled.setFont(fontLarge);
+      if (values.setback) {
+         // If in setback mode display target temperature instead of active preset
+         oled.moveXY(left,  35).write("SB :").setWidth(3).write(values.presetTemperature);
+      }
+      else {
+         oled.moveXY(left,  35).write("P").setWidth(1).write(values.preset).
+               write(values.presetModified?"*:":" :").setWidth(3).write(values.presetTemperature);
+      }
+      redrawn++;
+   }
+
+   if (tipWidget.update({values.tipName, values.power})) {
+      beginWidget(oled, TIP_TOP, TIP_BOTTOM);
+      oled.setPadding(Padding_LeadingSpaces).setWidth(3);
+      oled.setFont(fontSmall);
+      oled.moveXY(left,  50).write(values.tipName);
+      oled.moveXY(left+35,  50).write(values.power, 'W');
+      redrawn++;
+   }
+
+   if (powerBarWidget.update(values.powerBar)) {
+      beginWidget(oled, POWER_BAR_TOP, POWER_BAR_BOTTOM);
+      if (values.powerBar > 0) {
+         oled.drawRect(left, POWER_BAR_TOP, left+values.powerBar-1, POWER_BAR_BOTTOM, WriteMode_Xor);
+      }
+      redrawn++;
+   }
+
+   oled.clearClip();
+
+   return redrawn;
+}
@@ -0,0 +1,186 @@
+/*
+ * ChannelView.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef SOURCES_CHANNELVIEW_H_
+#define SOURCES_CHANNELVIEW_H_
+
+#include <stdint.h>
+#include "oled.h"
+
+/// Reduced character set of very large font (used for temperatures and times)
+using FontVeryLargeReduced = USBDM::FontArraySubset<USBDM::FontVeryLarge,
+      ' ', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'l', 'o', 'w', '-', '.', '*', 'm', 's', 'O', 'f'>;
+
+extern FontVeryLargeReduced fontVeryLargeReduced;
+
+/**
+ * Value of a widget that is retained between updates.
+ *
+ * @tparam T Type of value (must support ==)
+ */
+template<typename T>
+class RetainedValue {
+
+private:
+   T    value{};
+   bool valid = false;
+
+public:
+   /**
+    * Update value
+    *
+    * @param newValue Value to display
+    *
+    * @return true if the widget needs to be redrawn i.e. value changed or not yet drawn
+    */
+   bool update(const T &newValue) {
+      if (valid && (value == newValue)) {
+         return false;
+      }
+      value = newValue;
+      valid = true;
+      return true;
+   }
+
+   /**
+    * Force redraw on next update
+    */
+   void invalidate() {
+      valid = false;
+   }
+};
+
+/**
+ * Retained-mode view of one channel on the channel status screen (half of screen).
+ *
+ * The view is made of widgets (state name, temperature, preset, tip/power and power bar).
+ * Each widget remembers the value it last drew and is only redrawn when the value changes.
+ * A widget redraw is clipped to its own bounding box so the rest of the screen is untouched.
+ */
+class ChannelView {
+
+public:
+   /// Temperature value indicating no tip or overload i.e. "---" is displayed
+   static constexpr int TEMPERATURE_NONE = -1;
+
+   /// Temperature value indicating tip is below LOW_TEMPERATURE i.e. "low" is displayed
+   static constexpr int TEMPERATURE_LOW  = 0;
+
+   /// Temperatures below this are displayed as "low"
+   static constexpr int LOW_TEMPERATURE  = 40;
+
+   /**
+    * Information displayed for a channel
+    */
+   struct Values {
+      const char *stateName;          ///< Name of channel state (static string)
+      int         temperature;        ///< Tip temperature (or TEMPERATURE_NONE, TEMPERATURE_LOW)
+      bool        selected;           ///< Channel is selected (temperature highlighted)
+      bool        setback;            ///< Channel is in setback (target temperature shown instead of preset)
+      int         preset;             ///< Active preset number
+      bool        presetModified;     ///< Temperature differs from preset
+      int         presetTemperature;  ///< Preset or setback temperature
+      const char *tipName;            ///< Name of tip (static string)
+      int         power;              ///< Power in watts
+      int         powerBar;           ///< Length of power bar in pixels (0 => no bar)
+   };
+
+   /// Length of power bar at 100% power
+   static constexpr int POWER_BAR_LENGTH = (USBDM::Oled::WIDTH/2)-3;
+
+private:
+   /// Vertical extent of widgets
+   static constexpr int STATE_TOP          = 0;
+   static constexpr int STATE_BOTTOM       = 7;
+   static constexpr int TEMPERATURE_TOP    = 8;
+   static constexpr int TEMPERATURE_BOTTOM = 34;
+   static constexpr int PRESET_TOP         = 35;
+   static constexpr int PRESET_BOTTOM      = 49;
+   static constexpr int TIP_TOP            = 50;
+   static constexpr int TIP_BOTTOM         = 57;
+   static constexpr int POWER_BAR_TOP      = 58;
+   static constexpr int POWER_BAR_BOTTOM   = USBDM::Oled::HEIGHT-1;
+
+   /// Left edge of view
+   const int left;
+
+   /// Right edge of view (inclusive)
+   const int right;
+
+   struct TemperatureValue {
+      int  temperature;
+      bool selected;
+
+      bool operator==(const TemperatureValue &other) const {
+         return (temperature == other.temperature) && (selected == other.selected);
+      }
+   };
+
+   struct PresetValue {
+      bool setback;
+      int  preset;
+      bool modified;
+      int  temperature;
+
+      bool operator==(const PresetValue &other) const {
+         return (setback == other.setback) && (preset == other.preset) &&
+               (modified == other.modified) && (temperature == other.temperature);
+      }
+   };
+
+   struct TipValue {
+      const char *tipName;
+      int         power;
+
+      bool operator==(const TipValue &other) const {
+         return (tipName == other.tipName) && (power == other.power);
+      }
+   };
+
+   RetainedValue<const char *>     stateWidget;
+   RetainedValue<TemperatureValue> temperatureWidget;
+   RetainedValue<PresetValue>      presetWidget;
+   RetainedValue<TipValue>         tipWidget;
+   RetainedValue<int>              powerBarWidget;
+
+   /**
+    * Prepare to redraw a widget.
+    * Sets clipping to the widget and clears it.
+    *
+    * @param oled    Display to draw on
+    * @param top     Top of widget
+    * @param bottom  Bottom of widget (inclusive)
+    */
+   void beginWidget(USBDM::Oled &oled, int top, int bottom);
+
+public:
+   /**
+    * Constructor
+    *
+    * @param left    Left edge of view
+    * @param right   Right edge of view (inclusive)
+    */
+   ChannelView(int left, int right) : left(left), right(right) {
+   }
+
+   /**
+    * Force complete redraw on next update e.g. after screen has been cleared
+    */
+   void invalidate();
+
+   /**
+    * Redraw the widgets that have changed since the last update
+    *
+    * @param oled    Display to draw on
+    * @param values  Information to display
+    *
+    * @return Number of widgets redrawn
+    */
+   unsigned update(USBDM::Oled &oled, const Values &values);
+};
+
+#endif /* SOURCES_CHANNELVIEW_H_ */
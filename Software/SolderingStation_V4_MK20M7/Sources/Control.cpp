@@ -14,6 +14,9 @@
 #include "BoundedInteger.h"
 #include "Menus.h"
 #include "wdog.h"
+#include "ExecutionTiming.h"
+#include "DmaConsole.h"
+#include "FlightRecorder.h"
 
 using namespace USBDM;
 
@@ -38,6 +41,7 @@ void Control::initialise() {
    using namespace USBDM;
 
    Debug1::init();
+   ExecutionTiming::initialise();
 
    // Vref_out is needed for PGA/ADC reference
 //   Vref::configure(VrefBuffer_HighPower, VrefReg_Enable, VrefIcomp_Enable, VrefChop_Enable);
@@ -91,6 +95,9 @@ void Control::initialise() {
 
    // Over-current detection using external comparator and pin IRQ
    static CmpCallbackFunction overcurrent_cb = [](CmpStatus){
+      // Keep control state leading up to overload
+      flightRecorder.freeze(FlightRecorderTrigger_Overload, control.getHalfCycleCount());
+
       // Mark channels as overloaded
       channels[1].setOverload();
       channels[2].setOverload();
@@ -136,8 +143,11 @@ void Control::initialise() {
       ch1Drive.setInput();
       ch2Drive.setInput();
 
+      // Keep control state leading up to timeout (reported after reset)
+      flightRecorder.freeze(FlightRecorderTrigger_Watchdog, control.getHalfCycleCount());
+
       // Wait here for reset
-      __asm__("bkpt");
+      __BKPT();
    };
 
    Wdog::configure(
@@ -216,15 +226,6 @@ void Control::changeTemp(int16_t delta) {
    channel.setUserTemperature(targetTemperature);
 }
 
-/// Extra settling time on initial measurement or when changing gain
-static constexpr unsigned INITAL_SAMPLE_DELAY     = 0;
-
-/// Settling time for high gain amplifier
-static constexpr unsigned HIGH_GAIN_SAMPLE_DELAY  = 200;
-
-/// Settling time for low gain amplifier
-static constexpr unsigned LOW_GAIN_SAMPLE_DELAY   = 100;
-
 /**
  * Comparator interrupt handler for controlling the heaters.
  * This is triggered just prior to the mains zero-crossing.
@@ -233,11 +234,25 @@ static constexpr unsigned LOW_GAIN_SAMPLE_DELAY   = 100;
 void Control::zeroCrossingHandler() {
 
    Debug1 xx;
+   ExecutionTimer<TimingProbe_ZeroCrossingHandler> timer;
+
+   fHalfCycleCount = fHalfCycleCount + 1;
+
+   fHalfCyclesSinceUpdate[0]++;
+   fHalfCyclesSinceUpdate[1]++;
 
    if (fHoldOff) {
        return;
    }
 
+   if (isQuiescent() && (++fQuiescentCount < QUIESCENT_SAMPLE_INTERVAL)) {
+      // Skip measurement sequence (and its interrupts) on most half-cycles
+      // The watchdog still expects a refresh every half-cycle
+      Wdog::writeRefresh(0xA602, 0xB480);
+      return;
+   }
+   fQuiescentCount = 0;
+
    fHoldOff = true;
 
 //   // Schedule ADC conversions
@@ -275,28 +290,44 @@ void Control::zeroCrossingHandler() {
    }
 
    // Get measurements to do
-   int sequenceLength = 0;
-   fOddEven = !fOddEven;
-   if (fOddEven) {
-      sequenceLength += ch1.getMeasurementSequence(fSequence+sequenceLength, CH1_MASK);
+   // Schedules are pre-sorted at compile time (see MeasurementSchedule) so that:
+   // - High-gain measurements are done first. This prevents saturation of the high gain amplifier.
+   // - Bias is only changed once in sequence
+   const MeasurementSchedule *schedule = nullptr;
+   if (fMeasurementMode == MeasurementMode_Interleaved) {
+      ScheduleSelection ch1Selection = ch1.getScheduleSelection();
+      ScheduleSelection ch2Selection = ch2.getScheduleSelection();
+
+      // Measure both channels if the settling times fit in the budget
+      schedule = &MeasurementSchedule::getSchedule(ch1Selection, ch2Selection);
+      fMeasuringCh1 = true;
+      fMeasuringCh2 = true;
+
+      if (!schedule->isWithinBudget()) {
+         // Fall back to alternating channels
+         fOddEven = !fOddEven;
+         if (fOddEven) {
+            schedule = &MeasurementSchedule::getSchedule(CH1_MASK, ch1Selection);
+            fMeasuringCh2 = false;
+         }
+         else {
+            schedule = &MeasurementSchedule::getSchedule(CH2_MASK, ch2Selection);
+            fMeasuringCh1 = false;
+         }
+      }
    }
    else {
-      sequenceLength += ch2.getMeasurementSequence(fSequence+sequenceLength, CH2_MASK);
+      fOddEven      = !fOddEven;
+      fMeasuringCh1 = fOddEven;
+      fMeasuringCh2 = !fOddEven;
+      if (fOddEven) {
+         schedule = &MeasurementSchedule::getSchedule(CH1_MASK, ch1.getScheduleSelection());
+      }
+      else {
+         schedule = &MeasurementSchedule::getSchedule(CH2_MASK, ch2.getScheduleSelection());
+      }
    }
-   fSequence[sequenceLength] = MuxSelect_Complete;
-
-   // Used to sort measurements according to AMPLIFIER and BIAS settings
-   // Avoids enabling/disabling bias multiple times
-   static auto comp = [](const void *p1, const void *p2) {
-      const MuxSelect *left  = static_cast<const MuxSelect*>(p1);
-      const MuxSelect *right = static_cast<const MuxSelect*>(p2);
-      return ((*right^BIAS_MASK)&(BIAS_MASK))-((*left^BIAS_MASK)&(BIAS_MASK));
-   };
-
-   // Sort (excluding sentinel value) so that:
-   // - High-gain measurements are done first. This prevents saturation of the high gain amplifier.
-   // - Bias is only changed once in sequence
-   qsort(fSequence, sequenceLength, sizeof(fSequence[0]), comp);
+   fSequence = schedule->sequence;
 
    // Restart sequence
    fSequenceIndex = 0;
@@ -320,6 +351,7 @@ void Control::zeroCrossingHandler() {
  */
 void Control::adcHandler(uint32_t result, int adcChannel) {
    Debug1 xx;
+   ExecutionTimer<TimingProbe_AdcHandler> timer;
 
    // Pat the watchdog
    Wdog::writeRefresh(0xA602, 0xB480);
@@ -336,6 +368,7 @@ void Control::adcHandler(uint32_t result, int adcChannel) {
       // First conversion in sequence
       // Process chip temperature
       fChipTemperatureAverage.accumulate(result);
+      flightRecorder.startSequence(result);
 
       // Unclamp amplifier inputs (mux output)
       // Delayed to here to allow drive to drop
@@ -368,6 +401,7 @@ void Control::adcHandler(uint32_t result, int adcChannel) {
       else {
          ch2.processMeasurement(lastConversion, result);
       }
+      flightRecorder.addConversion(lastConversion, result);
    }
    // Get conversion to start this cycle
    MuxSelect currentConversion = fSequence[fSequenceIndex++];
@@ -382,15 +416,23 @@ void Control::adcHandler(uint32_t result, int adcChannel) {
       ch1.updateDrive();
       ch2.updateDrive();
 
-      // Run PIDs
-      {
-         if (fOddEven) {
-            ch1.updateController();
+      // Run PIDs for channels measured in this half-cycle
+      if (fMeasuringCh1) {
+         ch1.updateController(fHalfCyclesSinceUpdate[0]*SAMPLE_INTERVAL);
+         fHalfCyclesSinceUpdate[0] = 0;
+         if ((TELEMETRY_MODE == TelemetryMode_Binary) && ch1.isRunning()) {
+            fTelemetry.logChannel(1, ch1, fHalfCycleCount);
          }
-         else {
-            ch2.updateController();
+      }
+      if (fMeasuringCh2) {
+         ch2.updateController(fHalfCyclesSinceUpdate[1]*SAMPLE_INTERVAL);
+         fHalfCyclesSinceUpdate[1] = 0;
+         if ((TELEMETRY_MODE == TelemetryMode_Binary) && ch2.isRunning()) {
+            fTelemetry.logChannel(2, ch2, fHalfCycleCount);
          }
       }
+      flightRecorder.endSequence(fHalfCycleCount, ch1, ch2);
+
       // Allow new sequence
       fHoldOff = false;
 
@@ -406,20 +448,9 @@ void Control::adcHandler(uint32_t result, int adcChannel) {
    // Need extra time if bias has changed
 //   bool biasHasChange = (currentConversion ^ lastConversion) & BIAS_MASK;
 
-   // Allow extra time for high gain amplifier to settle
-   bool isHighGainAmplifier = (currentConversion & GAIN_BOOST_MASK);
-
-   // Allow extra settling time on 1st sample
-   unsigned delay = (fSequenceIndex == 1)?INITAL_SAMPLE_DELAY:0;
-
-   if (isHighGainAmplifier) {
-      // Longer settling time for high-gain amplifier
-      delay += HIGH_GAIN_SAMPLE_DELAY;
-   }
-   else {
-      // Standard delay
-      delay += LOW_GAIN_SAMPLE_DELAY;
-   }
+   // Allow extra settling time on 1st sample and for high gain amplifier
+   // These are the same delays used to check schedules against the measurement budget
+   unsigned delay = MeasurementSchedule::getSampleDelay(currentConversion, fSequenceIndex == 1);
 
    // Longer time for bias turning on
 //   delay += biasHasChange?INITAL_SAMPLE_DELAY:0;
@@ -443,7 +474,8 @@ void Control::adcHandler(uint32_t result, int adcChannel) {
  * Refresh the display of channel information
  */
 void Control::refresh() {
-   fNeedRefresh = false;
+   fNeedRefresh      = false;
+   fLastRefreshTime  = fHalfCycleCount;
 
    if (isDisplayInUse()) {
       // Update display
@@ -476,7 +508,7 @@ void Control::reportPid(Channel &ch) {
    if (ch.isRunning()) {
       ch.report(fDoReportPidTitle);
       fDoReportPidTitle = false;
-      console.resetFormat();
+      dmaConsole.resetFormat();
    }
 }
 
@@ -489,11 +521,11 @@ void Control::eventLoop()  {
    setNeedsRefresh();
 
    for(;;) {
-      if (fDoReportPid) {
+      if ((TELEMETRY_MODE == TelemetryMode_Text) && fDoReportPid) {
          reportPid(channels[1]);
       }
-      if (fNeedRefresh) {
-         // Redraw screen
+      if (fNeedRefresh && ((fHalfCycleCount-fLastRefreshTime) >= MIN_REFRESH_INTERVAL)) {
+         // Redraw screen (rate limited)
          refresh();
       }
 
@@ -557,7 +589,7 @@ void Control::eventLoop()  {
             break;
 
          case ev_QuadRotate    :
-            changeTemp(event.change);
+            changeTemp(event.acceleratedChange);
             break;
 
          case ev_QuadRotatePressed    :
@@ -574,6 +606,13 @@ void Control::eventLoop()  {
             // Change to settings sub-menu
             Menus::settingsMenu();
             break;
+
+         case ev_SelHold :
+            // Dump and restart execution timing statistics
+            ExecutionTiming::report(dmaConsole);
+            ExecutionTiming::reset();
+            break;
+
          default: break;
       }
    }
@@ -609,3 +648,13 @@ bool Control::isDisplayInUse() {
 
    return (fDisplayIdleTime<DISPLAY_OFF_TIME);
 }
+
+/**
+ * Checks if the station is quiescent i.e. both channels off and display off.
+ * The channels are measured less often and the idle timers stop.
+ *
+ * @return True if quiescent
+ */
+bool Control::isQuiescent() {
+   return !channels[1].isRunning() && !channels[2].isRunning() && !isDisplayInUse();
+}
@@ -15,9 +15,18 @@
 #include "DutyCycleCounter.h"
 #include "Averaging.h"
 #include "NonvolatileSettings.h"
+#include "Telemetry.h"
 
 class SettingsData;
 
+/**
+ * How channels are measured in each mains half-cycle
+ */
+enum MeasurementMode : uint8_t {
+   MeasurementMode_Alternate,    ///< Channels are measured (and controlled) on alternate half-cycles
+   MeasurementMode_Interleaved,  ///< Both channels are measured every half-cycle if the measurement budget allows
+};
+
 /**
  * This class implements most of the functionality including:
  *
@@ -44,8 +53,8 @@ private:
    bool fDoReportPid       = false;
    bool fDoReportPidTitle  = false;
 
-   /// Measurements to do near zero-crossing
-   MuxSelect fSequence[10];
+   /// Measurements to do near zero-crossing (terminated by MuxSelect_Complete sentinel)
+   const MuxSelect *fSequence = MeasurementSchedule::getSchedule(CH1_MASK, ScheduleSelection_None).sequence;
 
    /// Number of measurements to do near zero-crossing (valid entries in sequence)
    unsigned fSequenceIndex = 0;
@@ -64,12 +73,42 @@ private:
    /// Expressed as multiple of PID_INTERVAL
    static constexpr unsigned PID_LOG_INTERVAL = round(0.25_s/SAMPLE_INTERVAL);
 
+   /// How often to measure the channels while quiescent
+   /// Expressed as multiple of PID_INTERVAL
+   static constexpr unsigned QUIESCENT_SAMPLE_INTERVAL = round(0.5_s/SAMPLE_INTERVAL);
+
+   /// Half-cycles since last measurement while quiescent
+   unsigned fQuiescentCount = 0;
+
+   /// Minimum time between display refreshes i.e. useful frame rate
+   /// Expressed as multiple of PID_INTERVAL
+   static constexpr unsigned MIN_REFRESH_INTERVAL = round(40_ms/SAMPLE_INTERVAL);
+
+   /// Half-cycles since start-up (time base for front panel)
+   volatile unsigned fHalfCycleCount = 0;
+
+   /// Time of last display refresh (in half-cycles)
+   unsigned fLastRefreshTime = 0;
+
    /// Idle time for display dimming (in milliseconds)
    unsigned fDisplayIdleTime = 0;
 
    /// Used to alternate between channels
    bool fOddEven = false;
 
+   /// How channels are measured in each half-cycle
+   MeasurementMode fMeasurementMode = MeasurementMode_Interleaved;
+
+   /// Channels being measured in this half-cycle
+   bool fMeasuringCh1 = false;
+   bool fMeasuringCh2 = false;
+
+   /// Half-cycles since controller for each channel was updated
+   unsigned fHalfCyclesSinceUpdate[2] = {0};
+
+   /// Binary logging of controller updates (TelemetryMode_Binary)
+   Telemetry fTelemetry;
+
 public:
    /**
     * Constructor
@@ -77,6 +116,16 @@ public:
     */
    Control() {}
 
+   /**
+    * Get time base for front panel.
+    * This is incremented on each mains half-cycle.
+    *
+    * @return Half-cycles since start-up
+    */
+   unsigned getHalfCycleCount() const {
+      return fHalfCycleCount;
+   }
+
    /**
     * Get chip temperature from on-chip sensor
     *
@@ -120,6 +169,24 @@ public:
     */
    void changeTemp(int16_t delta);
 
+   /**
+    * Set how channels are measured in each mains half-cycle
+    *
+    * @param measurementMode Mode to use
+    */
+   void setMeasurementMode(MeasurementMode measurementMode) {
+      fMeasurementMode = measurementMode;
+   }
+
+   /**
+    * Get how channels are measured in each mains half-cycle
+    *
+    * @return Mode in use
+    */
+   MeasurementMode getMeasurementMode() const {
+      return fMeasurementMode;
+   }
+
    /**
     * Comparator interrupt handler for controlling the heaters.
     * This is triggered just prior to the mains zero-crossing.
@@ -194,6 +261,14 @@ public:
     * @return
     */
    bool isDisplayInUse();
+
+   /**
+    * Checks if the station is quiescent i.e. both channels off and display off.
+    * The channels are measured less often and the idle timers stop.
+    *
+    * @return True if quiescent
+    */
+   bool isQuiescent();
 };
 
 extern Control control;
@@ -10,6 +10,7 @@
 
 #include "TipSettings.h"
 #include "DutyCycleCounter.h"
+#include "TelemetryFrame.h"
 
 class Channel;
 
@@ -23,7 +24,7 @@ protected:
    unsigned    fTickCount      = 0;
 
    /// Interval for sampling
-   const USBDM::Seconds fInterval;
+   USBDM::Seconds fInterval;
 
    /// Current input sample
    float       fCurrentInput   = 0.0;
@@ -103,6 +104,16 @@ public:
     */
    virtual void setControlParameters(const TipSettings *settings) = 0;
 
+   /**
+    * Set interval between samples.
+    * This changes when the measurement scheduling changes between half-cycles.
+    *
+    * @param interval Interval for sampling
+    */
+   virtual void setInterval(USBDM::Seconds interval) {
+      fInterval = interval;
+   }
+
    /**
     * Main calculation
     *
@@ -136,6 +147,21 @@ public:
     * Print heading for report()
     */
    virtual void reportHeading(Channel &ch) const = 0;
+
+   /**
+    * Fill in controller values of telemetry frame
+    * (target, measured, proportional, integral, differential and duty)
+    *
+    * @param frame Frame to update
+    */
+   virtual void getTelemetry(TelemetryFrame &frame) const {
+      frame.target       = toTelemetryValue(fCurrentTarget, TELEMETRY_TEMPERATURE_SCALE);
+      frame.measured     = toTelemetryValue(fCurrentInput,  TELEMETRY_TEMPERATURE_SCALE);
+      frame.proportional = toTelemetryValue(fProportional,  TELEMETRY_PERCENT_SCALE);
+      frame.integral     = 0;
+      frame.differential = toTelemetryValue(fDifferential,  TELEMETRY_PERCENT_SCALE);
+      frame.duty         = toTelemetryValue(fCurrentOutput, TELEMETRY_PERCENT_SCALE);
+   }
 };
 
 class PidController;
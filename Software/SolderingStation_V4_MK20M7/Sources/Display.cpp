@@ -7,13 +7,10 @@
 #include "Display.h"
 #include "Channels.h"
 #include "Control.h"
+#include "ExecutionTiming.h"
 
 using namespace USBDM;
 
-FontArraySubset<FontVeryLarge,
-' ', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'l', 'o', 'w', '-', '.', '*', 'm', 's', 'O', 'f'>
-fontVeryLargeReduced;
-
 /**
  * Display information about one channel on OLED.
  * Used to draw left and right halves of screen
@@ -47,7 +44,7 @@ void Display::displayChannelStatus(Channel &, unsigned ) {
 void Display::displayChannelStatuses() {
    static constexpr int middle = (Oled::HEIGHT/2)-5;
 
-   oled.clearDisplay();
+   clearScreen();
 
    displayChannelStatus(channels[1], 0);
    displayChannelStatus(channels[2], middle+1);
@@ -63,80 +60,50 @@ void Display::displayChannelStatuses() {
 }
 
 /**
- * Display information about one channel on OLED.
- * Used to draw left and right halves of screen
+ * Get information to display about one channel.
  *
  * @param ch         Channel to display
  * @param selected   Whether the channel is currently selected
- * @param offset     X offset for display
+ *
+ * @return Values for channel view
  */
-void Display::displayChannel(Channel &ch, bool selected, unsigned offset) {
-   using namespace USBDM;
+ChannelView::Values Display::getChannelValues(Channel &ch, bool selected) {
+   ChannelView::Values values;
 
-   oled.setFont(fontMedium);
-   oled.moveXY(offset, 0).write(ch.getStateName());
-
-   oled.setPadding(Padding_LeadingSpaces).setWidth(3);
+   values.stateName = ch.getStateName();
 
-   oled.setFont(fontVeryLargeReduced);
    if ((ch.getState() == ChannelState_noTip) || (ch.getState() == ChannelState_overload)) {
-      oled.moveXY(offset+6, 8).write("---");
+      values.temperature = ChannelView::TEMPERATURE_NONE;
    }
    else {
       int currentTemp = round(ch.getCurrentTemperature());
       if (currentTemp>999) {
          currentTemp = 999;
       }
-      oled.moveXY(offset+2, 8);
-      if (currentTemp < 40) {
-         oled.write("low");
-      }
-      else {
-         oled.write(currentTemp);
-         oled.setFont(fontMedium);
-         oled.moveXY(offset+48, 14).write("C");
-      }
+      values.temperature = (currentTemp < ChannelView::LOW_TEMPERATURE)?ChannelView::TEMPERATURE_LOW:currentTemp;
    }
+   values.selected = selected;
 
-   if (selected) {
-      oled.drawRect(offset,  10, offset+57,  10+fontVeryLargeReduced.HEIGHT-9, WriteMode_Xor);
-   }
+   // If in setback mode display target temperature instead of active preset
+   values.setback           = ch.getState()==ChannelState_setback;
+   values.preset            = ch.getPreset();
+   values.presetModified    = ch.isTempModified();
+   values.presetTemperature = values.setback?ch.getTargetTemperature():ch.getUserTemperature();
 
-   oled.setFont(fontLarge);
-   if (ch.getState()==ChannelState_setback) {
-      // If in setback mode display target temperature instead of active preset
-      oled.moveXY(offset,  35).write("SB :").setWidth(3).write(ch.getTargetTemperature());
-   }
-   else {
-      oled.moveXY(offset,  35).write("P").setWidth(1).write(ch.getPreset()).
-            write(ch.isTempModified()?"*:":" :").setWidth(3).write(ch.getUserTemperature());
-   }
-   float power = ch.measurement->getPower();
+   values.tipName = ch.getTipName();
+   values.power   = (int)round(ch.measurement->getPower());
 
-   oled.setFont(fontSmall);
-   oled.moveXY(offset,  50).write(ch.getTipName());
+   float percentagePower = ChannelView::POWER_BAR_LENGTH*(ch.measurement->getPercentagePower()/100);
+   values.powerBar = (percentagePower>1)?(int)percentagePower:0;
 
-   oled.setFloatFormat(1, Padding_LeadingSpaces, 2);
-   oled.moveXY(offset+35,  50).write((int)round(power), 'W');
-
-   float percentagePower = ((oled.WIDTH/2)-3)*(ch.measurement->getPercentagePower()/100);
-#if 0
-   static constexpr int BG_TOP    = 58;
-   static constexpr int BG_BOTTOM = oled.HEIGHT-1;
-   oled.drawHorizontalLine(0, oled.WIDTH, BG_TOP,    WriteMode_Or);
-   oled.drawHorizontalLine(0, oled.WIDTH, BG_BOTTOM, WriteMode_Or);
-   oled.drawVerticalLine(0,            BG_TOP, BG_BOTTOM, WriteMode_Or);
-   oled.drawVerticalLine(oled.WIDTH-1, BG_TOP, BG_BOTTOM, WriteMode_Or);
-   if (percentagePower>1) {
-      oled.drawRect(offset, BG_TOP+1, offset-1+percentagePower,  BG_BOTTOM-1, WriteMode_Xor);
-   }
-#else
-   static constexpr int BG_TOP    = 58;
-   static constexpr int BG_BOTTOM = oled.HEIGHT-1;
-   if (percentagePower>1) {
-      oled.drawRect(offset, BG_TOP, offset-1+percentagePower,  BG_BOTTOM, WriteMode_Xor);
-   }
-#endif
+   return values;
+}
+
+/**
+ * I2C callback - continues queued I2C transactions
+ */
+void Display::i2cCallback() {
+   display.i2cQueue.transactionComplete();
 }
 
 /**
@@ -145,20 +112,25 @@ void Display::displayChannel(Channel &ch, bool selected, unsigned offset) {
 void Display::displayChannels() {
    using namespace USBDM;
 
-   static constexpr unsigned LEFT_OFFSET  = 1;
-   static constexpr unsigned RIGHT_OFFSET = 1+(oled.WIDTH+1)/2;
+   ExecutionTimer<TimingProbe_DisplayChannels> timer;
 
    Channel &ch1 = channels[1];
    Channel &ch2 = channels[2];
 
    bool ch1Selected = channels.getSelectedChannelNumber() == 1;
 
-   oled.clearDisplay();
-
-   displayChannel(ch1, ch1Selected,  LEFT_OFFSET);
-   displayChannel(ch2, !ch1Selected, RIGHT_OFFSET);
+   if (!channelScreenDrawn) {
+      // Another screen has been displayed - redraw everything
+      oled.clearDisplay();
+      channelViews[0].invalidate();
+      channelViews[1].invalidate();
+      oled.drawVerticalLine(RIGHT_OFFSET-3, 0, oled.HEIGHT-1, WriteMode_Write);
+      channelScreenDrawn = true;
+   }
 
-   oled.drawVerticalLine(RIGHT_OFFSET-3, 0, oled.HEIGHT-1, WriteMode_Write);
+   // Only the parts of the views that have changed are redrawn
+   channelViews[0].update(oled, getChannelValues(ch1, ch1Selected));
+   channelViews[1].update(oled, getChannelValues(ch2, !ch1Selected));
 
    oled.refreshImage();
 
@@ -175,7 +147,7 @@ void Display::displayChannels() {
  * @param modified         Indicates item has been modified since saving - adds indicator to display
  */
 void Display::displayTimeMenuItem(const char *description, unsigned seconds, bool modified) {
-   oled.clearDisplay();
+   clearScreen();
 
    oled.setFont(fontLarge);
    oled.moveXY(0, 0).writeln(description);
@@ -212,7 +184,7 @@ void Display::displayTimeMenuItem(const char *description, unsigned seconds, boo
  * @param modified      Indicates item has been modified since saving - adds indicator to display
  */
 void Display::displayFloatMenuItem(const char *description, int value, bool modified) {
-   oled.clearDisplay();
+   clearScreen();
 
    oled.setFont(fontLarge);
    oled.moveXY(0, 0).writeln(description);
@@ -237,7 +209,7 @@ void Display::displayFloatMenuItem(const char *description, int value, bool modi
  * @param modified      Indicates item has been modified since saving - adds indicator to display
  */
 void Display::displayTemperatureMenuItem(const char *description, unsigned temperature, bool modified) {
-   oled.clearDisplay();
+   clearScreen();
 
    oled.setFont(fontLarge);
    oled.moveXY(0, 0).writeln(description);
@@ -265,7 +237,7 @@ void Display::displayTemperatureMenuItem(const char *description, unsigned tempe
  */
 void Display::displayMenuList(const char *title, MenuItem const items[], unsigned modifiersUsed, BoundedMenuState &selection) {
 
-   oled.clearDisplay();
+   clearScreen();
 
    oled.setFont(fontMedium);
    oled.moveXY(0, 0);
@@ -323,7 +295,7 @@ void Display::displayMenuList(const char *title, MenuItem const items[], unsigne
  */
 void Display::displayChoice(const char *title, const char *prompt, const char *options[], int selection) {
 
-   oled.clearDisplay();
+   clearScreen();
 
    oled.setFont(fontMedium);
    oled.moveXY(0, 0);
@@ -359,7 +331,7 @@ void Display::displayChoice(const char *title, const char *prompt, const char *o
  * @param[in] message   Message to display
  */
 void Display::showMessage(const char *title, const char *message) {
-   oled.clearDisplay();
+   clearScreen();
 
    oled.setFont(fontMedium);
    oled.moveXY(0, 0);
@@ -388,7 +360,7 @@ Event Display::displayMessage(const char *title, const char *message) {
 
    Event event;
    while (!event.isSelHold() && !event.isSelRelease()) {
-      event = switchPolling.getEvent();
+      event = switchPolling.waitForEvent();
    }
    return event;
 }
@@ -402,7 +374,7 @@ Event Display::displayMessage(const char *title, const char *message) {
  */
 void Display::displayCalibration(const char *title, Channel &ch, unsigned targetTemperature) {
 
-   oled.clearDisplay();
+   clearScreen();
    oled.setFont(fontMedium);
    oled.moveXY(0, 0);
    oled.writeln(title);
@@ -436,21 +408,26 @@ void Display::displayCalibration(const char *title, Channel &ch, unsigned target
 /**
  * Display PID setting values
  *
- * @param tipname    Name of tip to display
- * @param selection  Index of selected item
- * @param stars      Array containing character to prefic menu item with
- * @param kp         PID Kp value
- * @param ki         PID Ki value
- * @param kd         PID Kd value
- * @param iLimit     PID I limit value
+ * @param tipname      Name of tip to display
+ * @param temperature  Temperature of calibration band being displayed
+ * @param selection    Index of selected item (0 => band, 1-4 => values)
+ * @param stars        Array containing character to prefic menu item with
+ * @param kp           PID Kp value
+ * @param ki           PID Ki value
+ * @param kd           PID Kd value
+ * @param iLimit       PID I limit value
  */
-void Display::displayPidSettings(const char *tipname, unsigned selection, char stars[4], int kp, int ki, int kd, int iLimit) {
+void Display::displayPidSettings(const char *tipname, unsigned temperature, unsigned selection, char stars[4], int kp, int ki, int kd, int iLimit) {
    static constexpr float SCALE_FACTOR = TipSettings::FLOAT_SCALE_FACTOR;
 
-   oled.clearDisplay();
+   clearScreen();
    oled.setFont(fontMedium);
    oled.moveXY(0, 0);
-   oled.writeln(" PID Settings");
+   int menuY= oled.getY();
+   oled.writeln(" PID Band ", temperature, "C");
+   if (selection == 0) {
+      oled.drawRect(0,  menuY-1, oled.WIDTH, menuY+fontMedium.HEIGHT-1, WriteMode_Xor);
+   }
    oled.moveXY(0, oled.getY()+3);
    oled.writeln(" Tip: ", tipname);
    oled.drawHorizontalLine(0, oled.WIDTH, oled.getY()+1);
@@ -459,28 +436,28 @@ void Display::displayPidSettings(const char *tipname, unsigned selection, char s
    oled.setFont(fontMedium);
    oled.setFloatFormat(3, Padding_LeadingSpaces, 2);
 
-   int menuY= oled.getY();
+   menuY= oled.getY();
    oled.writeln(stars[0], "Kp      ", kp/SCALE_FACTOR);
-   if (selection == 0) {
+   if (selection == 1) {
       oled.drawRect(0,  menuY-1, oled.WIDTH, menuY+fontMedium.HEIGHT-1, WriteMode_Xor);
    }
    oled.moveXY(0, oled.getY()+2);
    menuY= oled.getY();
    oled.writeln(stars[1], "Ki      ", ki/SCALE_FACTOR);
-   if (selection == 1) {
+   if (selection == 2) {
       oled.drawRect(0,  menuY-1, oled.WIDTH, menuY+fontMedium.HEIGHT-1, WriteMode_Xor);
    }
    oled.moveXY(0, oled.getY()+2);
    menuY= oled.getY();
    oled.writeln(stars[2], "Kd      ", kd/SCALE_FACTOR);
-   if (selection == 2) {
+   if (selection == 3) {
       oled.drawRect(0,  menuY-1, oled.WIDTH, menuY+fontMedium.HEIGHT-1, WriteMode_Xor);
    }
    oled.moveXY(0, oled.getY()+2);
    menuY= oled.getY();
    oled.setFloatFormat(1, Padding_LeadingSpaces, 2);
    oled.writeln(stars[3], "I limit ", iLimit/SCALE_FACTOR);
-   if (selection == 3) {
+   if (selection == 4) {
       oled.drawRect(0,  menuY-1, oled.WIDTH, menuY+fontMedium.HEIGHT-1, WriteMode_Xor);
    }
 
@@ -500,7 +477,7 @@ void Display::displayHeater(const char *title, Channel &ch, unsigned dutyCycle)
    float power = ch.measurement->getPower();
    float chipTemp = control.getChipTemperature();
 
-   oled.clearDisplay();
+   clearScreen();
    oled.setFont(fontMedium);
    oled.moveXY(0, 0);
    oled.writeln(title);
@@ -527,7 +504,7 @@ void Display::displayHeater(const char *title, Channel &ch, unsigned dutyCycle)
  * @return False - Cancelled (Press and hold)
  */
 bool Display::reportSettingsChange(const TipSettings &oldTs, const TipSettings &newTs) {
-   oled.clearDisplay();
+   clearScreen();
    oled.setFont(fontMedium);
    oled.moveXY(0, 0);
    oled.writeln("Calibration");
@@ -553,7 +530,7 @@ bool Display::reportSettingsChange(const TipSettings &oldTs, const TipSettings &
 
    Event event;
    while (!event.isSelHold() && !event.isSelRelease()) {
-      event = switchPolling.getEvent();
+      event = switchPolling.waitForEvent();
    }
 
    return ((event.type == ev_SelRelease) || (event.type == ev_QuadRelease));
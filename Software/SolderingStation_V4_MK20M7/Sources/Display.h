@@ -11,7 +11,9 @@
 #include "string.h"
 #include "Peripherals.h"
 #include "i2c.h"
+#include "I2cQueue.h"
 #include "oled.h"
+#include "ChannelView.h"
 #include "SwitchPolling.h"
 #include "TipSettings.h"
 #include "BoundedInteger.h"
@@ -51,19 +53,47 @@ class BoundedMenuState;
 class Display {
 
 private:
-   USBDM::I2c0  i2c{};
-   USBDM::Oled  oled{i2c};
+   USBDM::I2c0  i2c{USBDM::Oled::I2C_SPEED, USBDM::I2cMode_Interrupt};
+   I2cQueue     i2cQueue{i2c};
+   USBDM::Oled  oled{i2cQueue};
    unsigned     activeChannel = 0;
 
+   /// X offset of channel 1 (left) and channel 2 (right) views
+   static constexpr unsigned LEFT_OFFSET  = 1;
+   static constexpr unsigned RIGHT_OFFSET = 1+(USBDM::Oled::WIDTH+1)/2;
+
+   /// Views of channels on channel status screen
+   ChannelView  channelViews[2] = {
+         {LEFT_OFFSET,  RIGHT_OFFSET-4},
+         {RIGHT_OFFSET, USBDM::Oled::WIDTH-1},
+   };
+
+   /// Indicates the channel status screen is on the display so only changes need to be drawn
+   bool         channelScreenDrawn = false;
+
+   /**
+    * I2C callback - continues queued I2C transactions
+    */
+   static void i2cCallback();
+
+   /**
+    * Clear the display before drawing a new screen.
+    * The channel status screen is completely redrawn when next displayed.
+    */
+   void clearScreen() {
+      channelScreenDrawn = false;
+      oled.clearDisplay();
+   }
+
    /**
-    * Display information about one channel on OLED.
-    * Used to draw left and right halves of screen
+    * Get information to display about one channel.
     *
     * @param ch         Channel to display
     * @param selected   Whether the channel is currently selected
-    * @param offset     X offset for display
+    *
+    * @return Values for channel view
     */
-   void displayChannel(Channel &ch, bool selected, unsigned offset);
+   static ChannelView::Values getChannelValues(Channel &ch, bool selected);
 
    void displayChannelStatus(Channel &ch, unsigned offset);
 
@@ -81,6 +111,7 @@ public:
     * Initialise the display
     */
    void initialise() {
+      USBDM::I2c0::setCallback(i2cCallback);
       oled.initialise();
       oled.refreshImage();
    }
@@ -205,15 +236,16 @@ public:
    /**
     * Display PID setting values
     *
-    * @param tipname    Name of tip to display
-    * @param selection  Index of selected item
-    * @param stars      Array containing character to prefic menu item with
-    * @param kp         PID Kp value
-    * @param ki         PID Ki value
-    * @param kd         PID Kd value
-    * @param iLimit     PID I limit value
+    * @param tipname      Name of tip to display
+    * @param temperature  Temperature of calibration band being displayed
+    * @param selection    Index of selected item (0 => band, 1-4 => values)
+    * @param stars        Array containing character to prefic menu item with
+    * @param kp           PID Kp value
+    * @param ki           PID Ki value
+    * @param kd           PID Kd value
+    * @param iLimit       PID I limit value
     */
-   void displayPidSettings(const char *tipname, unsigned selection, char stars[4], int kp, int ki, int kd, int iLimit);
+   void displayPidSettings(const char *tipname, unsigned temperature, unsigned selection, char stars[4], int kp, int ki, int kd, int iLimit);
 
    /**
     * Display calibration information for tip during calibration sequence
@@ -0,0 +1,65 @@
+/*
+ * DmaConsole.cpp
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#include "hardware.h"
+#include "smc.h"
+#include "DmaConsole.h"
+
+using namespace USBDM;
+
+/**
+ * Queue line buffer on transmitter applying the overflow policy
+ */
+void DmaConsole::queueLine() {
+
+   if (fLineCount == 0) {
+      return;
+   }
+   if (fOverflowPolicy == OverflowPolicy_Block) {
+      do {
+         while (fTransmitter.getSpace() < fLineCount) {
+            // Space is released by the DMA completion interrupt
+            Smc::enterWaitMode();
+         }
+         // An interrupt writer (telemetry) may take the space first
+      } while (!fTransmitter.write(fLine, fLineCount));
+   }
+   else {
+      fTransmitter.write(fLine, fLineCount);
+   }
+   fLineCount = 0;
+}
+
+/**
+ * Writes a character (non-blocking unless transmitter buffer is full and OverflowPolicy_Block)
+ *
+ * @param[in]  ch - character to send
+ */
+void DmaConsole::_writeChar(char ch) {
+
+   if (fLineCount == LINE_SIZE) {
+      // Long line - queue in pieces
+      queueLine();
+   }
+   fLine[fLineCount++] = ch;
+   if (ch == '\n') {
+      // Same line ending as console
+      _writeChar('\r');
+      queueLine();
+   }
+}
+
+/**
+ * Queue any partial line and wait until all data has been transmitted
+ */
+DmaConsole &DmaConsole::flushOutput() {
+
+   queueLine();
+   while (!fTransmitter.isIdle()) {
+      Smc::enterWaitMode();
+   }
+   return *this;
+}
@@ -0,0 +1,113 @@
+/*
+ * DmaConsole.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef SOURCES_DMACONSOLE_H_
+#define SOURCES_DMACONSOLE_H_
+
+#include "formatted_io.h"
+#include "UartDmaTransmitter.h"
+
+/**
+ * Action when the transmit buffer is full
+ */
+enum OverflowPolicy {
+   OverflowPolicy_Drop,    ///< Discard the line (counted by UartDmaTransmitter::getDropped())
+   OverflowPolicy_Block,   ///< Wait until there is space in the buffer
+};
+
+/**
+ * Formatted output to the console UART using DMA.
+ *
+ * This is a drop-in replacement for console (USBDM::Uart0) for diagnostic
+ * reports e.g. Control::reportPid(), StepResponseDriver::run() and
+ * calibration reports. The caller only pays for formatting and copying as the
+ * characters are sent by UartDmaTransmitter rather than waiting on the UART.
+ *
+ * Characters are collected in a small line buffer which is queued on the
+ * transmitter as a whole when a line is completed, the buffer fills or on
+ * flushOutput(). Lines of up to LINE_SIZE characters are therefore never split
+ * by other users of the transmitter (e.g. telemetry frames) or partially dropped.
+ *
+ * Output only. Input remains on console.
+ * Not to be used from interrupt handlers.
+ */
+class DmaConsole : public USBDM::FormattedIO {
+
+public:
+   /// Size of line buffer (bytes)
+   static constexpr unsigned LINE_SIZE = 64;
+
+private:
+   /// Transmitter used
+   UartDmaTransmitter &fTransmitter;
+
+   /// Action when transmitter buffer is full
+   OverflowPolicy fOverflowPolicy;
+
+   /// Characters not yet queued on the transmitter
+   uint8_t fLine[LINE_SIZE];
+
+   /// Number of characters in fLine
+   unsigned fLineCount = 0;
+
+   DmaConsole(const DmaConsole &other) = delete;
+   DmaConsole(DmaConsole &&other) = delete;
+   DmaConsole& operator=(const DmaConsole &other) = delete;
+   DmaConsole& operator=(DmaConsole &&other) = delete;
+
+   /**
+    * Queue line buffer on transmitter applying the overflow policy
+    */
+   void queueLine();
+
+protected:
+   /**
+    * Writes a character (non-blocking unless transmitter buffer is full and OverflowPolicy_Block)
+    *
+    * @param[in]  ch - character to send
+    */
+   virtual void _writeChar(char ch) override;
+
+public:
+   /**
+    * Constructor
+    *
+    * @param transmitter     Transmitter to use
+    * @param overflowPolicy  Action when transmitter buffer is full
+    */
+   DmaConsole(UartDmaTransmitter &transmitter, OverflowPolicy overflowPolicy) :
+      fTransmitter(transmitter), fOverflowPolicy(overflowPolicy) {
+   }
+
+   virtual ~DmaConsole() {}
+
+   /**
+    * Set action when transmitter buffer is full
+    *
+    * @param overflowPolicy  Action when transmitter buffer is full
+    */
+   void setOverflowPolicy(OverflowPolicy overflowPolicy) {
+      fOverflowPolicy = overflowPolicy;
+   }
+
+   /**
+    * Get action when transmitter buffer is full
+    */
+   OverflowPolicy getOverflowPolicy() const {
+      return fOverflowPolicy;
+   }
+
+   /**
+    * Queue any partial line and wait until all data has been transmitted
+    */
+   virtual DmaConsole &flushOutput() override;
+};
+
+/// Console for diagnostic reports (transmitted by consoleTransmitter)
+extern DmaConsole dmaConsole;
+
+#endif /* SOURCES_DMACONSOLE_H_ */
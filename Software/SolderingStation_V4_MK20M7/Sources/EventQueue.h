@@ -7,7 +7,7 @@
 
 #ifndef SOURCES_QUEUE_H_
 #define SOURCES_QUEUE_H_
-#include "system.h"
+#include "SpscQueue.h"
 
 /**
  * Specialised queue
@@ -15,16 +15,16 @@
  *
  * These are discarded on add and automatically returned on empty queue.
  *
+ * This is a single-producer/single-consumer queue without critical sections (see SpscQueue).
+ * Only one interrupt handler may add() and only the main loop may get().
+ *
  * @tparam T            Type for queue elements
  * @tparam emptyValue   Special token indicating empty
- * @tparam size         Size of queue
+ * @tparam size         Size of queue (must be a power of 2)
  */
 template<typename T, T emptyValue, unsigned size>
 class EventQueue {
-   T queue[size];
-   unsigned head  = 0;
-   unsigned tail  = 0;
-   unsigned count = 0;
+   SpscQueue<T, size> queue;
 
    EventQueue(const EventQueue &other) = delete;
    EventQueue(EventQueue &&other) = delete;
@@ -42,7 +42,7 @@ public:
     * @return false => not empty
     */
    bool isEmpty() {
-      return count == 0;
+      return queue.isEmpty();
    }
 
    /**
@@ -52,12 +52,13 @@ public:
     * @return false => not full
     */
    bool isFull() {
-      return count == size;
+      return queue.isFull();
    }
 
    /**
     * Add item to queue
     * @note emptyValue will be discarded
+    * @note Item is discarded if the queue is full
     *
     * @param item
     */
@@ -66,16 +67,7 @@ public:
       if (item == emptyValue) {
          return;
       }
-      USBDM::CriticalSection cs;
-
-      if (isFull()) {
-         return;
-      }
-      count++;
-      queue[tail++] = item;
-      if (tail >= size) {
-         tail = 0;
-      }
+      queue.add(item);
    }
 
    /**
@@ -84,16 +76,10 @@ public:
     * @return Value from queue or emptyValue if empty
     */
    T get() {
-      USBDM::CriticalSection cs;
-
-      if (isEmpty()) {
+      T item;
+      if (!queue.get(item)) {
          return emptyValue;
       }
-      count--;
-      T item = queue[head++];
-      if (head >= size) {
-         head = 0;
-      }
       return item;
    }
 };
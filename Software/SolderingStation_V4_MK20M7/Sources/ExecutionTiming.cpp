@@ -0,0 +1,118 @@
+/*
+ * ExecutionTiming.cpp
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#include <atomic>
+#include "ExecutionTiming.h"
+
+/// Statistics for each probe
+ExecutionTiming::Entry ExecutionTiming::entries[TimingProbe_Count];
+
+/**
+ * Record an execution time
+ *
+ * @param probe  Code section timed
+ * @param cycles Execution time in cycles
+ */
+void ExecutionTiming::record(TimingProbe probe, uint32_t cycles) {
+   Entry &entry = entries[probe];
+
+   entry.sequence = entry.sequence + 1;
+   std::atomic_signal_fence(std::memory_order_seq_cst);
+
+   if (entry.resetRequested || (entry.count == 0)) {
+      entry.resetRequested = false;
+      entry.count   = 0;
+      entry.minimum = UINT32_MAX;
+      entry.maximum = 0;
+      entry.total   = 0;
+   }
+   entry.count++;
+   entry.total += cycles;
+   if (cycles < entry.minimum) {
+      entry.minimum = cycles;
+   }
+   if (cycles > entry.maximum) {
+      entry.maximum = cycles;
+   }
+
+   std::atomic_signal_fence(std::memory_order_seq_cst);
+   entry.sequence = entry.sequence + 1;
+}
+
+/**
+ * Request all statistics be reset.
+ * Each entry is cleared on the next record for that entry.
+ */
+void ExecutionTiming::reset() {
+   for (Entry &entry : entries) {
+      entry.resetRequested = true;
+   }
+}
+
+/**
+ * Get name of probe
+ *
+ * @param probe Probe of interest
+ *
+ * @return Pointer to static string
+ */
+const char *ExecutionTiming::getName(TimingProbe probe) {
+   static const char *const names[] = {
+         "zeroCrossingHandler",
+         "adcHandler",
+         "updateController",
+         "displayChannels",
+   };
+   static_assert((sizeof(names)/sizeof(names[0])) == TimingProbe_Count, "Missing probe names");
+
+   if (probe >= TimingProbe_Count) {
+      return "Unknown";
+   }
+   return names[probe];
+}
+
+/**
+ * Write table of statistics
+ *
+ * @param io Where to write report e.g. console
+ */
+void ExecutionTiming::report(USBDM::FormattedIO &io) {
+   using namespace USBDM;
+
+   const float cyclesPerMicrosecond = CycleCounter::getFrequency()/1000000;
+
+   io.writeln("Probe,Count,Min,Mean,Max (cycles),Min,Mean,Max (us)");
+
+   for (unsigned probe=0; probe<TimingProbe_Count; probe++) {
+      const Entry &entry = entries[probe];
+
+      uint32_t sequence, count, minimum, maximum;
+      uint64_t total;
+
+      // Retry if entry changed while being copied
+      do {
+         sequence = entry.sequence;
+         std::atomic_signal_fence(std::memory_order_seq_cst);
+         count    = entry.count;
+         minimum  = entry.minimum;
+         maximum  = entry.maximum;
+         total    = entry.total;
+         std::atomic_signal_fence(std::memory_order_seq_cst);
+      } while ((sequence & 1) || (sequence != entry.sequence));
+
+      float mean = (count==0)?0:(float)total/count;
+      if (count == 0) {
+         minimum = 0;
+      }
+      io.write(getName((TimingProbe)probe)).write(",").write(count).write(",")
+        .write(minimum).write(",").setFloatFormat(0).write(mean).write(",").write(maximum).write(",")
+        .setFloatFormat(2)
+        .write(minimum/cyclesPerMicrosecond).write(",")
+        .write(mean/cyclesPerMicrosecond).write(",")
+        .writeln(maximum/cyclesPerMicrosecond);
+   }
+   io.resetFormat();
+}
@@ -0,0 +1,127 @@
+/*
+ * ExecutionTiming.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef SOURCES_EXECUTIONTIMING_H_
+#define SOURCES_EXECUTIONTIMING_H_
+
+#include <stdint.h>
+#include "formatted_io.h"
+#include "cycleCounter.h"
+
+/**
+ * Code sections being timed
+ */
+enum TimingProbe : uint8_t {
+   TimingProbe_ZeroCrossingHandler,  ///< Control::zeroCrossingHandler() (ISR)
+   TimingProbe_AdcHandler,           ///< Control::adcHandler() (ISR), each invocation
+   TimingProbe_UpdateController,     ///< Channel::updateController() (within ADC ISR)
+   TimingProbe_DisplayChannels,      ///< Display::displayChannels() (main-line, includes pre-emption)
+   TimingProbe_Count,
+};
+
+/**
+ * Table of execution time statistics (min/max/mean in processor cycles).
+ *
+ * Each entry has a single writer (the code being timed) so no locking is needed.
+ * The writer brackets updates with a sequence count so a reader in a different context
+ * (e.g. the main-line reporting code) can detect and retry a torn read.
+ */
+class ExecutionTiming {
+
+private:
+   /**
+    * Statistics for a single probe
+    */
+   struct Entry {
+      volatile uint32_t sequence;        // Incremented before and after update (odd => update in progress)
+      volatile bool     resetRequested;  // Reset requested by reader - actioned by writer
+      uint32_t          count;           // Number of samples
+      uint32_t          minimum;         // Minimum execution time (cycles)
+      uint32_t          maximum;         // Maximum execution time (cycles)
+      uint64_t          total;           // Total of execution times (cycles)
+   };
+
+   /// Statistics for each probe
+   static Entry entries[TimingProbe_Count];
+
+   ExecutionTiming() = delete;
+
+public:
+   /**
+    * Enable timing hardware.
+    * Should be called before any timing is done.
+    */
+   static void initialise() {
+      USBDM::CycleCounter::enable();
+   }
+
+   /**
+    * Record an execution time
+    *
+    * @param probe  Code section timed
+    * @param cycles Execution time in cycles
+    */
+   static void record(TimingProbe probe, uint32_t cycles);
+
+   /**
+    * Request all statistics be reset.
+    * Each entry is cleared on the next record for that entry.
+    */
+   static void reset();
+
+   /**
+    * Get name of probe
+    *
+    * @param probe Probe of interest
+    *
+    * @return Pointer to static string
+    */
+   static const char *getName(TimingProbe probe);
+
+   /**
+    * Write table of statistics
+    *
+    * @param io Where to write report e.g. console
+    */
+   static void report(USBDM::FormattedIO &io);
+};
+
+/**
+ * Times execution of the enclosing scope
+ *
+ * @tparam probe Code section being timed
+ *
+ * Example:
+ * @code
+ *    void Control::zeroCrossingHandler() {
+ *       ExecutionTimer<TimingProbe_ZeroCrossingHandler> timer;
+ *       ...
+ *    }
+ * @endcode
+ */
+template<TimingProbe probe>
+class ExecutionTimer {
+
+private:
+   /// Count at start of scope
+   const uint32_t fStart;
+
+   ExecutionTimer(const ExecutionTimer &other) = delete;
+   ExecutionTimer(ExecutionTimer &&other) = delete;
+   ExecutionTimer& operator=(const ExecutionTimer &other) = delete;
+   ExecutionTimer& operator=(ExecutionTimer &&other) = delete;
+
+public:
+   ExecutionTimer() : fStart(USBDM::CycleCounter::getCount()) {
+   }
+
+   ~ExecutionTimer() {
+      ExecutionTiming::record(probe, USBDM::CycleCounter::getCount()-fStart);
+   }
+};
+
+#endif /* SOURCES_EXECUTIONTIMING_H_ */
@@ -0,0 +1,161 @@
+/*
+ * FixedPoint.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef SOURCES_FIXEDPOINT_H_
+#define SOURCES_FIXEDPOINT_H_
+
+#include <stdint.h>
+
+/**
+ * Fixed-point arithmetic used for ADC to temperature conversion.
+ *
+ * Formats used:
+ * - ADC samples are Q15 i.e. ADC code * 2^15 (int32_t).
+ *   The largest 16-bit ADC code (65535) still fits.
+ * - Temperatures are Q16 i.e. Celsius * 2^16 (int32_t).
+ *
+ * This avoids the software floating point library on targets without an FPU (e.g. Cortex-M0+).
+ */
+namespace FixedPoint {
+
+/// Fractional bits in ADC samples
+static constexpr unsigned ADC_FRACTION_BITS = 15;
+
+/// Fractional bits in temperatures
+static constexpr unsigned TEMPERATURE_FRACTION_BITS = 16;
+
+/// Natural log of 2
+static constexpr double LN2 = 0.693147180559945309417;
+
+/**
+ * Natural logarithm that may be evaluated at compile time.
+ * Not intended for use at run-time.
+ *
+ * @param x Value (>0)
+ *
+ * @return ln(x)
+ */
+constexpr double ln(double x) {
+
+   // Reduce to [0.75, 1.5)
+   int exponent = 0;
+   while (x >= 1.5) {
+      x /= 2;
+      exponent++;
+   }
+   while (x < 0.75) {
+      x *= 2;
+      exponent--;
+   }
+   // ln(x) = 2*atanh(z), z = (x-1)/(x+1), |z| < 0.2
+   double z    = (x-1)/(x+1);
+   double z2   = z*z;
+   double term = z;
+   double sum  = 0;
+   for (unsigned k=1; k<40; k+=2) {
+      sum  += term/k;
+      term *= z2;
+   }
+   return 2*sum + exponent*LN2;
+}
+
+/**
+ * Convert a value to fixed-point (rounded)
+ *
+ * @param value            Value to convert
+ * @param fractionBits     Number of fractional bits
+ *
+ * @return Fixed-point value
+ */
+constexpr int32_t toFixed(double value, unsigned fractionBits) {
+   double scaled = value * (int64_t(1)<<fractionBits);
+   return static_cast<int32_t>((scaled<0)?(scaled-0.5):(scaled+0.5));
+}
+
+/**
+ * Convert temperature from fixed-point
+ *
+ * @param temperature Temperature in Q16
+ *
+ * @return Temperature in Celsius
+ */
+inline float toCelsius(int32_t temperature) {
+   return temperature * (1.0f/(1<<TEMPERATURE_FRACTION_BITS));
+}
+
+/**
+ * Piece-wise linear conversion from ADC sample to temperature.
+ * The conversion is arranged as segments between 4 points.
+ * Values outside the end points are extrapolated using the end segments.
+ */
+class PiecewiseLinear {
+
+public:
+   /// Number of points defining the conversion
+   static constexpr unsigned NUM_POINTS = 4;
+
+private:
+   /// Fractional bits in slope
+   static constexpr unsigned SLOPE_FRACTION_BITS = 24;
+
+   /// ADC sample at start of each segment (Q15)
+   int32_t startSamples[NUM_POINTS-1] = {0};
+
+   /// Temperature at start of each segment (Q16)
+   int32_t startTemperatures[NUM_POINTS-1] = {0};
+
+   /// Slope of each segment (Q16 temperature per Q15 sample, Q24)
+   int32_t slopes[NUM_POINTS-1] = {0};
+
+public:
+   /**
+    * Set conversion points.
+    * Done when calibration changes so floating point is acceptable.
+    *
+    * @param samples       ADC samples at each point (increasing)
+    * @param temperatures  Temperatures at each point (Celsius)
+    */
+   void setPoints(const float samples[NUM_POINTS], const float temperatures[NUM_POINTS]) {
+      for (unsigned index=0; index<NUM_POINTS-1; index++) {
+         float deltaSample = samples[index+1] - samples[index];
+         float slope       = 0;
+         if (deltaSample != 0) {
+            slope = (temperatures[index+1] - temperatures[index])/deltaSample;
+         }
+         // Convert units (Celsius/sample) to (Q16/Q15) and scale
+         slope *= float(1<<(TEMPERATURE_FRACTION_BITS+SLOPE_FRACTION_BITS-ADC_FRACTION_BITS));
+         constexpr float SLOPE_LIMIT = 2.0E9f;
+         slope  = (slope>SLOPE_LIMIT)?SLOPE_LIMIT:((slope<-SLOPE_LIMIT)?-SLOPE_LIMIT:slope);
+
+         startSamples[index]      = toFixed(samples[index], ADC_FRACTION_BITS);
+         startTemperatures[index] = toFixed(temperatures[index], TEMPERATURE_FRACTION_BITS);
+         slopes[index]            = static_cast<int32_t>(slope);
+      }
+   }
+
+   /**
+    * Convert ADC sample to temperature
+    *
+    * @param sample ADC sample (Q15)
+    *
+    * @return Temperature (Q16)
+    */
+   int32_t convert(int32_t sample) const {
+      unsigned segment;
+      for (segment=0; segment<NUM_POINTS-2; segment++) {
+         if (sample < startSamples[segment+1]) {
+            break;
+         }
+      }
+      int64_t delta = int64_t(slopes[segment]) * (int64_t(sample) - startSamples[segment]);
+      return startTemperatures[segment] + static_cast<int32_t>(delta>>SLOPE_FRACTION_BITS);
+   }
+};
+
+} // End namespace FixedPoint
+
+#endif /* SOURCES_FIXEDPOINT_H_ */
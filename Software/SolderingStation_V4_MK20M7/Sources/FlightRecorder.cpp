@@ -0,0 +1,71 @@
+/*
+ * FlightRecorder.cpp
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#include "FlightRecorder.h"
+
+using namespace USBDM;
+
+/**
+ * Clear records and start recording.
+ * Should be called at boot after checking for a frozen recording.
+ */
+void FlightRecorder::initialise() {
+   fTrigger     = FlightRecorderTrigger_None;
+   fTriggerTime = 0;
+   fHead        = 0;
+   fCount       = 0;
+   fMagic       = MAGIC;
+   fCheck       = ~MAGIC;
+}
+
+/**
+ * Get name of trigger
+ *
+ * @param trigger Trigger to describe
+ *
+ * @return Name as string
+ */
+const char *FlightRecorder::getTriggerName(FlightRecorderTrigger trigger) {
+   switch(trigger) {
+      case FlightRecorderTrigger_None     : return "None";
+      case FlightRecorderTrigger_Overload : return "Overload";
+      case FlightRecorderTrigger_Watchdog : return "Watchdog";
+   }
+   return "Unknown";
+}
+
+/**
+ * Write records as CSV
+ *
+ * @param io Where to write report
+ */
+void FlightRecorder::report(FormattedIO &io) const {
+
+   static constexpr int HALF_CYCLE_MS = round(1000*SAMPLE_INTERVAL);
+
+   io.writeln("Flight recorder: ", getTriggerName(fTrigger), " at half-cycle ", (unsigned)fTriggerTime, ", ", fCount, " records");
+   io.writeln("Time (ms),Ch1 State,Ch1 Drive,Ch1 Temp,Ch2 State,Ch2 Drive,Ch2 Temp,Chip,Conversions (mux=result)");
+
+   for (unsigned index=0; index<fCount; index++) {
+      const FlightRecord &record = getRecord(index);
+
+      // Time relative to trigger
+      io.write((int)(record.timestamp-fTriggerTime)*HALF_CYCLE_MS);
+
+      io.setFloatFormat(1, Padding_None);
+      for (unsigned channel=0; channel<2; channel++) {
+         io.write(",", Channel::getStateName((ChannelState)record.state[channel]));
+         io.write(",", (unsigned)record.drive[channel]);
+         io.write(",", record.temperature[channel]);
+      }
+      io.write(",", (unsigned)record.chipTemperature);
+      for (unsigned conversion=0; conversion<record.count; conversion++) {
+         io.write(",0x").write((unsigned)record.conversions[conversion], Radix_16).write("=").write((unsigned)record.results[conversion]);
+      }
+      io.writeln();
+   }
+   io.resetFormat();
+}
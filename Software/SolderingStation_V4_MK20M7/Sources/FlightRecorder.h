@@ -0,0 +1,233 @@
+/*
+ * FlightRecorder.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef SOURCES_FLIGHTRECORDER_H_
+#define SOURCES_FLIGHTRECORDER_H_
+
+#include <stdint.h>
+#include "formatted_io.h"
+#include "MeasurementSchedule.h"
+#include "Channel.h"
+
+/**
+ * Event that stopped the flight recorder
+ */
+enum FlightRecorderTrigger : uint8_t {
+   FlightRecorderTrigger_None,      ///< Still recording
+   FlightRecorderTrigger_Overload,  ///< Over-current comparator
+   FlightRecorderTrigger_Watchdog,  ///< Watchdog timeout
+};
+
+/**
+ * Control state for one measurement sequence
+ */
+struct FlightRecord {
+   uint32_t  timestamp;                                           ///< Half-cycle count at end of sequence
+   float     temperature[2];                                      ///< Channel temperatures (C)
+   uint16_t  chipTemperature;                                     ///< Raw chip temperature conversion
+   uint16_t  results[MeasurementSchedule::MAX_MEASUREMENTS];      ///< Raw conversion results
+   MuxSelect conversions[MeasurementSchedule::MAX_MEASUREMENTS];  ///< Measurement made for each result
+   uint8_t   count;                                               ///< Number of results
+   uint8_t   state[2];                                            ///< ChannelState of channels
+   uint8_t   drive[2];                                            ///< DriveSelection applied in the half-cycle
+};
+
+/**
+ * Records the control state for the last SIZE measurement sequences for post-mortem.
+ *
+ * Records are written by Control::adcHandler() as the sequence progresses (a few
+ * stores for each conversion) so no locking or formatting is needed.
+ * An over-current or watchdog timeout freezes the recorder. It is then reported
+ * on the console at the next boot.
+ *
+ * The recorder itself is placed in the .noinit section so it survives a reset.
+ * Copying it elsewhere is not possible as the watchdog resets the processor
+ * shortly after its interrupt. It does not survive loss of power.
+ * The trivial constructor is required so the C start-up code does not clear it.
+ */
+class FlightRecorder {
+
+public:
+   /// Number of records (~2.5 s when measuring every half-cycle)
+   static constexpr unsigned SIZE = 256;
+
+private:
+   /// Indicates header is valid ("FLTR")
+   static constexpr uint32_t MAGIC = 0x464C5452;
+
+   /// MAGIC when header is valid
+   uint32_t fMagic;
+
+   /// ~MAGIC when header is valid
+   uint32_t fCheck;
+
+   /// Event that stopped recording
+   volatile FlightRecorderTrigger fTrigger;
+
+   /// Half-cycle count when recording stopped
+   uint32_t fTriggerTime;
+
+   /// Index of record being written
+   unsigned fHead;
+
+   /// Number of complete records
+   unsigned fCount;
+
+   /// Ring of records
+   FlightRecord fRecords[SIZE];
+
+public:
+   FlightRecorder() = default;
+
+   /**
+    * Clear records and start recording.
+    * Should be called at boot after checking for a frozen recording.
+    */
+   void initialise();
+
+   /**
+    * Check if contents are valid i.e. not random after power-on
+    *
+    * @return true  => Valid
+    * @return false => Not initialised
+    */
+   bool isValid() const {
+      return (fMagic == MAGIC) && (fCheck == ~MAGIC) && (fHead < SIZE) && (fCount <= SIZE) &&
+            (fTrigger <= FlightRecorderTrigger_Watchdog);
+   }
+
+   /**
+    * Check if recording has been stopped by a fault
+    *
+    * @return true  => Frozen
+    * @return false => Recording or not initialised
+    */
+   bool isFrozen() const {
+      return isValid() && (fTrigger != FlightRecorderTrigger_None);
+   }
+
+   /**
+    * Get number of complete records
+    */
+   unsigned getCount() const {
+      return fCount;
+   }
+
+   /**
+    * Get record
+    *
+    * @param index Index of record (0 => oldest)
+    *
+    * @return Record
+    */
+   const FlightRecord &getRecord(unsigned index) const {
+      return fRecords[(fHead+SIZE-fCount+index)%SIZE];
+   }
+
+   /**
+    * Start record for a measurement sequence (first conversion)
+    * Nothing is recorded once frozen.
+    *
+    * @param chipTemperature Raw chip temperature conversion
+    */
+   void startSequence(uint32_t chipTemperature) {
+      if (fTrigger != FlightRecorderTrigger_None) {
+         return;
+      }
+      FlightRecord &record   = fRecords[fHead];
+      record.chipTemperature = chipTemperature;
+      record.count           = 0;
+   }
+
+   /**
+    * Add conversion to record for current sequence
+    * Nothing is recorded once frozen.
+    *
+    * @param conversion Measurement made
+    * @param result     Raw conversion result
+    */
+   void addConversion(MuxSelect conversion, uint32_t result) {
+      if (fTrigger != FlightRecorderTrigger_None) {
+         return;
+      }
+      FlightRecord &record = fRecords[fHead];
+      unsigned      index  = record.count;
+      if (index < MeasurementSchedule::MAX_MEASUREMENTS) {
+         record.conversions[index] = conversion;
+         record.results[index]     = result;
+         record.count              = index+1;
+      }
+   }
+
+   /**
+    * Complete record for current sequence (after controllers have been updated)
+    * Nothing is recorded once frozen.
+    *
+    * @param timestamp  Half-cycle count
+    * @param ch1        Channel 1
+    * @param ch2        Channel 2
+    */
+   void endSequence(uint32_t timestamp, const Channel &ch1, const Channel &ch2) {
+      if (fTrigger != FlightRecorderTrigger_None) {
+         return;
+      }
+      FlightRecord &record  = fRecords[fHead];
+      record.timestamp      = timestamp;
+      record.temperature[0] = ch1.getCurrentTemperature();
+      record.temperature[1] = ch2.getCurrentTemperature();
+      record.state[0]       = ch1.getState();
+      record.state[1]       = ch2.getState();
+      record.drive[0]       = ch1.getDrive();
+      record.drive[1]       = ch2.getDrive();
+
+      // Record is now complete
+      fHead = (fHead+1)%SIZE;
+      if (fCount < SIZE) {
+         fCount++;
+      }
+   }
+
+   /**
+    * Stop recording. Only the first trigger is kept.
+    * This may be called from any interrupt as it may pre-empt the recording in
+    * progress. That record is incomplete and is discarded. When the ring is
+    * full it re-uses the oldest record which is also discarded.
+    *
+    * @param trigger    Event causing freeze
+    * @param timestamp  Half-cycle count
+    */
+   void freeze(FlightRecorderTrigger trigger, uint32_t timestamp) {
+      if (fTrigger == FlightRecorderTrigger_None) {
+         fTriggerTime = timestamp;
+         fTrigger     = trigger;
+         if (fCount == SIZE) {
+            fCount--;
+         }
+      }
+   }
+
+   /**
+    * Get name of trigger
+    *
+    * @param trigger Trigger to describe
+    *
+    * @return Name as string
+    */
+   static const char *getTriggerName(FlightRecorderTrigger trigger);
+
+   /**
+    * Write records as CSV
+    *
+    * @param io Where to write report
+    */
+   void report(USBDM::FormattedIO &io) const;
+};
+
+/// Flight recorder for control loop (in .noinit)
+extern FlightRecorder flightRecorder;
+
+#endif /* SOURCES_FLIGHTRECORDER_H_ */
@@ -0,0 +1,96 @@
+/*
+ * I2cQueue.cpp
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#include "I2cQueue.h"
+
+using namespace USBDM;
+
+/**
+ * Queue a transmission.
+ * Returns immediately. The transaction starts when all earlier transactions are complete.
+ *
+ * @param[in]  address     Address of slave to communicate with (should include LSB = R/W bit = 0)
+ * @param[in]  size        Size of transmission data
+ * @param[in]  data        Data to transmit, must remain unchanged until the transaction completes
+ * @param[in]  completion  Function to call when the transaction completes (may be nullptr)
+ * @param[in]  context     Value passed to completion function
+ *
+ * @return E_NO_ERROR      Transaction queued
+ * @return E_NO_RESOURCE   Queue is full - transaction discarded (completion function is not called)
+ */
+ErrorCode I2cQueue::transmit(
+      uint8_t address, uint16_t size, const uint8_t data[],
+      CompletionFunction completion, void *context) {
+
+   CriticalSection cs;
+
+   if (count >= QUEUE_SIZE) {
+      return E_NO_RESOURCE;
+   }
+   Transaction &transaction = queue[(head+count)%QUEUE_SIZE];
+   transaction.data       = data;
+   transaction.completion = completion;
+   transaction.context    = context;
+   transaction.size       = size;
+   transaction.address    = address;
+   count = count + 1;
+   if (count > highWater) {
+      highWater = count;
+   }
+   startNext();
+
+   return E_NO_ERROR;
+}
+
+/**
+ * Start transaction at head of queue if not already active.
+ * Transactions that fail to start are completed immediately with the error.
+ *
+ * @note Must be called with interrupts disabled or from the I2C interrupt
+ */
+void I2cQueue::startNext() {
+   while (!active && (count != 0)) {
+      const Transaction &transaction = queue[head];
+      active = true;
+      ErrorCode rc = i2c.startTransmit(transaction.address, transaction.size, transaction.data);
+      if (rc == E_NO_ERROR) {
+         break;
+      }
+      finish(rc);
+   }
+}
+
+/**
+ * Remove completed transaction from head of queue and notify the owner
+ *
+ * @param errorCode Result of transaction
+ *
+ * @note Must be called with interrupts disabled or from the I2C interrupt
+ */
+void I2cQueue::finish(ErrorCode errorCode) {
+   Transaction transaction = queue[head];
+   head  = (head+1)%QUEUE_SIZE;
+   count = count - 1;
+
+   // Remains active during completion so transactions queued by it are only appended
+   if (transaction.completion != nullptr) {
+      transaction.completion(transaction.context, errorCode);
+   }
+   active = false;
+}
+
+/**
+ * Continue processing queue.
+ * Must be called when each I2C transaction completes i.e. from I2C callback.
+ */
+void I2cQueue::transactionComplete() {
+   if (!active) {
+      // Not a queued transaction
+      return;
+   }
+   finish(i2c.getErrorCode());
+   startNext();
+}
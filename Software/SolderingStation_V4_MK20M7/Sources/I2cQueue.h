@@ -0,0 +1,186 @@
+/*
+ * I2cQueue.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef SOURCES_I2CQUEUE_H_
+#define SOURCES_I2CQUEUE_H_
+
+#include <stdint.h>
+#include "i2c.h"
+
+/**
+ * Bounded queue of I2C transmissions.
+ *
+ * Callers queue a transaction and return immediately.
+ * Transactions are started in order from the I2C interrupt as each one completes.
+ * An optional completion function is called (from the I2C interrupt) when each transaction completes.
+ *
+ * transactionComplete() must be called from the I2C callback (see USBDM::I2c0::setCallback()).
+ */
+class I2cQueue {
+
+public:
+   /// Maximum number of queued transactions (including the one in progress)
+   static constexpr unsigned QUEUE_SIZE = 16;
+
+   /**
+    * Function called when a transaction completes.
+    * This is called from the I2C interrupt and may queue further transactions.
+    *
+    * @param context    Value provided when transaction was queued
+    * @param errorCode  Result of transaction
+    */
+   typedef void (*CompletionFunction)(void *context, USBDM::ErrorCode errorCode);
+
+private:
+   /**
+    * Queued transaction
+    */
+   struct Transaction {
+      const uint8_t      *data;        ///< Data to transmit (must remain unchanged until complete)
+      CompletionFunction  completion;  ///< Function to call on completion (may be nullptr)
+      void               *context;     ///< Value passed to completion function
+      uint16_t            size;        ///< Number of bytes to transmit
+      uint8_t             address;     ///< I2C address (8-bit form)
+   };
+
+   /// I2C interface used
+   USBDM::I2c &i2c;
+
+   /// Circular buffer of transactions
+   Transaction queue[QUEUE_SIZE];
+
+   /// Index of transaction in progress or next to start
+   volatile uint8_t head = 0;
+
+   /// Number of transactions in queue (including the one in progress)
+   volatile uint8_t count = 0;
+
+   /// Indicates the transaction at head of queue has been started
+   volatile bool active = false;
+
+   /// Greatest number of transactions in queue (for tuning QUEUE_SIZE)
+   uint8_t highWater = 0;
+
+   /**
+    * Start transaction at head of queue if not already active.
+    * Transactions that fail to start are completed immediately with the error.
+    *
+    * @note Must be called with interrupts disabled or from the I2C interrupt
+    */
+   void startNext();
+
+   /**
+    * Remove completed transaction from head of queue and notify the owner
+    *
+    * @param errorCode Result of transaction
+    *
+    * @note Must be called with interrupts disabled or from the I2C interrupt
+    */
+   void finish(USBDM::ErrorCode errorCode);
+
+public:
+   /**
+    * Constructor
+    *
+    * @param i2c I2C interface to use. This must be in interrupt mode.
+    */
+   I2cQueue(USBDM::I2c &i2c) : i2c(i2c) {
+   }
+
+   /**
+    * Queue a transmission.
+    * Returns immediately. The transaction starts when all earlier transactions are complete.
+    *
+    * @param[in]  address     Address of slave to communicate with (should include LSB = R/W bit = 0)
+    * @param[in]  size        Size of transmission data
+    * @param[in]  data        Data to transmit, must remain unchanged until the transaction completes
+    * @param[in]  completion  Function to call when the transaction completes (may be nullptr)
+    * @param[in]  context     Value passed to completion function
+    *
+    * @return E_NO_ERROR      Transaction queued
+    * @return E_NO_RESOURCE   Queue is full - transaction discarded (completion function is not called)
+    */
+   USBDM::ErrorCode transmit(
+         uint8_t address, uint16_t size, const uint8_t data[],
+         CompletionFunction completion=nullptr, void *context=nullptr);
+
+   /**
+    * Queue a transmission.
+    * Returns immediately. The transaction starts when all earlier transactions are complete.
+    *
+    * @tparam txSize Number of bytes to transmit
+    *
+    * @param[in]  address     Address of slave to communicate with (should include LSB = R/W bit = 0)
+    * @param[in]  data        Data to transmit, must remain unchanged until the transaction completes
+    * @param[in]  completion  Function to call when the transaction completes (may be nullptr)
+    * @param[in]  context     Value passed to completion function
+    *
+    * @return E_NO_ERROR      Transaction queued
+    * @return E_NO_RESOURCE   Queue is full - transaction discarded (completion function is not called)
+    */
+   template<unsigned txSize>
+   USBDM::ErrorCode transmit(
+         uint8_t address, const uint8_t (&data)[txSize],
+         CompletionFunction completion=nullptr, void *context=nullptr) {
+      return transmit(address, txSize, data, completion, context);
+   }
+
+   /**
+    * Continue processing queue.
+    * Must be called when each I2C transaction completes i.e. from I2C callback.
+    */
+   void transactionComplete();
+
+   /**
+    * Get number of free entries in queue
+    *
+    * @return Number of transactions that may be queued
+    */
+   unsigned getFree() const {
+      return QUEUE_SIZE-count;
+   }
+
+   /**
+    * Get greatest number of transactions that have been in the queue
+    *
+    * @return Number of transactions
+    */
+   unsigned getHighWater() const {
+      return highWater;
+   }
+
+   /**
+    * Indicates all queued transactions are complete
+    *
+    * @return true if idle
+    */
+   bool isIdle() const {
+      return count == 0;
+   }
+
+   /**
+    * Wait for the transaction in progress (if any) to complete
+    *
+    * @note Must not be called from the I2C interrupt
+    */
+   void waitWhileBusy() {
+      i2c.waitWhileBusy();
+   }
+
+   /**
+    * Wait until all queued transactions are complete
+    *
+    * @note Must not be called from the I2C interrupt
+    */
+   void waitUntilIdle() {
+      while (count != 0) {
+         i2c.waitWhileBusy();
+      }
+   }
+};
+
+#endif /* SOURCES_I2CQUEUE_H_ */
@@ -12,7 +12,7 @@
 
 #include "Measurement.h"
 #include "Averaging.h"
-#include "PidController.h"
+#include "SelectableController.h"
 #include "TakeBackHalfController.h"
 
 /**
@@ -31,8 +31,8 @@ private:
    static constexpr MuxSelect Measurement1_Thermocouple = 
          muxSelectAddSubChannel(ThermocoupleAveraging::MEASUREMENT, SubChannelNum_A);
 
-   /// Loop controller
-   PidController controller{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+   /// Loop controller (selected by tip settings)
+   SelectableController controller{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY, nominalMaxPower};
 //   TakeBackHalfController controller{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
 
 public:
@@ -49,6 +49,18 @@ public:
       controller.enable(enable);
    }
 
+   /**
+    * Select relay autotuning in place of the controller for the tip.
+    * Autotuning starts when the control loop is next enabled.
+    *
+    * @param[in] enable True to select autotuning
+    *
+    * @return Autotuner
+    */
+   virtual RelayAutotuneController *selectAutotune(bool enable) override {
+      return controller.selectAutotune(enable);
+   }
+
    /**
     * Run end of controller cycle update:
     *   - Temperature
@@ -56,10 +68,12 @@ public:
     *   - Controller (PID etc)
     *
     * @param targetTemperature Target temperature
+    * @param interval          Time since last update
     */
-   virtual void updateController(float targetTemperature) override {
+   virtual void updateController(float targetTemperature, USBDM::Seconds interval) override {
 
       // Run PID
+      controller.setInterval(interval);
       float dc = controller.newSample(targetTemperature, getTemperature());
       controller.setDutyCycle(dc);
    }
@@ -113,7 +127,7 @@ public:
 
       float thermocoupleVoltage_mV  = 1000*thermocouple.getThermocoupleVoltage();
 
-      console.writeln(calibrationIndex, " : TC = ", thermocoupleVoltage_mV);
+      dmaConsole.writeln(calibrationIndex, " : TC = ", thermocoupleVoltage_mV);
 
       if ((thermocoupleVoltage_mV < 0.5) || (thermocoupleVoltage_mV > 3)) {
          return false;
@@ -163,6 +177,9 @@ public:
       settings->setCalibrationPoint(CalibrationIndex_400,  400.0,  3.0);
 
       settings->setInitialPidControlValues(1.0,0.1,0.0,10.0);
+
+      // Thermal model                C(J/K)  G(W/K)
+      settings->setInitialModelValues(0.8,    0.020);
    }
 
    /**
@@ -178,14 +195,14 @@ public:
    /**
     * Get the sequence of ADC measurements to do
     *
-    * @return Sequence array terminated by MuxSelect_Complete sentinel
+    * @param channelMask   Mask indicating which channel
+    * @param tipPresent    Indicates tip is present in tool
+    *
+    * @return Schedule ordered for measurement (constructed at compile time)
     */
-   virtual MuxSelect const *getMeasurementSequence() const override {
-      static const MuxSelect sequence[] = {
-            Measurement1_Thermocouple,
-            MuxSelect_Complete,
-      };
-      return sequence;
+   static constexpr MeasurementSchedule getMeasurementSchedule(uint8_t channelMask, bool tipPresent) {
+      (void)tipPresent;
+      return MeasurementSchedule(channelMask, Measurement1_Thermocouple);
    };
 
    /**
@@ -227,19 +244,27 @@ public:
       using namespace USBDM;
 
       if (doHeading) {
-         console.write("Time,");
+         dmaConsole.write("Time,");
          controller.reportHeading(ch);
       }
 
       // Time-stamp
-      console.setFloatFormat(2, Padding_LeadingSpaces, 3);
-      console.write(controller.getElapsedTime());
+      dmaConsole.setFloatFormat(2, Padding_LeadingSpaces, 3);
+      dmaConsole.write(controller.getElapsedTime());
       controller.report();
 
-      console.writeln(",", getInstantTemperature());
-      console.resetFormat();
+      dmaConsole.writeln(",", getInstantTemperature());
+      dmaConsole.resetFormat();
    }
 
+   /**
+    * Fill in controller and tool values of telemetry frame
+    *
+    * @param frame Frame to update
+    */
+   virtual void getTelemetry(TelemetryFrame &frame) const override {
+      controller.getTelemetry(frame);
+   }
 };
 
 #endif /* JBC_H_ */
@@ -10,8 +10,12 @@
 
 #include "TipSettings.h"
 #include "Averaging.h"
+#include "MeasurementSchedule.h"
+#include "TelemetryFrame.h"
+#include "DmaConsole.h"
 
 class Channel;
+class RelayAutotuneController;
 
 class Measurement {
 
@@ -96,13 +100,6 @@ public:
     */
    virtual void setCalibrationValues(const TipSettings *tipsettings) = 0;
 
-   /**
-    * Get the sequence of ADC measurements to do
-    *
-    * @return Sequence array terminated by MuxSelect_Complete sentinel
-    */
-   virtual MuxSelect const *getMeasurementSequence() const = 0;
-
    /**
     * Process ADC measurement value
     *
@@ -119,6 +116,19 @@ public:
     */
    virtual void enableControlLoop(bool enable = true) = 0;
 
+   /**
+    * Select relay autotuning in place of the controller for the tip.
+    * Autotuning starts when the control loop is next enabled.
+    *
+    * @param[in] enable True to select autotuning
+    *
+    * @return Autotuner or nullptr if not available for this tool
+    */
+   virtual RelayAutotuneController *selectAutotune(bool enable) {
+      (void)enable;
+      return nullptr;
+   }
+
    /**
     * Run end of controller cycle update:
     *   - Temperature
@@ -126,8 +136,9 @@ public:
     *   - Controller (PID etc)
     *
     * @param targetTemperature Target temperature
+    * @param interval          Time since last update
     */
-   virtual void updateController(float targetTemperature) = 0;
+   virtual void updateController(float targetTemperature, USBDM::Seconds interval) = 0;
 
    /**
     * Get drive value for each main half-cycle
@@ -167,6 +178,15 @@ public:
     * @param doHeading True to print a header first
     */
    virtual void report(bool doHeading=false) const = 0;
+
+   /**
+    * Fill in controller and tool values of telemetry frame
+    * (target, measured, proportional, integral, differential, duty and cold junction).
+    * Fields that do not apply to the tool are left unchanged.
+    *
+    * @param frame Frame to update
+    */
+   virtual void getTelemetry(TelemetryFrame &frame) const = 0;
 };
 
 class DummyMeasurement : public Measurement {
@@ -178,16 +198,13 @@ public:
    virtual bool  saveCalibrationPoint(CalibrationIndex, TipSettings &) override { return false; };
    virtual void  reportCalibrationValues(USBDM::FormattedIO &, bool) const override {};
    virtual void setCalibrationValues(const TipSettings *) override { }
-   virtual MuxSelect const *getMeasurementSequence() const override {
-      static const MuxSelect dummy[] = {MuxSelect_Complete, };
-      return dummy;
-   }
    virtual void processMeasurement(MuxSelect, uint32_t) override {}
    virtual void enableControlLoop(bool) override {}
-   virtual void updateController(float) override {}
+   virtual void updateController(float, USBDM::Seconds) override {}
    virtual DriveSelection getDrive() override { return DriveSelection_Off; }
    virtual void setDutyCycle(unsigned) {}
    virtual void report(bool) const {}
+   virtual void getTelemetry(TelemetryFrame &) const override {}
 };
 
 #endif /* SOURCES_MEASUREMENT_H_ */
@@ -0,0 +1,149 @@
+/*
+ * MeasurementSchedule.cpp
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#include "MeasurementSchedule.h"
+#include "Channel.h"
+
+/**
+ * Construct schedule for a channel
+ *
+ * @param channelMask   Mask indicating which channel (CH1_MASK/CH2_MASK)
+ * @param selection     Schedule to construct
+ *
+ * @return Schedule ordered for measurement
+ */
+static constexpr MeasurementSchedule makeSchedule(uint8_t channelMask, ScheduleSelection selection) {
+   switch(selection) {
+      default:
+      case ScheduleSelection_None:           return MeasurementSchedule(channelMask);
+      case ScheduleSelection_Identify:       return MeasurementSchedule(channelMask, Channel::MuxSelect_Identify);
+      case ScheduleSelection_Weller:         return Weller::getMeasurementSchedule(channelMask, true);
+      case ScheduleSelection_T12:            return T12::getMeasurementSchedule(channelMask, true);
+      case ScheduleSelection_T12NoTip:       return T12::getMeasurementSchedule(channelMask, false);
+      case ScheduleSelection_JBC_C210:       return JBC_C210::getMeasurementSchedule(channelMask, true);
+      case ScheduleSelection_AttenTweezers:  return AttenTweezers::getMeasurementSchedule(channelMask, true);
+   }
+}
+
+/// Schedules for each [channel][selection] - constructed at compile time and located in ROM
+constexpr MeasurementSchedule MeasurementSchedule::schedules[2][ScheduleSelection_Count] = {
+      {
+            makeSchedule(CH1_MASK, ScheduleSelection_None),
+            makeSchedule(CH1_MASK, ScheduleSelection_Identify),
+            makeSchedule(CH1_MASK, ScheduleSelection_Weller),
+            makeSchedule(CH1_MASK, ScheduleSelection_T12),
+            makeSchedule(CH1_MASK, ScheduleSelection_T12NoTip),
+            makeSchedule(CH1_MASK, ScheduleSelection_JBC_C210),
+            makeSchedule(CH1_MASK, ScheduleSelection_AttenTweezers),
+      },
+      {
+            makeSchedule(CH2_MASK, ScheduleSelection_None),
+            makeSchedule(CH2_MASK, ScheduleSelection_Identify),
+            makeSchedule(CH2_MASK, ScheduleSelection_Weller),
+            makeSchedule(CH2_MASK, ScheduleSelection_T12),
+            makeSchedule(CH2_MASK, ScheduleSelection_T12NoTip),
+            makeSchedule(CH2_MASK, ScheduleSelection_JBC_C210),
+            makeSchedule(CH2_MASK, ScheduleSelection_AttenTweezers),
+      },
+};
+
+/**
+ * Construct schedule measuring both channels
+ *
+ * @param ch1Selection  Schedule for channel 1
+ * @param ch2Selection  Schedule for channel 2
+ *
+ * @return Schedule ordered for measurement
+ */
+static constexpr MeasurementSchedule makeSchedule(ScheduleSelection ch1Selection, ScheduleSelection ch2Selection) {
+   return MeasurementSchedule(makeSchedule(CH1_MASK, ch1Selection), makeSchedule(CH2_MASK, ch2Selection));
+}
+
+/// Schedules measuring both channels for each [channel 1 selection][channel 2 selection]
+constexpr MeasurementSchedule MeasurementSchedule::combinedSchedules[ScheduleSelection_Count][ScheduleSelection_Count] = {
+      { // Channel 1 = None
+            makeSchedule(ScheduleSelection_None,           ScheduleSelection_None),
+            makeSchedule(ScheduleSelection_None,           ScheduleSelection_Identify),
+            makeSchedule(ScheduleSelection_None,           ScheduleSelection_Weller),
+            makeSchedule(ScheduleSelection_None,           ScheduleSelection_T12),
+            makeSchedule(ScheduleSelection_None,           ScheduleSelection_T12NoTip),
+            makeSchedule(ScheduleSelection_None,           ScheduleSelection_JBC_C210),
+            makeSchedule(ScheduleSelection_None,           ScheduleSelection_AttenTweezers),
+      },
+      { // Channel 1 = Identify
+            makeSchedule(ScheduleSelection_Identify,       ScheduleSelection_None),
+            makeSchedule(ScheduleSelection_Identify,       ScheduleSelection_Identify),
+            makeSchedule(ScheduleSelection_Identify,       ScheduleSelection_Weller),
+            makeSchedule(ScheduleSelection_Identify,       ScheduleSelection_T12),
+            makeSchedule(ScheduleSelection_Identify,       ScheduleSelection_T12NoTip),
+            makeSchedule(ScheduleSelection_Identify,       ScheduleSelection_JBC_C210),
+            makeSchedule(ScheduleSelection_Identify,       ScheduleSelection_AttenTweezers),
+      },
+      { // Channel 1 = Weller
+            makeSchedule(ScheduleSelection_Weller,         ScheduleSelection_None),
+            makeSchedule(ScheduleSelection_Weller,         ScheduleSelection_Identify),
+            makeSchedule(ScheduleSelection_Weller,         ScheduleSelection_Weller),
+            makeSchedule(ScheduleSelection_Weller,         ScheduleSelection_T12),
+            makeSchedule(ScheduleSelection_Weller,         ScheduleSelection_T12NoTip),
+            makeSchedule(ScheduleSelection_Weller,         ScheduleSelection_JBC_C210),
+            makeSchedule(ScheduleSelection_Weller,         ScheduleSelection_AttenTweezers),
+      },
+      { // Channel 1 = T12
+            makeSchedule(ScheduleSelection_T12,            ScheduleSelection_None),
+            makeSchedule(ScheduleSelection_T12,            ScheduleSelection_Identify),
+            makeSchedule(ScheduleSelection_T12,            ScheduleSelection_Weller),
+            makeSchedule(ScheduleSelection_T12,            ScheduleSelection_T12),
+            makeSchedule(ScheduleSelection_T12,            ScheduleSelection_T12NoTip),
+            makeSchedule(ScheduleSelection_T12,            ScheduleSelection_JBC_C210),
+            makeSchedule(ScheduleSelection_T12,            ScheduleSelection_AttenTweezers),
+      },
+      { // Channel 1 = T12NoTip
+            makeSchedule(ScheduleSelection_T12NoTip,       ScheduleSelection_None),
+            makeSchedule(ScheduleSelection_T12NoTip,       ScheduleSelection_Identify),
+            makeSchedule(ScheduleSelection_T12NoTip,       ScheduleSelection_Weller),
+            makeSchedule(ScheduleSelection_T12NoTip,       ScheduleSelection_T12),
+            makeSchedule(ScheduleSelection_T12NoTip,       ScheduleSelection_T12NoTip),
+            makeSchedule(ScheduleSelection_T12NoTip,       ScheduleSelection_JBC_C210),
+            makeSchedule(ScheduleSelection_T12NoTip,       ScheduleSelection_AttenTweezers),
+      },
+      { // Channel 1 = JBC_C210
+            makeSchedule(ScheduleSelection_JBC_C210,       ScheduleSelection_None),
+            makeSchedule(ScheduleSelection_JBC_C210,       ScheduleSelection_Identify),
+            makeSchedule(ScheduleSelection_JBC_C210,       ScheduleSelection_Weller),
+            makeSchedule(ScheduleSelection_JBC_C210,       ScheduleSelection_T12),
+            makeSchedule(ScheduleSelection_JBC_C210,       ScheduleSelection_T12NoTip),
+            makeSchedule(ScheduleSelection_JBC_C210,       ScheduleSelection_JBC_C210),
+            makeSchedule(ScheduleSelection_JBC_C210,       ScheduleSelection_AttenTweezers),
+      },
+      { // Channel 1 = AttenTweezers
+            makeSchedule(ScheduleSelection_AttenTweezers,  ScheduleSelection_None),
+            makeSchedule(ScheduleSelection_AttenTweezers,  ScheduleSelection_Identify),
+            makeSchedule(ScheduleSelection_AttenTweezers,  ScheduleSelection_Weller),
+            makeSchedule(ScheduleSelection_AttenTweezers,  ScheduleSelection_T12),
+            makeSchedule(ScheduleSelection_AttenTweezers,  ScheduleSelection_T12NoTip),
+            makeSchedule(ScheduleSelection_AttenTweezers,  ScheduleSelection_JBC_C210),
+            makeSchedule(ScheduleSelection_AttenTweezers,  ScheduleSelection_AttenTweezers),
+      },
+};
+
+/// Schedule selection for each [iron type][tip present]
+constexpr ScheduleSelection MeasurementSchedule::toolSelections[IronType_AttenTweezers+1][2] = {
+      // No tip                        Tip present
+      {ScheduleSelection_None,          ScheduleSelection_None,          }, // IronType_Unknown
+      {ScheduleSelection_Weller,        ScheduleSelection_Weller,        }, // IronType_Weller
+      {ScheduleSelection_T12NoTip,      ScheduleSelection_T12,           }, // IronType_T12
+      {ScheduleSelection_JBC_C210,      ScheduleSelection_JBC_C210,      }, // IronType_JBC_C210
+      {ScheduleSelection_AttenTweezers, ScheduleSelection_AttenTweezers, }, // IronType_AttenTweezers
+};
+
+// Check ordering - un-biased measurements before biased measurements
+static_assert((makeSchedule(CH2_MASK, ScheduleSelection_T12).sequence[1]&BIAS_MASK) != 0, "Biased measurements must be last");
+static_assert(makeSchedule(CH2_MASK, ScheduleSelection_None).sequence[0] == MuxSelect_Complete, "Empty schedule incorrect");
+static_assert((makeSchedule(ScheduleSelection_T12, ScheduleSelection_T12).sequence[1]&BIAS_MASK) == 0, "Biased measurements must be last");
+
+// Check budget - a single channel must always fit
+static_assert(makeSchedule(ScheduleSelection_AttenTweezers, ScheduleSelection_None).isWithinBudget(), "Single channel exceeds budget");
+static_assert(makeSchedule(ScheduleSelection_T12, ScheduleSelection_None).isWithinBudget(), "Single channel exceeds budget");
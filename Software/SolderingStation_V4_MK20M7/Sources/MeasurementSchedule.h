@@ -0,0 +1,207 @@
+/*
+ * MeasurementSchedule.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef SOURCES_MEASUREMENTSCHEDULE_H_
+#define SOURCES_MEASUREMENTSCHEDULE_H_
+
+#include <stdint.h>
+#include "Peripherals.h"
+#include "TipSettings.h"
+
+/**
+ * Selects which measurement schedule a channel uses in a half-cycle
+ */
+enum ScheduleSelection : uint8_t {
+   ScheduleSelection_None,             ///< No tool present - no measurements
+   ScheduleSelection_Identify,         ///< Tool identification
+   ScheduleSelection_Weller,           ///< Weller tool
+   ScheduleSelection_T12,              ///< T12 tool with tip present
+   ScheduleSelection_T12NoTip,         ///< T12 tool without tip (cold-junction only)
+   ScheduleSelection_JBC_C210,         ///< JBC C210 tool
+   ScheduleSelection_AttenTweezers,    ///< Atten tweezers
+   ScheduleSelection_Count,
+};
+
+/**
+ * Sequence of ADC measurements done near a zero-crossing.
+ *
+ * Schedules are built at compile time with the channel information added and
+ * already ordered so that:
+ * - Un-biased (high-gain) measurements are done first. This prevents saturation of the high gain amplifier.
+ * - Bias is only changed once in sequence
+ *
+ * Schedules are available for a single channel or for both channels combined.
+ * The zero-crossing handler selects a schedule by table lookup and walks it directly.
+ */
+class MeasurementSchedule {
+
+public:
+   /// Maximum number of measurements in a schedule for a single channel
+   static constexpr unsigned MAX_CHANNEL_MEASUREMENTS = 4;
+
+   /// Maximum number of measurements in a schedule (both channels)
+   static constexpr unsigned MAX_MEASUREMENTS = 2*MAX_CHANNEL_MEASUREMENTS;
+
+   /// Extra settling time for 1st measurement in sequence (us)
+   static constexpr unsigned INITIAL_SAMPLE_DELAY   = 0;
+
+   /// Settling time for high gain amplifier (us)
+   static constexpr unsigned HIGH_GAIN_SAMPLE_DELAY = 200;
+
+   /// Settling time for low gain amplifier (us)
+   static constexpr unsigned LOW_GAIN_SAMPLE_DELAY  = 100;
+
+   /// Time for a (hardware averaged) ADC conversion (us)
+   static constexpr unsigned ADC_CONVERSION_TIME    = 40;
+
+   /**
+    * Time available for measurements after the zero-crossing (us).
+    * The heater drive is off while measuring so this limits the power lost.
+    * Schedules that do not fit are done on alternate half-cycles.
+    */
+   static constexpr unsigned MEASUREMENT_BUDGET     = 800;
+
+   /// Measurements to do, terminated by MuxSelect_Complete sentinel
+   MuxSelect sequence[MAX_MEASUREMENTS+1];
+
+   /// Number of measurements (excluding sentinel)
+   uint8_t   length;
+
+   /// Time from zero-crossing to completion of sequence including chip temperature measurement (us)
+   uint16_t  duration;
+
+   /**
+    * Get settling time before a measurement
+    *
+    * @param muxSelect  Measurement being done
+    * @param isFirst    Indicates this is the first measurement in sequence
+    *
+    * @return Settling time in microseconds
+    */
+   static constexpr unsigned getSampleDelay(MuxSelect muxSelect, bool isFirst) {
+      return (isFirst?INITIAL_SAMPLE_DELAY:0) +
+            ((muxSelect & GAIN_BOOST_MASK)?HIGH_GAIN_SAMPLE_DELAY:LOW_GAIN_SAMPLE_DELAY);
+   }
+
+   /**
+    * Construct schedule from unordered list of measurements
+    *
+    * @param channelMask   Mask indicating which channel (CH1_MASK/CH2_MASK)
+    * @param measurements  Measurements to do (without channel information)
+    */
+   template<typename... Measurements>
+   constexpr MeasurementSchedule([[maybe_unused]] uint8_t channelMask, Measurements... measurements) : sequence{}, length(0), duration(0) {
+
+      static_assert(sizeof...(measurements) <= MAX_CHANNEL_MEASUREMENTS, "Too many measurements in schedule");
+
+      const MuxSelect list[] = {static_cast<MuxSelect>(measurements|channelMask)..., MuxSelect_Complete};
+
+      addMeasurements(list, sizeof...(measurements));
+   }
+
+   /**
+    * Construct schedule measuring both channels
+    *
+    * @param ch1Schedule   Schedule for channel 1
+    * @param ch2Schedule   Schedule for channel 2
+    */
+   constexpr MeasurementSchedule(const MeasurementSchedule &ch1Schedule, const MeasurementSchedule &ch2Schedule) :
+         sequence{}, length(0), duration(0) {
+
+      MuxSelect list[MAX_MEASUREMENTS+1] = {};
+      unsigned  count = 0;
+      for (unsigned index=0; index<ch1Schedule.length; index++) {
+         list[count++] = ch1Schedule.sequence[index];
+      }
+      for (unsigned index=0; index<ch2Schedule.length; index++) {
+         list[count++] = ch2Schedule.sequence[index];
+      }
+      addMeasurements(list, count);
+   }
+
+   /**
+    * Indicates if the schedule completes within the measurement budget
+    *
+    * @return True if schedule fits
+    */
+   constexpr bool isWithinBudget() const {
+      return duration <= MEASUREMENT_BUDGET;
+   }
+
+private:
+   /**
+    * Add measurements to schedule in measurement order and calculate duration
+    *
+    * @param list    Measurements to add (including channel information)
+    * @param count   Number of measurements in list
+    */
+   constexpr void addMeasurements(const MuxSelect list[], unsigned count) {
+
+      // Stable partition - un-biased measurements then biased measurements
+      for (unsigned pass=0; pass<2; pass++) {
+         for (unsigned index=0; index<count; index++) {
+            if (((list[index]&BIAS_MASK) != 0) == (pass != 0)) {
+               sequence[length] = list[index];
+               duration += getSampleDelay(list[index], length == 0);
+               length++;
+            }
+         }
+      }
+      sequence[length] = MuxSelect_Complete;
+
+      // Conversions including initial chip temperature measurement
+      duration += (length+1)*ADC_CONVERSION_TIME;
+   }
+
+   /// Schedules for each [channel][selection]
+   static const MeasurementSchedule schedules[2][ScheduleSelection_Count];
+
+   /// Schedules measuring both channels for each [channel 1 selection][channel 2 selection]
+   static const MeasurementSchedule combinedSchedules[ScheduleSelection_Count][ScheduleSelection_Count];
+
+   /// Schedule selection for each [iron type][tip present]
+   static const ScheduleSelection toolSelections[IronType_AttenTweezers+1][2];
+
+public:
+   /**
+    * Get measurement schedule
+    *
+    * @param channelMask   Mask indicating which channel (CH1_MASK/CH2_MASK)
+    * @param selection     Schedule to use
+    *
+    * @return Pre-sorted schedule including channel information
+    */
+   static const MeasurementSchedule &getSchedule(uint8_t channelMask, ScheduleSelection selection) {
+      return schedules[(channelMask == CH1_MASK)?0:1][selection];
+   }
+
+   /**
+    * Get measurement schedule for both channels
+    *
+    * @param ch1Selection  Schedule to use for channel 1
+    * @param ch2Selection  Schedule to use for channel 2
+    *
+    * @return Pre-sorted schedule including channel information
+    */
+   static const MeasurementSchedule &getSchedule(ScheduleSelection ch1Selection, ScheduleSelection ch2Selection) {
+      return combinedSchedules[ch1Selection][ch2Selection];
+   }
+
+   /**
+    * Get schedule selection for a tool
+    *
+    * @param ironType      Type of tool
+    * @param tipPresent    Indicates tip is present in tool
+    *
+    * @return Schedule to use when measuring tool
+    */
+   static ScheduleSelection getToolSelection(IronType ironType, bool tipPresent) {
+      return toolSelections[ironType][tipPresent];
+   }
+};
+
+#endif /* SOURCES_MEASUREMENTSCHEDULE_H_ */
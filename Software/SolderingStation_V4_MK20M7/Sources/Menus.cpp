@@ -12,8 +12,10 @@
 #include "NonvolatileSettings.h"
 #include "stringFormatter.h"
 #include "hardware.h"
+#include "smc.h"
 #include "Channels.h"
 #include "StepResponseDriver.h"
+#include "DmaConsole.h"
 
 using namespace USBDM;
 
@@ -40,10 +42,7 @@ EventType Menus::editTime(const SettingsData &data) {
          doRefresh = false;
          display.displayTimeMenuItem(data.name, scratch, scratch != unchanged);
       }
-      event = switchPolling.getEvent();
-      if (event.type == ev_None) {
-         continue;
-      }
+      event = switchPolling.waitForEvent();
       switch (event.type) {
          case ev_QuadRelease:
             *data.settingUint16 = scratch;
@@ -101,10 +100,7 @@ EventType Menus::editFloat(const SettingsData &data) {
          doRefresh = false;
          display.displayFloatMenuItem(data.name, scratch, scratch != unchanged);
       }
-      event = switchPolling.getEvent();
-      if (event.type == ev_None) {
-         continue;
-      }
+      event = switchPolling.waitForEvent();
       switch (event.type) {
          case ev_QuadRelease:
             *data.settingFloat = scratch/1000.0;
@@ -162,10 +158,7 @@ EventType Menus::editTemperature(const SettingsData &data) {
          doRefresh = false;
          display.displayTemperatureMenuItem(data.name, scratch, scratch != unchanged);
       }
-      event = switchPolling.getEvent();
-      if (event.type == ev_None) {
-         continue;
-      }
+      event = switchPolling.waitForEvent();
       switch (event.type) {
          case ev_QuadRelease:
             *data.settingUint16 = scratch;
@@ -246,6 +239,8 @@ bool Menus::calibrateTipTemp(Channel &ch, TipSettings &tipsettings, CalibrationI
       }
       Event event = switchPolling.getEvent();
       if (event.type == ev_None) {
+         // Wait for event or display refresh
+         Smc::enterWaitMode();
          continue;
       }
       switch(event.type) {
@@ -282,7 +277,7 @@ bool Menus::calibrateTipTemp(Channel &ch, TipSettings &tipsettings, CalibrationI
       }
    } while(loopControl == working);
 
-   tipsettings.report(console);
+   tipsettings.report(dmaConsole);
 
    ch.setState(ChannelState_off);
    return loopControl == complete;
@@ -319,10 +314,7 @@ EventType Menus::calibrateTipTemps(const SettingsData &) {
          refresh = false;
       }
 
-      event = switchPolling.getEvent();
-      if (event.type == ev_None) {
-         continue;
-      }
+      event = switchPolling.waitForEvent();
 
       // Assume refresh required
       refresh = true;
@@ -426,6 +418,7 @@ EventType Menus::calibrateTipTemps(const SettingsData &) {
 
 /**
  * Edit a non-volatile tip calibration setting.
+ * The first item selects the calibration band (250, 325 or 400 C) being edited.
  *
  * @param nvTipSettings Data describing setting to change
  *
@@ -436,20 +429,48 @@ bool Menus::editPidSetting(TipSettings &nvTipSettings) {
    // Max value truncated to nearest 100 (0.1 as float)
    static constexpr int MAX_VALUE = UINT16_MAX-UINT16_MAX%100;
 
+   BoundedInteger band(CalibrationIndex_250, CalibrationIndex_400, CalibrationIndex_250);
+
    // Work with raw integer values  (internal format)
-   BoundedInteger kp(    0, MAX_VALUE,    nvTipSettings.getRawKp());
-   BoundedInteger ki(    0, MAX_VALUE,    nvTipSettings.getRawKi());
-   BoundedInteger kd(    0, MAX_VALUE,    nvTipSettings.getRawKd());
-   BoundedInteger iLimit(0, MAX_VALUE,    nvTipSettings.getRawILimit());
+   BoundedInteger kp(    0, MAX_VALUE,    0);
+   BoundedInteger ki(    0, MAX_VALUE,    0);
+   BoundedInteger kd(    0, MAX_VALUE,    0);
+   BoundedInteger iLimit(0, MAX_VALUE,    0);
+
+   int scratchKp     = 0;
+   int scratchKi     = 0;
+   int scratchKd     = 0;
+   int scratchILimit = 0;
+
+   bool bandModified = false;
+
+   // Load values for current band
+   auto loadBand = [&]() {
+      CalibrationIndex index = CalibrationIndex(int(band));
+      kp     = static_cast<int>(nvTipSettings.getRawKp(index));
+      ki     = static_cast<int>(nvTipSettings.getRawKi(index));
+      kd     = static_cast<int>(nvTipSettings.getRawKd(index));
+      iLimit = static_cast<int>(nvTipSettings.getRawILimit(index));
+      scratchKp     = kp;
+      scratchKi     = ki;
+      scratchKd     = kd;
+      scratchILimit = iLimit;
+      bandModified  = false;
+   };
+
+   // Save values for current band
+   auto saveBand = [&]() {
+      if (bandModified) {
+         // Only update nonvolatile data as needed
+         nvTipSettings.setRawPidControlValues(CalibrationIndex(int(band)), scratchKp, scratchKi, scratchKd, scratchILimit);
+      }
+   };
 
-   int scratchKp     = kp;
-   int scratchKi     = ki;
-   int scratchKd     = kd;
-   int scratchILimit = iLimit;
+   loadBand();
 
    enum {working, complete, fail} loopControl = working;
    Event event;
-   BoundedInteger selection(0, 3, 0);
+   BoundedInteger selection(0, 4, 0);
 
    bool modified = false;
 
@@ -457,14 +478,13 @@ bool Menus::editPidSetting(TipSettings &nvTipSettings) {
    do {
       if (refresh) {
          char stars[4] = {kp == scratchKp?' ':'*', ki == scratchKi?' ':'*', kd == scratchKd?' ':'*', iLimit == scratchILimit?' ':'*'};
-         display.displayPidSettings(nvTipSettings.getTipName(), selection, stars, kp, ki, kd, iLimit);
+         display.displayPidSettings(
+               nvTipSettings.getTipName(), TipSettings::getCalibrationTemperature(CalibrationIndex(int(band))),
+               selection, stars, kp, ki, kd, iLimit);
          refresh = false;
       }
 
-      event = switchPolling.getEvent();
-      if (event.type == ev_None) {
-         continue;
-      }
+      event = switchPolling.waitForEvent();
 
       // Assume refresh required
       refresh = true;
@@ -474,21 +494,21 @@ bool Menus::editPidSetting(TipSettings &nvTipSettings) {
          case ev_SelRelease:
          case ev_QuadRelease:
             switch(selection) {
-               case 0:
+               case 1:
                   scratchKp = kp;
-                  modified = true;
+                  modified = bandModified = true;
                   break;
-               case 1:
+               case 2:
                   scratchKi = ki;
-                  modified = true;
+                  modified = bandModified = true;
                   break;
-               case 2:
+               case 3:
                   scratchKd = kd;
-                  modified = true;
+                  modified = bandModified = true;
                   break;
-               case 3:
+               case 4:
                   scratchILimit = iLimit;
-                  modified = true;
+                  modified = bandModified = true;
                   break;
             }
             break;
@@ -496,15 +516,20 @@ bool Menus::editPidSetting(TipSettings &nvTipSettings) {
             case ev_QuadRotate:
                switch(selection) {
                   case 0:
-                     kp += event.change*10;  // 0.010 steps
+                     saveBand();
+                     band += event.change;
+                     loadBand();
                      break;
                   case 1:
-                     ki += event.change*1;  // 0.001 steps
+                     kp += event.change*10;  // 0.010 steps
                      break;
                   case 2:
-                     kd += event.change*1;  // 0.001 steps
+                     ki += event.change*1;  // 0.001 steps
                      break;
                   case 3:
+                     kd += event.change*1;  // 0.001 steps
+                     break;
+                  case 4:
                      iLimit += event.change*100; // .100 steps
                      break;
                }
@@ -512,16 +537,16 @@ bool Menus::editPidSetting(TipSettings &nvTipSettings) {
 
                case ev_QuadRotatePressed:
                   switch(selection) {
-                     case 0:
+                     case 1:
                         kp += event.change*100;  // 0.100 steps
                         break;
-                     case 1:
+                     case 2:
                         ki += event.change*10;  // 0.01 steps
                         break;
-                     case 2:
+                     case 3:
                         kd += event.change*10;  // 0.01 steps
                         break;
-                     case 3:
+                     case 4:
                         iLimit += event.change*1000; // 1.00 steps
                         break;
                   }
@@ -547,10 +572,8 @@ bool Menus::editPidSetting(TipSettings &nvTipSettings) {
       }
    } while (loopControl == working);
 
-   if (modified) {
-      // Only update nonvolatile data as needed
-      nvTipSettings.setRawPidControlValues(scratchKp, scratchKi, scratchKd, scratchILimit);
-   }
+   saveBand();
+
    return modified;
 }
 
@@ -579,10 +602,7 @@ EventType Menus::editPidSettings(const SettingsData &) {
          refresh = false;
       }
 
-      event = switchPolling.getEvent();
-      if (event.type == ev_None) {
-         continue;
-      }
+      event = switchPolling.waitForEvent();
 
       // Assume refresh required
       refresh = true;
@@ -630,13 +650,95 @@ EventType Menus::editPidSettings(const SettingsData &) {
    return event.type;
 }
 
+/**
+ * Select control algorithm (PID or predictive) for each tip.
+ * Tips using the predictive controller are starred.
+ *
+ * @return Exiting event
+ */
+EventType Menus::selectControlMode(const SettingsData &) {
+
+   static constexpr unsigned modifiers = MenuItem::Starred;
+
+   MenuItem menuItems[TipSettings::NUM_TIP_SETTINGS] = {0};
+
+   int tipsAllocated = tips.populateSelectedTips(menuItems, &TipSettings::isPredictiveControl);
+
+   BoundedMenuState selection{tipsAllocated-1, 0};
+
+   bool refresh  = true;
+   enum {working, complete, fail} loopControl = working;
+   Event event;
+
+   do {
+      if (refresh) {
+         display.displayMenuList("Control Mode", menuItems, modifiers, selection);
+         refresh = false;
+      }
+
+      event = switchPolling.waitForEvent();
+
+      // Assume refresh required
+      refresh = true;
+
+      switch (event.type) {
+
+         case ev_SelRelease:
+         case ev_QuadRelease: {
+            if (menuItems[selection].name == nullptr) {
+               break;
+            }
+            TipSettings *ts = menuItems[selection].nvTipSettings;
+            if (ts->isPredictiveControl()) {
+               ts->setControlMode(ControlMode_Pid);
+               menuItems[selection].modifiers &= ~MenuItem::Starred;
+            }
+            else {
+               ts->setControlMode(ControlMode_Predictive);
+               menuItems[selection].modifiers |= MenuItem::Starred;
+            }
+         }
+         break;
+
+         case ev_QuadRotate:
+            selection += event.change;
+            break;
+
+         case ev_Ch1Release:
+         case ev_Ch2Release:
+            loopControl = complete;
+            break;
+
+         case ev_QuadHold:
+         case ev_SelHold:
+            event.type  = ev_None;
+            loopControl = complete;
+            break;
+
+         default:
+            refresh = false;
+            break;
+      }
+   } while (loopControl == working);
+
+   channels[1].refreshControllerParameters();
+   channels[2].refreshControllerParameters();
+
+   return event.type;
+}
+
 /**
  * Calculate a non-volatile tip PID settings.
+ * The tip is driven at fixed power and a model identified from the step response.
+ * PID values calculated from the model may then be saved.
  *
  * @return Exiting event
  */
 EventType Menus::stepResponse(const SettingsData &) {
 
+   // Drive used for step (%)
+   static constexpr unsigned STEP_DRIVE = 30;
+
    static constexpr unsigned modifiers = MenuItem::Starred;
 
    MenuItem menuItems[TipSettings::NUM_TIP_SETTINGS] = {0};
@@ -655,10 +757,7 @@ EventType Menus::stepResponse(const SettingsData &) {
          refresh = false;
       }
 
-      event = switchPolling.getEvent();
-      if (event.type == ev_None) {
-         continue;
-      }
+      event = switchPolling.waitForEvent();
 
       // Assume refresh required
       refresh = true;
@@ -677,11 +776,211 @@ EventType Menus::stepResponse(const SettingsData &) {
                   "power for a period.\n\n"
                   "Press to start/end");
             if (ev.isSelRelease()) {
-               TipSettings const *nvTipSettings = menuItems[selection].constTipSettings;
+               TipSettings *nvTipSettings = menuItems[selection].nvTipSettings;
                Channel &channel = channels[1];
                channel.setTip(nvTipSettings);
                StepResponseDriver driver(channels[1]);
-               driver.run(30);
+               if (!driver.run(STEP_DRIVE)) {
+                  display.displayMessage("Step Response", "Failed or cancelled");
+                  break;
+               }
+               PidGains gains = StepResponseDriver::calculatePidGains(driver.getModel());
+
+               StringFormatter_T<60> prompt;
+               prompt.setFloatFormat(2, Padding_None);
+               prompt.write("Kp=", gains.kp, " Ki=", gains.ki, "\nKd=", gains.kd, " IL=", gains.iLimit, "\nSave PID values?");
+               if (confirmAction(prompt.toString())) {
+                  nvTipSettings->setPidControlValues(gains);
+                  menuItems[selection].modifiers |= MenuItem::Starred;
+               }
+            }
+         }
+         break;
+
+         case ev_QuadRotate:
+            selection += event.change;
+            break;
+
+         case ev_Ch1Release:
+         case ev_Ch2Release:
+            loopControl = complete;
+            break;
+
+         case ev_QuadHold:
+         case ev_SelHold:
+            event.type  = ev_None;
+            loopControl = complete;
+            break;
+
+         default:
+            refresh = false;
+            break;
+      }
+   } while (loopControl == working);
+
+   channels[1].refreshControllerParameters();
+   channels[2].refreshControllerParameters();
+
+   return event.type;
+}
+
+/**
+ * Calculate a non-volatile tip PID settings.
+ * The tip is cycled around the tuning temperature by a relay (RelayAutotuneController)
+ * and the PID values calculated are used for all calibration bands.
+ * Optionally the tip is cycled around the temperature of each calibration band in turn.
+ * PID values calculated from the cycles may then be saved.
+ *
+ * @param data data.option != 0 to tune each calibration band separately
+ *
+ * @return Exiting event
+ */
+EventType Menus::autotunePid(const SettingsData &data) {
+
+   // Tune each calibration band separately (up to 30 s each)
+   const bool tuneBands = (data.option != 0);
+
+   static constexpr unsigned modifiers = MenuItem::Starred;
+
+   MenuItem menuItems[TipSettings::NUM_TIP_SETTINGS] = {0};
+
+   int tipsAllocated = tips.populateSelectedTips(menuItems, &TipSettings::isPidCalibrated);
+
+   BoundedMenuState selection{tipsAllocated-1, 0};
+
+   bool refresh  = true;
+   enum {working, complete, fail} loopControl = working;
+   Event event;
+
+   do {
+      if (refresh) {
+         display.displayMenuList("Pid Autotune", menuItems, modifiers, selection);
+         refresh = false;
+      }
+
+      event = switchPolling.waitForEvent();
+
+      // Assume refresh required
+      refresh = true;
+
+      switch (event.type) {
+
+         case ev_SelRelease:
+         case ev_QuadRelease: {
+            if (menuItems[selection].name == nullptr) {
+               break;
+            }
+            TipSettings *nvTipSettings = menuItems[selection].nvTipSettings;
+
+            // Find channel to use for tuning
+            Channel *channel;
+            if (nvTipSettings->getIronType() == channels[1].getIronType()) {
+               channel = &channels[1];
+            }
+            else if (nvTipSettings->getIronType() == channels[2].getIronType()) {
+               channel = &channels[2];
+            }
+            else {
+               display.displayMessage(
+                     "Autotune Fail",
+                     "\n No suitable tool"
+                     "\n connected to allow"
+                     "\n tuning of tip.");
+               break;
+            }
+            Event ev = display.displayMessage(
+                  "Pid Autotune",
+                  tuneBands?
+                        "This will cycle the\n"
+                        "tip at 250, 325 and\n"
+                        "400 C (up to 90 s)\n\n"
+                        "Press to start/end":
+                        "This will cycle the\n"
+                        "tip around 350 C\n"
+                        "for up to 30 s.\n\n"
+                        "Press to start/end");
+            if (!ev.isSelRelease()) {
+               break;
+            }
+            channel->setTip(nvTipSettings);
+            RelayAutotuneController *autotuner = channel->selectAutotune(true);
+            if ((autotuner == nullptr) || !channel->isTipPresent()) {
+               channel->selectAutotune(false);
+               display.displayMessage(
+                     "Autotune Fail",
+                     "\n Autotune not"
+                     "\n available for"
+                     "\n tool or no tip.");
+               break;
+            }
+            int userTemperature = channel->getUserTemperature();
+
+            // Tune once for all bands or each band in turn (heating upwards)
+            PidGains gains[CalibrationIndex_Number];
+            const CalibrationIndex lastIndex = tuneBands?CalibrationIndex_400:CalibrationIndex_250;
+            bool cancelled = false;
+            for (CalibrationIndex index=CalibrationIndex_250; (index<=lastIndex) && !cancelled; ++index) {
+               // Autotuning restarts when channel is re-enabled
+               channel->setUserTemperature(
+                     tuneBands?TipSettings::getCalibrationTemperature(index):RelayAutotuneController::TUNING_TEMPERATURE);
+               channel->setState(ChannelState_active);
+
+               while (!autotuner->isFinished() && !cancelled) {
+                  if (control.needsRefresh()) {
+                     display.displayChannels();
+                  }
+                  if (switchPolling.getEvent().type == ev_None) {
+                     // Wait for event or display refresh
+                     Smc::enterWaitMode();
+                     continue;
+                  }
+                  cancelled = true;
+               }
+               channel->setState(ChannelState_off);
+               if (autotuner->getState() != AutotuneState_Complete) {
+                  cancelled = true;
+                  break;
+               }
+               gains[index] = autotuner->calculatePidGains();
+
+               dmaConsole.setFloatFormat(3, Padding_None);
+               dmaConsole.write("@", autotuner->getTuneTemperature());
+               dmaConsole.write(" Ku=", autotuner->getUltimateGain(), ", Tu=", autotuner->getUltimatePeriod());
+               dmaConsole.writeln(" s, Hold=", autotuner->getHoldingOutput(), "%");
+               dmaConsole.write("Kp=", gains[index].kp, ", Ki=", gains[index].ki, ", Kd=", gains[index].kd, ", iLimit=", gains[index].iLimit);
+               dmaConsole.writeln();
+               dmaConsole.resetFormat();
+            }
+            channel->selectAutotune(false);
+            channel->setUserTemperature(userTemperature);
+
+            if (cancelled) {
+               display.displayMessage(
+                     "Autotune Fail",
+                     "\n Cancelled, timed"
+                     "\n out or temperature"
+                     "\n out of range.");
+               break;
+            }
+            StringFormatter_T<80> prompt;
+            prompt.setFloatFormat(2, Padding_None);
+            if (tuneBands) {
+               prompt.write("Kp ", gains[CalibrationIndex_250].kp, "/", gains[CalibrationIndex_325].kp, "/", gains[CalibrationIndex_400].kp);
+               prompt.write("\nKi ", gains[CalibrationIndex_250].ki, "/", gains[CalibrationIndex_325].ki, "/", gains[CalibrationIndex_400].ki);
+            }
+            else {
+               // Same values for all bands
+               gains[CalibrationIndex_325] = gains[CalibrationIndex_250];
+               gains[CalibrationIndex_400] = gains[CalibrationIndex_250];
+               prompt.write("Kp=", gains[CalibrationIndex_250].kp, " Ki=", gains[CalibrationIndex_250].ki);
+               prompt.write("\nKd=", gains[CalibrationIndex_250].kd, " IL=", gains[CalibrationIndex_250].iLimit);
+            }
+            prompt.write("\nSave PID values?");
+            if (confirmAction(prompt.toString())) {
+               for (CalibrationIndex index=CalibrationIndex_250; index<CalibrationIndex_Number; ++index) {
+                  nvTipSettings->setPidControlValues(index, gains[index]);
+               }
+               menuItems[selection].modifiers |= MenuItem::Starred;
             }
          }
          break;
@@ -739,10 +1038,7 @@ EventType Menus::selectAvailableTips(const SettingsData &) {
          display.displayMenuList("  Enable tips", tipMenuItems, modifiers, selection);
          refresh = false;
       }
-      event = switchPolling.getEvent();
-      if (event.type == ev_None) {
-         continue;
-      }
+      event = switchPolling.waitForEvent();
 
       // Assume refresh required
       refresh = true;
@@ -831,7 +1127,7 @@ bool Menus::confirmAction(const char *prompt) {
       if (doUpdate) {
          display.displayChoice("Warning", prompt, options, selection);
       }
-      Event event = switchPolling.getEvent();
+      Event event = switchPolling.waitForEvent();
       switch(event.type) {
          case ev_QuadRotate:
             selection += event.change;
@@ -871,6 +1167,8 @@ EventType Menus::runHeater(const SettingsData &data) {
 
       event = switchPolling.getEvent();
       if (event.type == ev_None) {
+         // Wait for event or display refresh
+         Smc::enterWaitMode();
          continue;
       }
 
@@ -918,10 +1216,13 @@ void Menus::settingsMenu() {
          {"Tip Selection",     },
          {"Temp Calibration",  },
          {"Pid Manual set",    },
+         {"Control Mode",      },
+         {"Step Response",     },
+         {"Pid Autotune",      },
+         {"Pid Autotune Bands",},
 #if defined(DEBUG_BUILD)
          {"Ch1 Debug",         },
          {"Ch2 Debug",         },
-         {"Step Response",     },
 #endif
    };
 
@@ -937,10 +1238,13 @@ void Menus::settingsMenu() {
          {"Tip Selection",            selectAvailableTips                                               },
          {"Temp Calibration",         calibrateTipTemps                                                 },
          {"Pid Manual set",           editPidSettings                                                   },
+         {"Control Mode",             selectControlMode                                                 },
+         {"Step Response",            stepResponse                                                      },
+         {"Pid Autotune",             autotunePid,          0                                           },
+         {"Pid Autotune Bands",       autotunePid,          1                                           },
 #if defined(DEBUG_BUILD)
          {"Ch1 Debug",                runHeater,            1                                           },
          {"Ch2 Debug",                runHeater,            2                                           },
-         {"Step Response",            stepResponse                                                      },
 #endif
    };
 
@@ -955,10 +1259,7 @@ void Menus::settingsMenu() {
          display.displayMenuList("  Settings", items, selection);
          refresh = false;
       }
-      Event event = switchPolling.getEvent();
-      if (event.type == ev_None) {
-         continue;
-      }
+      Event event = switchPolling.waitForEvent();
 
       // Assume refresh required on event
       refresh = true;
@@ -106,13 +106,35 @@ public:
     */
    static EventType editPidSettings(const SettingsData &);
 
+   /**
+    * Select control algorithm (PID or predictive) for each tip.
+    *
+    * @return Exiting event
+    */
+   static EventType selectControlMode(const SettingsData &);
+
    /**
     * Calculate a non-volatile tip PID settings.
+    * The tip is driven at fixed power and a model identified from the step response.
+    * PID values calculated from the model may then be saved.
     *
     * @return Exiting event
     */
    static EventType stepResponse(const SettingsData &);
 
+   /**
+    * Calculate a non-volatile tip PID settings.
+    * The tip is cycled around the tuning temperature by a relay (RelayAutotuneController)
+    * and the PID values calculated are used for all calibration bands.
+    * Optionally the tip is cycled around the temperature of each calibration band in turn.
+    * PID values calculated from the cycles may then be saved.
+    *
+    * @param data data.option != 0 to tune each calibration band separately
+    *
+    * @return Exiting event
+    */
+   static EventType autotunePid(const SettingsData &data);
+
    /**
     * Edit a available tips in non-volatile settings.
     *
@@ -5,8 +5,79 @@
  *      Author: peter
  */
 
+#include <string.h>
 #include "NonvolatileSettings.h"
 
+// Settings must fit in the emulated EEPROM (EepromSel_1KBytes)
+static_assert(sizeof(NonvolatileSettings) <= 1024, "Non-volatile settings too large for EEPROM");
+
+namespace {
+
+/**
+ * Tip settings entry written by the original firmware (no layout version).
+ * These start where nvLayoutVersion is now located.
+ */
+struct TipSettingsLayout0 {
+   uint16_t calibrationMeasurementValue[CalibrationIndex_Number];
+   uint16_t calibrationTemperatureValue[CalibrationIndex_Number];
+   uint16_t kp, ki, kd, iLimit;
+   uint16_t flags;
+   uint8_t  tipNameIndex;
+
+   void get(TipSettings::LegacySettings &legacy) const {
+      memcpy(legacy.calibrationMeasurementValue, calibrationMeasurementValue, sizeof(calibrationMeasurementValue));
+      memcpy(legacy.calibrationTemperatureValue, calibrationTemperatureValue, sizeof(calibrationTemperatureValue));
+      legacy.kp           = kp;
+      legacy.ki           = ki;
+      legacy.kd           = kd;
+      legacy.iLimit       = iLimit;
+      legacy.hasModel     = false;
+      legacy.flags        = flags;
+      legacy.tipNameIndex = static_cast<TipSettings::TipNameIndex>(tipNameIndex);
+   }
+
+   bool isValid() const {
+      // Only the tip name index can be checked
+      return true;
+   }
+};
+static_assert(sizeof(TipSettingsLayout0) == 24, "Unexpected size for original tip settings");
+
+/**
+ * Tip settings entry for LAYOUT_VERSION_1 (adds thermal model and control mode).
+ */
+struct TipSettingsLayout1 {
+   uint16_t calibrationMeasurementValue[CalibrationIndex_Number];
+   uint16_t calibrationTemperatureValue[CalibrationIndex_Number];
+   uint16_t kp, ki, kd, iLimit;
+   uint16_t thermalMass, thermalLoss;
+   uint16_t flags;
+   uint8_t  controlMode;
+   uint8_t  tipNameIndex;
+
+   void get(TipSettings::LegacySettings &legacy) const {
+      memcpy(legacy.calibrationMeasurementValue, calibrationMeasurementValue, sizeof(calibrationMeasurementValue));
+      memcpy(legacy.calibrationTemperatureValue, calibrationTemperatureValue, sizeof(calibrationTemperatureValue));
+      legacy.kp           = kp;
+      legacy.ki           = ki;
+      legacy.kd           = kd;
+      legacy.iLimit       = iLimit;
+      legacy.hasModel     = true;
+      legacy.thermalMass  = thermalMass;
+      legacy.thermalLoss  = thermalLoss;
+      legacy.controlMode  = static_cast<ControlMode>(controlMode);
+      legacy.flags        = flags;
+      legacy.tipNameIndex = static_cast<TipSettings::TipNameIndex>(tipNameIndex);
+   }
+
+   bool isValid() const {
+      return controlMode <= ControlMode_Predictive;
+   }
+};
+static_assert(sizeof(TipSettingsLayout1) == 28, "Unexpected size for LAYOUT_VERSION_1 tip settings");
+
+}
+
 /**
  * Constructor
  */
@@ -25,7 +96,92 @@ NonvolatileSettings::NonvolatileSettings() : Flash() {
    else {
       usbdm_assert(rc == USBDM::FLASH_ERR_OK, "FlexNVM initialisation error");
       USBDM::console.WRITELN("Not initialising NV variables");
+
+      if (nvLayoutVersion != LAYOUT_VERSION) {
+         // Written by firmware with a different layout (EEPROM is kept over firmware updates)
+         updateLayout();
+      }
+   }
+}
+
+/**
+ * Convert tip settings in an earlier layout to the current layout.
+ * Selected tips are moved to the converted entries.
+ *
+ * @tparam OldTipSettings Layout of a tip settings entry in EEPROM
+ *
+ * @param oldTipSettings  Location of tip settings in EEPROM
+ *
+ * @return true  Settings converted
+ * @return false Settings not valid in this layout and were not changed
+ */
+template<typename OldTipSettings>
+bool NonvolatileSettings::updateTipSettings(const void *oldTipSettings) {
+
+   // Copy as the new settings overlap the old
+   OldTipSettings oldSettings[TipSettings::NUM_TIP_SETTINGS];
+   memcpy(oldSettings, oldTipSettings, sizeof(oldSettings));
+
+   for (const OldTipSettings &old:oldSettings) {
+      bool validName =
+            (old.tipNameIndex == TipSettings::FREE_ENTRY) ||
+            ((old.tipNameIndex >= TipSettings::FIRST_VALID_TIP) && (old.tipNameIndex <= TipSettings::LAST_VALID_TIP));
+      if (!validName || !old.isValid()) {
+         return false;
+      }
+   }
+
+   // Selected tips point at old entries
+   auto newSelectedTip = [&](const TipSettings *selectedTip) -> const TipSettings * {
+      uintptr_t offset = reinterpret_cast<uintptr_t>(selectedTip) - reinterpret_cast<uintptr_t>(oldTipSettings);
+      unsigned  index  = offset/sizeof(OldTipSettings);
+      if (((offset%sizeof(OldTipSettings)) != 0) || (index >= TipSettings::NUM_TIP_SETTINGS) ||
+          (oldSettings[index].tipNameIndex == TipSettings::FREE_ENTRY)) {
+         return Tips::getDefaultTip();
+      }
+      return &tipSettings[index];
+   };
+   const TipSettings *ch1SelectedTip = newSelectedTip(ch1Settings.selectedTip);
+   const TipSettings *ch2SelectedTip = newSelectedTip(ch2Settings.selectedTip);
+
+   for (unsigned index=0; index<TipSettings::NUM_TIP_SETTINGS; index++) {
+      TipSettings::LegacySettings legacy;
+      oldSettings[index].get(legacy);
+      tipSettings[index].loadLegacySettings(legacy);
+   }
+   ch1Settings.selectedTip = ch1SelectedTip;
+   ch2Settings.selectedTip = ch2SelectedTip;
+
+   return true;
+}
+
+/**
+ * Update settings written by firmware with a different layout.
+ * Tip settings in a known layout are converted, otherwise they are re-initialised.
+ */
+void NonvolatileSettings::updateLayout() {
+   bool updated = false;
+
+   if (nvLayoutVersion == LAYOUT_VERSION_1) {
+      updated = updateTipSettings<TipSettingsLayout1>(&tipSettings);
+   }
+   else if ((nvLayoutVersion&0xFFFF0000) != LAYOUT_MAGIC) {
+      // Original layout without a version - tip settings start at nvLayoutVersion
+      updated = updateTipSettings<TipSettingsLayout0>(&nvLayoutVersion);
+   }
+   if (updated) {
+      USBDM::console.WRITELN("NV layout changed - converted tip settings");
+   }
+   else {
+      USBDM::console.WRITELN("NV layout changed - initialising tip settings");
+
+      // Selected tips refer to old tip settings
+      ch1Settings.selectedTip = Tips::getDefaultTip();
+      ch2Settings.selectedTip = Tips::getDefaultTip();
+
+      tips.initialiseTipSettings();
    }
+   nvLayoutVersion = LAYOUT_VERSION;
 }
 
 /**
@@ -36,5 +192,6 @@ void NonvolatileSettings::initialiseNonvolatileStorage() {
    ch1Settings.initialise();
    ch2Settings.initialise();
    hardwareCalibration.initialise();
+   nvLayoutVersion = LAYOUT_VERSION;
 }
 
@@ -28,6 +28,15 @@ class NonvolatileSettings : public USBDM::Flash {
    friend class Tips;
 
 public:
+   /// Identifies non-volatile settings layout (upper 16 bits)
+   static constexpr uint32_t LAYOUT_MAGIC   = 0x53540000;
+
+   /// Layout with a single set of PID values and thermal model for each tip
+   static constexpr uint32_t LAYOUT_VERSION_1 = LAYOUT_MAGIC|1;
+
+   /// Current non-volatile settings layout (change when the layout of the tip settings changes)
+   static constexpr uint32_t LAYOUT_VERSION = LAYOUT_MAGIC|2;
+
    /// Settings for calibration of hardware
    HardwareCalibration hardwareCalibration;
 
@@ -39,11 +48,35 @@ private:
    ///  Channel 2 non-volatile settings
    ChannelSettings ch2Settings;
 
+   /// Layout of following settings (LAYOUT_VERSION)\n
+   /// The hardware and channel settings above must not change so this stays at a fixed location
+   USBDM::Nonvolatile<uint32_t> nvLayoutVersion;
+
    /// Settings for tips selected as available
    Tips::TipSettingsArray tipSettings;
 
 private:
 
+   /**
+    * Update settings written by firmware with a different layout.
+    * Tip settings in a known layout are converted, otherwise they are re-initialised.
+    */
+   void updateLayout();
+
+   /**
+    * Convert tip settings in an earlier layout to the current layout.
+    * Selected tips are moved to the converted entries.
+    *
+    * @tparam OldTipSettings Layout of a tip settings entry in EEPROM
+    *
+    * @param oldTipSettings  Location of tip settings in EEPROM
+    *
+    * @return true  Settings converted
+    * @return false Settings not valid in this layout and were not changed
+    */
+   template<typename OldTipSettings>
+   bool updateTipSettings(const void *oldTipSettings);
+
    /**
     * Initialise a non-volatile channel settings
     */
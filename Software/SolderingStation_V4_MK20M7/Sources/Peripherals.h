@@ -230,13 +230,14 @@ static constexpr int      MIN_DUTY     = 0;
 
 /**
  * Sample interval (1 cycle of the rectified mains)
- * Samples alternate between channels to reduce interaction
+ * Both channels are sampled each cycle if the measurement budget allows (see MeasurementMode)
+ * otherwise samples alternate between channels
  */
 static constexpr Seconds  SAMPLE_INTERVAL = 10.0_ms;
 
 /**
- * Controller interval (2 cycles of the rectified mains)
- * Controller us update on every second cycle
+ * Initial controller interval (2 cycles of the rectified mains)
+ * The controller is updated with the actual interval each time it is run
  */
 static constexpr Seconds  CONTROL_INTERVAL = 20.0_ms;
 
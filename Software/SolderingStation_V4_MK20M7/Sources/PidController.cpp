@@ -8,19 +8,85 @@
 #include "PidController.h"
 #include "hardware.h"
 #include "Channel.h"
+#include "DmaConsole.h"
 
 using namespace USBDM;
 
 /**
  * Set control parameters
+ * The gains are rescheduled atomically with respect to the sampling interrupt (newSample()).
  *
  * @param settings Parameter to use
  */
 void PidController::setControlParameters(const TipSettings *settings) {
-   fKp       = settings->getKp();
-   fKi       = settings->getKi() * fInterval;
-   fKd       = settings->getKd() / fInterval;
-   fILimit   = settings->getILimit();
+   CriticalSection cs;
+
+   for (CalibrationIndex index=CalibrationIndex_250; index<CalibrationIndex_Number; ++index) {
+      fSchedule[index] = settings->getPidGains(index);
+   }
+   scheduleGains(fScheduledTarget);
+}
+
+/**
+ * Set gains from schedule for a target temperature.
+ * The change is bumpless for the current error unless the output is saturated
+ * or the error is larger than BUMPLESS_ERROR_LIMIT.
+ *
+ * @param targetTemperature Target tip temperature in Celsius
+ */
+void PidController::scheduleGains(float targetTemperature) {
+
+   // Find band at or below target (limited to first band)
+   CalibrationIndex lower = CalibrationIndex_250;
+   while (((lower+1) < (CalibrationIndex_Number-1)) &&
+          (targetTemperature >= TipSettings::getCalibrationTemperature(CalibrationIndex(lower+1)))) {
+      ++lower;
+   }
+   const CalibrationIndex upper = CalibrationIndex(lower+1);
+
+   const float lowerTemperature = TipSettings::getCalibrationTemperature(lower);
+   const float upperTemperature = TipSettings::getCalibrationTemperature(upper);
+
+   // Interpolate between bands (end bands used outside range)
+   float fraction = (targetTemperature-lowerTemperature)/(upperTemperature-lowerTemperature);
+   fraction = std::max(0.0f, std::min(fraction, 1.0f));
+
+   auto interpolate = [&](float PidGains::*gain) {
+      return fSchedule[lower].*gain + fraction*(fSchedule[upper].*gain - fSchedule[lower].*gain);
+   };
+   const float kp = interpolate(&PidGains::kp);
+   const float kd = interpolate(&PidGains::kd) / fInterval;
+
+   // Bumpless - transfer change in proportional term to integral (unless saturated)
+   if ((fCurrentOutput > fOutMin) && (fCurrentOutput < fOutMax) && (fabsf(fCurrentError) <= BUMPLESS_ERROR_LIMIT)) {
+      fIntegral += (fKp - kp) * fCurrentError;
+   }
+
+   if (fKd != 0) {
+      // Differential filter holds previous output
+      fDifferential *= kd / fKd;
+   }
+   fKp       = kp;
+   fKi       = interpolate(&PidGains::ki) * fInterval;
+   fKd       = kd;
+   fILimit   = interpolate(&PidGains::iLimit);
+
+   fScheduledTarget = targetTemperature;
+}
+
+/**
+ * Set interval between samples.
+ * Rescales the integral and differential gains.
+ *
+ * @param interval Interval for sampling
+ */
+void PidController::setInterval(Seconds interval) {
+   if (interval == fInterval) {
+      return;
+   }
+   fKi       = getKi() * interval;
+   fKd       = getKd() / interval;
+   fInterval = interval;
 }
 
 /**
@@ -37,6 +103,9 @@ void PidController::enable(bool enable) {
          // Just enabled
          fIntegral    = fCurrentOutput;
          fTickCount   = 0;
+
+         // Previous error is stale - no bumpless adjustment on first sample
+         fCurrentError = 0;
       }
    }
    else if (fEnabled) {
@@ -75,6 +144,10 @@ float PidController::newSample(float targetTemperature, float actualTemperature)
 
    fTickCount++;
 
+   if (targetTemperature != fScheduledTarget) {
+      // Uses previous error
+      scheduleGains(targetTemperature);
+   }
    fCurrentTarget = targetTemperature;
 
    // Update input samples & error
@@ -130,10 +203,10 @@ float PidController::newSample(float targetTemperature, float actualTemperature)
  */
 void PidController::reportHeading(Channel & ch) const {
 
-      console.setFloatFormat(1, Padding_None).write("SetTemp, Drive,", ch.getTipName(), ",Error,P=", getKp());
-      console.setFloatFormat(3, Padding_None).write(",I=", getKi());
-      console.setFloatFormat(1, Padding_None).write("<", fILimit, "@", (int)round(fOutMax), "%,D,Instant. T");
-      console.writeln();
+      dmaConsole.setFloatFormat(1, Padding_None).write("SetTemp, Drive,", ch.getTipName(), ",Error,P=", getKp());
+      dmaConsole.setFloatFormat(3, Padding_None).write(",I=", getKi());
+      dmaConsole.setFloatFormat(1, Padding_None).write("<", fILimit, "@", (int)round(fOutMax), "%,D,Instant. T");
+      dmaConsole.writeln();
 }
 
 /**
@@ -141,12 +214,27 @@ void PidController::reportHeading(Channel & ch) const {
  */
 void PidController::report() const {
 
-   console.setFloatFormat(1, Padding_LeadingSpaces, 3);
-   console.write(",", fCurrentTarget); // Set temperature
-   console.write(",", fCurrentOutput); // Drive %
-   console.write(",", fCurrentInput);  // Average temperature
-   console.write(",", fCurrentError);  // Error
-   console.write(",", fProportional);  // P
-   console.write(",", fIntegral);      // I
-   console.write(",", fDifferential);  // D
+   dmaConsole.setFloatFormat(1, Padding_LeadingSpaces, 3);
+   dmaConsole.write(",", fCurrentTarget); // Set temperature
+   dmaConsole.write(",", fCurrentOutput); // Drive %
+   dmaConsole.write(",", fCurrentInput);  // Average temperature
+   dmaConsole.write(",", fCurrentError);  // Error
+   dmaConsole.write(",", fProportional);  // P
+   dmaConsole.write(",", fIntegral);      // I
+   dmaConsole.write(",", fDifferential);  // D
+}
+
+/**
+ * Fill in controller values of telemetry frame
+ *
+ * @param frame Frame to update
+ */
+void PidController::getTelemetry(TelemetryFrame &frame) const {
+
+   frame.target       = toTelemetryValue(fCurrentTarget, TELEMETRY_TEMPERATURE_SCALE);
+   frame.measured     = toTelemetryValue(fCurrentInput,  TELEMETRY_TEMPERATURE_SCALE);
+   frame.proportional = toTelemetryValue(fProportional,  TELEMETRY_PERCENT_SCALE);
+   frame.integral     = toTelemetryValue(fIntegral,      TELEMETRY_PERCENT_SCALE);
+   frame.differential = toTelemetryValue(fDifferential,  TELEMETRY_PERCENT_SCALE);
+   frame.duty         = toTelemetryValue(fCurrentOutput, TELEMETRY_PERCENT_SCALE);
 }
@@ -12,15 +12,35 @@
 
 /**
  * PID Controller
+ *
+ * The gains are scheduled on the target temperature.
+ * A parameter set is held for each calibration band (250, 325 and 400 C) and the
+ * gains used are linearly interpolated between the bands either side of the target
+ * (the end bands are used outside this range).
+ *
+ * Changes of gain are bumpless i.e. the integral term is adjusted so that the
+ * output would be unchanged for the current error. This is not done while the output
+ * is saturated or the error is large (e.g. heating to a new target) as the output does
+ * not follow the proportional term and the adjustment would only wind up the integral.
  */
 class PidController : public Controller {
 
+public:
+   /// Largest error for which a change of gain is made bumpless (C)
+   static constexpr float BUMPLESS_ERROR_LIMIT = 10.0;
+
 private:
    float      fKp             = 0.0;
    float      fKi             = 0.0;
    float      fKd             = 0.0;
    float      fILimit         = 0.0;
 
+   /// Gains for each calibration band (Ki, Kd not scaled by interval)
+   PidGains   fSchedule[CalibrationIndex_Number] = {};
+
+   /// Target temperature that current gains were scheduled for
+   float      fScheduledTarget = 0.0;
+
    /// Integral accumulation term = sum(Ki * error(i)) * interval
    float      fIntegral       = 0.0;
 
@@ -86,11 +106,29 @@ public:
 
    /**
     * Set control parameters
+    * Loads the gains for all calibration bands and schedules them for the current target.
     *
     * @param settings Parameter to use
     */
    virtual void setControlParameters(const TipSettings *settings) override ;
 
+   /**
+    * Set gains from schedule for a target temperature.
+    * The change is bumpless for the current error unless the output is saturated
+    * or the error is larger than BUMPLESS_ERROR_LIMIT.
+    *
+    * @param targetTemperature Target tip temperature in Celsius
+    */
+   void scheduleGains(float targetTemperature);
+
+   /**
+    * Set interval between samples.
+    * Rescales the integral and differential gains.
+    *
+    * @param interval Interval for sampling
+    */
+   virtual void setInterval(USBDM::Seconds interval) override ;
+
    /**
     * Main calculation
     *
@@ -126,6 +164,13 @@ public:
     * Print heading for report()
     */
    virtual void reportHeading(Channel &ch) const override ;
+
+   /**
+    * Fill in controller values of telemetry frame
+    *
+    * @param frame Frame to update
+    */
+   virtual void getTelemetry(TelemetryFrame &frame) const override ;
 };
 
 #endif // SOURCES_PIDCONTROLLER_H_
@@ -0,0 +1,160 @@
+/**
+ * @file    PredictiveController.cpp
+ * @brief   Model based predictive controller class
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#include "PredictiveController.h"
+#include "hardware.h"
+#include "Channel.h"
+#include "DmaConsole.h"
+
+using namespace USBDM;
+
+/**
+ * Set control parameters
+ *
+ * @param settings Parameter to use
+ */
+void PredictiveController::setControlParameters(const TipSettings *settings) {
+   fThermalMass = settings->getThermalMass();
+   fThermalLoss = settings->getThermalLoss();
+   if (fThermalMass <= 0) {
+      // Not set - avoid division by zero
+      fThermalMass = 1.0;
+   }
+}
+
+/**
+ * Enable controller
+ *
+ * @note: Controller may be re-initialised when enabled.
+ * @note: Output is left unchanged when disabled.
+ *
+ * @param[in] enable True to enable
+ */
+void PredictiveController::enable(bool enable) {
+   if (enable) {
+      if (!fEnabled) {
+         // Just enabled
+         fDisturbance = 0;
+         fTickCount   = 0;
+      }
+   }
+   else if (fEnabled) {
+      // Just disabled
+      fCurrentOutput = 0;
+      setDutyCycle(0);
+   }
+   fEnabled = enable;
+}
+
+/**
+ * Main calculation
+ *
+ * Should be executed at interval period
+ *
+ * Process new sample to produce new control output
+ *
+ * @note If the controller is disabled it will simply return the last output value
+ *
+ * @param targetTemperature   Target tip temperature in Celsius
+ * @param actualTemperature   Tip temperature in Celsius
+ *
+ * @return Control output
+ */
+float PredictiveController::newSample(float targetTemperature, float actualTemperature) {
+
+   const float lastInput = fCurrentInput;
+
+   // Save for next iteration
+   fCurrentInput = actualTemperature;
+
+   if(!fEnabled) {
+      // Assume manually set value
+      return fCurrentOutput;
+   }
+
+   fTickCount++;
+
+   fCurrentTarget = targetTemperature;
+
+   // Update input samples & error
+   fCurrentError = fCurrentTarget - fCurrentInput;
+
+   if (fTickCount > 1) {
+      // Power actually applied since last sample (after limiting and quantisation)
+      const float appliedPower = (getDutyCycle()*fMaximumPower)/fResolution;
+
+      // Temperature predicted by model from last sample
+      const float predicted = lastInput +
+            (fInterval/fThermalMass)*(appliedPower - fThermalLoss*(lastInput-AMBIENT_TEMPERATURE) - fDisturbance);
+
+      // Attribute prediction error to load
+      fDisturbance += OBSERVER_GAIN*(fThermalMass/fInterval)*(predicted - fCurrentInput);
+
+      if (fDisturbance > fMaximumPower) {
+         fDisturbance = fMaximumPower;
+      }
+      else if (fDisturbance < -fMaximumPower) {
+         fDisturbance = -fMaximumPower;
+      }
+   }
+   fFeedForward  = fThermalLoss*(fCurrentTarget-AMBIENT_TEMPERATURE) + fDisturbance;
+   fCorrection   = (fThermalMass/HORIZON - fThermalLoss)*fCurrentError;
+
+   fCurrentOutput = 100*(fFeedForward + fCorrection)/fMaximumPower;
+
+   if(fCurrentOutput > fOutMax) {
+      fCurrentOutput = fOutMax;
+   }
+   else if(fCurrentOutput < fOutMin) {
+      fCurrentOutput = fOutMin;
+   }
+
+   // Update output
+   return fCurrentOutput;
+}
+
+/**
+ * Print heading for report()
+ */
+void PredictiveController::reportHeading(Channel & ch) const {
+
+      dmaConsole.setFloatFormat(1, Padding_None).write("SetTemp, Drive,", ch.getTipName(), ",Error,C=", fThermalMass);
+      dmaConsole.setFloatFormat(3, Padding_None).write(",G=", fThermalLoss);
+      dmaConsole.setFloatFormat(1, Padding_None).write("@", fMaximumPower, "W,Feed-forward,Load,Correction,Instant. T");
+      dmaConsole.writeln();
+}
+
+/**
+ * Report current situation
+ */
+void PredictiveController::report() const {
+
+   dmaConsole.setFloatFormat(1, Padding_LeadingSpaces, 3);
+   dmaConsole.write(",", fCurrentTarget); // Set temperature
+   dmaConsole.write(",", fCurrentOutput); // Drive %
+   dmaConsole.write(",", fCurrentInput);  // Average temperature
+   dmaConsole.write(",", fCurrentError);  // Error
+   dmaConsole.write(",", fFeedForward);   // Feed-forward W
+   dmaConsole.write(",", fDisturbance);   // Load W
+   dmaConsole.write(",", fCorrection);    // Correction W
+}
+
+/**
+ * Fill in controller values of telemetry frame
+ * (proportional => correction, integral => feed-forward, differential => load estimate)
+ *
+ * @param frame Frame to update
+ */
+void PredictiveController::getTelemetry(TelemetryFrame &frame) const {
+
+   frame.target       = toTelemetryValue(fCurrentTarget,                   TELEMETRY_TEMPERATURE_SCALE);
+   frame.measured     = toTelemetryValue(fCurrentInput,                    TELEMETRY_TEMPERATURE_SCALE);
+   frame.proportional = toTelemetryValue(100*fCorrection/fMaximumPower,    TELEMETRY_PERCENT_SCALE);
+   frame.integral     = toTelemetryValue(100*fFeedForward/fMaximumPower,   TELEMETRY_PERCENT_SCALE);
+   frame.differential = toTelemetryValue(100*fDisturbance/fMaximumPower,   TELEMETRY_PERCENT_SCALE);
+   frame.duty         = toTelemetryValue(fCurrentOutput,                   TELEMETRY_PERCENT_SCALE);
+}
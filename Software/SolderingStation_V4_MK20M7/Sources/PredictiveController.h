@@ -0,0 +1,137 @@
+/**
+ * @file    PredictiveController.h
+ * @brief   Model based predictive controller class
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#ifndef SOURCES_PREDICTIVECONTROLLER_H_
+#define SOURCES_PREDICTIVECONTROLLER_H_
+
+#include "Controller.h"
+
+/**
+ * Controller using a first-order thermal model of the tip:\n
+ *    C.dT/dt = P - G.(T-Tambient) - D
+ *
+ * where C is the heat capacity and G the loss to ambient from TipSettings,
+ * P is the heater power (duty-cycle of the maximum power from the heater
+ * resistance and voltage) and D is the unknown load e.g. a joint being soldered.
+ *
+ * Each sample:
+ * - The load D is estimated by comparing the measured temperature with that
+ *   predicted by the model from the previous sample and the power actually applied.
+ *   As the applied power is used there is no wind-up when the output is limited.
+ * - Feed-forward   = G.(Ttarget-Tambient) + D   i.e. power to hold the target temperature
+ * - Correction     = (C/HORIZON - G).(Ttarget-T) i.e. power to reach the target
+ *   temperature after HORIZON (predicted by the model)
+ */
+class PredictiveController : public Controller {
+
+private:
+   /// Time to reach target temperature (must exceed measurement lag)
+   static constexpr USBDM::Seconds HORIZON = 0.3;
+
+   /// Fraction of prediction error applied to load estimate each sample
+   static constexpr float OBSERVER_GAIN = 0.3;
+
+   /// Maximum heater power (W)
+   const float fMaximumPower;
+
+   /// Heat capacity of tip (J/K)
+   float fThermalMass    = 1.0;
+
+   /// Loss to ambient of tip (W/K)
+   float fThermalLoss    = 0.0;
+
+   /// Estimate of load not in model (W)
+   float fDisturbance    = 0.0;
+
+   /// Power to maintain target temperature including load (W)
+   float fFeedForward    = 0.0;
+
+   /// Power to reach target temperature over HORIZON (W)
+   float fCorrection     = 0.0;
+
+public:
+
+   /**
+    * Constructor
+    *
+    * @param[in] interval      Sample interval for controller in seconds
+    * @param[in] outMin        Minimum output value
+    * @param[in] outMax        Maximum output value
+    * @param[in] maximumPower  Heater power at 100% output (W)
+    */
+   PredictiveController(USBDM::Seconds interval, float outMin, float outMax, float maximumPower) :
+      Controller(interval, outMin, outMax), fMaximumPower(maximumPower) {
+   }
+
+   /**
+   * Destructor
+   */
+   virtual ~PredictiveController() {
+   }
+
+   /**
+    * Get estimate of load not in model
+    *
+    * @return Power in watts
+    */
+   float getDisturbance() const {
+      return fDisturbance;
+   }
+
+   /**
+    * Set control parameters
+    *
+    * @param settings Parameter to use
+    */
+   virtual void setControlParameters(const TipSettings *settings) override ;
+
+   /**
+    * Main calculation
+    *
+    * Should be executed at interval period
+    *
+    * Process new sample to produce new control output
+    *
+    * @note If the controller is disabled it will simply return the last output value
+    *
+    * @param targetTemperature   Target tip temperature in Celsius
+    * @param actualTemperature   Tip temperature in Celsius
+    *
+    * @return Control output
+    */
+   virtual float newSample(float targetTemperature, float actualTemperature) override ;
+
+   /**
+    * Enable controller
+    *
+    * @note: Controller may be re-initialised when enabled.
+    * @note: Output is left unchanged when disabled.
+    *
+    * @param[in] enable True to enable
+    */
+   virtual void enable(bool enable = true) override ;
+
+   /**
+    * Report current situation
+    */
+   virtual void report() const override ;
+
+   /**
+    * Print heading for report()
+    */
+   virtual void reportHeading(Channel &ch) const override ;
+
+   /**
+    * Fill in controller values of telemetry frame
+    * (proportional => correction, integral => feed-forward, differential => load estimate)
+    *
+    * @param frame Frame to update
+    */
+   virtual void getTelemetry(TelemetryFrame &frame) const override ;
+};
+
+#endif // SOURCES_PREDICTIVECONTROLLER_H_
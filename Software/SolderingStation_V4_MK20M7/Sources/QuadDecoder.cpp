@@ -5,22 +5,19 @@
  *      Author: peter
  */
 
-#include "hardware.h"
-#include "Peripherals.h"
 #include "QuadDecoder.h"
 
-using namespace USBDM;
-
 /**
- * Pin IRQ call-back.
- * Used to monitor shaft movements.\n
+ * Advance state machine.
  * This uses a state machine that is resistant to contact bounce.
  *
  * @note Assumes 4 transitions/detent
  *
- * @param eventMask Mask indicating active pins
+ * @param phases Current encoder phases (active-high, 2 bits)
+ *
+ * @return +1, -1 on completing a detent, 0 otherwise
  */
-void QuadDecoder::pinIrqCallback(uint32_t eventMask) {
+int QuadStateMachine::step(uint32_t phases) {
 
    // Count actions encoded in state
    constexpr uint8_t Inc = 0b010000;
@@ -59,53 +56,18 @@ void QuadDecoder::pinIrqCallback(uint32_t eventMask) {
       /* DecoderState_CCW01 */     { DecoderState_IdleDec,   DecoderState_CCW01, DecoderState_Idle,  DecoderState_CCW11 },
    };
 
-   static DecoderState currentState = DecoderState_Idle;
-
-   // Check if interrupt from Quad switch bits
-   if (eventMask && QuadPhases::BITMASK) {
+   // Use current state and state of GPIOs to determine next state
+   DecoderState nextState = nextStateTable[currentState][phases&0b11];
 
-      // Use current state and state of GPIOs to determine next state
-      DecoderState nextState = nextStateTable[currentState][QuadPhases::read()];
+   // Strip actions from state
+   currentState = (DecoderState)(nextState & DecoderState_Mask);
 
-      // Do transition actions
-      if (nextState&Inc) {
-         position = position + 1;
-      }
-      else if (nextState&Dec) {
-         position = position - 1;
-      }
-      // Strip actions from state
-      currentState = (DecoderState)(nextState & DecoderState_Mask);
+   // Do transition actions
+   if (nextState&Inc) {
+      return 1;
    }
+   if (nextState&Dec) {
+      return -1;
+   }
+   return 0;
 }
-
-/**
- * Enable shaft encoder interface.
- *
- * Enables encoder interrupts and does any other initialisation required.
- */
-void QuadDecoder::initialise() {
-
-   // Start position at zero
-   position = 0;
-
-   // Static call-back function
-   static auto cb = [](uint32_t pinMask) {
-      This->pinIrqCallback(pinMask);
-   };
-
-   // Configure encoder pins as inputs with dual-edge interrupts
-   QuadPhases::setPinCallback(cb);
-   QuadPhases::setInput(PinPull_Up, PinAction_IrqEither, PinFilter_Passive);
-   QuadPhases::enableNvicInterrupts(NvicPriority_Normal);
-}
-
-/**
- * Returns the encoder position.
- */
-int QuadDecoder::getPosition() {
-   return position;
-}
-
-/// This pointer for static callback function
-QuadDecoder *QuadDecoder::This = nullptr;
@@ -8,29 +8,75 @@
 #ifndef SOURCES_ENCODER_H_
 #define SOURCES_ENCODER_H_
 
+#include <type_traits>
+#include "hardware.h"
+#include "ftm.h"
+
+/**
+ * How the rotary encoder is decoded
+ */
+enum QuadDecoderMode {
+   QuadDecoderMode_PinIrq,  ///< Software state machine run from a pin interrupt on every edge
+   QuadDecoderMode_Ftm,     ///< FTM hardware quadrature decoder (no interrupts)
+};
+
+/// Decoder used for the rotary encoder (selected at build time)
+constexpr QuadDecoderMode QUAD_DECODER_MODE = QuadDecoderMode_PinIrq;
+//constexpr QuadDecoderMode QUAD_DECODER_MODE = QuadDecoderMode_Ftm;
+
+/**
+ * State machine used to decode encoder phases.
+ * This is resistant to contact bounce.
+ *
+ * @note Assumes 4 transitions/detent
+ */
+class QuadStateMachine {
+
+private:
+   /// Current state (DecoderState, see QuadDecoder.cpp)
+   uint8_t currentState = 0;
+
+public:
+   /**
+    * Advance state machine
+    *
+    * @param phases Current encoder phases (active-high, 2 bits)
+    *
+    * @return +1, -1 on completing a detent, 0 otherwise
+    */
+   int step(uint32_t phases);
+};
+
 /**
- * Interrupt drive Quadrature decoder
+ * Interrupt driven Quadrature decoder.
+ * The encoder is decoded in software from a pin interrupt on each edge.
+ *
+ * @tparam Phases GPIO field for encoder phases
  */
-class QuadDecoder {
+template<class Phases>
+class PinIrqQuadDecoder_T {
 
 private:
 
    /// Variable used by callback to track encoder position
    volatile int position;
 
+   /// Decoder state
+   QuadStateMachine stateMachine;
+
    /// This pointer for static callback function
-   static QuadDecoder *This;
+   static inline PinIrqQuadDecoder_T *This = nullptr;
 
-   QuadDecoder(const QuadDecoder &other) = delete;
-   QuadDecoder(QuadDecoder &&other) = delete;
-   QuadDecoder& operator=(const QuadDecoder &other) = delete;
-   QuadDecoder& operator=(QuadDecoder &&other) = delete;
+   PinIrqQuadDecoder_T(const PinIrqQuadDecoder_T &other) = delete;
+   PinIrqQuadDecoder_T(PinIrqQuadDecoder_T &&other) = delete;
+   PinIrqQuadDecoder_T& operator=(const PinIrqQuadDecoder_T &other) = delete;
+   PinIrqQuadDecoder_T& operator=(PinIrqQuadDecoder_T &&other) = delete;
 
 public:
    /**
     * Constructor
     */
-   QuadDecoder(){
+   PinIrqQuadDecoder_T(){
       usbdm_assert(This == nullptr, "QuadDecoder instantiated more than once");
       This = this;
    }
@@ -38,30 +84,134 @@ public:
    /**
     * Destructor
     */
-   ~QuadDecoder() {}
+   ~PinIrqQuadDecoder_T() {}
 
    /**
     * Pin IRQ call-back.
-    * Used to monitor shaft movements.\n
-    * This uses a state machine that is resistant to contact bounce.
-    *
-    * @note Assumes 4 transitions/detent
+    * Used to monitor shaft movements.
     *
     * @param eventMask Mask indicating active pins
     */
-   void pinIrqCallback(uint32_t eventMask);
+   void pinIrqCallback(uint32_t eventMask) {
+
+      // Check if interrupt from Quad switch bits
+      if (eventMask & Phases::BITMASK) {
+         position = position + stateMachine.step(Phases::read());
+      }
+   }
 
    /**
     * Enable shaft encoder interface.
     *
     * Enables encoder interrupts and does any other initialisation required.
     */
-   void initialise();
+   void initialise() {
+      using namespace USBDM;
+
+      // Start position at zero
+      position = 0;
+
+      // Static call-back function
+      static auto cb = [](uint32_t pinMask) {
+         This->pinIrqCallback(pinMask);
+      };
+
+      // Configure encoder pins as inputs with dual-edge interrupts
+      Phases::setPinCallback(cb);
+      Phases::setInput(PinPull_Up, PinAction_IrqEither, PinFilter_Passive);
+      Phases::enableNvicInterrupts(NvicPriority_Normal);
+   }
+
+   /**
+    * Returns the encoder position.
+    */
+   int getPosition() {
+      return position;
+   }
+};
+
+/**
+ * Hardware Quadrature decoder.
+ * The encoder is decoded by a FTM in quadrature decoder mode.
+ * This uses no interrupts and does not miss edges during fast rotation.
+ *
+ * The FTM counts every edge (4 per detent).
+ * The position changes when the count reaches the next detent so it
+ * follows the same sequence as PinIrqQuadDecoder_T.
+ *
+ * @tparam Decoder FTM quadrature decoder e.g. USBDM::FtmQuadDecoder1
+ */
+template<class Decoder>
+class HardwareQuadDecoder_T {
+
+private:
+
+   /// Length of input filter (in 4 x FTM clocks)
+   static constexpr int FILTER_LENGTH = 15;
+
+   /// Counter value at last call to getPosition()
+   uint16_t lastCount = 0;
+
+   /// Edges counted since initialise()
+   int edges = 0;
+
+   /// Position in detents
+   int position = 0;
+
+   HardwareQuadDecoder_T(const HardwareQuadDecoder_T &other) = delete;
+   HardwareQuadDecoder_T(HardwareQuadDecoder_T &&other) = delete;
+   HardwareQuadDecoder_T& operator=(const HardwareQuadDecoder_T &other) = delete;
+   HardwareQuadDecoder_T& operator=(HardwareQuadDecoder_T &&other) = delete;
+
+public:
+   HardwareQuadDecoder_T() {}
+   ~HardwareQuadDecoder_T() {}
+
+   /**
+    * Enable shaft encoder interface.
+    *
+    * Configures FTM as quadrature decoder and maps pins to it.
+    */
+   void initialise() {
+      using namespace USBDM;
+
+      Decoder::configure(FtmPrescale_1, FtmQuadratureMode_Phase_AB_Mode);
+
+      // Counter is updated synchronously with the FTM clock
+      Decoder::Ftm::setClockSource(FtmClockSource_System);
+      Decoder::Ftm::setCounterMaximumValue(65535_ticks, true);
+      Decoder::setPolarity(ActiveLow);
+      Decoder::enableFilter(FILTER_LENGTH);
+      Decoder::resetPosition();
+      Decoder::setInput(PinPull_Up, PinAction_None, PinFilter_Passive);
+
+      lastCount = 0;
+      edges     = 0;
+      position  = 0;
+   }
 
    /**
     * Returns the encoder position.
+    * Must be called more often than the counter can change by 32768 edges.
     */
-   int getPosition();
+   int getPosition() {
+      uint16_t count = Decoder::getPosition();
+      edges     += static_cast<int16_t>(count-lastCount);
+      lastCount  = count;
+
+      // Only move when a detent is reached in either direction
+      if (edges >= 4*(position+1)) {
+         position = edges>>2;
+      }
+      else if (edges <= 4*(position-1)) {
+         position = -((-edges)>>2);
+      }
+      return position;
+   }
 };
 
+/// Rotary encoder decoder selected by QUAD_DECODER_MODE
+using QuadDecoder = std::conditional_t<QUAD_DECODER_MODE==QuadDecoderMode_Ftm,
+      HardwareQuadDecoder_T<USBDM::FtmQuadDecoder1>, PinIrqQuadDecoder_T<USBDM::QuadPhases>>;
+
 #endif /* SOURCES_ENCODER_H_ */
@@ -0,0 +1,242 @@
+/**
+ * @file    RelayAutotuneController.cpp
+ * @brief   Relay feedback (Astrom-Hagglund) PID autotuner
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#include <math.h>
+#include "RelayAutotuneController.h"
+#include "hardware.h"
+#include "Channel.h"
+#include "Control.h"
+#include "DmaConsole.h"
+
+using namespace USBDM;
+
+/**
+ * Enable controller
+ *
+ * @note: Autotuning restarts when enabled.
+ * @note: Output is left unchanged when disabled.
+ *
+ * @param[in] enable True to enable
+ */
+void RelayAutotuneController::enable(bool enable) {
+   if (enable) {
+      if (!fEnabled) {
+         // Just enabled - restart
+         fState       = AutotuneState_Heating;
+         fTime        = 0;
+         fRelayStart  = 0;
+         fTickCount   = 0;
+         fRelayHigh   = true;
+         fBias        = 0;
+         fAmplitude   = 0;
+         fCycles      = 0;
+         fSumGain     = 0;
+         fSumPeriod   = 0;
+      }
+   }
+   else if (fEnabled) {
+      // Just disabled
+      fCurrentOutput = 0;
+      setDutyCycle(0);
+   }
+   fEnabled = enable;
+}
+
+/**
+ * Start a relay cycle
+ * Switches the relay low, updates the bias and amplitude and restarts the cycle measurements.
+ */
+void RelayAutotuneController::startCycle() {
+   if (fState == AutotuneState_Heating) {
+      // Output to hold target unknown for first cycle - use full range
+      fBias       = (fOutMax+fOutMin)/2;
+      fRelayStart = fTime;
+   }
+   else {
+      completeCycle();
+      if (isFinished()) {
+         return;
+      }
+      // Average output over cycle is the output to hold target
+      fBias = fCycleOutput/(fTime-fCycleStart);
+   }
+   // Use largest amplitude available around bias (limited to output range at low bias)
+   float amplitude = std::max(std::min(fBias-fOutMin, fOutMax-fBias), MINIMUM_AMPLITUDE);
+   fHighOutput     = std::min(fBias+amplitude, fOutMax);
+   fLowOutput      = std::max(fBias-amplitude, fOutMin);
+   fAmplitude      = (fHighOutput-fLowOutput)/2;
+
+   fState          = AutotuneState_Relay;
+   fRelayHigh      = false;
+   fCycleStart     = fTime;
+   fCycleOutput    = 0;
+   fCycleHighTime  = 0;
+   fCycleMaximum = fCurrentInput;
+   fCycleMinimum = fCurrentInput;
+}
+
+/**
+ * Complete a relay cycle
+ * Accumulates ultimate gain and period when the bias has settled.
+ */
+void RelayAutotuneController::completeCycle() {
+
+   fCycles++;
+   if (fCycles <= SETTLING_CYCLES) {
+      return;
+   }
+   // Amplitude of temperature cycle
+   float amplitude = (fCycleMaximum-fCycleMinimum)/2;
+   if (amplitude <= HYSTERESIS) {
+      fState = AutotuneState_Failed;
+      return;
+   }
+   USBDM::Seconds period = fTime-fCycleStart;
+
+   // Fundamental of relay output allowing for asymmetric cycle
+   float fundamental = 4*fAmplitude*sinf(M_PI*fCycleHighTime/period)/M_PI;
+
+   fSumGain   += fundamental/sqrtf(amplitude*amplitude-HYSTERESIS*HYSTERESIS);
+   fSumPeriod += period;
+
+   if (fCycles >= (SETTLING_CYCLES+MEASURED_CYCLES)) {
+      fState = AutotuneState_Complete;
+   }
+}
+
+/**
+ * Main calculation
+ *
+ * Should be executed at interval period
+ *
+ * Process new sample to produce new control output
+ *
+ * @note If the controller is disabled it will simply return the last output value
+ *
+ * @param targetTemperature   Target tip temperature in Celsius
+ * @param actualTemperature   Tip temperature in Celsius
+ *
+ * @return Control output
+ */
+float RelayAutotuneController::newSample(float targetTemperature, float actualTemperature) {
+
+   // Save for next iteration
+   fCurrentInput = actualTemperature;
+
+   if(!fEnabled) {
+      // Assume manually set value
+      return fCurrentOutput;
+   }
+
+   fTickCount++;
+
+   if (fState == AutotuneState_Heating) {
+      fTuneTemperature = targetTemperature;
+   }
+   fCurrentTarget = fTuneTemperature;
+   fCurrentError  = fCurrentTarget - fCurrentInput;
+
+   if (isFinished()) {
+      // Leave heater off
+      fCurrentOutput = fOutMin;
+      return fCurrentOutput;
+   }
+
+   // Output applied over last interval
+   fCycleOutput += fCurrentOutput*fInterval;
+   fTime        += fInterval;
+   if (fRelayHigh) {
+      fCycleHighTime += fInterval;
+   }
+
+   if ((fTime > TIMEOUT) || (fCurrentError < -MAXIMUM_OVERSHOOT)) {
+      fState         = AutotuneState_Failed;
+      fCurrentOutput = fOutMin;
+      return fCurrentOutput;
+   }
+
+   fCycleMaximum = std::max(fCycleMaximum, fCurrentInput);
+   fCycleMinimum = std::min(fCycleMinimum, fCurrentInput);
+
+   if (fRelayHigh) {
+      if (fCurrentError < -HYSTERESIS) {
+         // Above target - switch low and start next cycle
+         startCycle();
+      }
+      else if ((fState == AutotuneState_Heating) && (fTime >= MAXIMUM_HEATING_TIME)) {
+         // Heating too slow - cycle around temperature reached
+         fTuneTemperature = fCurrentInput;
+         fCurrentTarget   = fTuneTemperature;
+         fCurrentError    = 0;
+         startCycle();
+      }
+   }
+   else if (fCurrentError > HYSTERESIS) {
+      // Below target - switch high
+      fRelayHigh = true;
+   }
+   if (isFinished()) {
+      fCurrentOutput = fOutMin;
+   }
+   else if (fState == AutotuneState_Heating) {
+      fCurrentOutput = fOutMax;
+   }
+   else {
+      fCurrentOutput = fRelayHigh?fHighOutput:fLowOutput;
+   }
+   fProportional = fCurrentOutput-fBias;
+
+   return fCurrentOutput;
+}
+
+/**
+ * Calculate PID gains from ultimate gain and period (Tyreus-Luyben PI)\n
+ *    Kp = Ku/3.2, Ti = 2.2.Tu
+ *
+ * The integral limit allows for holding the maximum temperature
+ * using the steady-state gain from the output needed to hold the tuning temperature.
+ *
+ * @return PID gains (valid when complete)
+ */
+PidGains RelayAutotuneController::calculatePidGains() const {
+
+   PidGains gains;
+
+   gains.kp = getUltimateGain()/3.2;
+   gains.ki = gains.kp/(2.2*getUltimatePeriod());
+   gains.kd = 0;
+
+   // Steady-state gain (C/%) from bias output holding tuning temperature
+   const float gain = (fTuneTemperature-AMBIENT_TEMPERATURE)/fBias;
+   gains.iLimit = calculateIntegralLimit(gain, Control::MAX_TEMP);
+
+   return gains;
+}
+
+/**
+ * Print heading for report()
+ */
+void RelayAutotuneController::reportHeading(Channel &ch) const {
+
+   dmaConsole.write("SetTemp, Drive,", ch.getTipName(), ",Error,Bias,Amplitude,Cycles,Instant. T");
+   dmaConsole.writeln();
+}
+
+/**
+ * Report current situation
+ */
+void RelayAutotuneController::report() const {
+
+   dmaConsole.setFloatFormat(1, Padding_LeadingSpaces, 3);
+   dmaConsole.write(",", fCurrentTarget); // Set temperature
+   dmaConsole.write(",", fCurrentOutput); // Drive %
+   dmaConsole.write(",", fCurrentInput);  // Average temperature
+   dmaConsole.write(",", fCurrentError);  // Error
+   dmaConsole.write(",", fBias);          // Relay bias %
+   dmaConsole.write(",", fAmplitude);     // Relay amplitude %
+   dmaConsole.write(",", fCycles);        // Cycles completed
+}
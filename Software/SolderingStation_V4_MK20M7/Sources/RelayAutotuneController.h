@@ -0,0 +1,299 @@
+/**
+ * @file    RelayAutotuneController.h
+ * @brief   Relay feedback (Astrom-Hagglund) PID autotuner
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#ifndef SOURCES_RELAYAUTOTUNECONTROLLER_H_
+#define SOURCES_RELAYAUTOTUNECONTROLLER_H_
+
+#include "Controller.h"
+
+/**
+ * State of autotuning
+ */
+enum AutotuneState : uint8_t {
+   AutotuneState_Heating,   ///< Heating to target at full power
+   AutotuneState_Relay,     ///< Relay limit cycle around target
+   AutotuneState_Complete,  ///< Ultimate gain and period measured
+   AutotuneState_Failed,    ///< Timed out or temperature out of range
+};
+
+/**
+ * Controller that tunes the PID controller at the operating temperature.
+ *
+ * The output is switched between two levels (bias +/- amplitude) by a relay with
+ * hysteresis on the averaged temperature. This produces a limit cycle around the
+ * target from which the ultimate gain and period are found (describing function):\n
+ *    Ku = 4.d.sin(π.D)/(π.sqrt(a²-ε²)), Tu = period of cycle
+ *
+ * where d is the relay amplitude, D the fraction of the cycle the relay is high,
+ * a the amplitude of the temperature cycle and ε the hysteresis.
+ * The sin(π.D) term allows for an asymmetric cycle when the levels are limited
+ * by the output range.
+ *
+ * After each cycle the bias is set to the average output over the cycle (the
+ * power to hold the target) so the cycle becomes symmetric.
+ * PI gains are then calculated using the Tyreus-Luyben rules.
+ *
+ * If the target is not reached within MAXIMUM_HEATING_TIME the cycle is around the
+ * temperature reached so that tuning completes within TIMEOUT from the start of heating.
+ */
+class RelayAutotuneController : public Controller {
+
+public:
+   /// Temperature to tune at
+   static constexpr float TUNING_TEMPERATURE = 350.0;
+
+   /// Relay hysteresis (C)
+   static constexpr float HYSTERESIS = 1.0;
+
+   /// Minimum relay amplitude (%).\n
+   /// The output levels are limited to the output range so the cycle is asymmetric at low bias.
+   static constexpr float MINIMUM_AMPLITUDE = 20.0;
+
+   /// Cycles discarded while bias settles
+   static constexpr unsigned SETTLING_CYCLES = 1;
+
+   /// Cycles averaged for result
+   static constexpr unsigned MEASURED_CYCLES = 3;
+
+   /// Heating time after which tuning is done at the temperature reached if below target.\n
+   /// Gains found at a lower temperature have more stability margin at the target.
+   static constexpr USBDM::Seconds MAXIMUM_HEATING_TIME = 12.0;
+
+   /// Autotune fails if not complete in this time (including heating)
+   static constexpr USBDM::Seconds TIMEOUT = 30.0;
+
+   /// Autotune fails if the temperature exceeds the target by this amount (C)
+   static constexpr float MAXIMUM_OVERSHOOT = 30.0;
+
+private:
+   /// Current state
+   AutotuneState fState       = AutotuneState_Heating;
+
+   /// Time since enabled
+   USBDM::Seconds fTime       = 0;
+
+   /// Indicates relay output is at high level
+   bool  fRelayHigh           = true;
+
+   /// Output level at centre of relay (%)
+   float fBias                = 0;
+
+   /// Relay amplitude for current cycle (%)
+   float fAmplitude           = 0;
+
+   /// Output while relay is high (%)
+   float fHighOutput          = 0;
+
+   /// Output while relay is low (%)
+   float fLowOutput           = 0;
+
+   /// Start of first relay cycle
+   USBDM::Seconds fRelayStart = 0;
+
+   /// Start of current cycle (switch to low)
+   USBDM::Seconds fCycleStart = 0;
+
+   /// Integral of output over current cycle (%.s)
+   float fCycleOutput         = 0;
+
+   /// Time relay is high in current cycle
+   USBDM::Seconds fCycleHighTime = 0;
+
+   /// Highest temperature in current cycle
+   float fCycleMaximum        = 0;
+
+   /// Lowest temperature in current cycle
+   float fCycleMinimum        = 0;
+
+   /// Number of complete cycles
+   unsigned fCycles           = 0;
+
+   /// Sum of ultimate gain over measured cycles
+   float fSumGain             = 0;
+
+   /// Sum of ultimate period over measured cycles
+   float fSumPeriod           = 0;
+
+   /// Temperature the relay cycles around (target or temperature reached when heating is cut short)
+   float fTuneTemperature     = 0;
+
+   /**
+    * Start a relay cycle
+    * Switches the relay low, updates the bias and amplitude and restarts the cycle measurements.
+    */
+   void startCycle();
+
+   /**
+    * Complete a relay cycle
+    * Accumulates ultimate gain and period when the bias has settled.
+    */
+   void completeCycle();
+
+public:
+
+   /**
+    * Constructor
+    *
+    * @param[in] interval      Sample interval for controller in seconds
+    * @param[in] outMin        Minimum output value
+    * @param[in] outMax        Maximum output value
+    */
+   RelayAutotuneController(USBDM::Seconds interval, float outMin, float outMax) :
+      Controller(interval, outMin, outMax) {
+   }
+
+   /**
+   * Destructor
+   */
+   virtual ~RelayAutotuneController() {
+   }
+
+   /**
+    * Get state of autotuning
+    *
+    * @return State
+    */
+   AutotuneState getState() const {
+      return fState;
+   }
+
+   /**
+    * Indicates autotuning has finished (successfully or not)
+    *
+    * @return true if finished
+    */
+   bool isFinished() const {
+      return (fState == AutotuneState_Complete) || (fState == AutotuneState_Failed);
+   }
+
+   /**
+    * Get time taken to heat to target
+    *
+    * @return Time in seconds
+    */
+   USBDM::Seconds getHeatingTime() const {
+      return fRelayStart;
+   }
+
+   /**
+    * Get temperature the relay cycles around.
+    * This is below the target when heating took longer than MAXIMUM_HEATING_TIME.
+    *
+    * @return Temperature in Celsius
+    */
+   float getTuneTemperature() const {
+      return fTuneTemperature;
+   }
+
+   /**
+    * Get time spent in relay cycles
+    *
+    * @return Time in seconds
+    */
+   USBDM::Seconds getRelayTime() const {
+      return fTime-fRelayStart;
+   }
+
+   /**
+    * Get total time since autotune started (heating and relay cycles)
+    *
+    * @return Time in seconds
+    */
+   USBDM::Seconds getTotalTime() const {
+      return fTime;
+   }
+
+   /**
+    * Get number of relay cycles completed
+    *
+    * @return Number of cycles
+    */
+   unsigned getCycles() const {
+      return fCycles;
+   }
+
+   /**
+    * Get ultimate gain (valid when complete)
+    *
+    * @return Ku (% per C)
+    */
+   float getUltimateGain() const {
+      return fSumGain/MEASURED_CYCLES;
+   }
+
+   /**
+    * Get ultimate period (valid when complete)
+    *
+    * @return Tu (s)
+    */
+   USBDM::Seconds getUltimatePeriod() const {
+      return fSumPeriod/MEASURED_CYCLES;
+   }
+
+   /**
+    * Get output needed to hold target (valid when complete)
+    *
+    * @return Output (%)
+    */
+   float getHoldingOutput() const {
+      return fBias;
+   }
+
+   /**
+    * Calculate PID gains from ultimate gain and period
+    *
+    * @return PID gains (valid when complete)
+    */
+   PidGains calculatePidGains() const;
+
+   /**
+    * Set control parameters
+    * Not used - autotuning does not depend on tip settings
+    *
+    * @param settings Parameter to use
+    */
+   virtual void setControlParameters(const TipSettings *) override {
+   }
+
+   /**
+    * Main calculation
+    *
+    * Should be executed at interval period
+    *
+    * Process new sample to produce new control output
+    *
+    * @note If the controller is disabled it will simply return the last output value
+    *
+    * @param targetTemperature   Target tip temperature in Celsius
+    * @param actualTemperature   Tip temperature in Celsius
+    *
+    * @return Control output
+    */
+   virtual float newSample(float targetTemperature, float actualTemperature) override ;
+
+   /**
+    * Enable controller
+    *
+    * @note: Autotuning restarts when enabled.
+    * @note: Output is left unchanged when disabled.
+    *
+    * @param[in] enable True to enable
+    */
+   virtual void enable(bool enable = true) override ;
+
+   /**
+    * Report current situation
+    */
+   virtual void report() const override ;
+
+   /**
+    * Print heading for report()
+    */
+   virtual void reportHeading(Channel &ch) const override ;
+};
+
+#endif // SOURCES_RELAYAUTOTUNECONTROLLER_H_
@@ -0,0 +1,246 @@
+/**
+ * @file    SelectableController.h
+ * @brief   Loop controller selected by tip settings
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#ifndef SOURCES_SELECTABLECONTROLLER_H_
+#define SOURCES_SELECTABLECONTROLLER_H_
+
+#include "PidController.h"
+#include "PredictiveController.h"
+#include "RelayAutotuneController.h"
+
+/**
+ * Loop controller for a heater.
+ *
+ * Contains each type of controller and forwards to the one selected by the
+ * ControlMode of the tip (TipSettings::getControlMode()) or to the autotuner
+ * while autotuning (selectAutotune()).
+ * This has the same interface as the controllers as used by the tools (T12 etc.)
+ */
+class SelectableController {
+
+private:
+   /// PID controller (ControlMode_Pid)
+   PidController        fPidController;
+
+   /// Model based controller (ControlMode_Predictive)
+   PredictiveController fPredictiveController;
+
+   /// Relay autotuner (while autotuning)
+   RelayAutotuneController fAutotuneController;
+
+   /// Controller in use
+   Controller          *fController = &fPidController;
+
+   /// Control mode from tip settings
+   ControlMode          fControlMode = ControlMode_Pid;
+
+   /// Indicates autotuner is selected
+   bool                 fAutotune    = false;
+
+   /**
+    * Select controller from control mode and autotune selection
+    * If the controller changes while running the new controller continues from the current output.
+    * The change is atomic with respect to the sampling interrupt (newSample()).
+    */
+   void selectController() {
+      USBDM::CriticalSection cs;
+
+      Controller *controller = &fPidController;
+      if (fAutotune) {
+         controller = &fAutotuneController;
+      }
+      else if (fControlMode == ControlMode_Predictive) {
+         controller = &fPredictiveController;
+      }
+      if (controller != fController) {
+         bool     enabled = fController->isEnabled();
+         unsigned output  = fController->getDutyCycle();
+         fController->enable(false);
+         fController = controller;
+         fController->setOutput(output);
+         fController->setDutyCycle(output);
+         fController->enable(enabled);
+      }
+   }
+
+   SelectableController(const SelectableController &other) = delete;
+   SelectableController(SelectableController &&other) = delete;
+   SelectableController& operator=(const SelectableController &other) = delete;
+   SelectableController& operator=(SelectableController &&other) = delete;
+
+public:
+   /**
+    * Constructor
+    *
+    * @param[in] interval      Sample interval for controller in seconds
+    * @param[in] outMin        Minimum output value
+    * @param[in] outMax        Maximum output value
+    * @param[in] maximumPower  Heater power at 100% output (W)
+    */
+   SelectableController(USBDM::Seconds interval, float outMin, float outMax, float maximumPower) :
+      fPidController(interval, outMin, outMax),
+      fPredictiveController(interval, outMin, outMax, maximumPower),
+      fAutotuneController(interval, outMin, outMax) {
+   }
+
+   ~SelectableController() {}
+
+   /**
+    * Set control parameters and select controller
+    * If the controller changes while running the new controller continues from the current output.
+    *
+    * @param settings Parameter to use
+    */
+   void setControlParameters(const TipSettings *settings) {
+      fPidController.setControlParameters(settings);
+      fPredictiveController.setControlParameters(settings);
+      fControlMode = settings->getControlMode();
+      selectController();
+   }
+
+   /**
+    * Select autotuner in place of the controller for the tip.
+    * Autotuning starts when the controller is next enabled.
+    *
+    * @param enable True to select autotuner
+    *
+    * @return Autotuner
+    */
+   RelayAutotuneController *selectAutotune(bool enable) {
+      fAutotune = enable;
+      selectController();
+      return &fAutotuneController;
+   }
+
+   /**
+    * Get control algorithm in use
+    *
+    * @return Control mode
+    */
+   ControlMode getControlMode() const {
+      return (fController == &fPredictiveController)?ControlMode_Predictive:ControlMode_Pid;
+   }
+
+   /**
+    * Enable controller
+    *
+    * @param[in] enable True to enable
+    */
+   void enable(bool enable = true) {
+      fController->enable(enable);
+   }
+
+   /**
+    * Indicates if the output is enabled
+    *
+    * @return True  - Enabled
+    * @return False - Disabled
+    */
+   bool isEnabled() const {
+      return fController->isEnabled();
+   }
+
+   /**
+    * Set interval between samples.
+    *
+    * @param interval Interval for sampling
+    */
+   void setInterval(USBDM::Seconds interval) {
+      fController->setInterval(interval);
+   }
+
+   /**
+    * Main calculation
+    *
+    * @param targetTemperature   Target tip temperature in Celsius
+    * @param actualTemperature   Tip temperature in Celsius
+    *
+    * @return Control output
+    */
+   float newSample(float targetTemperature, float actualTemperature) {
+      return fController->newSample(targetTemperature, actualTemperature);
+   }
+
+   /**
+    * Set output of controller
+    * This is used when the controller is disabled
+    *
+    * @param newOutput New output value
+    */
+   void setOutput(float newOutput) {
+      fController->setOutput(newOutput);
+   }
+
+   /**
+    * Set duty-cycle
+    *
+    * @param dutyCycle Duty-cycle as a fraction of resolution
+    */
+   void setDutyCycle(unsigned dutyCycle) {
+      fController->setDutyCycle(dutyCycle);
+   }
+
+   /**
+    * Get currently set duty cycle
+    *
+    * @return Duty-cycle as a fraction of resolution
+    */
+   unsigned getDutyCycle() const {
+      return fController->getDutyCycle();
+   }
+
+   /**
+    * Advance the PWM sequence
+    */
+   void advance() {
+      fController->advance();
+   }
+
+   /**
+    * Is the drive to be on in the current interval
+    *
+    * @return True  => on
+    * @return False => off
+    */
+   bool isOn() const {
+      return fController->isOn();
+   }
+
+   /**
+    * Get number of seconds since last enabled
+    *
+    * @return Elapsed time
+    */
+   USBDM::Seconds getElapsedTime() const {
+      return fController->getElapsedTime();
+   }
+
+   /**
+    * Report current situation
+    */
+   void report() const {
+      fController->report();
+   }
+
+   /**
+    * Print heading for report()
+    */
+   void reportHeading(Channel &ch) const {
+      fController->reportHeading(ch);
+   }
+
+   /**
+    * Fill in controller values of telemetry frame
+    *
+    * @param frame Frame to update
+    */
+   void getTelemetry(TelemetryFrame &frame) const {
+      fController->getTelemetry(frame);
+   }
+};
+
+#endif // SOURCES_SELECTABLECONTROLLER_H_
@@ -0,0 +1,121 @@
+/*
+ * SpscQueue.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef SOURCES_SPSCQUEUE_H_
+#define SOURCES_SPSCQUEUE_H_
+
+#include <atomic>
+
+/**
+ * Lock-free single-producer/single-consumer queue.
+ *
+ * One context (e.g. an interrupt handler) may add() while one other context
+ * (e.g. the main loop) may get(). No interrupts are masked.
+ *
+ * The head and tail indices are free-running and each is written by only one side.
+ * The producer publishes an item with a release store of tail and the consumer
+ * frees a slot with a release store of head.
+ *
+ * @tparam T      Type for queue elements
+ * @tparam size   Size of queue (must be a power of 2)
+ */
+template<typename T, unsigned size>
+class SpscQueue {
+
+   static_assert((size != 0) && ((size & (size-1)) == 0), "SpscQueue size must be a power of 2");
+   static_assert(std::atomic<unsigned>::is_always_lock_free, "SpscQueue requires lock-free atomic indices");
+
+   /// Mask to convert a free-running index to a buffer index
+   static constexpr unsigned MASK = size-1;
+
+   /// Queue storage
+   T queue[size];
+
+   /// Index of next item to remove (written only by consumer)
+   std::atomic<unsigned> head{0};
+
+   /// Index of next free slot (written only by producer)
+   std::atomic<unsigned> tail{0};
+
+   SpscQueue(const SpscQueue &other) = delete;
+   SpscQueue(SpscQueue &&other) = delete;
+   SpscQueue& operator=(const SpscQueue &other) = delete;
+   SpscQueue& operator=(SpscQueue &&other) = delete;
+
+public:
+   SpscQueue() {}
+   ~SpscQueue() {}
+
+   /**
+    * Indicates if queue is empty
+    *
+    * @return true  => empty
+    * @return false => not empty
+    */
+   bool isEmpty() const {
+      return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+   }
+
+   /**
+    * Indicates if queue is full
+    *
+    * @return true  => full
+    * @return false => not full
+    */
+   bool isFull() const {
+      return getCount() >= size;
+   }
+
+   /**
+    * Get number of items in queue
+    *
+    * @return Number of items (a snapshot if called by neither side)
+    */
+   unsigned getCount() const {
+      return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+   }
+
+   /**
+    * Add item to queue.
+    * Must only be called by the producer.
+    *
+    * @param item Item to add
+    *
+    * @return true  => Item added
+    * @return false => Queue full - item discarded
+    */
+   bool add(const T &item) {
+      unsigned t = tail.load(std::memory_order_relaxed);
+      if ((t - head.load(std::memory_order_acquire)) >= size) {
+         return false;
+      }
+      queue[t & MASK] = item;
+      tail.store(t+1, std::memory_order_release);
+      return true;
+   }
+
+   /**
+    * Get item from queue.
+    * Must only be called by the consumer.
+    *
+    * @param [out] item Item removed from queue
+    *
+    * @return true  => Item removed
+    * @return false => Queue empty - item unchanged
+    */
+   bool get(T &item) {
+      unsigned h = head.load(std::memory_order_relaxed);
+      if (h == tail.load(std::memory_order_acquire)) {
+         return false;
+      }
+      item = queue[h & MASK];
+      head.store(h+1, std::memory_order_release);
+      return true;
+   }
+};
+
+#endif /* SOURCES_SPSCQUEUE_H_ */
@@ -9,10 +9,15 @@
 
 #include "StepResponseDriver.h"
 #include "Channel.h"
+#include "Control.h"
 #include "SwitchPolling.h"
+#include "DmaConsole.h"
 
 using namespace USBDM;
 
+/// Captured temperatures (0.1 C)
+uint16_t StepResponseDriver::samples[MAX_SAMPLES];
+
 /**
  * Constructor
  *
@@ -22,18 +27,22 @@ StepResponseDriver::StepResponseDriver(Channel &channel) : channel(channel) {
 }
 
 /**
- * Run step sequence
+ * Run step sequence and identify model
+ *
+ * @param maxDrive Drive to apply during step
  *
- * @return true  Completed successfully
+ * @return true  Completed successfully (model identified)
  * @return false Failed
  */
 bool StepResponseDriver::run(unsigned maxDrive) {
 
-   static constexpr float TICK_INTERVAL    = 100_ms;
+   static constexpr float TICK_INTERVAL    = CAPTURE_INTERVAL;
+
+   static constexpr unsigned INITIAL_TIME  = round( 2.0/TICK_INTERVAL);
+   static constexpr unsigned DRIVING_TIME  = round(40.0/TICK_INTERVAL);
+   static constexpr unsigned COOLING_TIME  = round(15.0/TICK_INTERVAL);
 
-   static constexpr unsigned INITIAL_TIME  = round( 50.0/TICK_INTERVAL);
-   static constexpr unsigned DRIVING_TIME  = round(600.0/TICK_INTERVAL);
-   static constexpr unsigned COOLING_TIME  = round(100.0/TICK_INTERVAL);
+   static_assert((INITIAL_TIME+DRIVING_TIME+COOLING_TIME) <= MAX_SAMPLES, "Sample buffer too small");
 
    static constexpr unsigned REFRESH_TIME  = round(  1.0/TICK_INTERVAL);
    static constexpr unsigned REPORT_TIME   = round(  0.5/TICK_INTERVAL);
@@ -49,17 +58,26 @@ bool StepResponseDriver::run(unsigned maxDrive) {
    int drive = MIN_DRIVE;
    bool success = true;
 
-   console.write("Time,").write("Drive,").write("Temp: ").writeln(channel.getTipName());
+   sampleCount = 0;
+   stepStart   = 0;
+   stepEnd     = 0;
+   stepDrive   = maxDrive;
+
+   dmaConsole.write("Time,").write("Drive,").write("Temp: ").writeln(channel.getTipName());
 
    while ((state != Step_Complete) && success) {
 
       float currentTemp = channel.getCurrentTemperature();
 
+      if (sampleCount < MAX_SAMPLES) {
+         samples[sampleCount++] = (currentTemp>0)?round(10*currentTemp):0;
+      }
+
       if ((tickCount%REPORT_TIME) == 0) {
-         console.setWidth(4).setPadding(Padding_LeadingSpaces);
-         console.setFloatFormat(1, Padding_LeadingSpaces, 3);
-         console.write(elapsedTime*TICK_INTERVAL).write(", ").write(drive).write(", ").writeln(currentTemp);
-         console.resetFormat();
+         dmaConsole.setWidth(4).setPadding(Padding_LeadingSpaces);
+         dmaConsole.setFloatFormat(1, Padding_LeadingSpaces, 3);
+         dmaConsole.write(elapsedTime*TICK_INTERVAL).write(", ").write(drive).write(", ").writeln(currentTemp);
+         dmaConsole.resetFormat();
       }
       if ((tickCount%REFRESH_TIME) == 0) {
          display.displayChannels();
@@ -75,14 +93,16 @@ bool StepResponseDriver::run(unsigned maxDrive) {
                state     = Step_Driving;
                drive     = maxDrive;
                tickCount = 0;
+               stepStart = sampleCount;
             }
             break;
 
          case Step_Driving:
-            if (tickCount >= DRIVING_TIME) {
+            if ((tickCount >= DRIVING_TIME) || (currentTemp >= MAX_TEMPERATURE)) {
                state     = Step_Cooling;
                drive     = MIN_DRIVE;
                tickCount = 0;
+               stepEnd   = sampleCount;
             }
             break;
 
@@ -107,5 +127,145 @@ bool StepResponseDriver::run(unsigned maxDrive) {
    channel.setDutyCycle(0);
    channel.setState(ChannelState_off);
 
-   return success;
+   if (!success) {
+      return false;
+   }
+   if (!identify(samples, sampleCount, stepStart, stepEnd, stepDrive, model)) {
+      dmaConsole.writeln("Step response not consistent with FOPDT model");
+      return false;
+   }
+   PidGains gains = calculatePidGains(model);
+
+   dmaConsole.setFloatFormat(3, Padding_None);
+   dmaConsole.write("K=", model.gain, " C/%, Tau=", model.timeConstant, " s, Theta=", model.deadTime);
+   dmaConsole.writeln(" s, Ambient=", model.ambient, " C");
+   dmaConsole.write("Kp=", gains.kp, ", Ki=", gains.ki, ", Kd=", gains.kd, ", iLimit=", gains.iLimit);
+   dmaConsole.writeln();
+   dmaConsole.resetFormat();
+
+   return true;
+}
+
+/**
+ * Fit a FOPDT model to a step response.
+ *
+ * The model is written as dT/dt = (K.u(t-θ) - (T-Tambient))/τ which is linear
+ * in a=K/τ and b=1/τ. These are found by least squares for each possible dead time
+ * and the dead time with the smallest residual is used.
+ *
+ * @param[in]  samples    Temperatures (0.1 C) at CAPTURE_INTERVAL
+ * @param[in]  count      Number of samples
+ * @param[in]  stepStart  Index of first sample with drive applied
+ * @param[in]  stepEnd    Index of first sample after drive removed
+ * @param[in]  drive      Drive applied during step (%)
+ * @param[out] model      Model identified
+ *
+ * @return true  => Model identified
+ * @return false => Response not consistent with a FOPDT model
+ */
+bool StepResponseDriver::identify(
+      const uint16_t samples[], unsigned count,
+      unsigned stepStart, unsigned stepEnd, unsigned drive,
+      FopdtModel &model) {
+
+   // Derivative is estimated over +/- this number of samples to reduce the effect of quantisation
+   static constexpr unsigned DERIVATIVE_SPAN   = 5;
+
+   // Largest dead time considered (samples)
+   static constexpr unsigned MAX_DEAD_TIME     = 20;
+
+   // Fraction of variation in dT/dt that must be explained by the model
+   static constexpr float    MIN_FIT           = 0.9;
+
+   if ((drive == 0) || (stepStart <= DERIVATIVE_SPAN) || (stepEnd <= stepStart) ||
+       (count < (stepEnd+DERIVATIVE_SPAN+MAX_DEAD_TIME))) {
+      return false;
+   }
+
+   auto temperature = [&](unsigned index) {
+      return samples[index]/10.0f;
+   };
+   auto slope = [&](unsigned index) {
+      return (temperature(index+DERIVATIVE_SPAN)-temperature(index-DERIVATIVE_SPAN))/(2*DERIVATIVE_SPAN*CAPTURE_INTERVAL);
+   };
+
+   // Ambient is the temperature before the step (tip assumed to be at rest)
+   float ambient = 0;
+   for (unsigned index=0; index<stepStart; index++) {
+      ambient += temperature(index);
+   }
+   ambient /= stepStart;
+
+   const unsigned first = DERIVATIVE_SPAN;
+   const unsigned last  = count-DERIVATIVE_SPAN;
+
+   float bestResidual = 0;
+   bool  found        = false;
+
+   for (unsigned deadTime=0; deadTime<=MAX_DEAD_TIME; deadTime++) {
+
+      // Normal equations for dT/dt = a.u(t-θ) - b.(T-Tambient)
+      float suu = 0, stt = 0, sut = 0, suy = 0, sty = 0, syy = 0;
+      for (unsigned index=first; index<last; index++) {
+         float u = ((index >= (stepStart+deadTime)) && (index < (stepEnd+deadTime)))?drive:0;
+         float t = temperature(index)-ambient;
+         float y = slope(index);
+         suu += u*u;
+         stt += t*t;
+         sut += u*t;
+         suy += u*y;
+         sty += t*y;
+         syy += y*y;
+      }
+      float determinant = suu*stt-sut*sut;
+      if ((determinant <= 0) || (syy <= 0)) {
+         continue;
+      }
+      float a =  (suy*stt-sty*sut)/determinant;
+      float b = -(sty*suu-suy*sut)/determinant;
+
+      // Residual sum of squares
+      float residual = syy - a*suy + b*sty;
+
+      if (found && (residual >= bestResidual)) {
+         continue;
+      }
+      if ((a <= 0) || (b <= 0) || (residual > (1-MIN_FIT)*syy)) {
+         continue;
+      }
+      found              = true;
+      bestResidual       = residual;
+      model.gain         = a/b;
+      model.timeConstant = 1/b;
+      model.deadTime     = deadTime*CAPTURE_INTERVAL;
+      model.ambient      = ambient;
+   }
+   return found;
+}
+
+/**
+ * Calculate PID gains from model using SIMC rules (Skogestad)\n
+ *    Kp = τ/(K.(τc+θ)), Ti = min(τ, 4(τc+θ)), Ki = Kp/Ti, Kd = 0
+ *
+ * @param model Model to use
+ *
+ * @return PID gains
+ */
+PidGains StepResponseDriver::calculatePidGains(const FopdtModel &model) {
+
+   // Smallest closed-loop time constant used (s) - allows for measurement lag not in model
+   static constexpr float MIN_CLOSED_LOOP_TIME = 0.3;
+
+   const float closedLoopTime = std::max(model.deadTime, MIN_CLOSED_LOOP_TIME);
+
+   PidGains gains;
+
+   gains.kp = model.timeConstant/(model.gain*(closedLoopTime+model.deadTime));
+   gains.ki = gains.kp/std::min(model.timeConstant, 4*(closedLoopTime+model.deadTime));
+   gains.kd = 0;
+
+   // Integral term must be able to supply drive to hold maximum temperature
+   gains.iLimit = calculateIntegralLimit(model.gain, Control::MAX_TEMP, model.ambient);
+
+   return gains;
 }
@@ -8,10 +8,43 @@
 #ifndef SOURCES_STEPRESPONSEDRIVER_H_
 #define SOURCES_STEPRESPONSEDRIVER_H_
 
+#include <stdint.h>
+#include "TipSettings.h"
+
 class Channel;
 
+/**
+ * First-order plus dead-time (FOPDT) model of the tip temperature response to drive\n
+ *    T(s)/U(s) = K.exp(-θs)/(τs+1)
+ */
+struct FopdtModel {
+   float gain;          ///< Steady-state gain K (C per % drive)
+   float timeConstant;  ///< Time constant τ (s)
+   float deadTime;      ///< Dead time θ (s)
+   float ambient;       ///< Temperature before step (C)
+};
+
+/**
+ * Drives a tip with a step in power and identifies a FOPDT model from the response.
+ *
+ * The temperature is captured in RAM while the drive is applied until the tip
+ * reaches MAX_TEMPERATURE (or a time limit) and while it then cools.
+ * The model is fitted to the whole capture so the tip need not reach steady-state.
+ * PID gains are then calculated from the model by the SIMC rules.
+ */
 class StepResponseDriver {
 
+public:
+   /// Interval between captured samples (s) - not the measurement SAMPLE_INTERVAL
+   static constexpr float CAPTURE_INTERVAL = 0.1;
+
+   /// Maximum number of samples captured (60 s)
+   static constexpr unsigned MAX_SAMPLES = 600;
+
+   /// Drive is removed when this temperature is reached (C)
+   static constexpr float MAX_TEMPERATURE = 300;
+
+private:
    StepResponseDriver(const StepResponseDriver &other) = delete;
    StepResponseDriver(StepResponseDriver &&other) = delete;
    StepResponseDriver& operator=(const StepResponseDriver &other) = delete;
@@ -19,26 +52,84 @@ class StepResponseDriver {
 
    Channel &channel;
 
+   /// Captured temperatures (0.1 C) - static as too large for the stack
+   static uint16_t samples[MAX_SAMPLES];
+
+   /// Number of samples captured
+   unsigned sampleCount = 0;
+
+   /// Index of first sample with drive applied
+   unsigned stepStart   = 0;
+
+   /// Index of first sample after drive removed
+   unsigned stepEnd     = 0;
+
+   /// Drive applied during step (%)
+   unsigned stepDrive   = 0;
+
+   /// Model identified by last run
+   FopdtModel model     = {0, 0, 0, 0};
+
 public:
    /**
     * Constructor
     *
     * @param channel  Associated channel
     */
-   StepResponseDriver(Channel &ch);
+   StepResponseDriver(Channel &channel);
 
    ~StepResponseDriver() {}
 
    /**
-    * Run step sequence
+    * Run step sequence and identify model
     *
     * @param maxDrive Drive to apply during step
     *
-    * @return true  Completed successfully
+    * @return true  Completed successfully (model identified)
     * @return false Failed
     */
    bool run(unsigned maxDrive);
 
+   /**
+    * Get model identified by last run()
+    *
+    * @return Model
+    */
+   const FopdtModel &getModel() const {
+      return model;
+   }
+
+   /**
+    * Fit a FOPDT model to a step response.
+    *
+    * The model is written as dT/dt = (K.u(t-θ) - (T-Tambient))/τ which is linear
+    * in a=K/τ and b=1/τ. These are found by least squares for each possible dead time
+    * and the dead time with the smallest residual is used.
+    *
+    * @param[in]  samples    Temperatures (0.1 C) at CAPTURE_INTERVAL
+    * @param[in]  count      Number of samples
+    * @param[in]  stepStart  Index of first sample with drive applied
+    * @param[in]  stepEnd    Index of first sample after drive removed
+    * @param[in]  drive      Drive applied during step (%)
+    * @param[out] model      Model identified
+    *
+    * @return true  => Model identified
+    * @return false => Response not consistent with a FOPDT model
+    */
+   static bool identify(
+         const uint16_t samples[], unsigned count,
+         unsigned stepStart, unsigned stepEnd, unsigned drive,
+         FopdtModel &model);
+
+   /**
+    * Calculate PID gains from model using SIMC rules (Skogestad)\n
+    *    Kp = τ/(K.(τc+θ)), Ti = min(τ, 4(τc+θ)), Ki = Kp/Ti, Kd = 0
+    *
+    * @param model Model to use
+    *
+    * @return PID gains
+    */
+   static PidGains calculatePidGains(const FopdtModel &model);
 };
 
 #endif /* SOURCES_STEPRESPONSEDRIVER_H_ */
@@ -9,12 +9,42 @@
 #include "Channels.h"
 #include "queue"
 #include "Control.h"
+#include "lptmr.h"
+#include "smc.h"
 
 using namespace USBDM;
 
-/// How often the switches are polled
+/// Low power timer used to poll the buttons while debouncing
+using DebounceTimer = Lptmr0;
+
+/// How often the switches are polled (while any button is pressed or bouncing)
 constexpr Seconds POLL_INTERVAL        = 10_ms;                        // Polled every 10 ms
 
+/// How often the idle timers (set-back, display off) are updated
+constexpr Seconds IDLE_TIMER_INTERVAL  = 1_s;
+
+/// Minimum time between rotation events (in half-cycles).
+/// Rotations within this time are combined into a single event.
+/// This matches the display refresh rate limit (see Control::MIN_REFRESH_INTERVAL).
+constexpr unsigned ROTATION_INTERVAL   = round(40_ms/SAMPLE_INTERVAL);
+
+/// Half-cycles in one second (for rotation rate)
+constexpr unsigned HALF_CYCLES_PER_SECOND = round(1_s/SAMPLE_INTERVAL);
+
+/**
+ * Rotary encoder acceleration.
+ * Change is multiplied when rotating at or above the given rate.
+ * Entries are in decreasing order of rate.
+ */
+static constexpr struct {
+   unsigned rate;        ///< Detents per second
+   int16_t  multiplier;  ///< Multiplier to apply to change
+} accelerationTable[] = {
+      { 60, 10 },
+      { 30,  5 },
+      { 15,  2 },
+};
+
 /// Number of consistent samples to confirm debouncing
 constexpr unsigned DEBOUNCE_COUNT      = round(40_ms/POLL_INTERVAL);   // Number if polls in 40 ms
 
@@ -65,15 +95,6 @@ const char * getEventName(const EventType eventType) {
  */
 EventType SwitchPolling::pollSwitches() {
 
-   // How long the buttons have been unchanged
-   static unsigned stableButtonCount = 0;
-
-   // Result from when the buttons were last polled
-   static unsigned lastButtonPoll    = 0;
-
-   // Button held event but pending until released
-   static EventType pendingEvent = ev_None;
-
    // Poll buttons
    unsigned  currentButtonValue = Buttons::read();
 
@@ -186,14 +207,82 @@ void SwitchPolling::pollSetbacks() {
       else if (!toolBusy[tool]) {
 
          // Tool in holder - increment idle time
-         channel.incrementIdleTime(POLL_INTERVAL/1_ms);
+         channel.incrementIdleTime(IDLE_TIMER_INTERVAL/1_ms);
+      }
+   }
+   control.updateDisplayInUse(IDLE_TIMER_INTERVAL/1_ms);
+}
+
+/**
+ * Start polling the buttons.
+ * Called from the button pin-change interrupt.
+ */
+void SwitchPolling::startDebounceTimer() {
+
+   // Pin-change interrupts are not needed while polling
+   Buttons::setInput(PinPull_Up, PinAction_None, PinFilter_Passive);
+
+   DebounceTimer::configureTimeCountingMode(LptmrResetOn_Compare, LptmrInterrupt_Enabled, LptmrClockSel_Mcgirclk);
+   DebounceTimer::setPeriod(POLL_INTERVAL);
+   DebounceTimer::enableNvicInterrupts(NvicPriority_Normal);
+}
+
+/**
+ * Stop polling the buttons and wait for a pin-change interrupt.
+ * Called from the debounce timer interrupt once the buttons are released and stable.
+ */
+void SwitchPolling::stopDebounceTimer() {
+
+   DebounceTimer::disable();
+
+   Buttons::setInput(PinPull_Up, PinAction_IrqEither, PinFilter_Passive);
+
+   if (Buttons::read() != 0) {
+      // Pressed before pin-change interrupts were re-enabled
+      startDebounceTimer();
+   }
+}
+
+/**
+ * Start the idle timers if stopped.
+ * Called on any front panel event.
+ */
+void SwitchPolling::startIdleTimer() {
+   CriticalSection cs;
+
+   if (!idleTimerRunning) {
+      idleTimerRunning = true;
+      PollingTimerChannel::configure(IDLE_TIMER_INTERVAL, PitChannelIrq_Enabled);
+   }
+}
+
+/**
+ * Scale rotary encoder change by rotation rate
+ *
+ * @param change  Detents moved
+ * @param elapsed Time taken (in half-cycles)
+ *
+ * @return Scaled change
+ */
+int16_t SwitchPolling::accelerate(int16_t change, unsigned elapsed) {
+
+   // Slow rotation - prevents overflow
+   if (elapsed > HALF_CYCLES_PER_SECOND) {
+      return change;
+   }
+   unsigned detents = abs(change);
+   for (const auto &entry:accelerationTable) {
+      // detents/elapsed >= rate/HALF_CYCLES_PER_SECOND
+      if ((detents*HALF_CYCLES_PER_SECOND) >= (entry.rate*elapsed)) {
+         return change*entry.multiplier;
       }
    }
-   control.updateDisplayInUse(POLL_INTERVAL/1_ms);
+   return change;
 }
 
 /**
- * Get last input event
+ * Get last input event.
+ * Rotary encoder changes are combined into at most one event per ROTATION_INTERVAL.
  *
  * @return Event or ev_None if none.
  */
@@ -204,10 +293,11 @@ Event SwitchPolling::getEvent() {
 
    if (t.type == ev_None) {
       // Check rotary encoder
-      static int16_t lastQuadPosition = 0;
-      int16_t currentQuadPosition = encoder.getPosition();
-      t.change = currentQuadPosition - lastQuadPosition;
-      if (t.change != 0) {
+      int16_t  currentQuadPosition = encoder.getPosition();
+      int16_t  change              = currentQuadPosition - lastQuadPosition;
+      unsigned now                 = control.getHalfCycleCount();
+      unsigned elapsed             = now - lastRotationTime;
+      if ((change != 0) && (elapsed >= ROTATION_INTERVAL)) {
 
 //         // Restart timers on use of rotary encoder
 //         channels.restartIdleTimers();
@@ -219,12 +309,35 @@ Event SwitchPolling::getEvent() {
             quadState = QuadState_Pressed_Rotate;
             t.type = ev_QuadRotatePressed;
          }
-         lastQuadPosition = currentQuadPosition;
+         t.change            = change;
+         t.acceleratedChange = accelerate(change, elapsed);
+         lastQuadPosition    = currentQuadPosition;
+         lastRotationTime    = now;
       }
    }
+   if (t.type != ev_None) {
+      // Idle timers may have stopped while quiescent
+      startIdleTimer();
+   }
    return t;
 }
 
+/**
+ * Wait for input event.
+ * The processor waits for an interrupt while there are no events.
+ *
+ * @return Event
+ */
+Event SwitchPolling::waitForEvent() {
+   for(;;) {
+      Event event = getEvent();
+      if (event.type != ev_None) {
+         return event;
+      }
+      Smc::enterWaitMode();
+   }
+}
+
 /**
  * Initialise the switch polling
  */
@@ -234,22 +347,50 @@ void SwitchPolling::initialise() {
 
    quadState = QuadState_Normal;
 
-   Buttons::setInput(PinPull_Up, PinAction_None, PinFilter_Passive);
-
 //   Setbacks::setInput(PinPull_Up, PinAction_None, PinFilter_Passive);
 
    /**
-    * Call-back handling switch and set-back polling
+    * Call-back handling button pin-change interrupt.
+    * Buttons are polled until released and stable.
+    */
+   static const auto pinCallBack = [](uint32_t) {
+      This->startDebounceTimer();
+   };
+
+   /**
+    * Call-back handling button polling
     */
-   static const auto callBack = []() {
+   static const auto debounceCallBack = []() {
       This->eventQueue.add(This->pollSwitches());
+      if (This->isButtonIdle()) {
+         This->stopDebounceTimer();
+      }
+   };
+
+   DebounceTimer::setCallback(debounceCallBack);
+
+   Buttons::setPinCallback(pinCallBack);
+   Buttons::enableNvicInterrupts(NvicPriority_Normal);
+
+   // Enables pin-change interrupts (or starts polling if a button is already pressed)
+   stopDebounceTimer();
+
+   /**
+    * Call-back handling set-back and display idle timers.
+    * The timer is stopped when there is nothing to time i.e. both channels off and display off.
+    */
+   static const auto idleCallBack = []() {
       This->pollSetbacks();
+      if (control.isQuiescent()) {
+         PollingTimerChannel::disable();
+         This->idleTimerRunning = false;
+      }
    };
 
    PollingTimerChannel::configureIfNeeded(PitDebugMode_Stop);
-   PollingTimerChannel::configure(POLL_INTERVAL, PitChannelIrq_Enabled);
-   PollingTimerChannel::setCallback(callBack);
+   PollingTimerChannel::setCallback(idleCallBack);
    PollingTimerChannel::enableNvicInterrupts(NvicPriority_Normal);
+   startIdleTimer();
 }
 
 SwitchPolling *SwitchPolling::This = nullptr;
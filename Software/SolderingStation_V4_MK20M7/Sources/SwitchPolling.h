@@ -42,12 +42,17 @@ class Event {
 
 public:
    EventType   type;
+
+   /// Rotary encoder detents (rotation events)
    int16_t     change;
 
-   Event() : type(ev_None), change(0) {
+   /// Rotary encoder change scaled up at high rotation rates (rotation events)
+   int16_t     acceleratedChange;
+
+   Event() : type(ev_None), change(0), acceleratedChange(0) {
    }
 
-   Event(EventType ev_, int16_t change) : type(ev_), change(change) {
+   Event(EventType ev_, int16_t change) : type(ev_), change(change), acceleratedChange(change) {
    }
 
    /**
@@ -90,7 +95,12 @@ inline const char *getEventName(const Event event) {
 }
 
 /**
- * Timer driven class to represent the front panel switches.
+ * Interrupt driven class to represent the front panel switches.
+ *
+ * The buttons wake the processor with a pin-change interrupt.
+ * They are then polled by a low power timer only until released and stable.
+ * The set-back and display idle timers use a slow PIT tick that stops when the
+ * station is quiescent (see Control::isQuiescent()).
  */
 class SwitchPolling {
 
@@ -99,11 +109,38 @@ private:
    EventType pollSwitches();
    void      pollSetbacks();
 
+   /**
+    * Start polling the buttons.
+    * Called from the button pin-change interrupt.
+    */
+   void startDebounceTimer();
+
+   /**
+    * Stop polling the buttons and wait for a pin-change interrupt.
+    * Called from the debounce timer interrupt once the buttons are released and stable.
+    */
+   void stopDebounceTimer();
+
+   /**
+    * Start the idle timers if stopped.
+    * Called on any front panel event.
+    */
+   void startIdleTimer();
+
+   /**
+    * Indicates the buttons are released and the release has been processed
+    *
+    * @return true if polling may stop
+    */
+   bool isButtonIdle() const {
+      return (lastButtonPoll == 0) && (stableButtonCount > 0);
+   }
+
    /// Quadrature decode for rotary encoder
    QuadDecoder encoder;
 
-   /// Queue of pending events
-   EventQueue<EventType, ev_None, 10> eventQueue;
+   /// Queue of pending events (added by debounce timer interrupt, removed by getEvent())
+   EventQueue<EventType, ev_None, 16> eventQueue;
 
    /// Static handle on class for timer call-back
    static SwitchPolling *This;
@@ -116,9 +153,50 @@ private:
 
    QuadState quadState = QuadState_Normal;
 
+   /// How long the buttons have been unchanged (in polls)
+   unsigned stableButtonCount = 0;
+
+   /// Result from when the buttons were last polled
+   unsigned lastButtonPoll    = 0;
+
+   /// Button held event but pending until released
+   EventType pendingEvent     = ev_None;
+
+   /// Indicates the idle timers are running
+   volatile bool idleTimerRunning = false;
+
+   /// Encoder position when last rotation event was reported
+   int16_t  lastQuadPosition = 0;
+
+   /// Time of last rotation event (in half-cycles, see Control::getHalfCycleCount())
+   unsigned lastRotationTime = 0;
+
+   /**
+    * Scale rotary encoder change by rotation rate
+    *
+    * @param change  Detents moved
+    * @param elapsed Time taken (in half-cycles)
+    *
+    * @return Scaled change
+    */
+   static int16_t accelerate(int16_t change, unsigned elapsed);
+
 public:
+   /**
+    * Get last input event
+    *
+    * @return Event or ev_None if none.
+    */
    Event getEvent();
 
+   /**
+    * Wait for input event.
+    * The processor waits for an interrupt while there are no events.
+    *
+    * @return Event
+    */
+   Event waitForEvent();
+
    SwitchPolling() {
       usbdm_assert(This == nullptr, "SwitchPolling instantiated more than once");
       This = this;
@@ -12,7 +12,7 @@
 
 #include "Measurement.h"
 #include "Averaging.h"
-#include "PidController.h"
+#include "SelectableController.h"
 
 /**
  * Class representing information for a T12 soldering iron
@@ -27,7 +27,7 @@ private:
    ThermocoupleAveraging   thermocouple;
 
    /// Thermistor in handle
-   ThermistorMF58Average coldJunctionThermistor;
+   ThermistorMF58Average<> coldJunctionThermistor;
 
    /// Measurement to use for thermocouple on sub-channel A
    static constexpr MuxSelect Measurement1_Thermocouple = 
@@ -35,10 +35,10 @@ private:
 
    /// Measurement to use for thermistor on sub_channel B
    static constexpr MuxSelect Measurement2_ColdRef      = 
-         muxSelectAddSubChannel(ThermistorMF58Average::MEASUREMENT, SubChannelNum_B);
+         muxSelectAddSubChannel(ThermistorMF58Average<>::MEASUREMENT, SubChannelNum_B);
 
-   /// Loop controller
-   PidController controller{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+   /// Loop controller (selected by tip settings)
+   SelectableController controller{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY, nominalMaxPower};
 
 public:
    T12(Channel &ch) : Measurement(ch, 8.5, 24) {}
@@ -54,6 +54,18 @@ public:
       controller.enable(enable);
    }
 
+   /**
+    * Select relay autotuning in place of the controller for the tip.
+    * Autotuning starts when the control loop is next enabled.
+    *
+    * @param[in] enable True to select autotuning
+    *
+    * @return Autotuner
+    */
+   virtual RelayAutotuneController *selectAutotune(bool enable) override {
+      return controller.selectAutotune(enable);
+   }
+
    /**
     * Run end of controller cycle update:
     *   - Temperature
@@ -61,10 +73,12 @@ public:
     *   - Controller (PID etc)
     *
     * @param targetTemperature Target temperature
+    * @param interval          Time since last update
     */
-   virtual void updateController(float targetTemperature) override {
+   virtual void updateController(float targetTemperature, USBDM::Seconds interval) override {
 
       // Run PID
+      controller.setInterval(interval);
       float dc = controller.newSample(targetTemperature, getTemperature());
       controller.setDutyCycle(dc);
    }
@@ -119,7 +133,7 @@ public:
       float thermocoupleVoltage_mV  = 1000*thermocouple.getThermocoupleVoltage();
       float coldJunctionTemp        = coldJunctionThermistor.getTemperature();
 
-      console.writeln(calibrationIndex, " : TC = ", thermocoupleVoltage_mV, "mV, Cold = ", coldJunctionTemp);
+      dmaConsole.writeln(calibrationIndex, " : TC = ", thermocoupleVoltage_mV, "mV, Cold = ", coldJunctionTemp);
 
       if ((thermocoupleVoltage_mV < 4) || (thermocoupleVoltage_mV > 12)) {
          return false;
@@ -179,6 +193,9 @@ public:
       settings->setCalibrationPoint(CalibrationIndex_400,  363.0,   7.7); // T = 363.900, M = 7.713
 
       settings->setInitialPidControlValues(5.0,0.2,0.0,20.0);
+
+      // Thermal model                C(J/K)  G(W/K)
+      settings->setInitialModelValues(2.0,    0.025);
    }
 
    /**
@@ -188,21 +205,22 @@ public:
     */
    virtual void setCalibrationValues(const TipSettings *tipsettings) override {
       thermocouple.setCalibrationValues(tipsettings);
+      coldJunctionThermistor.setCalibrationValues();
       controller.setControlParameters(tipsettings);
    }
 
    /**
     * Get the sequence of ADC measurements to do
     *
-    * @return Sequence array terminated by MuxSelect_Complete sentinel
+    * @param channelMask   Mask indicating which channel
+    * @param tipPresent    Indicates tip is present in tool
+    *
+    * @return Schedule ordered for measurement (constructed at compile time)
     */
-   virtual MuxSelect const *getMeasurementSequence() const override {
-      static const MuxSelect sequence[] = {
-            Measurement1_Thermocouple,
-            Measurement2_ColdRef,
-            MuxSelect_Complete,
-      };
-      return tipPresent?sequence:sequence+1;
+   static constexpr MeasurementSchedule getMeasurementSchedule(uint8_t channelMask, bool tipPresent) {
+      return tipPresent?
+            MeasurementSchedule(channelMask, Measurement1_Thermocouple, Measurement2_ColdRef):
+            MeasurementSchedule(channelMask, Measurement2_ColdRef);
    };
 
    /**
@@ -249,19 +267,28 @@ public:
       using namespace USBDM;
 
       if (doHeading) {
-         console.write("Time,");
+         dmaConsole.write("Time,");
          controller.reportHeading(ch);
       }
 
       // Time-stamp
-      console.setFloatFormat(2, Padding_LeadingSpaces, 3);
-      console.write(controller.getElapsedTime());
+      dmaConsole.setFloatFormat(2, Padding_LeadingSpaces, 3);
+      dmaConsole.write(controller.getElapsedTime());
       controller.report();
 
-      console.writeln(",", getInstantTemperature());
-      console.resetFormat();
+      dmaConsole.writeln(",", getInstantTemperature());
+      dmaConsole.resetFormat();
    }
 
+   /**
+    * Fill in controller and tool values of telemetry frame
+    *
+    * @param frame Frame to update
+    */
+   virtual void getTelemetry(TelemetryFrame &frame) const override {
+      controller.getTelemetry(frame);
+      frame.coldJunction = toTelemetryValue(coldJunctionThermistor.getTemperature(), TELEMETRY_COLD_JUNCTION_SCALE);
+   }
 };
 
 #endif /* T12_H_ */
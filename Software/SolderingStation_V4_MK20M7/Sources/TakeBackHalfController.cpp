@@ -10,6 +10,7 @@
 #include "TakeBackHalfController.h"
 #include "hardware.h"
 #include "Channel.h"
+#include "DmaConsole.h"
 
 using namespace USBDM;
 
@@ -19,10 +20,25 @@ using namespace USBDM;
  * @param settings Parameter to use
  */
 void TakeBackHalfController::setControlParameters(const TipSettings *ts) {
-   ts->getKd();
-   fGamma = ts->getKp(); // 1.0;
-   fBeta1 = ts->getKd()/fInterval; // 0.2;
-   fBeta2 = 2*ts->getKd()/fInterval; // 0.4;
+   // Not scheduled - uses the middle calibration band
+   fGamma = ts->getKp(CalibrationIndex_325); // 1.0;
+   fBeta1 = ts->getKd(CalibrationIndex_325)/fInterval; // 0.2;
+   fBeta2 = 2*ts->getKd(CalibrationIndex_325)/fInterval; // 0.4;
+}
+
+/**
+ * Set interval between samples.
+ * Rescales the differential gains.
+ *
+ * @param interval Interval for sampling
+ */
+void TakeBackHalfController::setInterval(Seconds interval) {
+   if (interval == fInterval) {
+      return;
+   }
+   fBeta1    = fBeta1 * fInterval / interval;
+   fBeta2    = fBeta2 * fInterval / interval;
+   fInterval = interval;
 }
 
 /**
@@ -116,8 +132,8 @@ float TakeBackHalfController::newSample(float targetTemperature, float actualTem
  */
 void TakeBackHalfController::reportHeading(Channel &ch) const {
 
-   console.setFloatFormat(3, Padding_LeadingSpaces, 3);
-   console.writeln("Target, \"Drive (", ch.getTipName(),")\nGamma = ", fGamma, "\nBeta1 = ", fBeta1, "\nBeta2 = ", fBeta2, "\", Inst. Temp, Error, differential");
+   dmaConsole.setFloatFormat(3, Padding_LeadingSpaces, 3);
+   dmaConsole.writeln("Target, \"Drive (", ch.getTipName(),")\nGamma = ", fGamma, "\nBeta1 = ", fBeta1, "\nBeta2 = ", fBeta2, "\", Inst. Temp, Error, differential");
 }
 
 /**
@@ -125,11 +141,11 @@ void TakeBackHalfController::reportHeading(Channel &ch) const {
  */
 void TakeBackHalfController::report() const {
 
-   console.setFloatFormat(1, Padding_LeadingSpaces, 4);
-   console.write(",", fCurrentTarget); // Set temperature
-   console.write(",", fCurrentOutput); // Drive %
-   console.write(",", fCurrentInput);  // Average temperature
-   console.write(",", fCurrentError);  // Error
-   console.write(",", fDifferential);  // Differential
+   dmaConsole.setFloatFormat(1, Padding_LeadingSpaces, 4);
+   dmaConsole.write(",", fCurrentTarget); // Set temperature
+   dmaConsole.write(",", fCurrentOutput); // Drive %
+   dmaConsole.write(",", fCurrentInput);  // Average temperature
+   dmaConsole.write(",", fCurrentError);  // Error
+   dmaConsole.write(",", fDifferential);  // Differential
 
 }
@@ -58,6 +58,14 @@ public:
     */
    virtual void setControlParameters(const TipSettings *settings) override ;
 
+   /**
+    * Set interval between samples.
+    * Rescales the differential gains.
+    *
+    * @param interval Interval for sampling
+    */
+   virtual void setInterval(USBDM::Seconds interval) override ;
+
    /**
     * Main calculation
     *
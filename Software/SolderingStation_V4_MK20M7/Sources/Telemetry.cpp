@@ -0,0 +1,47 @@
+/*
+ * Telemetry.cpp
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#include "Telemetry.h"
+#include "Channel.h"
+#include "UartDmaTransmitter.h"
+
+/**
+ * Complete frame by adding sync bytes, sequence number and CRC
+ *
+ * @param frame Frame to complete
+ */
+void Telemetry::seal(TelemetryFrame &frame) {
+
+   frame.sync1    = TELEMETRY_SYNC1;
+   frame.sync2    = TELEMETRY_SYNC2;
+   frame.sequence = fSequence++;   // Incremented even if frame is dropped
+
+   const uint8_t *data = reinterpret_cast<const uint8_t *>(&frame);
+   frame.crc = telemetryCrc(data+TELEMETRY_CRC_START, TELEMETRY_CRC_SIZE);
+}
+
+/**
+ * Log state of a channel after a controller update
+ *
+ * @param channelNumber Channel number (1 or 2)
+ * @param channel       Channel to log
+ * @param timestamp     Time of update (half-cycles)
+ */
+void Telemetry::logChannel(unsigned channelNumber, const Channel &channel, uint32_t timestamp) {
+
+   TelemetryFrame frame = {};
+
+   frame.timestamp = timestamp;
+   frame.channel   = channelNumber;
+   frame.state     = channel.getState();
+
+   // Controller values and cold junction (if applicable)
+   frame.coldJunction = TELEMETRY_NO_VALUE;
+   channel.getTelemetry(frame);
+
+   seal(frame);
+   consoleTransmitter.write(reinterpret_cast<const uint8_t *>(&frame), sizeof(frame));
+}
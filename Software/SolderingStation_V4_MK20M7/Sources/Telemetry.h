@@ -0,0 +1,59 @@
+/*
+ * Telemetry.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef SOURCES_TELEMETRY_H_
+#define SOURCES_TELEMETRY_H_
+
+#include <stdint.h>
+#include "TelemetryFrame.h"
+
+class Channel;
+
+/**
+ * How PID behaviour is logged over the console UART
+ */
+enum TelemetryMode {
+   TelemetryMode_Text,     ///< CSV text for channel 1 every PID_LOG_INTERVAL (Control::reportPid())
+   TelemetryMode_Binary,   ///< TelemetryFrame for every controller update of a running channel (UART DMA)
+};
+
+/// Logging used (selected at build time)
+constexpr TelemetryMode TELEMETRY_MODE = TelemetryMode_Binary;
+//constexpr TelemetryMode TELEMETRY_MODE = TelemetryMode_Text;
+
+/**
+ * Logs controller updates as binary frames.
+ *
+ * Frames are built in the ADC interrupt directly after each controller update
+ * and queued on consoleTransmitter. No formatting is done on the target.
+ * See Tools/TelemetryDecoder.cpp in the simulation project to convert a capture to CSV.
+ */
+class Telemetry {
+
+private:
+   /// Sequence number of next frame
+   uint16_t fSequence = 0;
+
+public:
+   /**
+    * Complete frame by adding sync bytes, sequence number and CRC
+    *
+    * @param frame Frame to complete
+    */
+   void seal(TelemetryFrame &frame);
+
+   /**
+    * Log state of a channel after a controller update
+    *
+    * @param channelNumber Channel number (1 or 2)
+    * @param channel       Channel to log
+    * @param timestamp     Time of update (half-cycles)
+    */
+   void logChannel(unsigned channelNumber, const Channel &channel, uint32_t timestamp);
+};
+
+#endif /* SOURCES_TELEMETRY_H_ */
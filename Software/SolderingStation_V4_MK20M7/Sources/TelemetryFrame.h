@@ -0,0 +1,113 @@
+/*
+ * TelemetryFrame.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ *
+ * Binary telemetry frame shared by the firmware and the host decoder.
+ * This file must not depend on the target hardware.
+ */
+
+#ifndef SOURCES_TELEMETRYFRAME_H_
+#define SOURCES_TELEMETRYFRAME_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+/// First byte of frame (not ASCII so frames can be found amongst console text)
+static constexpr uint8_t TELEMETRY_SYNC1 = 0xA5;
+
+/// Second byte of frame
+static constexpr uint8_t TELEMETRY_SYNC2 = 0x5A;
+
+/// Units of timestamp (us) i.e. one half-cycle of rectified mains
+static constexpr unsigned TELEMETRY_TIMESTAMP_US = 10000;
+
+/// Scale of temperature values (units per Celsius)
+static constexpr int TELEMETRY_TEMPERATURE_SCALE = 10;
+
+/// Scale of controller terms and output (units per percent)
+static constexpr int TELEMETRY_PERCENT_SCALE = 10;
+
+/// Scale of cold junction temperature (units per Celsius)
+static constexpr int TELEMETRY_COLD_JUNCTION_SCALE = 100;
+
+/// Value used for fields not applicable to the tool e.g. cold junction of a Weller tip
+static constexpr int16_t TELEMETRY_NO_VALUE = INT16_MIN;
+
+/**
+ * Binary telemetry frame for one controller update of a channel.
+ * Multi-byte values are little-endian.
+ */
+struct __attribute__((__packed__)) TelemetryFrame {
+   uint8_t  sync1;          ///< TELEMETRY_SYNC1
+   uint8_t  sync2;          ///< TELEMETRY_SYNC2
+   uint16_t sequence;       ///< Incremented for each frame (gaps indicate dropped frames)
+   uint32_t timestamp;      ///< Half-cycle of update (TELEMETRY_TIMESTAMP_US)
+   uint8_t  channel;        ///< Channel number (1 or 2)
+   uint8_t  state;          ///< Channel state (ChannelState)
+   int16_t  target;         ///< Target temperature (TELEMETRY_TEMPERATURE_SCALE)
+   int16_t  measured;       ///< Measured (averaged) temperature (TELEMETRY_TEMPERATURE_SCALE)
+   int16_t  proportional;   ///< Proportional term (TELEMETRY_PERCENT_SCALE)
+   int16_t  integral;       ///< Integral term (TELEMETRY_PERCENT_SCALE)
+   int16_t  differential;   ///< Differential term (TELEMETRY_PERCENT_SCALE)
+   int16_t  duty;           ///< Controller output (TELEMETRY_PERCENT_SCALE)
+   int16_t  coldJunction;   ///< Cold junction temperature (TELEMETRY_COLD_JUNCTION_SCALE) or TELEMETRY_NO_VALUE
+   uint16_t crc;            ///< telemetryCrc() of the bytes from sequence to coldJunction
+};
+
+static_assert(sizeof(TelemetryFrame) == 26, "TelemetryFrame layout changed");
+
+/// Offset of first byte covered by CRC
+static constexpr unsigned TELEMETRY_CRC_START = offsetof(TelemetryFrame, sequence);
+
+/// Number of bytes covered by CRC
+static constexpr unsigned TELEMETRY_CRC_SIZE  = offsetof(TelemetryFrame, crc)-TELEMETRY_CRC_START;
+
+/**
+ * Convert value to fixed-point field with saturation
+ *
+ * @param value   Value to convert
+ * @param scale   Units per unit of value
+ *
+ * @return Rounded and saturated value (TELEMETRY_NO_VALUE if value is not a number)
+ */
+static inline int16_t toTelemetryValue(float value, int scale) {
+   float scaled = value*scale;
+   if (isnan(scaled)) {
+      return TELEMETRY_NO_VALUE;
+   }
+   if (scaled >= INT16_MAX) {
+      return INT16_MAX;
+   }
+   if (scaled <= INT16_MIN+1) {
+      return INT16_MIN+1;
+   }
+   return static_cast<int16_t>((scaled<0)?(scaled-0.5f):(scaled+0.5f));
+}
+
+/**
+ * Calculate CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF).
+ * This uses a 16 entry table i.e. 2 look-ups per byte.
+ *
+ * @param data    Data to check
+ * @param size    Number of bytes
+ *
+ * @return CRC value
+ */
+static inline uint16_t telemetryCrc(const uint8_t data[], unsigned size) {
+   static constexpr uint16_t table[16] = {
+         0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+         0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+   };
+   uint16_t crc = 0xFFFF;
+   while (size-- > 0) {
+      uint8_t byte = *data++;
+      crc = (crc<<4)^table[(crc>>12)^(byte>>4)];
+      crc = (crc<<4)^table[(crc>>12)^(byte&0x0F)];
+   }
+   return crc;
+}
+
+#endif /* SOURCES_TELEMETRYFRAME_H_ */
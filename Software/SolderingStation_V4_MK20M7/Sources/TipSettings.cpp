@@ -170,6 +170,35 @@ void TipSettings::loadDefaultCalibration(TipNameIndex tipNameIndex) {
    }
 }
 
+/**
+ * Load settings written by earlier firmware.
+ * The single set of PID values is used for every calibration band.
+ * Values not present are loaded from the defaults for the tip.
+ *
+ * @param legacy Settings to load
+ */
+void TipSettings::loadLegacySettings(const LegacySettings &legacy) {
+   if (legacy.tipNameIndex == FREE_ENTRY) {
+      freeEntry();
+      return;
+   }
+   loadDefaultCalibration(legacy.tipNameIndex);
+   for (CalibrationIndex index=CalibrationIndex_250; index<CalibrationIndex_Number; ++index) {
+      nvCalibrationMeasurementValue.set(index, legacy.calibrationMeasurementValue[index]);
+      nvCalibrationTemperatureValue.set(index, legacy.calibrationTemperatureValue[index]);
+      nvKp.set(index, legacy.kp);
+      nvKi.set(index, legacy.ki);
+      nvKd.set(index, legacy.kd);
+      nvILimit.set(index, legacy.iLimit);
+   }
+   if (legacy.hasModel) {
+      nvThermalMass = legacy.thermalMass;
+      nvThermalLoss = legacy.thermalLoss;
+      nvControlMode = legacy.controlMode;
+   }
+   nvFlags = legacy.flags;
+}
+
 /**
  * Report settings object
  *
@@ -178,10 +207,17 @@ void TipSettings::loadDefaultCalibration(TipNameIndex tipNameIndex) {
 void TipSettings::report(FormattedIO &io) {
    using namespace USBDM;
    io.write("name   = ").writeln(getTipName());
-   io.write("Kp     = ").writeln(getKp());
-   io.write("Ki     = ").writeln(getKi());
-   io.write("Kd     = ").writeln(getKd());
-   io.write("iLimit = ").writeln(getILimit());
+   for (CalibrationIndex index=CalibrationIndex_250; index<=CalibrationIndex_400; ++index) {
+      io.
+         write("@").write(getCalibrationTemperature(index)).
+         write(" Kp = ").write(getKp(index)).
+         write(", Ki = ").write(getKi(index)).
+         write(", Kd = ").write(getKd(index)).
+         write(", iLimit = ").writeln(getILimit(index));
+   }
+   io.write("C      = ").writeln(getThermalMass());
+   io.write("G      = ").writeln(getThermalLoss());
+   io.write("mode   = ").writeln(isPredictiveControl()?"Predictive":"PID");
    io.write("flags  = 0b").writeln((uint16_t)nvFlags, Radix_2);
    for (CalibrationIndex index=CalibrationIndex_250; index<=CalibrationIndex_400; ++index) {
       io.
@@ -8,6 +8,7 @@
 #ifndef SOURCES_TIPSETTINGS_H_
 #define SOURCES_TIPSETTINGS_H_
 
+#include <algorithm>
 #include "formatted_io.h"
 #include "flash.h"
 
@@ -19,6 +20,46 @@ enum IronType : uint8_t {
    IronType_AttenTweezers,
 };
 
+/**
+ * Control algorithm used for a tip
+ */
+enum ControlMode : uint8_t {
+   ControlMode_Pid,         ///< PidController
+   ControlMode_Predictive,  ///< PredictiveController using the tip thermal model
+};
+
+/**
+ * PID gains in the form used by TipSettings and PidController
+ */
+struct PidGains {
+   float kp;            ///< Proportional gain (% per C)
+   float ki;            ///< Integral gain (% per C.s)
+   float kd;            ///< Differential gain (% per C/s)
+   float iLimit;        ///< Limit on integral term (%)
+};
+
+/// Ambient temperature assumed when it is not measured (C)
+constexpr float AMBIENT_TEMPERATURE = 25.0;
+
+/**
+ * Calculate the limit on the integral term of PidGains.
+ * The integral term must be able to supply the drive to hold the maximum temperature with some margin.
+ *
+ * @param gain            Steady-state temperature rise of tip per % drive (C/%)
+ * @param maxTemperature  Maximum temperature to hold (C)
+ * @param ambient         Ambient temperature (C)
+ *
+ * @return Integral limit (%) within 5-100%
+ */
+inline float calculateIntegralLimit(float gain, float maxTemperature, float ambient=AMBIENT_TEMPERATURE) {
+
+   // Integral limit as a multiple of drive to hold maximum temperature
+   constexpr float I_LIMIT_MARGIN = 1.2;
+
+   float iLimit = I_LIMIT_MARGIN*(maxTemperature-ambient)/gain;
+   return std::max(5.0f, std::min(iLimit, 100.0f));
+}
+
 class InitialTipInfo {
 public:
    const char    *name;
@@ -133,21 +174,30 @@ private:
    /// Second calibration value for each calibration point
    USBDM::NonvolatileArray<uint16_t, CalibrationIndex_Number>nvCalibrationTemperatureValue;
 
-   /// PID parameter - proportional constant
-   USBDM::Nonvolatile<uint16_t> nvKp;
+   /// PID parameter - proportional constant for each calibration band
+   USBDM::NonvolatileArray<uint16_t, CalibrationIndex_Number> nvKp;
+
+   /// PID parameter - integral constant for each calibration band
+   USBDM::NonvolatileArray<uint16_t, CalibrationIndex_Number> nvKi;
+
+   /// PID parameter - differential constant for each calibration band
+   USBDM::NonvolatileArray<uint16_t, CalibrationIndex_Number> nvKd;
 
-   /// PID parameter - integral constant
-   USBDM::Nonvolatile<uint16_t> nvKi;
+   /// PID parameter - limit on integral accumulation for each calibration band
+   USBDM::NonvolatileArray<uint16_t, CalibrationIndex_Number> nvILimit;
 
-   /// PID parameter - differential constant
-   USBDM::Nonvolatile<uint16_t> nvKd;
+   /// Thermal model - heat capacity of tip (mJ/K)
+   USBDM::Nonvolatile<uint16_t> nvThermalMass;
 
-   /// PID parameter - limit on integral accumulation
-   USBDM::Nonvolatile<uint16_t> nvILimit;
+   /// Thermal model - loss to ambient of tip (mW/K)
+   USBDM::Nonvolatile<uint16_t> nvThermalLoss;
 
    /// Flags for this entry
    USBDM::Nonvolatile<uint16_t>     nvFlags;
 
+   /// Control algorithm used for this tip
+   USBDM::Nonvolatile<ControlMode>  nvControlMode;
+
    /// Index into tip name table for this entry
    USBDM::Nonvolatile<TipNameIndex>    nvTipNameIndex;
 
@@ -228,92 +278,170 @@ public:
     */
    void loadDefaultCalibration(TipNameIndex tipNameIndex);
 
+   /**
+    * Tip settings written by earlier firmware with a single set of PID values.
+    * Used when updating the non-volatile settings layout.
+    */
+   struct LegacySettings {
+      uint16_t     calibrationMeasurementValue[CalibrationIndex_Number];
+      uint16_t     calibrationTemperatureValue[CalibrationIndex_Number];
+      uint16_t     kp, ki, kd, iLimit;
+      bool         hasModel;       ///< Thermal model and control mode are present
+      uint16_t     thermalMass;
+      uint16_t     thermalLoss;
+      ControlMode  controlMode;
+      uint16_t     flags;
+      TipNameIndex tipNameIndex;
+   };
+
+   /**
+    * Load settings written by earlier firmware.
+    * The single set of PID values is used for every calibration band.
+    * Values not present are loaded from the defaults for the tip.
+    *
+    * @param legacy Settings to load
+    */
+   void loadLegacySettings(const LegacySettings &legacy);
+
    /**
     * Get PID Kp value
     *
+    * @param index Calibration band
+    *
     * @return Kp value
     */
-   float getKp() const {
-      return nvKp/FLOAT_SCALE_FACTOR_F;
+   float getKp(CalibrationIndex index) const {
+      return nvKp[index]/FLOAT_SCALE_FACTOR_F;
    }
 
    /**
     * Get PID Ki value
     *
+    * @param index Calibration band
+    *
     * @return Ki value
     */
-   float getKi() const {
-      return nvKi/FLOAT_SCALE_FACTOR_F;
+   float getKi(CalibrationIndex index) const {
+      return nvKi[index]/FLOAT_SCALE_FACTOR_F;
    }
 
    /**
     * Get PID Kd value
     *
+    * @param index Calibration band
+    *
     * @return Kd value
     */
-   float getKd() const {
-      return nvKd/FLOAT_SCALE_FACTOR_F;
+   float getKd(CalibrationIndex index) const {
+      return nvKd[index]/FLOAT_SCALE_FACTOR_F;
    }
 
    /**
     * Get PID iLimit value
     *
+    * @param index Calibration band
+    *
     * @return I limit value
     */
-   float getILimit() const {
-      return nvILimit/FLOAT_SCALE_FACTOR_F;
+   float getILimit(CalibrationIndex index) const {
+      return nvILimit[index]/FLOAT_SCALE_FACTOR_F;
+   }
+
+   /**
+    * Get PID gains
+    *
+    * @param index Calibration band
+    *
+    * @return PID gains for band
+    */
+   PidGains getPidGains(CalibrationIndex index) const {
+      return PidGains{getKp(index), getKi(index), getKd(index), getILimit(index)};
    }
 
    /**
     * Get PID Kp value
     *
+    * @param index Calibration band
+    *
     * @return Scaled Kp value (internal format)
     */
-   float getRawKp() const {
-      return nvKp;
+   float getRawKp(CalibrationIndex index) const {
+      return nvKp[index];
    }
 
    /**
     * Get PID Ki value
     *
+    * @param index Calibration band
+    *
     * @return Scaled Ki value (internal format)
     */
-   float getRawKi() const {
-      return nvKi;
+   float getRawKi(CalibrationIndex index) const {
+      return nvKi[index];
    }
 
    /**
     * Get PID Kd value
     *
+    * @param index Calibration band
+    *
     * @return Scaled Kd value (internal format)
     */
-   float getRawKd() const {
-      return nvKd;
+   float getRawKd(CalibrationIndex index) const {
+      return nvKd[index];
    }
 
    /**
     * Get PID iLimit value
     *
+    * @param index Calibration band
+    *
     * @return Scaled I limit value (internal format)
     */
-   float getRawILimit() const {
-      return nvILimit;
+   float getRawILimit(CalibrationIndex index) const {
+      return nvILimit[index];
    }
 
    /**
-    * Set modified raw PID control values (custom)
+    * Set modified raw PID control values for a calibration band (custom)
     *
+    * @param index   Calibration band
     * @param kp      Scaled Kp value (internal format)
     * @param ki      Scaled Ki value (internal format)
     * @param kd      Scaled Ki value (internal format)
     * @param iLimit  Scaled ILimit value (internal format)
     */
-   void setRawPidControlValues(int kp, int ki, int kd, int iLimit) {
+   void setRawPidControlValues(CalibrationIndex index, int kp, int ki, int kd, int iLimit) {
       nvFlags = nvFlags | PID_CALIBRATED;
-      nvKp     = kp;
-      nvKi     = ki;
-      nvKd     = kd;
-      nvILimit = iLimit;
+      nvKp.set(index, kp);
+      nvKi.set(index, ki);
+      nvKd.set(index, kd);
+      nvILimit.set(index, iLimit);
+   }
+
+   /**
+    * Set PID control values for a calibration band from calculated gains (custom)
+    *
+    * @param index Calibration band
+    * @param gains PID gains e.g. from autotune at band temperature
+    */
+   void setPidControlValues(CalibrationIndex index, const PidGains &gains) {
+      // Limit to range of internal format
+      auto toRaw = [](float value) {
+         return static_cast<int>(round(std::max(0.0f, std::min(value * FLOAT_SCALE_FACTOR, float(UINT16_MAX)))));
+      };
+      setRawPidControlValues(index, toRaw(gains.kp), toRaw(gains.ki), toRaw(gains.kd), toRaw(gains.iLimit));
+   }
+
+   /**
+    * Set PID control values for all calibration bands from calculated gains (custom)
+    *
+    * @param gains PID gains e.g. from step response
+    */
+   void setPidControlValues(const PidGains &gains) {
+      for (CalibrationIndex index=CalibrationIndex_250; index<CalibrationIndex_Number; ++index) {
+         setPidControlValues(index, gains);
+      }
    }
 
    /**
@@ -342,6 +470,7 @@ public:
 
    /**
     * Set initial PID control values (non-custom)
+    * The same values are used for all calibration bands.
     *
     * @param kp
     * @param ki
@@ -349,10 +478,72 @@ public:
     * @param iLimit
     */
    void setInitialPidControlValues(float kp, float ki, float kd, float iLimit) {
-      nvKp     = round(kp * FLOAT_SCALE_FACTOR);
-      nvKi     = round(ki * FLOAT_SCALE_FACTOR);
-      nvKd     = round(kd * FLOAT_SCALE_FACTOR);
-      nvILimit = round(iLimit * FLOAT_SCALE_FACTOR);
+      nvKp.set(round(kp * FLOAT_SCALE_FACTOR));
+      nvKi.set(round(ki * FLOAT_SCALE_FACTOR));
+      nvKd.set(round(kd * FLOAT_SCALE_FACTOR));
+      nvILimit.set(round(iLimit * FLOAT_SCALE_FACTOR));
+   }
+
+   /**
+    * Set initial thermal model values (non-custom)
+    * This also selects PID control.
+    *
+    * @param thermalMass  Heat capacity of tip (J/K)
+    * @param thermalLoss  Loss to ambient of tip (W/K)
+    */
+   void setInitialModelValues(float thermalMass, float thermalLoss) {
+      nvThermalMass = round(thermalMass * FLOAT_SCALE_FACTOR);
+      nvThermalLoss = round(thermalLoss * FLOAT_SCALE_FACTOR);
+      nvControlMode = ControlMode_Pid;
+   }
+
+   /**
+    * Get thermal model heat capacity
+    *
+    * @return Heat capacity of tip (J/K)
+    */
+   float getThermalMass() const {
+      return nvThermalMass/FLOAT_SCALE_FACTOR_F;
+   }
+
+   /**
+    * Get thermal model loss
+    *
+    * @return Loss to ambient of tip (W/K)
+    */
+   float getThermalLoss() const {
+      return nvThermalLoss/FLOAT_SCALE_FACTOR_F;
+   }
+
+   /**
+    * Get control algorithm used for this tip
+    *
+    * @return Control mode (ControlMode_Pid if not set)
+    */
+   ControlMode getControlMode() const {
+      if (nvControlMode == ControlMode_Predictive) {
+         return ControlMode_Predictive;
+      }
+      return ControlMode_Pid;
+   }
+
+   /**
+    * Set control algorithm used for this tip
+    *
+    * @param controlMode Control mode to use
+    */
+   void setControlMode(ControlMode controlMode) {
+      nvControlMode = controlMode;
+   }
+
+   /**
+    * Indicates if the tip uses the predictive controller
+    *
+    * @return True  - PredictiveController
+    * @return False - PidController
+    */
+   bool isPredictiveControl() const {
+      return getControlMode() == ControlMode_Predictive;
    }
 
    /**
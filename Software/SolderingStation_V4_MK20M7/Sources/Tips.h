@@ -52,7 +52,7 @@ public:
 
    /**
     * Initialise all Tip non-volatile settings.
-    * A default set of tips are loaded.
+    * All entries are freed and a default set of tips are loaded.
     */
    void initialiseTipSettings() {
       static const char * const defaultTips[] = {
@@ -62,6 +62,9 @@ public:
             "WT50M",
             "WT50L",
       };
+      for (TipSettings &ts:tipSettings) {
+         ts.freeEntry();
+      }
       for (unsigned index=0; index<(sizeof(defaultTips)/sizeof(defaultTips[0])); index++) {
          TipSettings::TipNameIndex tipIndex = TipSettings::getTipNameIndex(defaultTips[index]);
          tipSettings[index].loadDefaultCalibration(tipIndex);
@@ -0,0 +1,123 @@
+/*
+ * UartDmaTransmitter.cpp
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#include <string.h>
+#include "hardware.h"
+#include "UartDmaTransmitter.h"
+
+using namespace USBDM;
+
+/**
+ * Configure DMA and UART for transmission
+ */
+void UartDmaTransmitter::initialise() {
+
+   fHead     = 0;
+   fTail     = 0;
+   fCount    = 0;
+   fInFlight = 0;
+
+   Dma0::configure();
+   Dma0::setCallback(DMA_CHANNEL, dmaCallback);
+   Dma0::enableNvicInterrupts(DMA_CHANNEL, NvicPriority_Low);
+
+   // UART transmit holding register empty triggers DMA transfer of a byte
+   DmaMux0::configure(DMA_CHANNEL, Dma0Slot_UART0_Tx);
+   console.enableDma(UartDma_TxHoldingEmpty);
+}
+
+/**
+ * Start DMA transfer of contiguous bytes from fTail.
+ * Must be called with interrupts disabled and no transfer in progress.
+ */
+void UartDmaTransmitter::startTransfer() {
+
+   fInFlight = BUFFER_SIZE-fTail;
+   if (fInFlight > fCount) {
+      fInFlight = fCount;
+   }
+
+   const DmaTcd tcd(
+         /* Source address                 */ reinterpret_cast<uintptr_t>(fBuffer+fTail),
+         /* Source offset                  */ sizeof(fBuffer[0]),
+         /* Source size                    */ DmaSize_8bit,
+         /* Source modulo                  */ DmaModulo_Disabled,
+         /* Last source adjustment         */ 0,
+
+         /* Destination address            */ reinterpret_cast<uintptr_t>(&console.uart->D),
+         /* Destination offset             */ 0,
+         /* Destination size               */ DmaSize_8bit,
+         /* Destination modulo             */ DmaModulo_Disabled,
+         /* Last destination adjustment    */ 0,
+
+         /* Minor loop byte count          */ sizeof(fBuffer[0]),
+         /* Major loop count               */ static_cast<uint16_t>(fInFlight),
+
+         /* Start channel                  */ false,
+         /* Disable Req. on major complete */ true,
+         /* Interrupt on major complete    */ true
+   );
+   Dma0::configureTransfer(DMA_CHANNEL, tcd);
+   Dma0::enableRequests(DMA_CHANNEL);
+}
+
+/**
+ * DMA call-back.
+ * Releases the transmitted bytes and starts the next transfer if needed.
+ */
+void UartDmaTransmitter::dmaCallback(DmaChannelNum channel) {
+
+   Dma0::clearInterruptRequest(channel);
+
+   // Writers may be higher priority interrupts
+   CriticalSection cs;
+
+   This->fTail      = (This->fTail+This->fInFlight)%BUFFER_SIZE;
+   This->fCount    -= This->fInFlight;
+   This->fInFlight  = 0;
+
+   if (This->fCount > 0) {
+      This->startTransfer();
+   }
+}
+
+/**
+ * Queue data for transmission.
+ * The data is copied and either all or none of it is queued.
+ *
+ * @param data Data to transmit
+ * @param size Number of bytes
+ *
+ * @return true  => Data queued
+ * @return false => Insufficient space in buffer (data discarded)
+ */
+bool UartDmaTransmitter::write(const uint8_t data[], unsigned size) {
+
+   CriticalSection cs;
+
+   if (size > (BUFFER_SIZE-fCount)) {
+      fDropped++;
+      return false;
+   }
+
+   // Copy in up to 2 pieces as may wrap around end of buffer
+   unsigned firstPart = BUFFER_SIZE-fHead;
+   if (firstPart > size) {
+      firstPart = size;
+   }
+   memcpy(fBuffer+fHead, data, firstPart);
+   memcpy(fBuffer, data+firstPart, size-firstPart);
+
+   fHead   = (fHead+size)%BUFFER_SIZE;
+   fCount += size;
+   if (fCount > fHighWater) {
+      fHighWater = fCount;
+   }
+   if (fInFlight == 0) {
+      startTransfer();
+   }
+   return true;
+}
@@ -0,0 +1,140 @@
+/*
+ * UartDmaTransmitter.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef SOURCES_UARTDMATRANSMITTER_H_
+#define SOURCES_UARTDMATRANSMITTER_H_
+
+#include <stdint.h>
+#include "dma.h"
+
+/**
+ * Transmits data over the console UART using DMA.
+ *
+ * Data is copied into a RAM ring buffer and the caller returns immediately.
+ * The buffer is drained by a DMA channel triggered by the UART transmit
+ * holding register becoming empty. Each DMA transfer sends the contiguous
+ * bytes up to the end of the buffer and the next transfer is started from
+ * the DMA completion interrupt.
+ *
+ * write() may be used from any priority including interrupt handlers.
+ */
+class UartDmaTransmitter {
+
+public:
+   /// Size of ring buffer (bytes)
+   static constexpr unsigned BUFFER_SIZE = 1024;
+
+private:
+   /// DMA channel used for transmission
+   static constexpr USBDM::DmaChannelNum DMA_CHANNEL = USBDM::DmaChannelNum_0;
+
+   /// This pointer for static call-back function
+   static inline UartDmaTransmitter *This = nullptr;
+
+   /// Ring buffer
+   uint8_t  fBuffer[BUFFER_SIZE];
+
+   /// Index of next byte to write to buffer
+   unsigned fHead = 0;
+
+   /// Index of next byte to transmit
+   unsigned fTail = 0;
+
+   /// Number of bytes in buffer (including those being transmitted)
+   unsigned fCount = 0;
+
+   /// Number of bytes in current DMA transfer (0 => idle)
+   unsigned fInFlight = 0;
+
+   /// Number of writes discarded as the buffer was full
+   unsigned fDropped = 0;
+
+   /// Maximum number of bytes in buffer
+   unsigned fHighWater = 0;
+
+   UartDmaTransmitter(const UartDmaTransmitter &other) = delete;
+   UartDmaTransmitter(UartDmaTransmitter &&other) = delete;
+   UartDmaTransmitter& operator=(const UartDmaTransmitter &other) = delete;
+   UartDmaTransmitter& operator=(UartDmaTransmitter &&other) = delete;
+
+   /**
+    * Start DMA transfer of contiguous bytes from fTail.
+    * Must be called with interrupts disabled and no transfer in progress.
+    */
+   void startTransfer();
+
+   /**
+    * DMA call-back.
+    * Releases the transmitted bytes and starts the next transfer if needed.
+    */
+   static void dmaCallback(USBDM::DmaChannelNum channel);
+
+public:
+   UartDmaTransmitter() {
+      usbdm_assert(This == nullptr, "UartDmaTransmitter instantiated more than once");
+      This = this;
+   }
+
+   ~UartDmaTransmitter() {}
+
+   /**
+    * Configure DMA and UART for transmission
+    */
+   void initialise();
+
+   /**
+    * Queue data for transmission.
+    * The data is copied and either all or none of it is queued.
+    *
+    * @param data Data to transmit
+    * @param size Number of bytes
+    *
+    * @return true  => Data queued
+    * @return false => Insufficient space in buffer (data discarded)
+    */
+   bool write(const uint8_t data[], unsigned size);
+
+   /**
+    * Get free space in buffer
+    *
+    * @return Number of bytes that may be written
+    */
+   unsigned getSpace() const {
+      USBDM::CriticalSection cs;
+      return BUFFER_SIZE-fCount;
+   }
+
+   /**
+    * Check if all queued data has been transmitted
+    *
+    * @return true  => Buffer empty and DMA idle
+    * @return false => Transmission in progress
+    */
+   bool isIdle() const {
+      USBDM::CriticalSection cs;
+      return fCount == 0;
+   }
+
+   /**
+    * Get number of writes discarded as the buffer was full
+    */
+   unsigned getDropped() const {
+      return fDropped;
+   }
+
+   /**
+    * Get maximum number of bytes that have been in the buffer
+    */
+   unsigned getHighWater() const {
+      return fHighWater;
+   }
+};
+
+/// Transmitter for console UART
+extern UartDmaTransmitter consoleTransmitter;
+
+#endif /* SOURCES_UARTDMATRANSMITTER_H_ */
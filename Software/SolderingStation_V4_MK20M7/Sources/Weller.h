@@ -12,7 +12,7 @@
 
 #include "Measurement.h"
 #include "Averaging.h"
-#include "PidController.h"
+#include "SelectableController.h"
 
 /**
  * Class representing information for a Weller WT-50 soldering tweezers
@@ -22,14 +22,14 @@ class Weller : public Measurement {
 private:
 
    /// Thermistor in heater
-   WellerThermistorAverage thermistor;
+   WellerThermistorAverage<> thermistor;
 
    /// Measurement to use for thermistor on sub-channel B
    static constexpr MuxSelect Measurement1_Thermistor =
-         muxSelectAddSubChannel(WellerThermistorAverage::MEASUREMENT, SubChannelNum_B);
+         muxSelectAddSubChannel(WellerThermistorAverage<>::MEASUREMENT, SubChannelNum_B);
 
-   /// Loop controller
-   PidController controller{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+   /// Loop controller (selected by tip settings)
+   SelectableController controller{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY, nominalMaxPower};
 
 public:
    Weller(Channel &ch) : Measurement(ch, 11.0, 24) {}
@@ -45,6 +45,18 @@ public:
       controller.enable(enable);
    }
 
+   /**
+    * Select relay autotuning in place of the controller for the tip.
+    * Autotuning starts when the control loop is next enabled.
+    *
+    * @param[in] enable True to select autotuning
+    *
+    * @return Autotuner
+    */
+   virtual RelayAutotuneController *selectAutotune(bool enable) override {
+      return controller.selectAutotune(enable);
+   }
+
    /**
     * Run end of controller cycle update:
     *   - Temperature
@@ -52,10 +64,12 @@ public:
     *   - Controller (PID etc)
     *
     * @param targetTemperature Target temperature
+    * @param interval          Time since last update
     */
-   virtual void updateController(float targetTemperature) override {
+   virtual void updateController(float targetTemperature, USBDM::Seconds interval) override {
 
       // Run PID
+      controller.setInterval(interval);
       float dc = controller.newSample(targetTemperature, getTemperature());
       controller.setDutyCycle(dc);
    }
@@ -160,6 +174,9 @@ public:
          // Standard iron - Kp=2.0,Ki=0.06,Kd=0.0,Ilimit=32.5@100%
          settings->setInitialPidControlValues(0.5,0.05,0.0,20.0);
       }
+
+      // Thermal model                C(J/K)  G(W/K)
+      settings->setInitialModelValues(4.0,    0.030);
    }
 
    /**
@@ -175,14 +192,14 @@ public:
    /**
     * Get the sequence of ADC measurements to do
     *
-    * @return Sequence array terminated by MuxSelect_Complete sentinel
+    * @param channelMask   Mask indicating which channel
+    * @param tipPresent    Indicates tip is present in tool
+    *
+    * @return Schedule ordered for measurement (constructed at compile time)
     */
-   virtual MuxSelect const *getMeasurementSequence() const override {
-      static const MuxSelect sequence[] = {
-            Measurement1_Thermistor,
-            MuxSelect_Complete,
-      };
-      return sequence;
+   static constexpr MeasurementSchedule getMeasurementSchedule(uint8_t channelMask, bool tipPresent) {
+      (void)tipPresent;
+      return MeasurementSchedule(channelMask, Measurement1_Thermistor);
    };
 
    /**
@@ -223,19 +240,27 @@ public:
       using namespace USBDM;
 
       if (doHeading) {
-         console.write("Time,");
+         dmaConsole.write("Time,");
          controller.reportHeading(ch);
       }
 
       // Time-stamp
-      console.setFloatFormat(2, Padding_LeadingSpaces, 3);
-      console.write(controller.getElapsedTime());
+      dmaConsole.setFloatFormat(2, Padding_LeadingSpaces, 3);
+      dmaConsole.write(controller.getElapsedTime());
       controller.report();
 
-      console.writeln(",", getInstantTemperature());
-      console.resetFormat();
+      dmaConsole.writeln(",", getInstantTemperature());
+      dmaConsole.resetFormat();
    }
 
+   /**
+    * Fill in controller and tool values of telemetry frame
+    *
+    * @param frame Frame to update
+    */
+   virtual void getTelemetry(TelemetryFrame &frame) const override {
+      controller.getTelemetry(frame);
+   }
 };
 
 #endif /* SOURCES_WELLER_H_ */
@@ -14,22 +14,31 @@
  * Any manual changes will be lost.
  */
 #include <stdint.h>
+#include <stddef.h>
+#include <utility>
 #include "array"
 
 namespace USBDM {
 
+/**
+ * Page ordered character data is prepared for a display rotated by 180 degrees.
+ * This must agree with the display orientation (see Oled::orientation).
+ */
+static constexpr bool FONT_PAGES_ROTATED_180 = true;
+
 /**
  * Represents a font
  */
 class Font {
 
 public:
-   const uint8_t * (*fptr)(uint8_t ch);   // Pointer to indexing function
-   const uint8_t width;                   // Width of the character in pixels
-   const uint8_t height;                  // Height of the character in pixels
+   const uint8_t * (*fptr)(uint8_t ch);      // Pointer to indexing function
+   const uint8_t * (*pageFptr)(uint8_t ch);  // Pointer to indexing function for page ordered data (may be nullptr)
+   const uint8_t width;                      // Width of the character in pixels
+   const uint8_t height;                     // Height of the character in pixels
 
-   constexpr Font(unsigned width, unsigned height, const uint8_t * (*fptr)(uint8_t ch)) :
-      fptr(fptr), width(width), height(height) {
+   constexpr Font(unsigned width, unsigned height, const uint8_t * (*fptr)(uint8_t ch), const uint8_t * (*pageFptr)(uint8_t ch)=nullptr) :
+      fptr(fptr), pageFptr(pageFptr), width(width), height(height) {
    }
 
    /**
@@ -44,11 +53,72 @@ public:
    const uint8_t *operator[] (uint8_t ch) const {
       return fptr(ch);
    }
+
+   /**
+    * Get page ordered pixel data for a character
+    *
+    * @param ch   Character
+    *
+    * @return  Pixel data for ch or nullptr if not available.
+    *
+    * @note Returned value is a C array of size WIDTH*((HEIGHT+7)/8) (see FontPageCharacter)
+    */
+   const uint8_t *getPageData(uint8_t ch) const {
+      return (pageFptr == nullptr)?nullptr:pageFptr(ch);
+   }
 };
 
 template<unsigned width, unsigned height>
 using FontCharacter = std::array<uint8_t, ((width+7)/8)*height>;
 
+/**
+ * Character data in page order as used by SSD1306 type displays.
+ * Each page is 8 pixel rows of the character.
+ * Each byte is a column of 8 pixels with the LSB at the top.
+ * Pages are arranged top to bottom, columns are arranged left to right.
+ * If FONT_PAGES_ROTATED_180 then the character is rotated before conversion.
+ */
+template<unsigned width, unsigned height>
+using FontPageCharacter = std::array<uint8_t, width*((height+7)/8)>;
+
+/**
+ * Convert character from row order (FontCharacter) to page order (FontPageCharacter) at compile time
+ *
+ * @param character Character to convert
+ *
+ * @return Converted character
+ */
+template<unsigned width, unsigned height>
+constexpr FontPageCharacter<width, height> toPageOrder(const FontCharacter<width, height> &character) {
+   constexpr unsigned BYTES_PER_ROW = (width+7)/8;
+
+   FontPageCharacter<width, height> pageCharacter{};
+   for (unsigned row=0; row<height; row++) {
+      for (unsigned column=0; column<width; column++) {
+         if ((character[(row*BYTES_PER_ROW)+(column/8)] & (0x80>>(column%8))) == 0) {
+            continue;
+         }
+         unsigned r = FONT_PAGES_ROTATED_180?(height-1-row):row;
+         unsigned c = FONT_PAGES_ROTATED_180?(width-1-column):column;
+         pageCharacter[((r/8)*width)+c] |= (1<<(r%8));
+      }
+   }
+   return pageCharacter;
+}
+
+/**
+ * Convert table of characters to page order at compile time
+ *
+ * @param characters Characters to convert
+ *
+ * @return Converted characters
+ */
+template<unsigned width, unsigned height, size_t... index>
+constexpr std::array<FontPageCharacter<width, height>, sizeof...(index)>
+toPageOrder(const FontCharacter<width, height> characters[], std::index_sequence<index...>) {
+   return {{toPageOrder<width, height>(characters[index])...}};
+}
+
 template<typename FontData, uint8_t... elements>
 class FontArraySubset : public Font {
 
@@ -56,7 +126,7 @@ public:
    static constexpr unsigned WIDTH      = FontData::WIDTH;
    static constexpr unsigned HEIGHT     = FontData::HEIGHT;
 
-   constexpr FontArraySubset() : Font(WIDTH, HEIGHT, doit) {
+   constexpr FontArraySubset() : Font(WIDTH, HEIGHT, doit, pageDoit) {
    }
 
    /**
@@ -92,6 +162,21 @@ public:
 
       return font[getIndex(ch)].data();
    }
+
+   /**
+    * Get page ordered pixel data for this character
+    *
+    * @param ch   Character
+    *
+    * @return  Pixel data for ch.  This is a C array of size width*((height+7)/8).
+    */
+   static const uint8_t *pageDoit(uint8_t ch) {
+      static constexpr FontPageCharacter<WIDTH, HEIGHT> font[sizeof...(elements)] = {
+            {toPageOrder<WIDTH, HEIGHT>(FontData::data[elements-' '])}...,
+      };
+
+      return font[getIndex(ch)].data();
+   }
 };
 
 class FontSmall : public Font {
@@ -101,7 +186,7 @@ public:
    static constexpr unsigned HEIGHT     = 8;
    static constexpr uint8_t  START_CHAR = ' ';
 
-   constexpr FontSmall() : Font(WIDTH, HEIGHT, doit) {}
+   constexpr FontSmall() : Font(WIDTH, HEIGHT, doit, pageDoit) {}
 
    /**
     * Get pixel data for a character
@@ -116,6 +201,21 @@ public:
       return data[ch-START_CHAR].data();
    }
 
+   /**
+    * Get page ordered pixel data for a character
+    *
+    * @param ch   Character
+    *
+    * @return  Pixel data for ch.
+    *
+    * @note Returned value is a C array of size WIDTH*((HEIGHT+7)/8)
+    */
+   static const uint8_t *pageDoit(uint8_t ch) {
+      static constexpr auto pageData =
+            toPageOrder<WIDTH, HEIGHT>(data, std::make_index_sequence<sizeof(data)/sizeof(data[0])>());
+      return pageData[ch-START_CHAR].data();
+   }
+
    using FontCharacterType = FontCharacter<WIDTH, HEIGHT>;
 
    // Font data is organised from (left to right) X (top to bottom) as bytes
@@ -226,7 +326,7 @@ public:
    static constexpr unsigned HEIGHT     = 8;
    static constexpr uint8_t  START_CHAR = ' ';
 
-   constexpr FontMedium() : Font(WIDTH, HEIGHT, doit) {}
+   constexpr FontMedium() : Font(WIDTH, HEIGHT, doit, pageDoit) {}
 
    /**
     * Get pixel data for a character
@@ -241,6 +341,21 @@ public:
       return data[ch-START_CHAR].data();
    }
 
+   /**
+    * Get page ordered pixel data for a character
+    *
+    * @param ch   Character
+    *
+    * @return  Pixel data for ch.
+    *
+    * @note Returned value is a C array of size WIDTH*((HEIGHT+7)/8)
+    */
+   static const uint8_t *pageDoit(uint8_t ch) {
+      static constexpr auto pageData =
+            toPageOrder<WIDTH, HEIGHT>(data, std::make_index_sequence<sizeof(data)/sizeof(data[0])>());
+      return pageData[ch-START_CHAR].data();
+   }
+
    using FontCharacterType = FontCharacter<WIDTH, HEIGHT>;
 
    // Font data is organised from (left to right) X (top to bottom) as bytes
@@ -351,7 +466,7 @@ public:
    static constexpr unsigned HEIGHT     = 16;
    static constexpr uint8_t  START_CHAR = ' ';
 
-   constexpr FontLarge() : Font(WIDTH, HEIGHT, doit) {}
+   constexpr FontLarge() : Font(WIDTH, HEIGHT, doit, pageDoit) {}
 
    /**
     * Get pixel data for a character
@@ -366,6 +481,21 @@ public:
       return data[ch-START_CHAR].data();
    }
 
+   /**
+    * Get page ordered pixel data for a character
+    *
+    * @param ch   Character
+    *
+    * @return  Pixel data for ch.
+    *
+    * @note Returned value is a C array of size WIDTH*((HEIGHT+7)/8)
+    */
+   static const uint8_t *pageDoit(uint8_t ch) {
+      static constexpr auto pageData =
+            toPageOrder<WIDTH, HEIGHT>(data, std::make_index_sequence<sizeof(data)/sizeof(data[0])>());
+      return pageData[ch-START_CHAR].data();
+   }
+
    using FontCharacterType = FontCharacter<WIDTH, HEIGHT>;
 
    // Font data is organised from (left to right) X (top to bottom) as bytes
@@ -476,7 +606,7 @@ public:
    static constexpr unsigned HEIGHT     = 32;
    static constexpr uint8_t  START_CHAR = ' ';
 
-   constexpr FontVeryLarge() : Font(WIDTH, HEIGHT, doit) {}
+   constexpr FontVeryLarge() : Font(WIDTH, HEIGHT, doit, pageDoit) {}
 
    /**
     * Get pixel data for a character
@@ -491,6 +621,21 @@ public:
       return data[ch-START_CHAR].data();
    }
 
+   /**
+    * Get page ordered pixel data for a character
+    *
+    * @param ch   Character
+    *
+    * @return  Pixel data for ch.
+    *
+    * @note Returned value is a C array of size WIDTH*((HEIGHT+7)/8)
+    */
+   static const uint8_t *pageDoit(uint8_t ch) {
+      static constexpr auto pageData =
+            toPageOrder<WIDTH, HEIGHT>(data, std::make_index_sequence<sizeof(data)/sizeof(data[0])>());
+      return pageData[ch-START_CHAR].data();
+   }
+
    using FontCharacterType = FontCharacter<WIDTH, HEIGHT>;
 
    /**
@@ -257,6 +257,37 @@ ErrorCode I2c::transmit(uint8_t address, uint16_t size, const uint8_t data[]) {
    return tErrorCode;
 }
 
+/**
+ * Start transmission of message without waiting for completion.
+ * Requires I2cMode_Interrupt.
+ *
+ * @param[in]  address  Address of slave to communicate with (should include LSB = R/W bit = 0)
+ * @param[in]  size     Size of transmission data
+ * @param[in]  data     Data to transmit
+ *
+ * @return E_NO_ERROR on successful start of transaction
+ */
+ErrorCode I2c::startTransmit(uint8_t address, uint16_t size, const uint8_t data[]) {
+
+   errorCode = E_NO_ERROR;
+
+   rxBytesRemaining = 0;
+
+   // Set up transmit data
+   txDataPtr        = data;
+   txBytesRemaining = size;
+
+   // Send address byte at start and move to data transmission
+   state = i2c_txData;
+
+   sendAddress(address);
+   if (errorCode != E_NO_ERROR) {
+      // Bus didn't become free
+      state = i2c_idle;
+   }
+   return errorCode;
+}
+
 /**
  * Receive message
  *
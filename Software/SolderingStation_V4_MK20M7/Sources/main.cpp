@@ -16,6 +16,9 @@
 #include "rcm.h"
 #include "NonvolatileSettings.h"
 #include "BootInformation.h"
+#include "UartDmaTransmitter.h"
+#include "DmaConsole.h"
+#include "FlightRecorder.h"
 
 using namespace USBDM;
 
@@ -38,10 +41,17 @@ Control        control;
 /// Handles the OLED display
 Display        display;
 
+/// Transmits console data (telemetry and reports) using DMA
+UartDmaTransmitter consoleTransmitter;
+
+/// Console for diagnostic reports (waits for space rather than losing report lines)
+DmaConsole dmaConsole(consoleTransmitter, OverflowPolicy_Block);
+
 void initialise() {
    // Turn on filtering of reset pin
    Rcm::configure(RcmResetPinRunWaitFilter_LowPowerOscillator, RcmResetPinStopFilter_LowPowerOscillator);
 
+   consoleTransmitter.initialise();
    display.initialise();
    control.initialise();
    switchPolling.initialise();
@@ -70,6 +80,10 @@ static constexpr HardwareType HARDWARE_VERSION = HW_SOLDER_STATION_V4;
 __attribute__ ((section(".noinit")))
 static uint32_t magicNumber;
 
+/// Flight recorder for control loop (survives reset)
+__attribute__ ((section(".noinit")))
+FlightRecorder flightRecorder;
+
 #if defined(RELEASE_BUILD)
 // Triggers memory image relocation for bootloader
 extern BootInformation const bootloaderInformation;
@@ -108,6 +122,13 @@ static void resetToBootloader() {
 int main() {
 
    console.writeln("Reset Source = ", Rcm::getResetSourceDescription());
+
+   // Report control state leading up to an overload or watchdog reset
+   if (flightRecorder.isFrozen()) {
+      flightRecorder.report(console);
+   }
+   flightRecorder.initialise();
+
    if (Rcm::getResetSource() & RcmSource_Wdog) {
       console.writeln("Watchdog reset - halting");
       for(;;) {
@@ -18,11 +18,27 @@ static constexpr uint8_t MULTIPLE_COMMANDS = 0b00000000; ///< Co=0, D/C=0: Byte(
 static constexpr uint8_t MULTIPLE_GDRAM    = 0b01000000; ///< Co=0, D/C=1: Byte(s) are graphic data until I2C stop
 
 /**
- * Clear internal frame buffer
+ * Clear internal frame buffer (back buffer)
  * The OLED is not affected until refreshImage() is called.
  */
 Oled &Oled::clearDisplay(void) {
-   memset((uint8_t *)&buffer, 0, sizeof(buffer));
+
+   // Only columns with something on them are changed
+   for (unsigned page=0; page<NUM_PAGES; page++) {
+      const uint8_t *pageData = backBuffer->data+(page*WIDTH);
+      int left  = 0;
+      int right = WIDTH-1;
+      while ((left <= right) && (pageData[left] == 0)) {
+         left++;
+      }
+      while ((right > left) && (pageData[right] == 0)) {
+         right--;
+      }
+      if (left <= right) {
+         markDirty(page, left, right);
+      }
+   }
+   memset(backBuffer->data, 0, sizeof(backBuffer->data));
 
    x = 0;
    y = 0;
@@ -39,8 +55,12 @@ Oled &Oled::clearDisplay(void) {
  */
 void Oled::initialise() {
 
+   waitForRefresh();
    clearDisplay();
 
+   // Display contents unknown
+   stalePages = (1<<NUM_PAGES)-1;
+
    // Initialise sequence
    static const uint8_t init1[] = {
          MULTIPLE_COMMANDS,                    // Co = 0, D/C = 0
@@ -65,7 +85,7 @@ void Oled::initialise() {
          0,                                    // first page
          (((HEIGHT+7)/8)-1),                   // last page
    };
-   i2c.transmit(I2C_ADDRESS, init1);
+   i2cQueue.transmit(I2C_ADDRESS, init1);
 
    if constexpr ((WIDTH == 128) && (HEIGHT == 32)) {
 
@@ -76,7 +96,7 @@ void Oled::initialise() {
             SSD1306_SETCONTRAST,                  // 0x81
             0x10,
       };
-      i2c.transmit(I2C_ADDRESS, init4a);
+      i2cQueue.transmit(I2C_ADDRESS, init4a);
 
    } else if constexpr ((WIDTH == 128) && (HEIGHT == 64)) {
 
@@ -87,7 +107,7 @@ void Oled::initialise() {
             SSD1306_SETCONTRAST,                  // 0x81
             ((VCC_CONTROL == OledVccControl_External) ? 0x9F : 0xCF),
       };
-      i2c.transmit(I2C_ADDRESS, init4b);
+      i2cQueue.transmit(I2C_ADDRESS, init4b);
 
    } else if constexpr ((WIDTH == 96) && (HEIGHT == 16)) {
 
@@ -98,7 +118,7 @@ void Oled::initialise() {
             SSD1306_SETCONTRAST,                  // 0x81
             ((VCC_CONTROL == OledVccControl_External) ? 0x10 : 0xAF),
       };
-      i2c.transmit(I2C_ADDRESS, init4c);
+      i2cQueue.transmit(I2C_ADDRESS, init4c);
    } else {
       // Other screen varieties -- TBD
    }
@@ -114,13 +134,17 @@ void Oled::initialise() {
          SSD1306_DEACTIVATE_SCROLL,
          SSD1306_DISPLAYON,                    // Main screen turn on
    };
-   i2c.transmit(I2C_ADDRESS, init5);
+   i2cQueue.transmit(I2C_ADDRESS, init5);
+   enabled = true;
 }
 
 /**
  * Turn display on or off
  */
 void Oled::enable(bool enable) {
+   if (enable == enabled) {
+      return;
+   }
    static const uint8_t onCommand[] = {
          MULTIPLE_COMMANDS,                    // Co = 0, D/C = 0
          SSD1306_DISPLAYON,                    // 0xAF
@@ -129,7 +153,9 @@ void Oled::enable(bool enable) {
          MULTIPLE_COMMANDS,                    // Co = 0, D/C = 0
          SSD1306_DISPLAYOFF,                   // 0xAE
    };
-   i2c.transmit(I2C_ADDRESS, enable?onCommand:offCommand);
+   if (i2cQueue.transmit(I2C_ADDRESS, enable?onCommand:offCommand) == E_NO_ERROR) {
+      enabled = enable;
+   }
 }
 
 /**
@@ -140,20 +166,170 @@ void Oled::enable(bool enable) {
  * @param level
  */
 void Oled::setContrast(uint8_t level) {
-   uint8_t contrastCommand[] = {
-         MULTIPLE_COMMANDS,                    // Co = 0, D/C = 0
-         SSD1306_SETCONTRAST,                  // 0x81
-         level,
-   };
-   i2c.transmit(I2C_ADDRESS, contrastCommand);
+   // Only the latest level matters if a previous change is still queued
+   contrastCommand[0] = MULTIPLE_COMMANDS;     // Co = 0, D/C = 0
+   contrastCommand[1] = SSD1306_SETCONTRAST;   // 0x81
+   contrastCommand[2] = level;
+   i2cQueue.transmit(I2C_ADDRESS, contrastCommand);
 }
 
 /**
- * Refresh OLED from frame buffer
+ * Refresh OLED from frame buffer.
+ * Only the columns of pages modified since the last refresh are sent.
+ * Returns immediately. The transfer is queued and completed from the I2C interrupt.
+ *
+ * Each run of consecutive pages is sent directly from the front buffer using a window covering
+ * the modified columns of all pages in the run.
+ * The byte before each transfer is temporarily replaced by the control byte.
+ * This byte is outside the window being sent: it is either a column to the left of the window,
+ * a column to the right of the window in the previous page or belongs to a page that is not being
+ * sent as runs are separated by at least one page.
  */
 void Oled::refreshImage() {
-   buffer.controlByte = MULTIPLE_GDRAM;
-   i2c.transmit(I2C_ADDRESS, buffer.rawData);
+
+   // Front buffer is in use until refresh completes
+   waitForRefresh();
+
+   uint8_t changedPages = getChangedPages(dirtyPages);
+   uint8_t sendPages    = changedPages|stalePages;
+
+   // Columns to send for each page - contents of stale pages are unknown
+   uint8_t windowLeft[NUM_PAGES];
+   uint8_t windowRight[NUM_PAGES];
+   for (unsigned page=0; page<NUM_PAGES; page++) {
+      if (stalePages & (1<<page)) {
+         windowLeft[page]  = 0;
+         windowRight[page] = WIDTH-1;
+      }
+      else {
+         windowLeft[page]  = dirtyLeft[page];
+         windowRight[page] = dirtyRight[page];
+      }
+   }
+   dirtyPages = 0;
+   stalePages = 0;
+   if (sendPages == 0) {
+      // Unchanged frame
+      return;
+   }
+   Buffer *t   = frontBuffer;
+   frontBuffer = backBuffer;
+   backBuffer  = t;
+
+   // Bring back buffer up to date for drawing - only the modified columns differ
+   for (unsigned page=0; page<NUM_PAGES; page++) {
+      if (changedPages & (1<<page)) {
+         unsigned offset = (page*WIDTH)+dirtyLeft[page];
+         memcpy(backBuffer->data+offset, frontBuffer->data+offset, dirtyRight[page]-dirtyLeft[page]+1);
+      }
+   }
+
+   // Queue runs of consecutive pages
+   unsigned runCount      = 0;
+   unsigned transferCount = 0;
+   while (sendPages != 0) {
+      unsigned runStart = __builtin_ctz(sendPages);
+      unsigned runEnd   = runStart;
+      while (((runEnd+1U) < NUM_PAGES) && (sendPages & (1<<(runEnd+1)))) {
+         runEnd++;
+      }
+      uint8_t runMask = ((2<<runEnd)-1) & ~((1<<runStart)-1);
+      sendPages &= ~runMask;
+
+      // Window covering modified columns of all pages in run
+      unsigned left  = windowLeft[runStart];
+      unsigned right = windowRight[runStart];
+      for (unsigned page=runStart+1; page<=runEnd; page++) {
+         left  = min<unsigned>(left, windowLeft[page]);
+         right = max<unsigned>(right, windowRight[page]);
+      }
+      const unsigned columns = right-left+1;
+
+      Run &run = runs[runCount++];
+      run.owner            = this;
+      run.mask             = runMask;
+      run.windowCommand[0] = MULTIPLE_COMMANDS;             // Co = 0, D/C = 0
+      run.windowCommand[1] = SSD1306_COLUMNADDR;            // 0x21
+      run.windowCommand[2] = left;                          // first column
+      run.windowCommand[3] = right;                         // last column
+      run.windowCommand[4] = SSD1306_PAGEADDR;              // 0x22
+      run.windowCommand[5] = runStart;                      // first page
+      run.windowCommand[6] = runEnd;                        // last page
+
+      // Window is contiguous in frame buffer for a single page or full width
+      const bool     contiguous = (runStart == runEnd) || (columns == WIDTH);
+      const unsigned count      = contiguous?1:(runEnd-runStart+1);
+      const unsigned length     = contiguous?((runEnd-runStart+1)*columns):columns;
+
+      // Window and data must be queued together as earlier runs complete from the I2C interrupt
+      CriticalSection cs;
+      if (i2cQueue.getFree() < (1+count)) {
+         // Send on next refresh
+         stalePages |= run.mask|sendPages;
+         break;
+      }
+      i2cQueue.transmit(I2C_ADDRESS, run.windowCommand, windowComplete, &run);
+      for (unsigned index=0; index<count; index++) {
+         const unsigned page = runStart+index;
+         Transfer &transfer = transfers[transferCount++];
+         transfer.owner     = this;
+         transfer.mask      = contiguous?runMask:(1<<page);
+         transfer.data      = frontBuffer->rawData+(page*WIDTH)+left;
+         transfer.savedByte = *transfer.data;
+         *transfer.data     = MULTIPLE_GDRAM;
+         transfersInProgress = transfersInProgress + 1;
+         i2cQueue.transmit(I2C_ADDRESS, 1+length, transfer.data, dataComplete, &transfer);
+      }
+   }
+}
+
+/**
+ * Completion of window command of a run (called from I2C interrupt)
+ *
+ * @param context    Run being sent
+ * @param errorCode  Result of transaction
+ */
+void Oled::windowComplete(void *context, ErrorCode errorCode) {
+   Run &run = *static_cast<Run *>(context);
+   if (errorCode != E_NO_ERROR) {
+      // Data will be written to the wrong place - send again on next refresh
+      run.owner->stalePages |= run.mask;
+   }
+}
+
+/**
+ * Completion of a data transfer of a run (called from I2C interrupt)
+ *
+ * @param context    Transfer being sent
+ * @param errorCode  Result of transaction
+ */
+void Oled::dataComplete(void *context, ErrorCode errorCode) {
+   Transfer &transfer = *static_cast<Transfer *>(context);
+   *transfer.data = transfer.savedByte;
+   if (errorCode != E_NO_ERROR) {
+      // Send again on next refresh
+      transfer.owner->stalePages |= transfer.mask;
+   }
+   transfer.owner->transfersInProgress = transfer.owner->transfersInProgress - 1;
+}
+
+/**
+ * Get pages that differ between back and front buffers
+ *
+ * @param pages Pages to check (bit per page). Only the modified columns of each page are compared.
+ *
+ * @return Pages that differ (bit per page)
+ */
+uint8_t Oled::getChangedPages(uint8_t pages) const {
+   uint8_t changedPages = 0;
+   for (unsigned page=0; page<NUM_PAGES; page++) {
+      if ((pages & (1<<page)) &&
+          (memcmp(backBuffer->data+(page*WIDTH)+dirtyLeft[page], frontBuffer->data+(page*WIDTH)+dirtyLeft[page],
+                  dirtyRight[page]-dirtyLeft[page]+1) != 0)) {
+         changedPages |= (1<<page);
+      }
+   }
+   return changedPages;
 }
 
 /**
@@ -170,20 +346,28 @@ Oled &Oled::writeImage(const uint8_t *dataPtr, int x, int y, int width, int heig
    // Doesn't support negative clipping of images
    usbdm_assert((x>=0)||(y>=0), "Illegal image coordinate");
 
-   if ((x>=WIDTH)||(y>=HEIGHT)) {
+   if ((x>clipRight)||(y>clipBottom)) {
       // Entirely off screen
       return *this;
    }
    for(int h=0; h<height; h++) {
-      if ((y+h) >= HEIGHT) {
+      if ((y+h) > clipBottom) {
          // Clip at bottom
          break;
       }
+      if ((y+h) < clipTop) {
+         // Clip at top
+         continue;
+      }
       for(int w=0;w<width; w++) {
-         if ((x+w) >= WIDTH) {
+         if ((x+w) > clipRight) {
             // Clip on right
             break;
          }
+         if ((x+w) < clipLeft) {
+            // Clip on left
+            continue;
+         }
          // Get pixel value from image
          unsigned pixelIndex = (h*((width+7)/8))+(w/8);
          bool pixel = (dataPtr[pixelIndex]&(1<<(7-(w&0b111))));
@@ -202,6 +386,93 @@ Oled &Oled::writeImage(const uint8_t *dataPtr, int x, int y, int width, int heig
    return *this;
 }
 
+/**
+ * Write page ordered image to frame buffer (as WriteMode_Write)
+ * The image must lie entirely on the screen.
+ * The image is clipped to the clipping rectangle.
+ *
+ * @param [in] pageData   Page ordered image (see FontPageCharacter)
+ * @param [in] x          X position of top-left corner
+ * @param [in] y          Y position of top-left corner
+ * @param [in] width      Width of image
+ * @param [in] height     Height of image
+ */
+void Oled::writePageImage(const uint8_t *pageData, int x, int y, int width, int height) {
+   usbdm_assert((x>=0)&&(y>=0)&&((x+width)<=WIDTH)&&((y+height)<=HEIGHT), "Illegal image coordinate");
+
+   // Top-left corner of image and clipping rectangle in frame buffer
+   int left;
+   int top;
+   int clipX1, clipY1, clipX2, clipY2;
+   if constexpr (orientation == Orientation_Rotated_180) {
+      // Image data is already rotated
+      left   = WIDTH-x-width;
+      top    = HEIGHT-y-height;
+      clipX1 = (WIDTH-1)-clipRight;
+      clipX2 = (WIDTH-1)-clipLeft;
+      clipY1 = (HEIGHT-1)-clipBottom;
+      clipY2 = (HEIGHT-1)-clipTop;
+   }
+   else {
+      left   = x;
+      top    = y;
+      clipX1 = clipLeft;
+      clipX2 = clipRight;
+      clipY1 = clipTop;
+      clipY2 = clipBottom;
+   }
+   const unsigned shift = top&0b111;
+
+   // Columns of image within clipping rectangle
+   const int firstColumn = max(0, clipX1-left);
+   const int lastColumn  = min(width-1, clipX2-left);
+   if (firstColumn > lastColumn) {
+      return;
+   }
+
+   uint8_t *dst = backBuffer->data+((top/8)*WIDTH)+left;
+   for (int row=0; row<height; row+=8, pageData+=width, dst+=WIDTH) {
+
+      // Image rows in this page of image may straddle two pages of frame buffer
+      unsigned rows  = ((height-row)<8)?(height-row):8;
+      unsigned mask  = ((1U<<rows)-1)<<shift;
+
+      // Rows of the two pages within clipping rectangle
+      int pageTop    = (top&~0b111)+row;
+      int clipFirst  = max(0, clipY1-pageTop);
+      int clipLast   = min(15, clipY2-pageTop);
+      if (clipFirst > clipLast) {
+         continue;
+      }
+      mask &= (2U<<clipLast)-(1U<<clipFirst);
+
+      uint8_t  lowMask   = mask;
+      uint8_t  highMask  = mask>>8;
+
+      uint8_t  lowChanged  = 0;
+      uint8_t  highChanged = 0;
+      for (int column=firstColumn; column<=lastColumn; column++) {
+         unsigned pixels = pageData[column]<<shift;
+         uint8_t  value  = (dst[column]&~lowMask)|(pixels&lowMask);
+         lowChanged     |= dst[column]^value;
+         dst[column]     = value;
+         if (highMask != 0) {
+            value          = (dst[column+WIDTH]&~highMask)|((pixels>>8)&highMask);
+            highChanged   |= dst[column+WIDTH]^value;
+            dst[column+WIDTH] = value;
+         }
+      }
+      // Columns of pages need to be sent on next refresh
+      unsigned page = (dst-backBuffer->data)/WIDTH;
+      if (lowChanged != 0) {
+         markDirty(page, left+firstColumn, left+lastColumn);
+      }
+      if (highChanged != 0) {
+         markDirty(page+1, left+firstColumn, left+lastColumn);
+      }
+   }
+}
+
 /**
  * Write a character to the LCD in graphics mode at the current x,y location
  *
@@ -221,7 +492,13 @@ void Oled::_writeChar(char ch) {
          // Don't display partial characters
          return;
       }
-      writeImage((*font)[ch], x, y, width, height);
+      const uint8_t *pageData = font->getPageData(ch);
+      if ((pageData != nullptr) && (x>=0) && (y>=0) && ((y+height)<=HEIGHT)) {
+         writePageImage(pageData, x, y, width, height);
+      }
+      else {
+         writeImage((*font)[ch], x, y, width, height);
+      }
       x += width;
       fontHeight = max(fontHeight, height);
    }
@@ -247,6 +524,8 @@ Oled &Oled::putSpace(int width) {
 }
 
 /**
+ * Modify pixel(s) in frame buffer.
+ * The page is marked for refresh if the frame buffer changes.
  *
  * @param [in] index      Index into frame buffer in bytes
  * @param [in] mask       Mask for pixel being manipulated in byte
@@ -255,88 +534,192 @@ Oled &Oled::putSpace(int width) {
  */
 void Oled::putPixel(unsigned index, uint8_t mask, bool pixel, WriteMode writeMode) {
    usbdm_assert(index < IMAGE_DATA_SIZE, "Illegal index");
+   uint8_t &data   = backBuffer->data[index];
+   uint8_t  before = data;
    switch(writeMode) {
       case WriteMode_Write:
          if (pixel) {
-            buffer.data[index] |= mask;
+            data |= mask;
          }
          else {
-            buffer.data[index] &= ~mask;
+            data &= ~mask;
          }
          break;
       case WriteMode_InverseWrite:
          if (pixel) {
-            buffer.data[index] &= ~mask;
+            data &= ~mask;
          }
          else {
-            buffer.data[index] |= mask;
+            data |= mask;
          }
          break;
       case WriteMode_Or:
          if (pixel) {
-            buffer.data[index] |= mask;
+            data |= mask;
          }
          break;
       case WriteMode_InverseAnd:
          if (!pixel) {
-            buffer.data[index] &= ~mask;
+            data &= ~mask;
          }
          break;
       case WriteMode_Xor:
          if (pixel) {
-            buffer.data[index] ^= mask;
+            data ^= mask;
          }
          break;
       default:
          break;
    }
-
+   if (data != before) {
+      // Column of page needs to be sent on next refresh
+      markDirty(index/WIDTH, index%WIDTH, index%WIDTH);
+   }
 }
 
 /**
- * Draw vertical line to frame buffer
+ * Clip rectangle to clipping rectangle and convert to frame buffer co-ordinates
  *
- * @param [in] x           X position in pixels
- * @param [in] y1          Top Y position
- * @param [in] y2          Bottom Y position
- * @param [in] writeMode   Mode of modification
+ * @param [in,out] x1   Left X position in pixels
+ * @param [in,out] y1   Top Y position in pixels
+ * @param [in,out] x2   Right X position in pixels
+ * @param [in,out] y2   Bottom Y position in pixels
+ *
+ * @return false if the rectangle is entirely outside the clipping rectangle
  */
-void Oled::drawVerticalLine(int x, int y1, int y2, WriteMode writeMode) {
-   if ((x<0)||(x>=WIDTH)) {
-      // Off screen
-      return;
-   }
-   if constexpr (orientation == Orientation_Rotated_180) {
-      x = (WIDTH-1)-x;
-      y1 = (HEIGHT-1)-y1;
-      y2 = (HEIGHT-1)-y2;
+bool Oled::clipRect(int &x1, int &y1, int &x2, int &y2) const {
+   if (x1>x2) {
+      int t = x1;
+      x1 = x2;
+      x2 = t;
    }
    if (y1>y2) {
       int t = y1;
       y1 = y2;
       y2 = t;
    }
-   if (y1<0) {
-      y1 = 0;
+   if ((x2<clipLeft)||(x1>clipRight)||(y2<clipTop)||(y1>clipBottom)) {
+      // Off screen
+      return false;
+   }
+   if (x1<clipLeft) {
+      x1 = clipLeft;
    }
-   if (y2>=HEIGHT) {
-      y2 = HEIGHT-1;
+   if (x2>clipRight) {
+      x2 = clipRight;
+   }
+   if (y1<clipTop) {
+      y1 = clipTop;
+   }
+   if (y2>clipBottom) {
+      y2 = clipBottom;
+   }
+   if constexpr (orientation == Orientation_Rotated_180) {
+      int t = x1;
+      x1 = (WIDTH-1)-x2;
+      x2 = (WIDTH-1)-t;
+      t  = y1;
+      y1 = (HEIGHT-1)-y2;
+      y2 = (HEIGHT-1)-t;
+   }
+   return true;
+}
+
+/**
+ * Set, clear or invert a rectangle of pixels in the frame buffer.
+ * Each page is modified as 32-bit words (4 columns at a time) with
+ * masks for the partial words at each end and the partial pages at top and bottom.
+ * The modes have the same effect as drawing each pixel with putPixel(..., 1, writeMode).
+ *
+ * @param [in] x1          Left column in frame buffer (0..WIDTH-1)
+ * @param [in] y1          Top row in frame buffer (0..HEIGHT-1)
+ * @param [in] x2          Right column in frame buffer (x1..WIDTH-1)
+ * @param [in] y2          Bottom row in frame buffer (y1..HEIGHT-1)
+ * @param [in] writeMode   Mode of modification
+ */
+void Oled::blit(unsigned x1, unsigned y1, unsigned x2, unsigned y2, WriteMode writeMode) {
+   usbdm_assert((x1<=x2)&&(x2<WIDTH)&&(y1<=y2)&&(y2<HEIGHT), "Illegal rectangle");
+
+   // Each word is modified as ((word|setMask)&~clearMask)^invertMask
+   uint32_t setAll    = 0;
+   uint32_t clearAll  = 0;
+   uint32_t invertAll = 0;
+   switch(writeMode) {
+      case WriteMode_Write:
+      case WriteMode_Or:
+         setAll    = 0xFFFFFFFF;
+         break;
+      case WriteMode_InverseWrite:
+         clearAll  = 0xFFFFFFFF;
+         break;
+      case WriteMode_Xor:
+         invertAll = 0xFFFFFFFF;
+         break;
+      case WriteMode_InverseAnd:
+      default:
+         // Drawing 'on' pixels has no effect
+         return;
    }
-   uint8_t  startMask   = 0b11111111U<<(unsigned(y1&7));
-   uint8_t  endMask     = ~(0b11111111U<<(unsigned(y2&7)+1));
 
-   uint8_t mask = startMask;
-   unsigned startRow = y1>>3;
-   unsigned endRow   = y2>>3;
+   // Byte lanes (columns) of first and last word (little-endian)
+   const uint32_t startMask = 0xFFFFFFFFU<<(8*(x1&0b11));
+   const uint32_t endMask   = 0xFFFFFFFFU>>(8*(3-(x2&0b11)));
+   const unsigned startWord = x1/4;
+   const unsigned endWord   = x2/4;
 
-   unsigned index = (y1>>3)*WIDTH + x;
-   for (unsigned row=startRow; row<endRow; row++) {
-      putPixel(index, mask, 1, writeMode);
-      mask = 0xFF;
-      index += WIDTH;
+   // Rows of first and last page
+   const unsigned startPage = y1/8;
+   const unsigned endPage   = y2/8;
+   const uint8_t  topMask    = 0xFFU<<(y1&0b111);
+   const uint8_t  bottomMask = 0xFFU>>(7-(y2&0b111));
+
+   for (unsigned page=startPage; page<=endPage; page++) {
+
+      // Replicate column mask across byte lanes
+      uint8_t pixels = 0xFF;
+      if (page == startPage) {
+         pixels &= topMask;
+      }
+      if (page == endPage) {
+         pixels &= bottomMask;
+      }
+      const uint32_t pageMask = pixels*0x01010101U;
+
+      uint32_t *words   = reinterpret_cast<uint32_t*>(backBuffer->data+(page*WIDTH));
+      uint32_t  changed = 0;
+      for (unsigned word=startWord; word<=endWord; word++) {
+         uint32_t mask = pageMask;
+         if (word == startWord) {
+            mask &= startMask;
+         }
+         if (word == endWord) {
+            mask &= endMask;
+         }
+         uint32_t before = words[word];
+         uint32_t after  = ((before|(mask&setAll))&~(mask&clearAll))^(mask&invertAll);
+         changed        |= before^after;
+         words[word]     = after;
+      }
+      if (changed != 0) {
+         // Columns of page need to be sent on next refresh
+         markDirty(page, x1, x2);
+      }
+   }
+}
+
+/**
+ * Draw vertical line to frame buffer
+ *
+ * @param [in] x           X position in pixels
+ * @param [in] y1          Top Y position
+ * @param [in] y2          Bottom Y position
+ * @param [in] writeMode   Mode of modification
+ */
+void Oled::drawVerticalLine(int x, int y1, int y2, WriteMode writeMode) {
+   int x2 = x;
+   if (clipRect(x, y1, x2, y2)) {
+      blit(x, y1, x2, y2, writeMode);
    }
-   mask &= endMask;
-   putPixel(index, mask, 1, writeMode);
 }
 
 /**
@@ -348,31 +731,9 @@ void Oled::drawVerticalLine(int x, int y1, int y2, WriteMode writeMode) {
  * @param [in] writeMode   Mode of modification
  */
 void Oled::drawHorizontalLine(int x1, int x2, int y, WriteMode writeMode) {
-   if ((y<0)||(y>=HEIGHT)) {
-      // Off screen
-      return;
-   }
-   if constexpr (orientation == Orientation_Rotated_180) {
-      x1 = (WIDTH-1)-x1;
-      x2 = (WIDTH-1)-x2;
-      y = (HEIGHT-1)-y;
-   }
-   if (x1>x2) {
-      int t = x1;
-      x1 = x2;
-      x2 = t;
-   }
-   if (x1<0) {
-      x1 = 0;
-   }
-   if (x2>=WIDTH) {
-      x2 = WIDTH-1;
-   }
-   uint8_t mask = 0b1<<(y&0b111);
-   unsigned baseIndex = ((y>>3) * WIDTH);
-   for (unsigned xx=(unsigned)x1; xx<=(unsigned)x2; xx++) {
-      unsigned index = xx + baseIndex;
-      putPixel(index, mask, 1, writeMode);
+   int y2 = y;
+   if (clipRect(x1, y, x2, y2)) {
+      blit(x1, y, x2, y2, writeMode);
    }
 }
 
@@ -385,11 +746,11 @@ void Oled::drawHorizontalLine(int x1, int x2, int y, WriteMode writeMode) {
  * @param [in] writeMode  Mode of modification
  */
 void Oled::drawPixel(int x, int y, bool pixel, WriteMode writeMode) {
-   if ((x<0)||(x>=WIDTH)) {
+   if ((x<clipLeft)||(x>clipRight)) {
       // Off screen
       return;
    }
-   if ((y<0)||(y>=HEIGHT)) {
+   if ((y<clipTop)||(y>clipBottom)) {
       // Off screen
       return;
    }
@@ -412,12 +773,7 @@ void Oled::drawPixel(int x, int y, bool pixel, WriteMode writeMode) {
  * @param writeMode  Write mode (inverse, xor etc)
  */
 void Oled::drawRect(int x1, int y1, int x2, int y2, WriteMode writeMode) {
-   if (y1>y2) {
-      int t = y1;
-      y1 = y2;
-      y2 = t;
-   }
-   for (int y=y1; y<=y2; y++) {
-      drawHorizontalLine(x1, x2, y, writeMode);
+   if (clipRect(x1, y1, x2, y2)) {
+      blit(x1, y1, x2, y2, writeMode);
    }
 }
@@ -10,7 +10,9 @@
 #ifndef SOURCES_OLED_H_
 #define SOURCES_OLED_H_
 
+#include <stddef.h>
 #include "i2c.h"
+#include "I2cQueue.h"
 #include "fonts.h"
 #include "formatted_io.h"
 
@@ -81,6 +83,9 @@ public:
    enum Orientation {Orientation_Normal, Orientation_Rotated_180};
    static constexpr Orientation orientation = Orientation_Rotated_180;
 
+   static_assert(FONT_PAGES_ROTATED_180 == (orientation == Orientation_Rotated_180),
+         "Page ordered font data doesn't match display orientation");
+
 private:
 
    const USBDM::Font *font = &USBDM::fontSmall;
@@ -131,29 +136,46 @@ public:
    static constexpr unsigned   I2C_ADDRESS   = 0b01111000;
    static constexpr unsigned   I2C_SPEED     = 400_kHz;
 
+   // Number of pages (8 pixel rows) in display
+   static constexpr unsigned NUM_PAGES = (HEIGHT + 7) / 8;
+
    // Size of image array in memory
-   static constexpr size_t IMAGE_DATA_SIZE = WIDTH * ((HEIGHT + 7) / 8);
+   static constexpr size_t IMAGE_DATA_SIZE = WIDTH * NUM_PAGES;
 
 #pragma pack(push,1)
    /// Buffer type for display data
    /// This is prefixed by a command byte for transmission to OLED
-   union Buffer {
-      struct {
-      /// Command byte
-      uint8_t  controlByte;
-      /// Data values
-      uint8_t  data[IMAGE_DATA_SIZE];
+   /// Display data is word aligned so each page may be accessed as 32-bit words
+   struct alignas(4) Buffer {
+      /// Padding to align data
+      uint8_t  reserved[3];
+      union {
+         struct {
+         /// Command byte
+         uint8_t  controlByte;
+         /// Data values
+         uint8_t  data[IMAGE_DATA_SIZE];
+         };
+         /// All data for transmission
+         uint8_t rawData[IMAGE_DATA_SIZE+1];
       };
-      /// All data for transmission
-      uint8_t rawData[IMAGE_DATA_SIZE+1];
    };
 #pragma pack(pop)
 
-   /** I2C peripheral to use */
-   I2c &i2c;
+   static_assert((offsetof(Buffer, data)%4) == 0, "Display data must be word aligned");
+   static_assert((WIDTH%4) == 0, "Pages must be a whole number of words");
+
+   /** Queue of I2C transactions to display */
+   I2cQueue &i2cQueue;
+
+   /** Buffers for display data */
+   Buffer buffers[2] = {};
 
-   /** Buffer for display data */
-   Buffer buffer;
+   /** Buffer being displayed - read by refresh in progress */
+   Buffer *frontBuffer = &buffers[0];
+
+   /** Buffer being drawn into */
+   Buffer *backBuffer  = &buffers[1];
 
    /** Graphic mode X position */
    int x = 0;
@@ -164,13 +186,156 @@ public:
    /** Graphic mode font height (for newline) */
    int fontHeight = 0;
 
+   /** Clipping rectangle for drawing (inclusive, display co-ordinates) */
+   int clipLeft   = 0;
+   int clipTop    = 0;
+   int clipRight  = WIDTH-1;
+   int clipBottom = HEIGHT-1;
+
+   static_assert(NUM_PAGES <= 8, "Page mask too small");
+
+   /** Pages of back buffer modified since last refresh (bit per page) */
+   uint8_t dirtyPages = 0;
+
+   /** First column of back buffer modified since last refresh for each page in dirtyPages */
+   uint8_t dirtyLeft[NUM_PAGES];
+
+   /** Last column of back buffer modified since last refresh for each page in dirtyPages */
+   uint8_t dirtyRight[NUM_PAGES];
+
+   /** Pages where display may differ from front buffer (bit per page, set from I2C interrupt on failure) */
+   uint8_t stalePages = 0;
+
+   /** Indicates display is on */
+   bool enabled = false;
+
+   /** Command changing contrast (must remain unchanged while queued) */
+   uint8_t contrastCommand[3];
+
+   /**
+    * Run of consecutive pages being sent by a refresh.
+    * Each run is queued as a command setting the display window (columns and pages)
+    * followed by the page data as one or more transfers.
+    */
+   struct Run {
+      Oled    *owner;             ///< Display being refreshed
+      uint8_t  mask;              ///< Pages in run (bit per page)
+      uint8_t  windowCommand[7];  ///< Command setting display window for run
+   };
+
+   /**
+    * Page data sent by a refresh.
+    * The columns of the window of a run are contiguous in the frame buffer only for a single page
+    * or the full width so otherwise each page of the run is a separate transfer.
+    */
+   struct Transfer {
+      Oled    *owner;             ///< Display being refreshed
+      uint8_t  mask;              ///< Pages in transfer (bit per page)
+      uint8_t  savedByte;         ///< Frame buffer byte temporarily replaced by control byte
+      uint8_t *data;              ///< Start of transmission in front buffer (control byte)
+   };
+
+   /** Maximum number of runs - runs are separated by at least one page */
+   static constexpr unsigned MAX_RUNS = (NUM_PAGES+1)/2;
+
+   /** Runs of refresh in progress */
+   Run runs[MAX_RUNS];
+
+   /** Transfers of refresh in progress (at most one per page) */
+   Transfer transfers[NUM_PAGES];
+
+   /** Number of transfers not yet completely sent (decremented from I2C interrupt) */
+   volatile uint8_t transfersInProgress = 0;
+
+   /**
+    * Mark columns of a page of the back buffer as modified
+    *
+    * @param page    Page modified
+    * @param left    First column modified
+    * @param right   Last column modified
+    */
+   void markDirty(unsigned page, unsigned left, unsigned right) {
+      if (dirtyPages & (1<<page)) {
+         dirtyLeft[page]  = min<uint8_t>(dirtyLeft[page], left);
+         dirtyRight[page] = max<uint8_t>(dirtyRight[page], right);
+      }
+      else {
+         dirtyPages       |= (1<<page);
+         dirtyLeft[page]   = left;
+         dirtyRight[page]  = right;
+      }
+   }
+
+   /**
+    * Completion of window command of a run (called from I2C interrupt)
+    *
+    * @param context    Run being sent
+    * @param errorCode  Result of transaction
+    */
+   static void windowComplete(void *context, ErrorCode errorCode);
+
+   /**
+    * Completion of a data transfer of a run (called from I2C interrupt)
+    *
+    * @param context    Transfer being sent
+    * @param errorCode  Result of transaction
+    */
+   static void dataComplete(void *context, ErrorCode errorCode);
+
+   /**
+    * Get pages that differ between back and front buffers
+    *
+    * @param pages Pages to check (bit per page)
+    *
+    * @return Pages that differ (bit per page)
+    */
+   uint8_t getChangedPages(uint8_t pages) const;
+
+   /**
+    * Set, clear or invert a rectangle of pixels in the frame buffer.
+    * Each page is modified as 32-bit words (4 columns at a time) with
+    * masks for the partial words at each end and the partial pages at top and bottom.
+    * The modes have the same effect as drawing each pixel with putPixel(..., 1, writeMode).
+    *
+    * @param [in] x1          Left column in frame buffer (0..WIDTH-1)
+    * @param [in] y1          Top row in frame buffer (0..HEIGHT-1)
+    * @param [in] x2          Right column in frame buffer (x1..WIDTH-1)
+    * @param [in] y2          Bottom row in frame buffer (y1..HEIGHT-1)
+    * @param [in] writeMode   Mode of modification
+    *
+    * @note Co-ordinates are in frame buffer order i.e. after any rotation
+    */
+   void blit(unsigned x1, unsigned y1, unsigned x2, unsigned y2, WriteMode writeMode);
+
+   /**
+    * Clip rectangle to clipping rectangle and convert to frame buffer co-ordinates
+    *
+    * @param [in,out] x1   Left X position in pixels
+    * @param [in,out] y1   Top Y position in pixels
+    * @param [in,out] x2   Right X position in pixels
+    * @param [in,out] y2   Bottom Y position in pixels
+    *
+    * @return false if the rectangle is entirely outside the clipping rectangle
+    */
+   bool clipRect(int &x1, int &y1, int &x2, int &y2) const;
+
    template<typename T> T max(T a, T b) {
       return (a>b)?a:b;
    }
 
+   template<typename T> T min(T a, T b) {
+      return (a<b)?a:b;
+   }
+
 public:
-   Oled(USBDM::I2c &i2c) : i2c(i2c) {
-      initialise();
+   /**
+    * Constructor
+    *
+    * @param i2cQueue Queue used for transactions to the display
+    *
+    * @note initialise() must be called once the queue is operating
+    */
+   Oled(I2cQueue &i2cQueue) : i2cQueue(i2cQueue) {
    }
 
    /**
@@ -206,7 +371,7 @@ public:
     */   void initialise();
 
     /**
-     * Clear internal frame buffer
+     * Clear internal frame buffer (back buffer)
      * The OLED is not affected until refreshImage() is called.
      */
     Oled &clearDisplay();
@@ -226,10 +391,49 @@ public:
     void setContrast(uint8_t level);
 
     /**
-     * Refresh OLED from frame buffer
+     * Refresh OLED from frame buffer.
+     * The back buffer becomes the front buffer and only pages that differ from the previous front buffer are sent.
+     * Only the columns of each page modified since the last refresh are sent.
+     * Returns immediately. The transfer is queued and completed from the I2C interrupt.
      */
     void refreshImage();
 
+    /**
+     * Wait until any refresh in progress has completed.
+     */
+    void waitForRefresh() {
+       while (transfersInProgress != 0) {
+          i2cQueue.waitWhileBusy();
+       }
+    }
+
+    /**
+     * Indicates a refresh is in progress
+     *
+     * @return true if refresh in progress
+     */
+    bool isRefreshing() const {
+       return transfersInProgress != 0;
+    }
+
+    /**
+     * Get image being drawn
+     *
+     * @return Back buffer data
+     */
+    const uint8_t *getImage() const {
+       return backBuffer->data;
+    }
+
+    /**
+     * Get image being displayed
+     *
+     * @return Front buffer data
+     */
+    const uint8_t *getDisplayedImage() const {
+       return frontBuffer->data;
+    }
+
     /**
      * Write image to frame buffer
      *
@@ -242,6 +446,19 @@ public:
      */
     Oled &writeImage(const uint8_t *dataPtr, int x, int y, int width, int height, WriteMode writeMode=WriteMode_Write);
 
+    /**
+     * Write page ordered image to frame buffer (as WriteMode_Write)
+     * The image must lie entirely on the screen.
+     * The image is clipped to the clipping rectangle.
+     *
+     * @param [in] pageData   Page ordered image (see FontPageCharacter)
+     * @param [in] x          X position of top-left corner
+     * @param [in] y          Y position of top-left corner
+     * @param [in] width      Width of image
+     * @param [in] height     Height of image
+     */
+    void writePageImage(const uint8_t *pageData, int x, int y, int width, int height);
+
     /**
      * Writes whitespace to the frame buffer at the current x,y location
      *
@@ -250,6 +467,8 @@ public:
     Oled &putSpace(int width);
 
     /**
+     * Modify pixel(s) in frame buffer.
+     * The column of the page is marked for refresh if the frame buffer changes.
      *
      * @param [in] index      Index into frame buffer in bytes
      * @param [in] mask       Mask for pixel being manipulated in byte
@@ -313,6 +532,34 @@ public:
        return *this;
     }
 
+    /**
+     * Restrict drawing to a rectangle.
+     * Pixels outside the rectangle are not changed by drawing operations.
+     *
+     * @param x1   Left X (inclusive)
+     * @param y1   Top Y (inclusive)
+     * @param x2   Right X (inclusive)
+     * @param y2   Bottom Y (inclusive)
+     *
+     * @return Reference to self
+     */
+    Oled &setClip(int x1, int y1, int x2, int y2) {
+       clipLeft   = max(x1, 0);
+       clipTop    = max(y1, 0);
+       clipRight  = min(x2, int(WIDTH-1));
+       clipBottom = min(y2, int(HEIGHT-1));
+       return *this;
+    }
+
+    /**
+     * Remove drawing restriction set by setClip()
+     *
+     * @return Reference to self
+     */
+    Oled &clearClip() {
+       return setClip(0, 0, WIDTH-1, HEIGHT-1);
+    }
+
     /**
      * Get current X location
      *
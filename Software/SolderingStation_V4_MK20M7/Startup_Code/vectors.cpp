@@ -20,6 +20,9 @@
 #include "wdog.h"
 #include "pit.h"
 #include "adc.h"
+#include "i2c.h"
+#include "lptmr.h"
+#include "dma.h"
 
 
 /*
@@ -222,7 +225,6 @@ void USBDCD0_IRQHandler(void)                 WEAK_DEFAULT_HANDLER;
 void DAC0_IRQHandler(void)                    WEAK_DEFAULT_HANDLER;
 void TSI0_IRQHandler(void)                    WEAK_DEFAULT_HANDLER;
 void MCG_IRQHandler(void)                     WEAK_DEFAULT_HANDLER;
-void LPTMR0_IRQHandler(void)                  WEAK_DEFAULT_HANDLER;
 void PORTA_IRQHandler(void)                   WEAK_DEFAULT_HANDLER;
 void PORTC_IRQHandler(void)                   WEAK_DEFAULT_HANDLER;
 void PORTE_IRQHandler(void)                   WEAK_DEFAULT_HANDLER;
@@ -257,22 +259,22 @@ VectorTable const __vector_table = {
       SysTick_Handler,                         /*   15,   -1  System Tick Timer                                                                */
 
                                                /* External Interrupts */
-      DMA0_IRQHandler,                         /*   16,    0  Direct memory access controller                                                  */
-      DMA1_IRQHandler,                         /*   17,    1  Direct memory access controller                                                  */
-      DMA2_IRQHandler,                         /*   18,    2  Direct memory access controller                                                  */
-      DMA3_IRQHandler,                         /*   19,    3  Direct memory access controller                                                  */
-      DMA4_IRQHandler,                         /*   20,    4  Direct memory access controller                                                  */
-      DMA5_IRQHandler,                         /*   21,    5  Direct memory access controller                                                  */
-      DMA6_IRQHandler,                         /*   22,    6  Direct memory access controller                                                  */
-      DMA7_IRQHandler,                         /*   23,    7  Direct memory access controller                                                  */
-      DMA8_IRQHandler,                         /*   24,    8  Direct memory access controller                                                  */
-      DMA9_IRQHandler,                         /*   25,    9  Direct memory access controller                                                  */
-      DMA10_IRQHandler,                        /*   26,   10  Direct memory access controller                                                  */
-      DMA11_IRQHandler,                        /*   27,   11  Direct memory access controller                                                  */
-      DMA12_IRQHandler,                        /*   28,   12  Direct memory access controller                                                  */
-      DMA13_IRQHandler,                        /*   29,   13  Direct memory access controller                                                  */
-      DMA14_IRQHandler,                        /*   30,   14  Direct memory access controller                                                  */
-      DMA15_IRQHandler,                        /*   31,   15  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<0>,              /*   16,    0  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<1>,              /*   17,    1  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<2>,              /*   18,    2  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<3>,              /*   19,    3  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<4>,              /*   20,    4  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<5>,              /*   21,    5  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<6>,              /*   22,    6  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<7>,              /*   23,    7  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<8>,              /*   24,    8  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<9>,              /*   25,    9  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<10>,             /*   26,   10  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<11>,             /*   27,   11  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<12>,             /*   28,   12  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<13>,             /*   29,   13  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<14>,             /*   30,   14  Direct memory access controller                                                  */
+      USBDM::Dma0::irqHandler<15>,             /*   31,   15  Direct memory access controller                                                  */
       DMA_Error_IRQHandler,                    /*   32,   16  DMA error interrupt all channels                                                 */
       Default_Handler,                         /*   33,   17                                                                                   */
       FTF_Command_IRQHandler,                  /*   34,   18  Flash Memory Interface                                                           */
@@ -281,7 +283,7 @@ VectorTable const __vector_table = {
       LLWU_IRQHandler,                         /*   37,   21  Low Leakage Wakeup                                                               */
       USBDM::Wdog::irqHandler,                 /*   38,   22  External Watchdog Monitor                                                        */
       Default_Handler,                         /*   39,   23                                                                                   */
-      I2C0_IRQHandler,                         /*   40,   24  Inter-Integrated Circuit                                                         */
+      USBDM::I2c0::irqHandler,                 /*   40,   24  Inter-Integrated Circuit                                                         */
       I2C1_IRQHandler,                         /*   41,   25  Inter-Integrated Circuit                                                         */
       SPI0_IRQHandler,                         /*   42,   26  Serial Peripheral Interface                                                      */
       SPI1_IRQHandler,                         /*   43,   27  Serial Peripheral Interface                                                      */
@@ -342,7 +344,7 @@ VectorTable const __vector_table = {
       Default_Handler,                         /*   98,   82                                                                                   */
       TSI0_IRQHandler,                         /*   99,   83  Touch Sense Interface                                                            */
       MCG_IRQHandler,                          /*  100,   84  Multipurpose Clock Generator                                                     */
-      LPTMR0_IRQHandler,                       /*  101,   85  Low Power Timer                                                                  */
+      USBDM::Lptmr0::irqHandler,               /*  101,   85  Low Power Timer                                                                  */
       Default_Handler,                         /*  102,   86                                                                                   */
       PORTA_IRQHandler,                        /*  103,   87  General Purpose Input/Output                                                     */
       USBDM::PortB::irqHandler,                /*  104,   88  General Purpose Input/Output                                                     */
@@ -0,0 +1,138 @@
+/**
+ * @file     SimulatedHardware.h (SolderingStation_V4_Simulation/Project_Headers/SimulatedHardware.h)
+ * @brief    Hooks used by the host peripheral stubs to reach the simulator
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ *
+ * The stub USBDM headers in this directory replace the hardware access of the
+ * real library with calls to these functions.
+ * They are implemented by the simulator (see Sources/Simulator.cpp).
+ */
+
+#ifndef PROJECT_HEADERS_SIMULATEDHARDWARE_H_
+#define PROJECT_HEADERS_SIMULATEDHARDWARE_H_
+
+#include <stdint.h>
+
+namespace Simulation {
+
+/**
+ * Get the current simulated time
+ *
+ * @return Time since start of simulation in microseconds
+ */
+uint64_t getTimeInMicroseconds();
+
+/**
+ * Start an ADC conversion.
+ * USBDM::Adc0::irqHandler() is executed when the conversion completes.
+ *
+ * @param adcChannel ADC channel being converted
+ */
+void startAdcConversion(int adcChannel);
+
+/**
+ * Start a PIT one-shot.
+ * USBDM::Pit::irqHandler() is executed on timeout.
+ *
+ * @param pitChannel    PIT channel being used
+ * @param microseconds  Delay in microseconds
+ */
+void startOneShot(unsigned pitChannel, uint32_t microseconds);
+
+/**
+ * Start a periodic PIT channel.
+ * USBDM::Pit::irqHandler() is executed on each timeout.
+ *
+ * @param pitChannel    PIT channel being used
+ * @param microseconds  Period in microseconds
+ */
+void startPeriodic(unsigned pitChannel, uint32_t microseconds);
+
+/**
+ * Stop a PIT channel
+ *
+ * @param pitChannel    PIT channel being used
+ */
+void stopPit(unsigned pitChannel);
+
+/**
+ * Start the low power timer (periodic).
+ * USBDM::Lptmr0::irqHandler() is executed on each timeout.
+ *
+ * @param microseconds  Period in microseconds
+ */
+void startLowPowerTimer(uint32_t microseconds);
+
+/**
+ * Stop the low power timer
+ */
+void stopLowPowerTimer();
+
+/**
+ * Equivalent of WFI.
+ * Advances simulated time to the next interrupt and executes it.
+ */
+void waitForInterrupt();
+
+/**
+ * Point in main-line code where pending interrupts may be taken
+ * e.g. on exit from a critical section.
+ * Busy-waiting code must pass through one of these to allow time to advance.
+ */
+void preemptionPoint();
+
+/**
+ * Busy-wait delay in main-line code.
+ * Interrupts continue to be executed while waiting.
+ *
+ * @param seconds  How long to wait
+ */
+void delay(float seconds);
+
+/**
+ * Transmit data over the simulated I2C bus
+ *
+ * @param address I2C address (8-bit form)
+ * @param size    Number of bytes to transmit
+ * @param data    Data to transmit
+ */
+void i2cTransmit(uint8_t address, uint16_t size, const uint8_t data[]);
+
+/**
+ * Start transmission of data over the simulated I2C bus.
+ * USBDM::I2c0::irqHandler() is executed when the transmission completes.
+ *
+ * @param address I2C address (8-bit form)
+ * @param size    Number of bytes to transmit
+ * @param data    Data to transmit
+ */
+void i2cStartTransmit(uint8_t address, uint16_t size, const uint8_t data[]);
+
+/**
+ * Start DMA transmission of data over the simulated console UART.
+ * USBDM::Dma0::irqHandler<channel>() is executed when the transmission completes.
+ *
+ * @param dmaChannel DMA channel used
+ * @param size       Number of bytes to transmit
+ * @param data       Data to transmit
+ */
+void uartDmaStartTransmit(unsigned dmaChannel, uint16_t size, const uint8_t data[]);
+
+/**
+ * Refresh of watchdog from firmware
+ */
+void watchdogRefresh();
+
+/**
+ * Simulated break-point.
+ * Terminates the simulation with an error.
+ *
+ * @param reason Description of reason
+ */
+[[noreturn]] void breakpoint(const char *reason);
+
+} // End namespace Simulation
+
+#endif /* PROJECT_HEADERS_SIMULATEDHARDWARE_H_ */
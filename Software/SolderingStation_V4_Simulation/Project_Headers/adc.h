@@ -0,0 +1,142 @@
+/**
+ * @file     adc.h (SolderingStation_V4_Simulation/Project_Headers/adc.h)
+ * @brief    Host replacement for USBDM Analogue to Digital Converter
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef HEADER_ADC_H
+#define HEADER_ADC_H
+
+#include "pin_mapping.h"
+
+namespace USBDM {
+
+/**
+ * ADC Resolutions
+ */
+enum AdcResolution {
+   AdcResolution_8bit_se,  //!<  8-bit unsigned for use with single-ended mode
+   AdcResolution_10bit_se, //!< 10-bit unsigned for use with single-ended mode
+   AdcResolution_12bit_se, //!< 12-bit unsigned for use with single-ended mode
+   AdcResolution_16bit_se, //!< 16-bit unsigned for use with single-ended mode
+};
+
+/// ADC clock source
+enum AdcClockSource { AdcClockSource_Bus, AdcClockSource_Asynch, };
+
+/// ADC sample time
+enum AdcSample { AdcSample_Short, AdcSample_20, AdcSample_12, AdcSample_6, AdcSample_2, };
+
+/// ADC power
+enum AdcPower { AdcPower_Normal, AdcPower_Low, };
+
+/// ADC multiplexor selection
+enum AdcMuxsel { AdcMuxsel_A, AdcMuxsel_B, };
+
+/// ADC clock range
+enum AdcClockRange { AdcClockRange_Normal, AdcClockRange_High, };
+
+/// ADC asynchronous clock
+enum AdcAsyncClock { AdcAsyncClock_Disabled, AdcAsyncClock_Enabled, };
+
+/// ADC reference
+enum AdcRefSel { AdcRefSel_VrefHL, AdcRefSel_VrefAlt, };
+
+/// ADC hardware averaging
+enum AdcAveraging { AdcAveraging_Off, AdcAveraging_4, AdcAveraging_8, AdcAveraging_16, AdcAveraging_32, };
+
+/// ADC conversion complete interrupt
+enum AdcInterrupt { AdcInterrupt_Disabled, AdcInterrupt_Enabled, };
+
+/**
+ * Type definition for ADC interrupt call back
+ *
+ * @param[in]  result  Conversion result
+ * @param[in]  channel Channel that generated the result
+ */
+typedef void (*AdcCallbackFunction)(uint32_t result, int channel);
+
+/**
+ * Simulated ADC
+ */
+class Adc0 {
+
+public:
+   /// Call-back for conversion complete
+   static inline AdcCallbackFunction callback = nullptr;
+
+   /**
+    * ADC interrupt handler.
+    * Called by the simulator when a conversion completes.
+    *
+    * @param result   Conversion result
+    * @param channel  Channel converted
+    */
+   static void irqHandler(uint32_t result, int channel) {
+      if (callback != nullptr) {
+         callback(result, channel);
+      }
+   }
+
+   /**
+    * Get ADC maximum conversion value for an single-ended range
+    *
+    * @param adcResolution
+    *
+    * @return range e.g. AdcResolution_8bit_se => (2^8)-1
+    */
+   static constexpr int getSingleEndedMaximum(AdcResolution adcResolution) {
+      switch(adcResolution) {
+         case AdcResolution_8bit_se:  return (1<<8)-1;
+         case AdcResolution_10bit_se: return (1<<10)-1;
+         case AdcResolution_12bit_se: return (1<<12)-1;
+         case AdcResolution_16bit_se: return (1<<16)-1;
+         default:                     return 0;
+      }
+   }
+
+   template<typename... Types>
+   static void configure(Types...) {}
+
+   static void setReference(AdcRefSel) {}
+   static void setAveraging(AdcAveraging) {}
+   static ErrorCode calibrate() { return E_NO_ERROR; }
+   static void enableNvicInterrupts(NvicPriority = NvicPriority_Normal) {}
+   static void disableNvicInterrupts() {}
+
+   /**
+    * Set conversion complete call-back
+    *
+    * @param cb Call-back to execute
+    */
+   static void setCallback(AdcCallbackFunction cb) {
+      callback = cb;
+   }
+
+   /**
+    * Template representing a single ADC channel
+    *
+    * @tparam channel Channel number
+    */
+   template<int channel>
+   class Channel {
+
+   public:
+      /// Channel number
+      static constexpr int CHANNEL = channel;
+
+      /**
+       * Start a conversion.
+       * The call-back is executed on completion.
+       */
+      static void startConversion(AdcInterrupt = AdcInterrupt_Disabled) {
+         Simulation::startAdcConversion(channel);
+      }
+   };
+};
+
+} // End namespace USBDM
+
+#endif /* HEADER_ADC_H */
@@ -0,0 +1,144 @@
+/**
+ * @file     cmp.h (SolderingStation_V4_Simulation/Project_Headers/cmp.h)
+ * @brief    Host replacement for USBDM Analogue Comparator
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef HEADER_CMP_H_
+#define HEADER_CMP_H_
+
+#include "pin_mapping.h"
+
+namespace USBDM {
+
+/// Comparator power level
+enum CmpPower { CmpPower_LowSpeed, CmpPower_HighSpeed, };
+
+/// Comparator hysteresis
+enum CmpHysteresis { CmpHysteresis_0, CmpHysteresis_1, CmpHysteresis_2, CmpHysteresis_3, };
+
+/// Comparator polarity
+enum CmpPolarity { CmpPolarity_Noninverted, CmpPolarity_Inverted, };
+
+/// Comparator filter samples
+enum CmpFilterSamples { CmpFilterSamples_Disabled, CmpFilterSamples_1, CmpFilterSamples_2, CmpFilterSamples_3,
+   CmpFilterSamples_4, CmpFilterSamples_5, CmpFilterSamples_6, CmpFilterSamples_7, };
+
+/// Comparator filter clock
+enum CmpFilterClockSource { CmpFilterClockSource_Internal, CmpFilterClockSource_BusClock = CmpFilterClockSource_Internal, };
+
+/// Comparator DAC reference
+enum CmpDacSource { CmpDacSource_Vin1, CmpDacSource_Vin2, CmpDacSource_Vdda = CmpDacSource_Vin2, };
+
+/// Comparator interrupt/event
+enum CmpEvent { CmpEvent_None, CmpEvent_Rising, CmpEvent_Falling, CmpEvent_Both, };
+
+/// Comparator interrupt selection
+enum CmpInterrupt { CmpInterrupt_None, CmpInterrupt_Rising, CmpInterrupt_Falling, CmpInterrupt_Both, };
+
+/**
+ * Used to represent the comparator status for interrupt handler
+ */
+struct CmpStatus {
+   CmpEvent event;   //!< Event triggering handler
+   uint8_t  state;   //!< State of CMPO at event
+
+   constexpr CmpStatus(CmpEvent event, uint8_t  state) : event(event), state(state) {}
+};
+
+/**
+ * Type definition for CMP interrupt call back
+ */
+typedef void (*CmpCallbackFunction)(CmpStatus status);
+
+/**
+ * Simulated comparator
+ *
+ * @tparam instance Comparator number
+ */
+template<unsigned instance>
+class CmpBase_T {
+
+public:
+   /// Call-back for comparator event
+   static inline CmpCallbackFunction callback = nullptr;
+
+   /// Maximum value for DAC
+   static constexpr int MAXIMUM_DAC_VALUE = 63;
+
+   /**
+    * Comparator interrupt handler.
+    * Called by the simulator on a comparator event.
+    *
+    * @param event Event type
+    */
+   static void irqHandler(CmpEvent event) {
+      if (callback != nullptr) {
+         callback(CmpStatus(event, event == CmpEvent_Rising));
+      }
+   }
+
+   template<typename... Types>
+   static void configure(Types...) {}
+
+   template<typename... Types>
+   static void setInputFiltered(Types...) {}
+
+   static void setInputs() {}
+   static void configureDac(uint8_t, CmpDacSource) {}
+   static void selectInputs(int, int) {}
+   static void enableInterrupts(CmpInterrupt) {}
+   static void enableNvicInterrupts(NvicPriority = NvicPriority_Normal) {}
+   static void disableNvicInterrupts() {}
+
+   /**
+    * Set comparator call-back
+    *
+    * @param cb Call-back to execute
+    */
+   static void setCallback(CmpCallbackFunction cb) {
+      callback = cb;
+   }
+
+   /// Comparator input pin
+   template<int input>
+   class Pin {};
+};
+
+/**
+ * Comparator 0
+ */
+class Cmp0 : public CmpBase_T<0> {
+
+public:
+   /**
+    * Select CMP0 inputs
+    */
+   enum Input {
+      Input_Ptc7                = 1, ///< Mapped pin PTC7(p52)
+      Input_ZeroCrossingInput   = 1, ///< Mapped pin PTC7(p52)
+      Input_CmpDac              = 7, ///< Fixed pin  CMP_DAC(Internal)
+   };
+};
+
+/**
+ * Comparator 2
+ */
+class Cmp2 : public CmpBase_T<2> {
+
+public:
+   /**
+    * Select CMP2 inputs
+    */
+   enum Input {
+      Input_Pta13               = 1, ///< Mapped pin PTA13(p29)
+      Input_Overcurrent         = 1, ///< Mapped pin PTA13(p29)
+      Input_CmpDac              = 7, ///< Fixed pin  CMP_DAC(Internal)
+   };
+};
+
+} // End namespace USBDM
+
+#endif /* HEADER_CMP_H_ */
@@ -0,0 +1,115 @@
+/**
+ * @file     console.h (SolderingStation_V4_Simulation/Project_Headers/console.h)
+ * @brief    Host replacement for USBDM console
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ *
+ * The console writes to a host stream which may be changed by the simulation
+ * (output is discarded by default).
+ * DMA transmission is handled by the simulator (see dma.h).
+ */
+
+#ifndef INCLUDE_USBDM_CONSOLE_H_
+#define INCLUDE_USBDM_CONSOLE_H_
+
+#include <stdio.h>
+#include "formatted_io.h"
+
+// The following macros allow the selective use of the console routines
+#define NUM_ARGS_(_1, _2, _3, _4, _5, _6, TOTAL, ...) TOTAL
+#define NUM_ARGS(...) NUM_ARGS_(__VA_ARGS__, 6, 5, 4, 3, 2, 1)
+
+#define CONCATE_(X, Y) X##Y
+#define CONCATE(MACRO, NUMBER) CONCATE_(MACRO, NUMBER)
+#define VA_MACRO(MACRO, ...) CONCATE(MACRO, NUM_ARGS(__VA_ARGS__))(__VA_ARGS__)
+
+#define WRITE(...)   VA_MACRO(WRITE, __VA_ARGS__)
+#define WRITELN(...) VA_MACRO(WRITELN, __VA_ARGS__)
+
+#if defined(DEBUG_BUILD) && USE_CONSOLE
+#define WRITE1(_1)           write(_1)
+#define WRITE2(_1, _2)       write(_1,_2)
+#define WRITE3(_1, _2, _3)   write(_1,_2,_3)
+#define WRITELN1(_1)         writeln(_1)
+#define WRITELN2(_1, _2)     writeln(_1,_2)
+#define WRITELN3(_1, _2, _3) writeln(_1,_2,_3)
+#else
+#define WRITE1(_1)           null()
+#define WRITE2(_1, _2)       null()
+#define WRITE3(_1, _2, _3)   null()
+#define WRITELN1(_1)         null()
+#define WRITELN2(_1, _2)     null()
+#define WRITELN3(_1, _2, _3) null()
+#endif
+
+/**
+ * UART registers (only the address of the data register is used)
+ */
+struct UART_Type {
+   volatile uint8_t D;
+};
+
+namespace USBDM {
+
+/**
+ * UART DMA requests
+ */
+enum UartDma {
+   UartDma_TxHoldingEmpty  = (1<<7),  //!< DMA request on Transmit holding register empty
+   UartDma_RxFull          = (1<<5),  //!< DMA request on Receive holding full
+};
+
+/**
+ * Console writing to a host stream
+ */
+class Console : public FormattedIO {
+
+private:
+   /// Stream to write to (nullptr => discard)
+   FILE *fStream = nullptr;
+
+   /// Simulated registers
+   UART_Type fRegisters = {};
+
+protected:
+   virtual void _writeChar(char ch) override {
+      if (fStream != nullptr) {
+         fputc(ch, fStream);
+      }
+   }
+
+public:
+   /// Simulated UART hardware
+   UART_Type *const uart = &fRegisters;
+
+   Console() {}
+
+   /**
+    * Enable DMA requests (no effect - see dma.h)
+    */
+   void enableDma(UartDma, bool =true) {}
+
+   /**
+    * Set host stream for console output
+    *
+    * @param stream Stream to use (nullptr => discard output)
+    */
+   void setStream(FILE *stream) {
+      fStream = stream;
+   }
+
+   virtual FormattedIO &flushOutput() override {
+      if (fStream != nullptr) {
+         fflush(fStream);
+      }
+      return *this;
+   }
+};
+
+//! Console instance
+extern Console console;
+
+} // End namespace USBDM
+
+#endif /* INCLUDE_USBDM_CONSOLE_H_ */
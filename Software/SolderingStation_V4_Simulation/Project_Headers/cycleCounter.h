@@ -0,0 +1,50 @@
+/**
+ * @file     cycleCounter.h (SolderingStation_V4_Simulation/Project_Headers/cycleCounter.h)
+ * @brief    Host replacement for DWT cycle counter
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef HEADER_CYCLECOUNTER_H_
+#define HEADER_CYCLECOUNTER_H_
+
+#include <stdint.h>
+#include <chrono>
+
+namespace USBDM {
+
+/**
+ * Free-running count based on the host steady clock.
+ * The count is in nanoseconds of host (wall) time i.e. it measures
+ * the execution time of the code on the host, not simulated time.
+ */
+class CycleCounter {
+
+public:
+   static void enable() {
+   }
+
+   /**
+    * Get current count
+    *
+    * @return Count in nanoseconds (wraps as for the target)
+    */
+   static uint32_t getCount() {
+      return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+   }
+
+   /**
+    * Get frequency of the counter
+    *
+    * @return Frequency in Hz
+    */
+   static float getFrequency() {
+      return 1.0E9;
+   }
+};
+
+} // End namespace USBDM
+
+#endif /* HEADER_CYCLECOUNTER_H_ */
@@ -0,0 +1,46 @@
+/**
+ * @file     delay.h (SolderingStation_V4_Simulation/Project_Headers/delay.h)
+ * @brief    Host replacement for USBDM busy-wait delays
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef INCLUDE_USBDM_DELAY_H_
+#define INCLUDE_USBDM_DELAY_H_
+
+#include <stdint.h>
+#include "derivative.h"
+
+namespace USBDM {
+
+/**
+ * Simple delay routine
+ *
+ * @param[in] usToWait How many microseconds to busy-wait
+ */
+inline void waitUS(uint32_t usToWait) {
+   Simulation::delay(usToWait/1000000.0f);
+}
+
+/**
+ * Simple delay routine
+ *
+ * @param[in]  msToWait How many milliseconds to busy-wait
+ */
+inline void waitMS(uint32_t msToWait) {
+   Simulation::delay(msToWait/1000.0f);
+}
+
+/**
+ * Simple delay routine
+ *
+ * @param[in]  seconds How many seconds to busy-wait
+ */
+inline void wait(float seconds) {
+   Simulation::delay(seconds);
+}
+
+} // End namespace USBDM
+
+#endif /* INCLUDE_USBDM_DELAY_H_ */
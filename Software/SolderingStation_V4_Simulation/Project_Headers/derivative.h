@@ -0,0 +1,21 @@
+/**
+ * @file     derivative.h (SolderingStation_V4_Simulation/Project_Headers/derivative.h)
+ * @brief    Host replacement for device header
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef PROJECT_HEADERS_DERIVATIVE_H_
+#define PROJECT_HEADERS_DERIVATIVE_H_
+
+#include <stdint.h>
+#include "SimulatedHardware.h"
+
+/// Break-point stops the simulation
+#define __BKPT(...) Simulation::breakpoint("__BKPT()")
+
+/// Interrupt numbers are not used by the host build
+typedef int IRQn_Type;
+
+#endif /* PROJECT_HEADERS_DERIVATIVE_H_ */
@@ -0,0 +1,133 @@
+/**
+ * @file     dma.h (SolderingStation_V4_Simulation/Project_Headers/dma.h)
+ * @brief    Host replacement for USBDM DMA (UART transmit only)
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ *
+ * A transfer is passed to the simulator when requests are enabled.
+ * The simulator accounts for the UART time, captures the data and executes
+ * USBDM::Dma0::irqHandler<channel>() when the major loop completes.
+ * Only memory to peripheral transfers of bytes are modelled.
+ */
+
+#ifndef HEADER_DMA_H_
+#define HEADER_DMA_H_
+
+#include "pin_mapping.h"
+#include "SimulatedHardware.h"
+
+namespace USBDM {
+
+enum DmaChannelNum : unsigned {
+   DmaChannelNum_0, DmaChannelNum_1, DmaChannelNum_2, DmaChannelNum_3,
+   DmaChannelNum_None = (1<<7),
+};
+enum DmaSize    { DmaSize_8bit = 0b000, DmaSize_16bit = 0b001, DmaSize_32bit = 0b010, };
+enum DmaModulo  { DmaModulo_Disabled = 0b00000, };
+enum DmaSlot    { Dma0Slot_UART0_Tx = 3, };
+
+typedef void (*DmaCallbackFunction)(DmaChannelNum dmaChannelNum);
+
+/**
+ * Transfer control descriptor (subset of fields used)
+ */
+struct DmaTcd {
+   uintptr_t SADDR;
+   uint16_t  CITER;
+   bool      interruptOnMajorComplete;
+
+   constexpr DmaTcd(
+         uintptr_t     sourceAddress,
+         int16_t       /* sourceOffset */,
+         DmaSize       /* sourceSize */,
+         DmaModulo     /* sourceModulo */,
+         int32_t       /* lastSourceAdjustment */,
+
+         uintptr_t     /* destinationAddress */,
+         int16_t       /* destinationOffset */,
+         DmaSize       /* destinationSize */,
+         DmaModulo     /* destinationModulo */,
+         int32_t       /* lastDestinationAdjustment */,
+
+         uint32_t      /* minorLoopByteCount */,
+         uint16_t      majorLoopCount,
+
+         bool          /* startChannel */,
+         bool          /* disableRequestOnCompletion */,
+         bool          interruptOnMajorComplete) :
+      SADDR(sourceAddress), CITER(majorLoopCount), interruptOnMajorComplete(interruptOnMajorComplete) {
+   }
+
+   constexpr DmaTcd() : SADDR(0), CITER(0), interruptOnMajorComplete(false) {}
+};
+
+/**
+ * Simulated DMA controller
+ *
+ * @tparam NumChannels Number of channels modelled
+ */
+template<unsigned NumChannels>
+class DmaBase_T {
+
+   /// Call-backs for each channel
+   static inline DmaCallbackFunction sCallbacks[NumChannels] = {};
+
+   /// Transfer for each channel
+   static inline DmaTcd sTcds[NumChannels] = {};
+
+public:
+   static void configure() {
+      for (unsigned channel=0; channel<NumChannels; channel++) {
+         sCallbacks[channel] = nullptr;
+         sTcds[channel]      = DmaTcd();
+      }
+   }
+
+   static void setCallback(DmaChannelNum dmaChannelNum, DmaCallbackFunction callback) {
+      sCallbacks[dmaChannelNum] = callback;
+   }
+
+   static void enableNvicInterrupts(DmaChannelNum, uint32_t = NvicPriority_Normal) {}
+
+   static void configureTransfer(DmaChannelNum dmaChannelNum, const DmaTcd &tcd) {
+      sTcds[dmaChannelNum] = tcd;
+   }
+
+   /**
+    * Enable hardware requests.
+    * The peripheral (UART) is assumed to be requesting so the transfer starts immediately.
+    */
+   static void enableRequests(DmaChannelNum dmaChannelNum, bool enable=true) {
+      if (enable) {
+         const DmaTcd &tcd = sTcds[dmaChannelNum];
+         Simulation::uartDmaStartTransmit(dmaChannelNum, tcd.CITER, reinterpret_cast<const uint8_t *>(tcd.SADDR));
+      }
+   }
+
+   static void clearInterruptRequest(DmaChannelNum) {}
+
+   /**
+    * Executed by simulator when major loop completes
+    */
+   template<unsigned channel>
+   static void irqHandler() {
+      if (sTcds[channel].interruptOnMajorComplete && (sCallbacks[channel] != nullptr)) {
+         sCallbacks[channel]((DmaChannelNum)channel);
+      }
+   }
+};
+
+/**
+ * Simulated DMA multiplexor (no effect)
+ */
+class DmaMux0 {
+public:
+   static void configure(DmaChannelNum, DmaSlot) {}
+};
+
+using Dma0 = DmaBase_T<4>;
+
+} // End namespace USBDM
+
+#endif /* HEADER_DMA_H_ */
@@ -0,0 +1,180 @@
+/**
+ * @file     flash.h (SolderingStation_V4_Simulation/Project_Headers/flash.h)
+ * @brief    Host replacement for USBDM Flash and FlexRAM non-volatile variables
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ *
+ * Non-volatile variables are held in ordinary RAM.
+ * The EEPROM always reports that it has just been partitioned so
+ * the firmware initialises all settings to their defaults.
+ */
+
+#ifndef SOURCES_FLASH_H_
+#define SOURCES_FLASH_H_
+
+#include <string.h>
+#include "pin_mapping.h"
+
+namespace USBDM {
+
+/**
+ * Error codes for Flash operations
+ */
+enum FlashDriverError_t {
+   FLASH_ERR_OK                = (0),
+   FLASH_ERR_ILLEGAL_PARAMS    = (2),  // Parameters illegal
+   FLASH_ERR_NEW_EEPROM        = (15), // Indicates EEPROM has just been partitioned and needs initialisation
+};
+
+/**
+ * Simulated Flash controller
+ */
+class Flash {
+
+protected:
+   Flash() {}
+
+public:
+   /// EEPROM Data Size choice
+   enum EepromSel { EepromSel_1KBytes, };
+
+   /// FlexNVM Partition choice
+   enum PartitionSel { PartitionSel_flash0K_eeprom32K, };
+
+   /// Split between A/B Flash portions
+   enum SplitSel { SplitSel_disabled, };
+
+   /**
+    * Initialise the EEPROM.
+    *
+    * @return FLASH_ERR_NEW_EEPROM => EEPROM contents are not initialised
+    */
+   template<EepromSel, PartitionSel, SplitSel>
+   static FlashDriverError_t initialiseEeprom() {
+      return FLASH_ERR_NEW_EEPROM;
+   }
+
+   /**
+    * Wait until FlexRAM is idle (no delay in simulation)
+    */
+   static void waitUntilFlexIdle() {}
+};
+
+/**
+ * Class to wrap a scalar variable allocated within the FlexRam area.
+ *
+ * @tparam T Scalar type for variable
+ */
+template <typename T>
+class Nonvolatile {
+
+   static_assert((sizeof(T) == 1)||(sizeof(T) == 2)||(sizeof(T) == 4)||(sizeof(T) == sizeof(void*)),
+         "Size of non-volatile object must be 1, 2 or 4 bytes in size");
+
+   // Don't allow construction of copies
+   Nonvolatile(const Nonvolatile<T> &) = delete;
+
+private:
+   /// Data value
+   T data;
+
+public:
+   /// Erased FlexRAM reads as 0xFF
+   Nonvolatile() {
+      memset(&data, 0xFF, sizeof(data));
+   }
+
+   Nonvolatile<T> &operator=(const Nonvolatile<T> &other) {
+      data = (T)other;
+      return *this;
+   }
+   Nonvolatile<T> &operator=(const T &other) {
+      data = other;
+      return *this;
+   }
+   Nonvolatile<T> &operator+=(const Nonvolatile<T> &change) {
+      data += (T)change;
+      return *this;
+   }
+   Nonvolatile<T> &operator+=(const T &change) {
+      data += change;
+      return *this;
+   }
+   Nonvolatile<T> &operator-=(const Nonvolatile<T> &change) {
+      data -= (T)change;
+      return *this;
+   }
+   Nonvolatile<T> &operator-=(const T &change) {
+      data -= change;
+      return *this;
+   }
+   operator const T() const {
+      return data;
+   }
+};
+
+/**
+ * Class to wrap an array of scalar variables allocated to the FlexRam area.
+ *
+ * @tparam T         Scalar type for element
+ * @tparam dimension Dimension of array
+ */
+template <typename T, int dimension>
+class NonvolatileArray {
+
+private:
+   using TArray = T[dimension];
+   using TPtr   = const T(*);
+
+   /// Array of elements
+   T data[dimension];
+
+public:
+   /// Erased FlexRAM reads as 0xFF
+   NonvolatileArray() {
+      memset(data, 0xFF, sizeof(data));
+   }
+
+   NonvolatileArray &operator=(const TArray &other) {
+      for (int index=0; index<dimension; index++) {
+         data[index] = other[index];
+      }
+      return *this;
+   }
+
+   NonvolatileArray &operator=(const NonvolatileArray &other) {
+      *this = other.data;
+      return *this;
+   }
+
+   void copyTo(T *other) const {
+      for (int index=0; index<dimension; index++) {
+         other[index] = data[index];
+      }
+   }
+
+   Nonvolatile<T> &operator [](int index) const {
+      usbdm_assert(static_cast<unsigned>(index)<dimension, "Index out of range");
+      return *(Nonvolatile<T> *)(&data[index]);
+   }
+
+   operator TPtr() const {
+      return data;
+   }
+
+   void set(unsigned index, T value) {
+      usbdm_assert(static_cast<unsigned>(index)<dimension, "Index out of range");
+      data[index] = value;
+   }
+
+   void set(T value) {
+      for (int index=0; index<dimension; index++) {
+         set(index, value);
+      }
+   }
+};
+
+} // End namespace USBDM
+
+#endif /* SOURCES_FLASH_H_ */
@@ -0,0 +1,145 @@
+/**
+ * @file     ftm.h (SolderingStation_V4_Simulation/Project_Headers/ftm.h)
+ * @brief    Host replacement for USBDM FTM (quadrature decoder mode only)
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef HEADER_FTM_H_
+#define HEADER_FTM_H_
+
+#include "pin_mapping.h"
+#include "gpio.h"
+
+namespace USBDM {
+
+enum FtmPrescale {
+   FtmPrescale_1, FtmPrescale_2, FtmPrescale_4, FtmPrescale_8, FtmPrescale_16, FtmPrescale_32, FtmPrescale_64, FtmPrescale_128,
+};
+enum FtmQuadratureMode { FtmQuadratureMode_Phase_AB_Mode, FtmQuadratureMode_Count_Direction_Mode, };
+enum FtmClockSource    { FtmClockSource_Disabled, FtmClockSource_System, FtmClockSource_Fixed, FtmClockSource_External, };
+
+/**
+ * Simulated FTM as quadrature decoder (phase A/B mode).
+ *
+ * The decoder samples the simulated port pins directly once they are mapped by setInput().
+ * The counter changes by one on each valid edge while the FTM clock is running.
+ * The input filter is not modelled.
+ *
+ * @tparam Info      Port information e.g. GpioBInfo
+ * @tparam phaBit    Pin used for phase A
+ * @tparam phbBit    Pin used for phase B
+ */
+template<class Info, unsigned phaBit, unsigned phbBit>
+class FtmQuadDecoder_T {
+
+   /// Counter (CNT)
+   static inline uint16_t counter = 0;
+
+   /// Counter maximum (MOD)
+   static inline uint16_t modulo = 0;
+
+   /// Clock selected (counter only changes while clocked)
+   static inline FtmClockSource clockSource = FtmClockSource_Disabled;
+
+   /// Phase inputs are inverted
+   static inline bool inverted = false;
+
+   /// Last phase state as position in quadrature sequence (0-3)
+   static inline unsigned lastStep = 0;
+
+   /**
+    * Convert pins to position in quadrature sequence.
+    * Counting up, phase A leads i.e. AB = 00->10->11->01.
+    *
+    * @param pins Port pins
+    *
+    * @return Position in sequence (0-3)
+    */
+   static unsigned sequenceStep(uint32_t pins) {
+      static constexpr unsigned steps[] = {0, 3, 1, 2};
+      bool a = (pins>>phaBit)&1;
+      bool b = (pins>>phbBit)&1;
+      if (inverted) {
+         a = !a;
+         b = !b;
+      }
+      return steps[(a<<1)|b];
+   }
+
+   /**
+    * Monitors pin changes as the hardware decoder
+    *
+    * @param pins Port pins
+    */
+   static void pinsChanged(uint32_t pins) {
+      unsigned step = sequenceStep(pins);
+      unsigned delta = (step-lastStep)&3;
+      lastStep = step;
+      if (clockSource == FtmClockSource_Disabled) {
+         return;
+      }
+      if (delta == 1) {
+         counter = (counter == modulo)?0:counter+1;
+      }
+      else if (delta == 3) {
+         counter = (counter == 0)?modulo:counter-1;
+      }
+      // delta == 2 is an invalid transition and is ignored
+   }
+
+public:
+   /// Simulated port
+   static SimulatedPort &port() { return simulatedPorts[Info::portIndex]; }
+
+   /**
+    * Subset of FTM shared by quadrature decoder
+    */
+   class Ftm {
+   public:
+      static void setClockSource(FtmClockSource ftmClockSource=FtmClockSource_System) {
+         clockSource = ftmClockSource;
+      }
+      static void setCounterMaximumValue(Ticks endValue, bool =false) {
+         modulo = static_cast<uint16_t>(endValue);
+      }
+   };
+
+   /**
+    * Map pins to decoder
+    */
+   template<typename... Types>
+   static void setInput(Types...) {
+      port().PDDR &= ~((1U<<phaBit)|(1U<<phbBit));
+      port().setIrq((1U<<phaBit)|(1U<<phbBit), false);
+      port().peripheral = pinsChanged;
+      lastStep = sequenceStep(port().pins());
+   }
+
+   static void setPolarity(Polarity polarity) {
+      inverted = (polarity == ActiveLow);
+      lastStep = sequenceStep(port().pins());
+   }
+
+   static void configure(FtmPrescale = FtmPrescale_1, FtmQuadratureMode = FtmQuadratureMode_Phase_AB_Mode) {
+      clockSource = FtmClockSource_Disabled;
+   }
+
+   static void enableFilter(int =7) {}
+
+   static void resetPosition() {
+      counter = 0;
+   }
+
+   static int16_t getPosition() {
+      return (int16_t)counter;
+   }
+};
+
+/// FTM1 as quadrature decoder (PTB0 = PHA, PTB1 = PHB)
+using FtmQuadDecoder1 = FtmQuadDecoder_T<GpioBInfo, 0, 1>;
+
+} // End namespace USBDM
+
+#endif /* HEADER_FTM_H_ */
@@ -0,0 +1,371 @@
+/**
+ * @file     gpio.h (SolderingStation_V4_Simulation/Project_Headers/gpio.h)
+ * @brief    Host replacement for USBDM GPIO
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ *
+ * Each port is represented by a set of simulated registers (PDOR/PDIR/PDDR).
+ * The simulator drives PDIR (inputs) and observes PDOR/PDDR (outputs).
+ */
+
+#ifndef HEADER_GPIO_H
+#define HEADER_GPIO_H
+
+#include <stdint.h>
+#include <type_traits>
+#include "pin_mapping.h"
+
+namespace USBDM {
+
+/**
+ * Simulated GPIO port
+ */
+struct SimulatedPort {
+   /// Port Data Output Register
+   uint32_t PDOR;
+
+   /// Port Data Input Register (driven by simulation, defaults to pulled-up)
+   uint32_t PDIR;
+
+   /// Port Data Direction Register (1 => output)
+   uint32_t PDDR;
+
+   /// Pin change call-back
+   PinCallbackFunction callback;
+
+   /// Pins with pin-change interrupts enabled
+   uint32_t irqMask;
+
+   /// Peripheral sampling the pins directly e.g. FTM quadrature decoder (called with pins on any input change)
+   PinCallbackFunction peripheral;
+
+   /**
+    * Level seen on port pins.
+    * Pins configured as outputs reflect PDOR, inputs reflect PDIR.
+    */
+   uint32_t pins() const {
+      return (PDOR&PDDR)|(PDIR&~PDDR);
+   }
+
+   /**
+    * Called by simulation to change input pins
+    * Executes pin call-back if any of the pins with interrupts enabled change.
+    * Any peripheral sampling the pins sees every change.
+    *
+    * @param mask    Pins being changed
+    * @param value   New value for pins
+    *
+    * @return true if a pin-change interrupt occurred
+    */
+   bool setInputs(uint32_t mask, uint32_t value) {
+      uint32_t changed = (PDIR^value)&mask&irqMask;
+      bool     inputChanged = ((PDIR^value)&mask) != 0;
+      PDIR = (PDIR&~mask)|(value&mask);
+      if (inputChanged && (peripheral != nullptr)) {
+         peripheral(pins());
+      }
+      if (changed && (callback != nullptr)) {
+         callback(changed);
+         return true;
+      }
+      return false;
+   }
+
+   /**
+    * Enable or disable pin-change interrupts from pins
+    *
+    * @param mask    Pins being configured
+    * @param enable  true to enable interrupts
+    */
+   void setIrq(uint32_t mask, bool enable) {
+      irqMask = enable?(irqMask|mask):(irqMask&~mask);
+   }
+
+};
+
+/// Simulated ports A-E
+extern SimulatedPort simulatedPorts[5];
+
+/**
+ * Check if a pin option enables pin-change interrupts
+ *
+ * @param option Pin option e.g. PinPull_Up, PinAction_IrqEither
+ *
+ * @return true if option is a PinAction other than PinAction_None
+ */
+template<typename T>
+constexpr bool isPinIrq(T option) {
+   if constexpr (std::is_same_v<T, PinAction>) {
+      return option != PinAction_None;
+   }
+   else {
+      return false;
+   }
+}
+
+/// Port A information
+class GpioAInfo { public: static constexpr unsigned portIndex = 0; };
+/// Port B information
+class GpioBInfo { public: static constexpr unsigned portIndex = 1; };
+/// Port C information
+class GpioCInfo { public: static constexpr unsigned portIndex = 2; };
+/// Port D information
+class GpioDInfo { public: static constexpr unsigned portIndex = 3; };
+/// Port E information
+class GpioEInfo { public: static constexpr unsigned portIndex = 4; };
+
+/**
+ * Virtual-free base class for a single GPIO pin
+ */
+class Gpio {
+
+   Gpio(const Gpio&) = delete;
+   Gpio(Gpio&&) = delete;
+
+public:
+   /// Underlying GPIO hardware
+   SimulatedPort * const gpio;
+
+   /// Mask for GPIO bit being manipulated
+   const uint32_t bitMask;
+
+   /// Mask to flip bit if active low (0 otherwise)
+   const uint32_t flipMask;
+
+protected:
+   constexpr Gpio(SimulatedPort *gpio, uint8_t bitNo, Polarity polarity) :
+      gpio(gpio), bitMask(1<<bitNo), flipMask((polarity == ActiveLow)?(1<<bitNo):0) {
+   }
+
+public:
+   /// Make pin an input
+   void setIn()  const { gpio->PDDR &= ~bitMask; }
+
+   /// Make pin an output
+   void setOut() const { gpio->PDDR |= bitMask; }
+
+   /// Set pin high
+   void high()   const { gpio->PDOR |= bitMask; }
+
+   /// Set pin low
+   void low()    const { gpio->PDOR &= ~bitMask; }
+
+   /// Toggle pin
+   void toggle() const { gpio->PDOR ^= bitMask; }
+
+   /// Set pin to active level
+   void on()     const { gpio->PDOR = (gpio->PDOR&~bitMask)|(bitMask^flipMask); }
+
+   /// Set pin to inactive level
+   void off()    const { gpio->PDOR = (gpio->PDOR&~bitMask)|flipMask; }
+
+   /**
+    * Set pin as active or inactive
+    *
+    * @param value true => active, false => inactive
+    */
+   void write(bool value) const {
+      if (value) {
+         on();
+      }
+      else {
+         off();
+      }
+   }
+
+   /// Read pin level
+   bool isHigh() const { return gpio->pins() & bitMask; }
+
+   /// Read pin level
+   bool isLow()  const { return !isHigh(); }
+
+   /// Read pin as active/inactive
+   bool read()   const { return (gpio->pins()^flipMask) & bitMask; }
+
+   /// Read output latch as active/inactive
+   bool readState() const { return (gpio->PDOR^flipMask) & bitMask; }
+};
+
+/**
+ * Template representing a single GPIO pin
+ *
+ * @tparam Info      Port information
+ * @tparam bitNum    Bit number in port
+ * @tparam polarity  Polarity of pin
+ */
+template<class Info, const uint32_t bitNum, Polarity polarity>
+class GpioTable_T : public Gpio {
+
+public:
+   constexpr GpioTable_T() : Gpio(&simulatedPorts[Info::portIndex], bitNum, polarity) {}
+
+   /// Bit number of pin in port
+   static constexpr unsigned BITNUM   = bitNum;
+
+   /// Mask for pin in port
+   static constexpr uint32_t BITMASK  = 1U<<bitNum;
+
+   /// Mask to flip pin if active-low
+   static constexpr uint32_t FLIP_MASK = (polarity == ActiveLow)?BITMASK:0;
+
+   /// Simulated port
+   static SimulatedPort &port() { return simulatedPorts[Info::portIndex]; }
+
+   /// Configure as output (pin options are ignored)
+   template<typename... Types>
+   static void setOutput(Types...) { port().PDDR |= BITMASK; }
+
+   /// Configure as input (pin options are ignored)
+   template<typename... Types>
+   static void setInput(Types...) { port().PDDR &= ~BITMASK; }
+
+   static void setIn()  { port().PDDR &= ~BITMASK; }
+   static void setOut() { port().PDDR |= BITMASK; }
+   static void high()   { port().PDOR |= BITMASK; }
+   static void low()    { port().PDOR &= ~BITMASK; }
+   static void toggle() { port().PDOR ^= BITMASK; }
+   static void on()     { port().PDOR = (port().PDOR&~BITMASK)|(BITMASK^FLIP_MASK); }
+   static void off()    { port().PDOR = (port().PDOR&~BITMASK)|FLIP_MASK; }
+
+   static void write(bool value) {
+      if (value) {
+         on();
+      }
+      else {
+         off();
+      }
+   }
+
+   static bool isHigh()    { return port().pins() & BITMASK; }
+   static bool isLow()     { return !isHigh(); }
+   static bool read()      { return (port().pins()^FLIP_MASK) & BITMASK; }
+   static bool readState() { return (port().PDOR^FLIP_MASK) & BITMASK; }
+};
+
+/**
+ * Virtual-free base class for a GPIO bit field
+ */
+class GpioField {
+
+public:
+   /// Underlying GPIO hardware
+   SimulatedPort * const gpio;
+
+   /// Mask for GPIO bits being manipulated
+   const uint32_t bitMask;
+
+   /// Mask to flip bit values if active low (0 otherwise)
+   const uint32_t flipMask;
+
+   /// Offset of bit field in GPIO hardware
+   const uint8_t  right;
+
+protected:
+   constexpr GpioField(SimulatedPort *gpio, uint32_t bitMask, unsigned right, uint32_t flipMask) :
+      gpio(gpio), bitMask(bitMask), flipMask(flipMask), right(right) {
+   }
+
+public:
+   /// Make field an input
+   void setIn()  const { gpio->PDDR &= ~bitMask; }
+
+   /// Make field an output
+   void setOut() const { gpio->PDDR |= bitMask; }
+
+   /// Read field (active bits)
+   uint32_t read() const {
+      return ((gpio->pins()^flipMask)&bitMask)>>right;
+   }
+
+   /// Read field (raw bits)
+   uint32_t bitRead() const {
+      return (gpio->pins()&bitMask)>>right;
+   }
+
+   /// Write field (active bits)
+   void write(uint32_t value) const {
+      gpio->PDOR = (gpio->PDOR&~bitMask)|(((value<<right)^flipMask)&bitMask);
+   }
+
+   /// Active bits being driven i.e. pins configured as output and active
+   uint32_t readState() const {
+      return (((gpio->PDOR^flipMask)&gpio->PDDR)&bitMask)>>right;
+   }
+};
+
+/**
+ * Template representing a GPIO bit field
+ *
+ * @tparam Info      Port information
+ * @tparam Left      Left-most bit in port
+ * @tparam Right     Right-most bit in port
+ * @tparam polarity  Polarity of bits. ActiveHigh, ActiveLow or bit mask of active-low bits
+ */
+template<class Info, unsigned Left, unsigned Right, uint32_t polarity>
+class GpioFieldTable_T : public GpioField {
+
+public:
+   /// Left-most bit
+   static constexpr unsigned LEFT    = Left;
+
+   /// Right-most bit
+   static constexpr unsigned RIGHT   = Right;
+
+   /// Mask for field in port
+   static constexpr uint32_t BITMASK = static_cast<uint32_t>((1ULL<<(Left-Right+1))-1)<<Right;
+
+   /// Mask to flip active-low bits
+   static constexpr uint32_t FLIP_MASK = (polarity == ActiveLow)?BITMASK:((polarity<<Right)&BITMASK);
+
+   constexpr GpioFieldTable_T() : GpioField(&simulatedPorts[Info::portIndex], BITMASK, Right, FLIP_MASK) {}
+
+   /// Simulated port
+   static SimulatedPort &port() { return simulatedPorts[Info::portIndex]; }
+
+   /// Configure as output (pin options are ignored)
+   template<typename... Types>
+   static void setOutput(Types...) { port().PDDR |= BITMASK; }
+
+   /// Configure as input (only PinAction is modelled i.e. pin-change interrupts)
+   template<typename... Types>
+   static void setInput(Types... options) {
+      port().PDDR &= ~BITMASK;
+      port().setIrq(BITMASK, (isPinIrq(options) || ...));
+   }
+
+   static void setIn()  { port().PDDR &= ~BITMASK; }
+   static void setOut() { port().PDDR |= BITMASK; }
+
+   static uint32_t read() {
+      return ((port().pins()^FLIP_MASK)&BITMASK)>>Right;
+   }
+
+   static uint32_t bitRead() {
+      return (port().pins()&BITMASK)>>Right;
+   }
+
+   static void write(uint32_t value) {
+      port().PDOR = (port().PDOR&~BITMASK)|(((value<<Right)^FLIP_MASK)&BITMASK);
+   }
+
+   static uint32_t readState() {
+      return (((port().PDOR^FLIP_MASK)&port().PDDR)&BITMASK)>>Right;
+   }
+
+   /**
+    * Set pin-change call-back for the port
+    *
+    * @param callback Call-back to execute
+    */
+   static void setPinCallback(PinCallbackFunction callback) {
+      port().callback = callback;
+   }
+
+   static void enableNvicInterrupts(NvicPriority = NvicPriority_Normal) {}
+   static void disableNvicInterrupts() {}
+};
+
+} // End namespace USBDM
+
+#endif /* HEADER_GPIO_H */
@@ -0,0 +1,187 @@
+/**
+ * @file     i2c.h (SolderingStation_V4_Simulation/Project_Headers/i2c.h)
+ * @brief    Host replacement for USBDM I2C
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ *
+ * Transfers are passed to the simulator which accounts for the bus time.
+ * Non-blocking transfers complete with USBDM::I2c0::irqHandler() executed by the simulator.
+ */
+
+#ifndef HEADER_I2C_H
+#define HEADER_I2C_H
+
+#include "pin_mapping.h"
+
+namespace USBDM {
+
+/**
+ * Type definition for interrupt call back
+ */
+typedef void (*I2cCallbackFunction)();
+
+/**
+ * I2C mode
+ */
+enum I2cMode {
+   I2cMode_Polled,     //!< Operate in Polled mode
+   I2cMode_Interrupt,  //!< Operate in Interrupt mode
+};
+
+/**
+ * Simulated I2C interface
+ */
+class I2c {
+
+protected:
+   /// Bus speed
+   const unsigned bps;
+
+   /// Indicates a transaction started by startTransmit() is in progress
+   volatile bool busy = false;
+
+   /// Result of last transaction
+   ErrorCode errorCode = E_NO_ERROR;
+
+   I2c(unsigned bps) : bps(bps) {}
+
+public:
+   virtual ~I2c() {}
+
+   virtual ErrorCode startTransaction(int =0) {return E_NO_ERROR;};
+   virtual ErrorCode endTransaction() {return E_NO_ERROR;};
+
+   /**
+    * Transmit message
+    *
+    * @param[in]  address  Address of slave to communicate with (should include LSB = R/W bit = 0)
+    * @param[in]  size     Size of transmission data
+    * @param[in]  data     Data to transmit, 0th byte is often register address
+    *
+    * @return E_NO_ERROR on success
+    */
+   ErrorCode transmit(uint8_t address, uint16_t size, const uint8_t data[]) {
+      waitWhileBusy();
+      Simulation::i2cTransmit(address, size, data);
+      return E_NO_ERROR;
+   }
+
+   /**
+    * Transmit message
+    *
+    * @tparam txSize Number of bytes to transmit
+    *
+    * @param[in]  address  Address of slave to communicate with (should include LSB = R/W bit = 0)
+    * @param[in]  data     Data to transmit, 0th byte is often register address
+    *
+    * @return E_NO_ERROR on success
+    */
+   template<unsigned txSize>
+   ErrorCode transmit(uint8_t address, const uint8_t (&data)[txSize]) {
+      return transmit(address, txSize, data);
+   }
+
+   /**
+    * Start transmission of message without waiting for completion
+    *
+    * @param[in]  address  Address of slave to communicate with (should include LSB = R/W bit = 0)
+    * @param[in]  size     Size of transmission data
+    * @param[in]  data     Data to transmit, must remain unchanged until the transaction completes
+    *
+    * @return E_NO_ERROR on successful start of transaction
+    */
+   ErrorCode startTransmit(uint8_t address, uint16_t size, const uint8_t data[]) {
+      if (busy) {
+         Simulation::breakpoint("I2C transaction started while busy");
+      }
+      busy = true;
+      Simulation::i2cStartTransmit(address, size, data);
+      return E_NO_ERROR;
+   }
+
+   /**
+    * Start transmission of message without waiting for completion
+    *
+    * @tparam txSize Number of bytes to transmit
+    *
+    * @param[in]  address  Address of slave to communicate with (should include LSB = R/W bit = 0)
+    * @param[in]  data     Data to transmit, must remain unchanged until the transaction completes
+    *
+    * @return E_NO_ERROR on successful start of transaction
+    */
+   template<unsigned txSize>
+   ErrorCode startTransmit(uint8_t address, const uint8_t (&data)[txSize]) {
+      return startTransmit(address, txSize, data);
+   }
+
+   /**
+    * Indicates a transaction is in progress
+    *
+    * @return true if busy
+    */
+   bool isBusy() const {
+      return busy;
+   }
+
+   /**
+    * Get result of last transaction
+    *
+    * @return E_NO_ERROR on success
+    */
+   ErrorCode getErrorCode() const {
+      return errorCode;
+   }
+
+   /**
+    * Wait for current transaction to complete
+    */
+   void waitWhileBusy() {
+      while (busy) {
+         Simulation::waitForInterrupt();
+      }
+   }
+};
+
+/**
+ * Simulated I2C0
+ */
+class I2c0 : public I2c {
+
+   /// Used by ISR to obtain handle of object
+   static inline I2c0 *thisPtr = nullptr;
+
+   /// Callback function for ISR
+   static inline I2cCallbackFunction sCallback = nullptr;
+
+public:
+   I2c0(unsigned bps=400000, I2cMode =I2cMode_Polled, uint8_t =0) : I2c(bps) {
+      thisPtr = this;
+   }
+
+   /**
+    * Set callback executed when a transaction completes
+    *
+    * @param[in] callback Callback function to execute on interrupt
+    */
+   static void setCallback(I2cCallbackFunction callback) {
+      sCallback = callback;
+   }
+
+   /**
+    * Completion of a transaction started by startTransmit()
+    *
+    * @param[in] errorCode Result of transaction (e.g. E_NO_ACK)
+    */
+   static void irqHandler(ErrorCode errorCode=E_NO_ERROR) {
+      thisPtr->errorCode = errorCode;
+      thisPtr->busy      = false;
+      if (sCallback != nullptr) {
+         sCallback();
+      }
+   }
+};
+
+} // End namespace USBDM
+
+#endif /* HEADER_I2C_H */
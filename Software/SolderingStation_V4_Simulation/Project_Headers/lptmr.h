@@ -0,0 +1,85 @@
+/**
+ * @file     lptmr.h (SolderingStation_V4_Simulation/Project_Headers/lptmr.h)
+ * @brief    Host replacement for USBDM Low Power Timer
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef HEADER_LPTMR_H_
+#define HEADER_LPTMR_H_
+
+#include <math.h>
+#include "pin_mapping.h"
+
+namespace USBDM {
+
+/**
+ * Type definition for LPTMR interrupt call back
+ */
+typedef void (*LptmrCallbackFunction)(void);
+
+enum LptmrClockSel  { LptmrClockSel_Mcgirclk, LptmrClockSel_Lpoclk, LptmrClockSel_Erclk32, LptmrClockSel_Oscerclk, };
+enum LptmrResetOn   { LptmrResetOn_Compare,   LptmrResetOn_Overflow, };
+enum LptmrInterrupt { LptmrInterrupt_Disabled, LptmrInterrupt_Enabled, };
+
+/**
+ * Simulated Low Power Timer (time counting mode only).
+ * The timer runs from setPeriod() until disable().
+ */
+class Lptmr0 {
+
+public:
+   /// Call-back executed on each timeout
+   static inline LptmrCallbackFunction callback = nullptr;
+
+   static void configureTimeCountingMode(
+         LptmrResetOn   = LptmrResetOn_Compare,
+         LptmrInterrupt = LptmrInterrupt_Disabled,
+         LptmrClockSel  = LptmrClockSel_Lpoclk) {}
+
+   static void enableNvicInterrupts(NvicPriority = NvicPriority_Normal) {}
+   static void disableNvicInterrupts() {}
+
+   /**
+    * Set period of timer and start it
+    *
+    * @param period Period in seconds
+    *
+    * @return E_NO_ERROR
+    */
+   static ErrorCode setPeriod(Seconds period) {
+      Simulation::startLowPowerTimer(static_cast<uint32_t>(round(period*1000000)));
+      return E_NO_ERROR;
+   }
+
+   /**
+    * Stop timer
+    */
+   static void disable() {
+      Simulation::stopLowPowerTimer();
+   }
+
+   /**
+    * Set call-back
+    *
+    * @param cb Call-back to execute on timeout
+    */
+   static void setCallback(LptmrCallbackFunction cb) {
+      callback = cb;
+   }
+
+   /**
+    * LPTMR interrupt handler.
+    * Called by the simulator on each timeout.
+    */
+   static void irqHandler() {
+      if (callback != nullptr) {
+         callback();
+      }
+   }
+};
+
+} // End namespace USBDM
+
+#endif /* HEADER_LPTMR_H_ */
@@ -0,0 +1,188 @@
+/**
+ * @file     pin_mapping.h (SolderingStation_V4_Simulation/Project_Headers/pin_mapping.h)
+ * @brief    Host replacement for USBDM pin mapping and common definitions
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ *
+ * Provides the subset of pcr.h/pin_mapping.h used by the soldering station firmware.
+ * Register access is replaced by simple state or calls into the simulator.
+ *
+ * The include guard deliberately matches the real pin_mapping.h so that library
+ * headers shared with the target build (e.g. formatted_io.h) pick up this version.
+ */
+
+#ifndef PROJECT_HEADERS_PIN_MAPPING_H
+#define PROJECT_HEADERS_PIN_MAPPING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <limits.h>
+#include <math.h>
+#include <algorithm>
+#include "derivative.h"
+#include "error.h"
+
+#define NOINLINE_DEBUG
+
+#define USE_DIMENSION_CHECK false
+
+namespace USBDM {
+
+using Ticks    = unsigned;
+using Seconds  = float;
+using Hertz    = float;
+
+/*
+ * Allows writing numbers with units e.g. 100_ms
+ */
+constexpr auto operator"" _ticks(unsigned long long int num) { return static_cast<Ticks>((unsigned)num); };
+constexpr auto operator"" _ticks(long double num)            { return static_cast<Ticks>((float)num); };
+
+constexpr auto operator"" _s(unsigned long long int num)     { return static_cast<Seconds>(num); };
+constexpr auto operator"" _s(long double num)                { return static_cast<Seconds>(num); };
+
+constexpr auto operator"" _ms(unsigned long long int num)    { return static_cast<Seconds>(num*0.001); };
+constexpr auto operator"" _ms(long double num)               { return static_cast<Seconds>(num*0.001); };
+
+constexpr auto operator"" _us(unsigned long long int num)    { return static_cast<Seconds>(num*0.000001); };
+constexpr auto operator"" _us(long double num)               { return static_cast<Seconds>(num*0.000001); };
+
+constexpr auto operator"" _Hz(unsigned long long int num)    { return static_cast<Hertz>(num); };
+constexpr auto operator"" _Hz(long double num)               { return static_cast<Hertz>(num); };
+
+constexpr auto operator"" _kHz(unsigned long long int num)   { return static_cast<Hertz>(num*1000); };
+constexpr auto operator"" _kHz(long double num)              { return static_cast<Hertz>(num*1000); };
+
+/**
+ * Convenience names for common priority levels
+ */
+enum NvicPriority {
+   NvicPriority_VeryHigh     = 0,  //!< NvicPriority_VeryHigh
+   NvicPriority_High         = 2,  //!< NvicPriority_High
+   NvicPriority_MidHigh      = 5,  //!< NvicPriority_MidHigh
+   NvicPriority_Normal       = 8,  //!< NvicPriority_Normal
+   NvicPriority_Midlow       = 11, //!< NvicPriority_Midlow
+   NvicPriority_Low          = 13, //!< NvicPriority_Low
+   NvicPriority_VeryLow      = 15, //!< NvicPriority_VeryLow
+   NvicPriority_NotInstalled = -1, //!< Indicates handler is not installed
+};
+
+/**
+ * Polarity of signals
+ */
+enum Polarity : uint32_t {
+   ActiveLow  = 0xFFFFFFFFU,  //!< Signal is active low i.e. Active => Low level, Inactive => High level
+   ActiveHigh = 0x00000000U,  //!< Signal is active high i.e. Active => High level, Inactive => Low level
+};
+
+/// Pin pull device
+enum PinPull : uint32_t {
+   PinPull_None,  //!< No pull device
+   PinPull_Up,    //!< Weak pull-up
+   PinPull_Down,  //!< Weak pull-down
+};
+
+/// Pin drive strengths
+enum PinDriveStrength : uint32_t {
+   PinDriveStrength_Low,  //!< Low drive strength
+   PinDriveStrength_High, //!< High drive strength
+};
+
+/// Pin drive mode
+enum PinDriveMode : uint32_t {
+   PinDriveMode_PushPull,                           //!< Push-pull output
+   PinDriveMode_OpenDrain,                          //!< Open-drain output
+   PinDriveMode_OpenCollector = PinDriveMode_OpenDrain, //!< For oldies like me
+};
+
+/// Pin Slew rate control
+enum PinSlewRate : uint32_t {
+   PinSlewRate_Slow, //!< Slow slew rate on output
+   PinSlewRate_Fast, //!< Fast slew rate on output
+};
+
+/// Pin filter mode
+enum PinFilter : uint32_t {
+   PinFilter_None,     //!< No pin filter
+   PinFilter_Passive,  //!< Pin filter enabled
+};
+
+/// Pin interrupt/DMA action
+enum PinAction : uint32_t {
+   PinAction_None,        //!< No interrupt or DMA function
+   PinAction_IrqLow,      //!< Generate IRQ request when low
+   PinAction_IrqRising,   //!< Generate IRQ request on rising edge
+   PinAction_IrqFalling,  //!< Generate IRQ request on falling edge
+   PinAction_IrqEither,   //!< Generate IRQ request on either edge
+   PinAction_IrqHigh,     //!< Generate IRQ request when high
+};
+
+/// Type definition for PORT interrupt call back
+typedef void (*PinCallbackFunction)(uint32_t status);
+
+/**
+ * @tparam  T  Type of comparison object (inferred)
+ * @param   a  Left-hand object for comparison
+ * @param   b  Right-hand object for comparison
+ *
+ * @return Smaller of a or b
+ */
+template<class T>
+constexpr T min(const T a, const T b) {
+   return (b < a) ? b : a;
+}
+
+/**
+ * @tparam  T  Type of comparison object (inferred)
+ * @param   a  Left-hand object for comparison
+ * @param   b  Right-hand object for comparison
+ *
+ * @return Larger of a or b
+ */
+template<class T>
+constexpr T max(const T a, const T b) {
+   return (b > a) ? b : a;
+}
+
+/**
+ * Determine the number of elements in an array
+ *
+ * @tparam T      Deduced array type
+ * @tparam N      Deduced array size
+ *
+ * @return  Size of array in elements
+ */
+template<typename T, size_t N>
+constexpr size_t sizeofArray(T (&)[N]) {
+   return N;
+}
+
+/**
+ * Class to implement simple critical sections.
+ *
+ * Interrupts are not pre-emptive in the simulation so this is only used
+ * to mark where pending interrupts may be taken by main-line code
+ * i.e. at the end of the outermost critical section.
+ */
+class CriticalSection {
+
+private:
+   /// Depth of nested critical sections
+   static inline unsigned nesting = 0;
+
+public:
+   CriticalSection() {
+      nesting++;
+   }
+
+   ~CriticalSection() {
+      if (--nesting == 0) {
+         Simulation::preemptionPoint();
+      }
+   }
+};
+
+} // End namespace USBDM
+
+#endif /* PROJECT_HEADERS_PIN_MAPPING_H */
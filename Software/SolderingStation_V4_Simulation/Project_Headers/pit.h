@@ -0,0 +1,118 @@
+/**
+ * @file     pit.h (SolderingStation_V4_Simulation/Project_Headers/pit.h)
+ * @brief    Host replacement for USBDM Programmable Interrupt Timer
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef INCLUDE_USBDM_PIT_H_
+#define INCLUDE_USBDM_PIT_H_
+
+#include "pin_mapping.h"
+
+namespace USBDM {
+
+/**
+ * Type definition for PIT interrupt call back
+ */
+typedef void (*PitCallbackFunction)(void);
+
+/**
+ * Control PIT operation in debug mode (suspended for debugging)
+ */
+enum PitDebugMode {
+   PitDebugMode_Run  = 0,  //!< PIT continues to run in debug mode
+   PitDebugMode_Stop = 1,  //!< PIT stops in debug mode
+};
+
+/**
+ * Enable the PIT channel interrupt
+ */
+enum PitChannelIrq {
+   PitChannelIrq_Disabled  = 0,  //!< PIT channel interrupt disabled
+   PitChannelIrq_Enabled   = 1,  //!< PIT channel interrupt enabled
+};
+
+/**
+ * Simulated Programmable Interrupt Timer
+ */
+class Pit {
+
+public:
+   /// Number of PIT channels
+   static constexpr unsigned NUMBER_OF_CHANNELS = 4;
+
+   /// Call-backs for each channel
+   static inline PitCallbackFunction callbacks[NUMBER_OF_CHANNELS] = {};
+
+   /**
+    * PIT channel interrupt handler.
+    * Called by the simulator when a channel times out.
+    *
+    * @param channel Channel that timed out
+    */
+   static void irqHandler(unsigned channel) {
+      if (callbacks[channel] != nullptr) {
+         callbacks[channel]();
+      }
+   }
+
+   /**
+    * Template representing a single PIT channel
+    *
+    * @tparam channel Channel number
+    */
+   template<unsigned channel>
+   class Channel {
+
+   public:
+      /// Channel number
+      static constexpr unsigned CHANNEL = channel;
+
+      static void configure(PitDebugMode = PitDebugMode_Stop) {}
+      static void configureIfNeeded(PitDebugMode = PitDebugMode_Stop) {}
+      static void enableNvicInterrupts(NvicPriority = NvicPriority_Normal) {}
+      static void disableNvicInterrupts() {}
+
+      /**
+       * Disable channel i.e. stop timer
+       */
+      static void disable() {
+         Simulation::stopPit(channel);
+      }
+
+      /**
+       * Configure channel for periodic interrupts
+       *
+       * @param interval   Period
+       */
+      static void configure(Seconds interval, PitChannelIrq = PitChannelIrq_Disabled) {
+         Simulation::startPeriodic(channel, static_cast<uint32_t>(round(interval*1000000)));
+      }
+
+      /**
+       * Set channel call-back
+       *
+       * @param callback Call-back to execute on timeout
+       */
+      static void setCallback(PitCallbackFunction callback) {
+         callbacks[channel] = callback;
+      }
+
+      /**
+       * Set one-shot timer callback in microseconds
+       *
+       * @param callback      Call-back to execute on timeout
+       * @param microseconds  Interval in microseconds
+       */
+      static void oneShotInMicroseconds(PitCallbackFunction callback, uint32_t microseconds) {
+         callbacks[channel] = callback;
+         Simulation::startOneShot(channel, microseconds);
+      }
+   };
+};
+
+} // End namespace USBDM
+
+#endif /* INCLUDE_USBDM_PIT_H_ */
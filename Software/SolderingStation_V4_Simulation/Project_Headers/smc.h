@@ -0,0 +1,33 @@
+/**
+ * @file     smc.h (SolderingStation_V4_Simulation/Project_Headers/smc.h)
+ * @brief    Host replacement for USBDM System Mode Controller
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef HEADER_SMC_H
+#define HEADER_SMC_H
+
+#include "pin_mapping.h"
+
+namespace USBDM {
+
+/**
+ * Simulated System Mode Controller
+ */
+class Smc {
+
+public:
+   /**
+    * Enter Wait Mode.
+    * Simulated time advances to the next interrupt.
+    */
+   static void enterWaitMode() {
+      Simulation::waitForInterrupt();
+   }
+};
+
+} // End namespace USBDM
+
+#endif /* HEADER_SMC_H */
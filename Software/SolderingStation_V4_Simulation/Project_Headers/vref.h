@@ -0,0 +1,28 @@
+/**
+ * @file     vref.h (SolderingStation_V4_Simulation/Project_Headers/vref.h)
+ * @brief    Host replacement for USBDM Voltage Reference
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef HEADER_VREF_H
+#define HEADER_VREF_H
+
+#include "pin_mapping.h"
+
+namespace USBDM {
+
+/**
+ * Simulated voltage reference (no function)
+ */
+class Vref {
+
+public:
+   template<typename... Types>
+   static void configure(Types...) {}
+};
+
+} // End namespace USBDM
+
+#endif /* HEADER_VREF_H */
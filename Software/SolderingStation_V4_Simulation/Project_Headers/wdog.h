@@ -0,0 +1,89 @@
+/**
+ * @file     wdog.h (SolderingStation_V4_Simulation/Project_Headers/wdog.h)
+ * @brief    Host replacement for USBDM Watchdog
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef HEADER_WDOG_H_
+#define HEADER_WDOG_H_
+
+#include "pin_mapping.h"
+
+namespace USBDM {
+
+enum WdogEnableInWait  { WdogEnableInWait_Disabled,  WdogEnableInWait_Enabled,  };
+enum WdogEnableInStop  { WdogEnableInStop_Disabled,  WdogEnableInStop_Enabled,  };
+enum WdogEnableInDebug { WdogEnableInDebug_Disabled, WdogEnableInDebug_Enabled, };
+enum WdogWindow        { WdogWindow_Disabled,        WdogWindow_Enabled,        };
+enum WdogInterrupt     { WdogInterrupt_Disabled,     WdogInterrupt_Enabled,     };
+enum WdogClock         { WdogClock_Lpo,              WdogClock_Alt,             };
+enum WdogEnable        { WdogEnable_Disabled,        WdogEnable_Enabled,        };
+
+/**
+ * Type definition for WDOG interrupt call back
+ */
+typedef void (*WdogCallbackFunction)();
+
+/**
+ * Simulated watchdog.
+ * The simulator checks the time between refreshes against the timeout.
+ */
+class Wdog {
+
+public:
+   /// Call-back executed on timeout
+   static inline WdogCallbackFunction callback = nullptr;
+
+   /// Watchdog timeout (0 => disabled)
+   static inline Seconds timeout = 0;
+
+   /**
+    * Watchdog interrupt handler.
+    * Called by the simulator on timeout.
+    */
+   static void irqHandler() {
+      if (callback != nullptr) {
+         callback();
+      }
+   }
+
+   template<typename... Types>
+   static void configure(Types...) {}
+
+   static void lockRegisters() {}
+   static void enableNvicInterrupts(NvicPriority = NvicPriority_Normal) {}
+   static void disableNvicInterrupts() {}
+
+   /**
+    * Set watchdog timeout
+    *
+    * @param seconds Timeout
+    */
+   static ErrorCode setTimeout(Seconds seconds) {
+      timeout = seconds;
+      Simulation::watchdogRefresh();
+      return E_NO_ERROR;
+   }
+
+   /**
+    * Set watchdog call-back
+    *
+    * @param cb Call-back to execute
+    */
+   static void setCallback(WdogCallbackFunction cb) {
+      callback = cb;
+   }
+
+   /**
+    * Refresh the watchdog
+    */
+   static void writeRefresh(uint16_t, uint16_t) {
+      Simulation::watchdogRefresh();
+   }
+};
+
+} // End namespace USBDM
+
+#endif /* HEADER_WDOG_H_ */
@@ -0,0 +1,2503 @@
+/*
+ * Benchmarks.cpp
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "hardware.h"
+#include "cycleCounter.h"
+#include "MeasurementSchedule.h"
+#include "Averaging.h"
+#include "TipSettings.h"
+#include "oled.h"
+#include "I2cQueue.h"
+#include "ChannelView.h"
+#include "SpscQueue.h"
+#include "QuadDecoder.h"
+#include "ftm.h"
+#include "PidController.h"
+#include "PredictiveController.h"
+#include "RelayAutotuneController.h"
+#include "StepResponseDriver.h"
+#include "Telemetry.h"
+#include "Channel.h"
+#include "UartDmaTransmitter.h"
+#include "DmaConsole.h"
+#include "Channels.h"
+#include "FlightRecorder.h"
+#include "Simulator.h"
+#include "ThermalModel.h"
+#include "Benchmarks.h"
+
+using namespace USBDM;
+
+namespace Simulation {
+
+/// Number of iterations of each benchmark
+static constexpr unsigned ITERATIONS = 1000000;
+
+/// Prevents the compiler discarding benchmark results
+static volatile unsigned sink;
+
+/**
+ * Tool combinations exercised (iron type, tip present)
+ */
+static const struct {
+   IronType ironType;
+   bool     tipPresent;
+} tools[] = {
+      {IronType_Unknown,        false},
+      {IronType_Weller,         true},
+      {IronType_T12,            true},
+      {IronType_T12,            false},
+      {IronType_JBC_C210,       true},
+      {IronType_AttenTweezers,  true},
+};
+
+static constexpr unsigned NUM_TOOLS = sizeof(tools)/sizeof(tools[0]);
+
+/**
+ * Previous zero-crossing code path:
+ * Copy measurement sequence from tool (via virtual call), add channel information and qsort.
+ *
+ * @param[out] seq         Array of measurements to do
+ * @param[in]  channelMask Mask indicating which channel
+ * @param[in]  tool        Tool being measured
+ *
+ * @return Number of measurements in seq[]
+ */
+__attribute__((noinline))
+static unsigned previousSequence(MuxSelect seq[], uint8_t channelMask, unsigned tool) {
+
+   // Tool sequences without channel information as returned by Measurement::getMeasurementSequence()
+   static MuxSelect const *toolSequences[NUM_TOOLS];
+   if (toolSequences[0] == nullptr) {
+      for (unsigned index=0; index<NUM_TOOLS; index++) {
+         toolSequences[index] = MeasurementSchedule::getSchedule(0,
+               MeasurementSchedule::getToolSelection(tools[index].ironType, tools[index].tipPresent)).sequence;
+      }
+   }
+   MuxSelect const *volatile newSequence = toolSequences[tool];
+
+   unsigned sequenceLength;
+   for(sequenceLength=0; newSequence[sequenceLength] != MuxSelect_Complete; sequenceLength++) {
+      seq[sequenceLength] = (MuxSelect)(newSequence[sequenceLength]|channelMask);
+   }
+   seq[sequenceLength] = MuxSelect_Complete;
+
+   static auto comp = [](const void *p1, const void *p2) {
+      const MuxSelect *left  = static_cast<const MuxSelect*>(p1);
+      const MuxSelect *right = static_cast<const MuxSelect*>(p2);
+      return ((*right^BIAS_MASK)&(BIAS_MASK))-((*left^BIAS_MASK)&(BIAS_MASK));
+   };
+   qsort(seq, sequenceLength, sizeof(seq[0]), comp);
+
+   return sequenceLength;
+}
+
+/**
+ * Current zero-crossing code path:
+ * Look up pre-sorted schedule.
+ *
+ * @param[in]  channelMask Mask indicating which channel
+ * @param[in]  tool        Tool being measured
+ *
+ * @return Schedule to use
+ */
+__attribute__((noinline))
+static const MeasurementSchedule &currentSchedule(uint8_t channelMask, unsigned tool) {
+   return MeasurementSchedule::getSchedule(channelMask,
+         MeasurementSchedule::getToolSelection(tools[tool].ironType, tools[tool].tipPresent));
+}
+
+/**
+ * Compare the qsort measurement sequence against the pre-sorted schedule table
+ *
+ * @return true if schedules match
+ */
+static bool benchmarkMeasurementSchedule() {
+
+   // Check results are identical for all tools on both channels
+   bool matches = true;
+   for (uint8_t channelMask : {CH1_MASK, CH2_MASK}) {
+      for (unsigned tool=0; tool<NUM_TOOLS; tool++) {
+         MuxSelect sequence[MeasurementSchedule::MAX_MEASUREMENTS+1];
+         unsigned length = previousSequence(sequence, channelMask, tool);
+         const MeasurementSchedule &schedule = currentSchedule(channelMask, tool);
+         if (length != schedule.length) {
+            matches = false;
+         }
+         for (unsigned index=0; index<=length; index++) {
+            if (sequence[index] != schedule.sequence[index]) {
+               matches = false;
+            }
+         }
+      }
+   }
+
+   uint32_t start = CycleCounter::getCount();
+   for (unsigned iteration=0; iteration<ITERATIONS; iteration++) {
+      MuxSelect sequence[MeasurementSchedule::MAX_MEASUREMENTS+1];
+      previousSequence(sequence, (iteration&1)?CH1_MASK:CH2_MASK, iteration%NUM_TOOLS);
+      sink = sequence[0];
+   }
+   uint32_t previousTime = CycleCounter::getCount()-start;
+
+   start = CycleCounter::getCount();
+   for (unsigned iteration=0; iteration<ITERATIONS; iteration++) {
+      sink = currentSchedule((iteration&1)?CH1_MASK:CH2_MASK, iteration%NUM_TOOLS).sequence[0];
+   }
+   uint32_t currentTime = CycleCounter::getCount()-start;
+
+   double previous = previousTime/(double)ITERATIONS;
+   double current  = currentTime/(double)ITERATIONS;
+
+   printf("Measurement schedule (zero-crossing), %u iterations\n", ITERATIONS);
+   printf("   Copy + qsort          = %.1f ns\n", previous);
+   printf("   Pre-sorted table      = %.1f ns\n", current);
+   printf("   Speed-up              = %.1f\n",    previous/current);
+   printf("   Schedules match       = %s\n",      matches?"yes":"NO");
+
+   return matches;
+}
+
+/// Prevents the compiler discarding benchmark results
+static volatile float floatSink;
+
+/// Maximum error allowed for fixed-point temperature conversion (C)
+static constexpr float MAXIMUM_CONVERSION_ERROR = 0.1;
+
+/**
+ * Find the first tip for a tool
+ *
+ * @param ironType Type of tool
+ *
+ * @return Tip name index
+ */
+static TipSettings::TipNameIndex findTip(IronType ironType) {
+   for (TipSettings::TipNameIndex index=TipSettings::FIRST_VALID_TIP; index<=TipSettings::LAST_VALID_TIP; TipSettings::inc(index)) {
+      if (TipSettings::initialTipInfo[index].type == ironType) {
+         return index;
+      }
+   }
+   return TipSettings::NO_TIP;
+}
+
+/**
+ * Average then convert a sequence of samples as done on each half-cycle
+ *
+ * @param sensor Sensor to use
+ *
+ * @return Sum of temperatures (prevents discarding results)
+ */
+template<typename Sensor>
+__attribute__((noinline))
+static float convertSamples(Sensor &sensor, unsigned base, unsigned range) {
+   float sum = 0;
+   for (unsigned iteration=0; iteration<ITERATIONS; iteration++) {
+      sensor.accumulate(base+(iteration%range));
+      sum += sensor.getTemperature();
+   }
+   return sum;
+}
+
+/**
+ * Compare floating point and fixed-point ADC to temperature conversion for a sensor.
+ * All ADC values corresponding to the temperature range are checked.
+ *
+ * @tparam FloatSensor  Sensor using floating point
+ * @tparam FixedSensor  Sensor using fixed-point
+ *
+ * @param name             Name of sensor
+ * @param ironType         Tool used for tip calibration
+ * @param minimumTemperature  Start of range checked (C)
+ * @param maximumTemperature  End of range checked (C)
+ *
+ * @return true if error is within MAXIMUM_CONVERSION_ERROR over entire range
+ */
+template<typename FloatSensor, typename FixedSensor>
+static bool checkConversion(const char *name, IronType ironType, float minimumTemperature, float maximumTemperature) {
+
+   constexpr unsigned ADC_MAXIMUM = FixedGainAdc::getSingleEndedMaximum(ADC_RESOLUTION);
+
+   FloatSensor floatSensor;
+   FixedSensor fixedSensor;
+
+   TipSettings tipSettings;
+   tipSettings.loadDefaultCalibration(findTip(ironType));
+   floatSensor.setCalibrationValues(&tipSettings);
+   fixedSensor.setCalibrationValues(&tipSettings);
+
+   float    maximumError = 0;
+   unsigned count        = 0;
+   unsigned first        = ADC_MAXIMUM;
+   unsigned last         = 0;
+   for (unsigned sample=0; sample<=ADC_MAXIMUM; sample++) {
+      if (!floatSensor.accumulate(sample)) {
+         break;
+      }
+      fixedSensor.accumulate(sample);
+      float expected = floatSensor.getInstantTemperature();
+      if (!(expected >= minimumTemperature) || (expected > maximumTemperature)) {
+         continue;
+      }
+      float error = fabsf(fixedSensor.getInstantTemperature() - expected);
+      if (!(error <= maximumError)) {
+         // Also catches NaN
+         maximumError = isnan(error)?INFINITY:error;
+      }
+      first = std::min(first, sample);
+      last  = std::max(last, sample);
+      count++;
+   }
+
+   // Time average and conversion over the samples in range
+   uint32_t start = CycleCounter::getCount();
+   floatSink = convertSamples(floatSensor, first, last-first+1);
+   uint32_t floatTime = CycleCounter::getCount()-start;
+
+   start = CycleCounter::getCount();
+   floatSink = convertSamples(fixedSensor, first, last-first+1);
+   uint32_t fixedTime = CycleCounter::getCount()-start;
+
+   bool success = (count > 0) && (maximumError <= MAXIMUM_CONVERSION_ERROR);
+
+   printf("   %-12s %3.0f-%3.0f C %6u %9.4f C %8.1f ns %8.1f ns  %s\n",
+         name, minimumTemperature, maximumTemperature, count, maximumError,
+         floatTime/(double)ITERATIONS, fixedTime/(double)ITERATIONS, success?"pass":"FAIL");
+
+   return success;
+}
+
+/**
+ * Compare floating point and fixed-point ADC to temperature conversion for each sensor
+ *
+ * @return true if all conversions are within MAXIMUM_CONVERSION_ERROR
+ */
+static bool benchmarkTemperatureConversion() {
+
+   printf("Temperature conversion (average + ADC -> Celsius), %u iterations\n", ITERATIONS);
+   printf("   Sensor       Range     Samples Max. error      Float      Fixed\n");
+
+   bool success = true;
+
+   success = checkConversion<ThermocoupleAverage<1, TemperatureArithmetic_Float>, ThermocoupleAverage<1, TemperatureArithmetic_Fixed>>(
+         "T12",     IronType_T12,      0, 500) && success;
+   success = checkConversion<ThermocoupleAverage<1, TemperatureArithmetic_Float>, ThermocoupleAverage<1, TemperatureArithmetic_Fixed>>(
+         "JBC",     IronType_JBC_C210, 0, 500) && success;
+   success = checkConversion<WellerThermistorAverage<TemperatureArithmetic_Float>, WellerThermistorAverage<TemperatureArithmetic_Fixed>>(
+         "Weller",  IronType_Weller,   0, 500) && success;
+
+   return success;
+}
+
+/**
+ * Calculate the average with the exact (Steinhart-Hart) conversion of the cold junction thermistor
+ * i.e. the previous implementation of ThermistorMF58Average::getTemperature().
+ *
+ * @param sensor Sensor to use
+ *
+ * @return Sum of temperatures (prevents discarding results)
+ */
+template<typename Sensor>
+__attribute__((noinline))
+static float convertSamplesExact(Sensor &sensor, unsigned base, unsigned range) {
+   float sum = 0;
+   for (unsigned iteration=0; iteration<ITERATIONS; iteration++) {
+      sensor.accumulate(base+(iteration%range));
+      sum += ThermistorMF58Table::convertNtcResistanceToCelsius(sensor.getResistance());
+   }
+   return sum;
+}
+
+/**
+ * Check the cold junction thermistor (MF58 NTC) table against the exact conversion
+ *
+ * @return true if error is within MAXIMUM_CONVERSION_ERROR over range
+ */
+static bool benchmarkThermistorTable() {
+
+   // Range limited by the sensor and the table accuracy
+   constexpr float MINIMUM_TEMPERATURE = 0;
+   constexpr float MAXIMUM_TEMPERATURE = 120;
+
+   ThermistorMF58Average<TemperatureArithmetic_Float> floatSensor;
+   ThermistorMF58Average<TemperatureArithmetic_Fixed> fixedSensor;
+
+   floatSensor.setCalibrationValues();
+   fixedSensor.setCalibrationValues();
+
+   float    floatError = 0;
+   float    fixedError = 0;
+   unsigned count      = 0;
+   unsigned first      = ThermistorMF58Table::ADC_MAXIMUM;
+   unsigned last       = 0;
+   for (unsigned sample=0; sample<=ThermistorMF58Table::ADC_MAXIMUM; sample++) {
+      // Start average from this sample
+      floatSensor.reset();
+      if (!floatSensor.accumulate(sample)) {
+         break;
+      }
+      fixedSensor.accumulate(sample);
+      float expected = ThermistorMF58Table::convertNtcResistanceToCelsius(floatSensor.getResistance());
+      if (!(expected >= MINIMUM_TEMPERATURE) || (expected > MAXIMUM_TEMPERATURE)) {
+         continue;
+      }
+      // Comparisons also catch NaN
+      float error = fabsf(floatSensor.getInstantTemperature() - expected);
+      if (!(error <= floatError)) {
+         floatError = isnan(error)?INFINITY:error;
+      }
+      error = fabsf(fixedSensor.getInstantTemperature() - expected);
+      if (!(error <= fixedError)) {
+         fixedError = isnan(error)?INFINITY:error;
+      }
+      first = std::min(first, sample);
+      last  = std::max(last, sample);
+      count++;
+   }
+
+   uint32_t start = CycleCounter::getCount();
+   floatSink = convertSamplesExact(floatSensor, first, last-first+1);
+   uint32_t exactTime = CycleCounter::getCount()-start;
+
+   start = CycleCounter::getCount();
+   floatSink = convertSamples(floatSensor, first, last-first+1);
+   uint32_t floatTime = CycleCounter::getCount()-start;
+
+   start = CycleCounter::getCount();
+   floatSink = convertSamples(fixedSensor, first, last-first+1);
+   uint32_t fixedTime = CycleCounter::getCount()-start;
+
+   bool success = (count > 0) && (floatError <= MAXIMUM_CONVERSION_ERROR) && (fixedError <= MAXIMUM_CONVERSION_ERROR);
+
+   printf("Cold junction thermistor table (%u entries), %u iterations\n", ThermistorMF58Table::TABLE_SIZE, ITERATIONS);
+   printf("   Range                 = %.0f-%.0f C (%u samples)\n", MINIMUM_TEMPERATURE, MAXIMUM_TEMPERATURE, count);
+   printf("   Steinhart-Hart (log)  = %.1f ns\n", exactTime/(double)ITERATIONS);
+   printf("   Table (float)         = %.1f ns, max. error %.4f C\n", floatTime/(double)ITERATIONS, floatError);
+   printf("   Table (fixed)         = %.1f ns, max. error %.4f C\n", fixedTime/(double)ITERATIONS, fixedError);
+   printf("   Within %.1f C          = %s\n",  MAXIMUM_CONVERSION_ERROR, success?"yes":"NO");
+
+   return success;
+}
+
+/**
+ * Draw one channel of the channel status screen (as Display::displayChannel())
+ *
+ * @param oled          OLED to draw on
+ * @param temperature   Current temperature to display
+ * @param offset        X offset for display
+ */
+static void drawChannel(Oled &oled, int temperature, int offset) {
+   oled.setFont(fontMedium);
+   oled.moveXY(offset, 0).write("Active");
+
+   oled.setPadding(Padding_LeadingSpaces).setWidth(3);
+   oled.setFont(fontVeryLarge);
+   oled.moveXY(offset+2, 8).write(temperature);
+   oled.setFont(fontMedium);
+   oled.moveXY(offset+48, 14).write("C");
+
+   oled.setFont(fontLarge);
+   oled.moveXY(offset, 35).write("P").setWidth(1).write(1).write(" :").setWidth(3).write(350);
+
+   oled.setFont(fontSmall);
+   oled.moveXY(offset, 50).write("T12-B2");
+   oled.moveXY(offset+35, 50).write(12, 'W');
+
+   oled.drawRect(offset, 58, offset+10, oled.HEIGHT-1, WriteMode_Xor);
+   oled.resetFormat();
+}
+
+/**
+ * Draw channel status screen (as Display::displayChannels())
+ *
+ * @param oled          OLED to draw on
+ * @param temperature   Current temperature to display on channel 1
+ */
+static void drawChannelScreen(Oled &oled, int temperature) {
+   oled.clearDisplay();
+   drawChannel(oled, temperature, 1);
+   drawChannel(oled, 20, 66);
+   oled.drawVerticalLine(63, 0, oled.HEIGHT-1);
+}
+
+/**
+ * Refresh OLED and report I2C traffic
+ *
+ * @param oled          OLED to refresh
+ * @param description   Description of update
+ *
+ * @return true if the display matches the frame buffer after refresh
+ */
+static bool refreshDisplay(Oled &oled, const char *description) {
+   Simulator &simulator = Simulator::instance();
+
+   uint64_t startBytes        = simulator.getI2cBytes();
+   uint64_t startTransactions = simulator.getI2cTransactions();
+   oled.refreshImage();
+   oled.waitForRefresh();
+   uint64_t bytes        = simulator.getI2cBytes()-startBytes;
+   uint64_t transactions = simulator.getI2cTransactions()-startTransactions;
+
+   bool matches = memcmp(simulator.getOled().getRam(), oled.getDisplayedImage(), Oled::IMAGE_DATA_SIZE) == 0;
+   printf("   %-24s= %4llu bytes, %2llu transactions (%.1f ms), display %s\n",
+         description, (unsigned long long)bytes, (unsigned long long)transactions, bytes*9/400.0, matches?"matches":"DIFFERS");
+   return matches;
+}
+
+/**
+ * Count I2C traffic for typical updates of the channel status screen.
+ * The previous implementation sent the complete frame buffer on every refresh.
+ * The image on the (simulated) display is checked against the frame buffer after each refresh.
+ *
+ * @return true if display matches after every refresh
+ */
+static bool benchmarkDisplayRefresh() {
+
+   I2c0     i2c{Oled::I2C_SPEED, I2cMode_Interrupt};
+   I2cQueue i2cQueue{i2c};
+   Oled     oled{i2cQueue};
+
+   static I2cQueue *thisQueue;
+   thisQueue = &i2cQueue;
+   I2c0::setCallback([](){thisQueue->transactionComplete();});
+   oled.initialise();
+   i2cQueue.waitUntilIdle();
+
+   printf("OLED refresh, I2C bytes per update (previously %u bytes)\n", unsigned(Oled::IMAGE_DATA_SIZE+2));
+
+   bool success = true;
+
+   drawChannelScreen(oled, 349);
+   success = refreshDisplay(oled, "Initial screen") && success;
+
+   drawChannelScreen(oled, 350);
+   success = refreshDisplay(oled, "Redraw, digit changed") && success;
+
+   drawChannelScreen(oled, 350);
+   success = refreshDisplay(oled, "Redraw, unchanged") && success;
+
+   // Channel drawn over existing screen
+   drawChannel(oled, 351, 1);
+   success = refreshDisplay(oled, "In place, digit changed") && success;
+
+   success = refreshDisplay(oled, "No change") && success;
+
+   I2c0::setCallback(nullptr);
+
+   return success;
+}
+
+/// Number of iterations of each glyph benchmark
+static constexpr unsigned GLYPH_ITERATIONS = 100000;
+
+/**
+ * Fill frame buffer with a pattern so that clearing of pixels is checked
+ *
+ * @param oled OLED to draw on
+ */
+static void drawBackground(Oled &oled) {
+   oled.clearDisplay();
+   for (int x=0; x<Oled::WIDTH; x+=2) {
+      oled.drawVerticalLine(x, 0, Oled::HEIGHT-1);
+   }
+}
+
+/**
+ * Check page ordered characters against the previous (row ordered) rendering and compare speed
+ *
+ * @param oled1   OLED to draw on
+ * @param oled2   OLED to draw on
+ * @param name    Name of font
+ * @param font    Font to check
+ *
+ * @return true if images are identical
+ */
+static bool checkGlyphs(Oled &oled1, Oled &oled2, const char *name, const Font &font) {
+
+   const int width  = font.width;
+   const int height = font.height;
+
+   oled2.setFont(font);
+
+   // Every character at every alignment in page, without and with clipping through the characters
+   unsigned mismatches = 0;
+   for (bool clipped : {false, true}) {
+      for (int y=0; y<8; y++) {
+         if (clipped) {
+            oled1.setClip(3, y+3, Oled::WIDTH-4, y+height-2);
+            oled2.setClip(3, y+3, Oled::WIDTH-4, y+height-2);
+         }
+         drawBackground(oled1);
+         drawBackground(oled2);
+         int x = 0;
+         for (unsigned ch=' '; ch<='~'; ch++) {
+            if ((x+width) > Oled::WIDTH) {
+               x = 0;
+               if (memcmp(oled1.getImage(), oled2.getImage(), Oled::IMAGE_DATA_SIZE) != 0) {
+                  mismatches++;
+               }
+               drawBackground(oled1);
+               drawBackground(oled2);
+            }
+            oled1.writeImage(font[ch], x, y+1, width, height);
+            oled2.moveXY(x, y+1).write((char)ch);
+            x += width+1;
+         }
+         if (memcmp(oled1.getImage(), oled2.getImage(), Oled::IMAGE_DATA_SIZE) != 0) {
+            mismatches++;
+         }
+      }
+      oled1.clearClip();
+      oled2.clearClip();
+   }
+
+   uint32_t start = CycleCounter::getCount();
+   for (unsigned iteration=0; iteration<GLYPH_ITERATIONS; iteration++) {
+      unsigned ch = ' '+(iteration%95);
+      oled1.writeImage(font[ch], (iteration*width)%(Oled::WIDTH-width), iteration%(Oled::HEIGHT-height+1), width, height);
+   }
+   uint32_t rowTime = CycleCounter::getCount()-start;
+
+   start = CycleCounter::getCount();
+   for (unsigned iteration=0; iteration<GLYPH_ITERATIONS; iteration++) {
+      unsigned ch = ' '+(iteration%95);
+      oled2.writePageImage(font.getPageData(ch), (iteration*width)%(Oled::WIDTH-width), iteration%(Oled::HEIGHT-height+1), width, height);
+   }
+   uint32_t pageTime = CycleCounter::getCount()-start;
+
+   printf("   %-9s %2dx%-2d %11.0f %11.0f %7s\n", name, width, height,
+         GLYPH_ITERATIONS/(rowTime*1E-9), GLYPH_ITERATIONS/(pageTime*1E-9), (mismatches == 0)?"yes":"NO");
+
+   return mismatches == 0;
+}
+
+/**
+ * Compare drawing of characters from page ordered data with the previous pixel by pixel rendering
+ *
+ * @return true if images are identical
+ */
+static bool benchmarkGlyphs() {
+
+   I2c0     i2c{Oled::I2C_SPEED, I2cMode_Interrupt};
+   I2cQueue i2cQueue{i2c};
+   Oled     oled1{i2cQueue};
+   Oled     oled2{i2cQueue};
+
+   printf("Character drawing (glyphs/s), %u iterations\n", GLYPH_ITERATIONS);
+   printf("   Font      Size      Previous  Page order   Match\n");
+
+   bool success = true;
+
+   success = checkGlyphs(oled1, oled2, "Small",     fontSmall)     && success;
+   success = checkGlyphs(oled1, oled2, "Medium",    fontMedium)    && success;
+   success = checkGlyphs(oled1, oled2, "Large",     fontLarge)     && success;
+   success = checkGlyphs(oled1, oled2, "VeryLarge", fontVeryLarge) && success;
+
+   return success;
+}
+
+/// Number of random shapes drawn when checking the blitter
+static constexpr unsigned BLIT_CHECKS = 20000;
+
+/// Number of iterations of each blitter benchmark
+static constexpr unsigned BLIT_ITERATIONS = 20000;
+
+/**
+ * Previous rectangle drawing:
+ * Each pixel is modified individually (as drawHorizontalLine() row by row).
+ *
+ * @param oled       OLED to draw on
+ * @param x1         Left X
+ * @param y1         Top Y
+ * @param x2         Right X
+ * @param y2         Bottom Y
+ * @param writeMode  Write mode (inverse, xor etc)
+ */
+__attribute__((noinline))
+static void previousDrawRect(Oled &oled, int x1, int y1, int x2, int y2, WriteMode writeMode) {
+   if (x1>x2) {
+      int t = x1;
+      x1 = x2;
+      x2 = t;
+   }
+   if (y1>y2) {
+      int t = y1;
+      y1 = y2;
+      y2 = t;
+   }
+   for (int y=y1; y<=y2; y++) {
+      for (int x=x1; x<=x2; x++) {
+         oled.drawPixel(x, y, true, writeMode);
+      }
+   }
+}
+
+/**
+ * Check rectangles and lines drawn by the blitter against drawing pixel by pixel and compare speed
+ *
+ * @return true if images are identical
+ */
+static bool benchmarkBlit() {
+
+   I2c0     i2c{Oled::I2C_SPEED, I2cMode_Interrupt};
+   I2cQueue i2cQueue{i2c};
+   Oled     oled1{i2cQueue};
+   Oled     oled2{i2cQueue};
+
+   static const WriteMode writeModes[] = {
+         WriteMode_Write, WriteMode_InverseWrite, WriteMode_Or, WriteMode_InverseAnd, WriteMode_Xor,
+   };
+
+   // Random shapes (including partially and entirely off-screen) in all write modes
+   srand(1);
+   auto randomCoordinate = [](int size) { return (rand()%(size+20))-10; };
+   unsigned mismatches = 0;
+   drawBackground(oled1);
+   drawBackground(oled2);
+   for (unsigned check=0; check<BLIT_CHECKS; check++) {
+      WriteMode writeMode = writeModes[rand()%(sizeof(writeModes)/sizeof(writeModes[0]))];
+      int x1 = randomCoordinate(Oled::WIDTH);
+      int x2 = randomCoordinate(Oled::WIDTH);
+      int y1 = randomCoordinate(Oled::HEIGHT);
+      int y2 = randomCoordinate(Oled::HEIGHT);
+      switch(check%3) {
+         case 0:
+            oled1.drawHorizontalLine(x1, x2, y1, writeMode);
+            previousDrawRect(oled2, x1, y1, x2, y1, writeMode);
+            break;
+         case 1:
+            oled1.drawVerticalLine(x1, y1, y2, writeMode);
+            previousDrawRect(oled2, x1, y1, x1, y2, writeMode);
+            break;
+         default:
+            oled1.drawRect(x1, y1, x2, y2, writeMode);
+            previousDrawRect(oled2, x1, y1, x2, y2, writeMode);
+            break;
+      }
+      if (memcmp(oled1.getImage(), oled2.getImage(), Oled::IMAGE_DATA_SIZE) != 0) {
+         mismatches++;
+         // Re-synchronise
+         drawBackground(oled1);
+         drawBackground(oled2);
+      }
+   }
+
+   printf("Rectangle drawing (rectangles/s), %u iterations, %u shapes checked\n", BLIT_ITERATIONS, BLIT_CHECKS);
+   printf("   Shape                  Previous        Blit\n");
+
+   static const struct {
+      const char *name;
+      int x1, y1, x2, y2;
+      WriteMode writeMode;
+   } shapes[] = {
+         {"Power bar      100x6",  14, 55, 113, 60, WriteMode_Xor},
+         {"Menu highlight 128x9",   0, 23, 127, 31, WriteMode_Xor},
+         {"Horizontal line 128",    0, 32, 127, 32, WriteMode_Or},
+         {"Vertical line 64",      64,  0,  64, 63, WriteMode_Write},
+         {"Full screen    128x64",  0,  0, 127, 63, WriteMode_Xor},
+   };
+   for (auto &shape : shapes) {
+      uint32_t start = CycleCounter::getCount();
+      for (unsigned iteration=0; iteration<BLIT_ITERATIONS; iteration++) {
+         previousDrawRect(oled2, shape.x1, shape.y1, shape.x2, shape.y2, shape.writeMode);
+      }
+      uint32_t previousTime = CycleCounter::getCount()-start;
+
+      start = CycleCounter::getCount();
+      for (unsigned iteration=0; iteration<BLIT_ITERATIONS; iteration++) {
+         oled1.drawRect(shape.x1, shape.y1, shape.x2, shape.y2, shape.writeMode);
+      }
+      uint32_t blitTime = CycleCounter::getCount()-start;
+
+      printf("   %-22s %9.0f %11.0f\n", shape.name,
+            BLIT_ITERATIONS/(previousTime*1E-9), BLIT_ITERATIONS/(blitTime*1E-9));
+   }
+   printf("   Blit matches pixel by pixel drawing = %s\n", (mismatches == 0)?"yes":"NO");
+
+   return mismatches == 0;
+}
+
+/// Number of updates of the channel status screen
+static constexpr unsigned VIEW_UPDATES = 2000;
+
+/// Position of channel views (as Display)
+static constexpr int VIEW_LEFT_OFFSET  = 1;
+static constexpr int VIEW_RIGHT_OFFSET = 1+(Oled::WIDTH+1)/2;
+
+/**
+ * Previous drawing of one channel of the channel status screen (as Display::displayChannel())
+ *
+ * @param oled     OLED to draw on
+ * @param values   Information to display
+ * @param offset   X offset for display
+ */
+static void previousDrawChannel(Oled &oled, const ChannelView::Values &values, int offset) {
+   oled.setFont(fontMedium);
+   oled.moveXY(offset, 0).write(values.stateName);
+
+   oled.setPadding(Padding_LeadingSpaces).setWidth(3);
+
+   oled.setFont(fontVeryLargeReduced);
+   if (values.temperature == ChannelView::TEMPERATURE_NONE) {
+      oled.moveXY(offset+6, 8).write("---");
+   }
+   else {
+      oled.moveXY(offset+2, 8);
+      if (values.temperature == ChannelView::TEMPERATURE_LOW) {
+         oled.write("low");
+      }
+      else {
+         oled.write(values.temperature);
+         oled.setFont(fontMedium);
+         oled.moveXY(offset+48, 14).write("C");
+      }
+   }
+   if (values.selected) {
+      oled.drawRect(offset,  10, offset+57,  10+fontVeryLargeReduced.HEIGHT-9, WriteMode_Xor);
+   }
+
+   oled.setFont(fontLarge);
+   if (values.setback) {
+      oled.moveXY(offset,  35).write("SB :").setWidth(3).write(values.presetTemperature);
+   }
+   else {
+      oled.moveXY(offset,  35).write("P").setWidth(1).write(values.preset).
+            write(values.presetModified?"*:":" :").setWidth(3).write(values.presetTemperature);
+   }
+
+   oled.setFont(fontSmall);
+   oled.moveXY(offset,  50).write(values.tipName);
+   oled.moveXY(offset+35,  50).write(values.power, 'W');
+
+   if (values.powerBar > 0) {
+      oled.drawRect(offset, 58, offset+values.powerBar-1,  oled.HEIGHT-1, WriteMode_Xor);
+   }
+}
+
+/**
+ * Previous drawing of the channel status screen (as Display::displayChannels())
+ * The whole screen is cleared and redrawn.
+ *
+ * @param oled     OLED to draw on
+ * @param values   Information to display for each channel
+ */
+__attribute__((noinline))
+static void previousDrawChannels(Oled &oled, const ChannelView::Values values[2]) {
+   oled.clearDisplay();
+   previousDrawChannel(oled, values[0], VIEW_LEFT_OFFSET);
+   previousDrawChannel(oled, values[1], VIEW_RIGHT_OFFSET);
+   oled.drawVerticalLine(VIEW_RIGHT_OFFSET-3, 0, oled.HEIGHT-1, WriteMode_Write);
+   oled.resetFormat();
+}
+
+/**
+ * Retained-mode drawing of the channel status screen (as Display::displayChannels())
+ *
+ * @param oled     OLED to draw on
+ * @param views    Channel views
+ * @param values   Information to display for each channel
+ *
+ * @return Number of widgets redrawn
+ */
+__attribute__((noinline))
+static unsigned currentDrawChannels(Oled &oled, ChannelView views[2], const ChannelView::Values values[2]) {
+   unsigned redrawn = views[0].update(oled, values[0]);
+   redrawn += views[1].update(oled, values[1]);
+   oled.resetFormat();
+   return redrawn;
+}
+
+/**
+ * Generate channel information for a typical sequence of updates.
+ * Channel 1 heats up, regulates with noise and goes into setback while channel 2 is idle.
+ *
+ * @param update   Update number
+ * @param values   Information to display for each channel
+ */
+static void getViewValues(unsigned update, ChannelView::Values values[2]) {
+   static const char *const stateNames[] = {"Active", "Setback", "Off"};
+
+   ChannelView::Values &ch1 = values[0];
+   ChannelView::Values &ch2 = values[1];
+
+   bool setback = (update/500)%2 == 1;
+   int  target  = setback?200:350;
+   int  heating = (int)(20+update*2);
+
+   ch1.stateName         = stateNames[setback?1:0];
+   ch1.temperature       = std::min(heating, target+(rand()%3)-1);
+   ch1.selected          = (update/700)%2 == 0;
+   ch1.setback           = setback;
+   ch1.preset            = 2;
+   ch1.presetModified    = false;
+   ch1.presetTemperature = target;
+   ch1.tipName           = "T12-B2";
+   ch1.power             = (heating<target)?60:10+(rand()%5);
+   ch1.powerBar          = (ChannelView::POWER_BAR_LENGTH*ch1.power)/75;
+   if (ch1.temperature < ChannelView::LOW_TEMPERATURE) {
+      ch1.temperature = ChannelView::TEMPERATURE_LOW;
+   }
+
+   ch2.stateName         = stateNames[2];
+   ch2.temperature       = ChannelView::TEMPERATURE_LOW;
+   ch2.selected          = !ch1.selected;
+   ch2.setback           = false;
+   ch2.preset            = 1;
+   ch2.presetModified    = true;
+   ch2.presetTemperature = 320;
+   ch2.tipName           = "----";
+   ch2.power             = 0;
+   ch2.powerBar          = 0;
+}
+
+/**
+ * Compare retained-mode drawing of the channel status screen against clearing and redrawing the screen.
+ * Reports drawing time and I2C traffic per update.
+ *
+ * @return true if images are identical after every update and redrawing changed widgets sends fewer I2C bytes
+ */
+static bool benchmarkChannelView() {
+
+   I2c0     i2c{Oled::I2C_SPEED, I2cMode_Interrupt};
+   I2cQueue i2cQueue{i2c};
+   Oled     oled1{i2cQueue};
+   Oled     oled2{i2cQueue};
+
+   static I2cQueue *thisQueue;
+   thisQueue = &i2cQueue;
+   I2c0::setCallback([](){thisQueue->transactionComplete();});
+   oled1.initialise();
+   i2cQueue.waitUntilIdle();
+
+   Simulator &simulator = Simulator::instance();
+
+   ChannelView views[2] = {
+         {VIEW_LEFT_OFFSET,  VIEW_RIGHT_OFFSET-4},
+         {VIEW_RIGHT_OFFSET, Oled::WIDTH-1},
+   };
+   ChannelView::Values values[2];
+
+   // Previous - complete redraw on each update
+   srand(1);
+   uint32_t previousTime  = 0;
+   uint64_t previousBytes = simulator.getI2cBytes();
+   for (unsigned update=0; update<VIEW_UPDATES; update++) {
+      getViewValues(update, values);
+      uint32_t start = CycleCounter::getCount();
+      previousDrawChannels(oled1, values);
+      previousTime += CycleCounter::getCount()-start;
+      oled1.refreshImage();
+      oled1.waitForRefresh();
+   }
+   previousBytes = simulator.getI2cBytes()-previousBytes;
+
+   // Current - redraw changed widgets (checked against complete redraw)
+   srand(1);
+   oled2.clearDisplay();
+   oled2.drawVerticalLine(VIEW_RIGHT_OFFSET-3, 0, oled2.HEIGHT-1, WriteMode_Write);
+   uint32_t currentTime    = 0;
+   unsigned widgets        = 0;
+   unsigned mismatches     = 0;
+   uint64_t currentBytes   = simulator.getI2cBytes();
+   for (unsigned update=0; update<VIEW_UPDATES; update++) {
+      getViewValues(update, values);
+      uint32_t start = CycleCounter::getCount();
+      widgets += currentDrawChannels(oled2, views, values);
+      currentTime += CycleCounter::getCount()-start;
+      oled2.refreshImage();
+      oled2.waitForRefresh();
+
+      previousDrawChannels(oled1, values);
+      if (memcmp(oled1.getImage(), oled2.getImage(), Oled::IMAGE_DATA_SIZE) != 0) {
+         mismatches++;
+      }
+   }
+   currentBytes = simulator.getI2cBytes()-currentBytes;
+
+   I2c0::setCallback(nullptr);
+
+   printf("Channel status screen, %u updates\n", VIEW_UPDATES);
+   printf("   Complete redraw       = %5.2f us, %4.0f I2C bytes per update\n",
+         previousTime*1E-3/VIEW_UPDATES, previousBytes/(double)VIEW_UPDATES);
+   printf("   Changed widgets       = %5.2f us, %4.0f I2C bytes per update, %.1f widgets redrawn per update\n",
+         currentTime*1E-3/VIEW_UPDATES, currentBytes/(double)VIEW_UPDATES, widgets/(double)VIEW_UPDATES);
+   printf("   Images match          = %s\n", (mismatches == 0)?"yes":"NO");
+
+   // Only the columns of the changed widgets are sent
+   bool fewerBytes = currentBytes < previousBytes;
+   printf("   Fewer I2C bytes       = %s\n", fewerBytes?"yes":"NO");
+
+   return (mismatches == 0) && fewerBytes;
+}
+
+/// Number of transactions queued by main-line code in I2C queue stress test
+static constexpr unsigned QUEUE_TRANSACTIONS = 20000;
+
+/// Largest transaction in I2C queue stress test
+static constexpr unsigned QUEUE_MAX_SIZE = 64;
+
+/// Buffers for each producer - more than the number of transactions that may be queued
+static constexpr unsigned QUEUE_BUFFERS = 2*I2cQueue::QUEUE_SIZE;
+
+/// I2C address not used by the OLED so the data is not interpreted
+static constexpr uint8_t QUEUE_ADDRESS = 0xA0;
+
+/**
+ * Transactions from one producer (main-line code or completion functions)
+ */
+struct QueueProducer {
+   uint8_t  buffers[QUEUE_BUFFERS][QUEUE_MAX_SIZE];
+   unsigned queued    = 0;   ///< Sequence number of next transaction
+   unsigned completed = 0;   ///< Sequence number of next expected completion
+   unsigned rejected  = 0;   ///< Transactions refused as queue full
+};
+
+/**
+ * State of I2C queue stress test (shared with completion function and bus monitor)
+ */
+static struct {
+   I2cQueue      *queue;
+   QueueProducer  producers[2];          ///< [0] => main-line, [1] => completion function
+   unsigned       outOfOrder     = 0;    ///< Completions not in sequence for producer
+   unsigned       corrupted      = 0;    ///< Transactions with incorrect data on the bus
+   unsigned       mismatched     = 0;    ///< Completions not for the transaction last on the bus
+   unsigned       busErrors      = 0;    ///< Transactions failed on the bus
+   unsigned       reportedErrors = 0;    ///< Completions reporting failure
+   const uint8_t *lastBusData    = nullptr;
+   ErrorCode      lastBusResult  = E_NO_ERROR;
+} queueTest;
+
+/**
+ * Fill transaction buffer with pattern identifying the producer and sequence number
+ *
+ * @param producer   Producer index
+ * @param sequence   Sequence number of transaction
+ * @param size       Size of transaction (4..QUEUE_MAX_SIZE)
+ *
+ * @return Buffer to transmit
+ */
+static const uint8_t *fillQueueBuffer(unsigned producer, unsigned sequence, unsigned size) {
+   uint8_t *buffer = queueTest.producers[producer].buffers[sequence%QUEUE_BUFFERS];
+   uint32_t tag    = (producer<<31)|sequence;
+   memcpy(buffer, &tag, sizeof(tag));
+   for (unsigned index=sizeof(tag); index<size; index++) {
+      buffer[index] = static_cast<uint8_t>(sequence*31+index);
+   }
+   return buffer;
+}
+
+/**
+ * Get context value identifying a transaction
+ */
+static void *queueContext(unsigned producer, unsigned sequence) {
+   return reinterpret_cast<void *>(static_cast<uintptr_t>((producer<<31)|sequence));
+}
+
+/**
+ * Completion function for stress test transactions (called from I2C interrupt).
+ * Every 5th main-line transaction queues a further transaction from the completion function.
+ *
+ * @param context    Identifies transaction
+ * @param errorCode  Result of transaction
+ */
+static void queueTestComplete(void *context, ErrorCode errorCode) {
+   uint32_t       tag      = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(context));
+   unsigned       producer = tag>>31;
+   unsigned       sequence = tag&0x7FFFFFFF;
+   QueueProducer &p        = queueTest.producers[producer];
+
+   if (sequence != p.completed) {
+      queueTest.outOfOrder++;
+   }
+   p.completed = sequence+1;
+   if ((queueTest.lastBusData != p.buffers[sequence%QUEUE_BUFFERS]) || (queueTest.lastBusResult != errorCode)) {
+      queueTest.mismatched++;
+   }
+   queueTest.lastBusData = nullptr;
+   if (errorCode != E_NO_ERROR) {
+      queueTest.reportedErrors++;
+   }
+   if ((producer == 0) && ((sequence%5) == 0)) {
+      QueueProducer &follow = queueTest.producers[1];
+      unsigned size = 4+(sequence%(QUEUE_MAX_SIZE-3));
+      const uint8_t *data = fillQueueBuffer(1, follow.queued, size);
+      if (queueTest.queue->transmit(QUEUE_ADDRESS, size, data, queueTestComplete, queueContext(1, follow.queued)) == E_NO_ERROR) {
+         follow.queued++;
+      }
+      else {
+         follow.rejected++;
+      }
+   }
+}
+
+/**
+ * Bus monitor for stress test - checks the data of each transaction as it completes on the bus
+ */
+static void queueTestMonitor(uint8_t address, uint16_t size, const uint8_t data[], ErrorCode errorCode) {
+   if (address != QUEUE_ADDRESS) {
+      return;
+   }
+   uint32_t tag;
+   memcpy(&tag, data, sizeof(tag));
+   unsigned producer = tag>>31;
+   unsigned sequence = tag&0x7FFFFFFF;
+   for (unsigned index=sizeof(tag); index<size; index++) {
+      if (data[index] != static_cast<uint8_t>(sequence*31+index)) {
+         queueTest.corrupted++;
+         break;
+      }
+   }
+   if (data != queueTest.producers[producer].buffers[sequence%QUEUE_BUFFERS]) {
+      queueTest.corrupted++;
+   }
+   queueTest.lastBusData   = data;
+   queueTest.lastBusResult = errorCode;
+   if (errorCode != E_NO_ERROR) {
+      queueTest.busErrors++;
+   }
+}
+
+/**
+ * Previous event queue with each add() and get() in a critical section.
+ * A mutex stands in for masking interrupts on the host.
+ *
+ * @tparam size Size of queue
+ */
+template<unsigned size>
+class LockedQueue {
+   uint32_t   queue[size];
+   unsigned   head  = 0;
+   unsigned   tail  = 0;
+   unsigned   count = 0;
+   std::mutex mutex;
+
+public:
+   bool add(uint32_t item) {
+      std::lock_guard<std::mutex> cs(mutex);
+      if (count == size) {
+         return false;
+      }
+      count++;
+      queue[tail++] = item;
+      if (tail >= size) {
+         tail = 0;
+      }
+      return true;
+   }
+
+   bool get(uint32_t &item) {
+      std::lock_guard<std::mutex> cs(mutex);
+      if (count == 0) {
+         return false;
+      }
+      count--;
+      item = queue[head++];
+      if (head >= size) {
+         head = 0;
+      }
+      return true;
+   }
+};
+
+/// Size of queues for SPSC benchmark (as used by SwitchPolling)
+static constexpr unsigned SPSC_QUEUE_SIZE  = 16;
+
+/// Number of items passed between threads in SPSC stress test
+static constexpr unsigned SPSC_ITEMS       = 1000000;
+
+/// Number of items timed for producer to consumer latency
+static constexpr unsigned SPSC_PINGS       = 10000;
+
+/**
+ * Pass items from a producer thread to the consumer (this thread) as fast as possible.
+ * Checks every item arrives once and in order.
+ *
+ * @param queue   Queue to test
+ * @param elapsed Time taken (ns)
+ *
+ * @return Number of items lost, duplicated or out of order
+ */
+template<typename Queue>
+static unsigned spscStress(Queue &queue, uint64_t &elapsed) {
+   auto start = std::chrono::steady_clock::now();
+   std::thread producer([&queue](){
+      for (uint32_t item=0; item<SPSC_ITEMS; item++) {
+         while (!queue.add(item)) {
+            std::this_thread::yield();
+         }
+      }
+   });
+   unsigned errors   = 0;
+   uint32_t expected = 0;
+   while (expected < SPSC_ITEMS) {
+      uint32_t item;
+      if (!queue.get(item)) {
+         std::this_thread::yield();
+         continue;
+      }
+      if (item != expected) {
+         errors++;
+      }
+      expected = item+1;
+   }
+   producer.join();
+   elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-start).count();
+
+   // Nothing left over
+   uint32_t item;
+   if (queue.get(item)) {
+      errors++;
+   }
+   return errors;
+}
+
+/**
+ * Time from add() in producer thread to get() in the consumer (this thread).
+ * Each item is sent when the previous one has been received.
+ *
+ * @param queue     Queue to test
+ * @param latencies Latency of each item (ns) - sorted
+ */
+template<typename Queue>
+static void spscLatency(Queue &queue, std::vector<uint32_t> &latencies) {
+   std::atomic<unsigned> received{0};
+   std::vector<uint64_t> sent(SPSC_PINGS);
+   latencies.resize(SPSC_PINGS);
+
+   auto origin = std::chrono::steady_clock::now();
+   auto now = [origin]() {
+      return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-origin).count();
+   };
+   std::thread producer([&](){
+      for (uint32_t item=0; item<SPSC_PINGS; item++) {
+         while (received.load(std::memory_order_acquire) != item) {
+            std::this_thread::yield();
+         }
+         sent[item] = now();
+         queue.add(item);
+      }
+   });
+   for (uint32_t expected=0; expected<SPSC_PINGS; expected++) {
+      uint32_t item;
+      while (!queue.get(item)) {
+         std::this_thread::yield();
+      }
+      latencies[item] = now()-sent[item];
+      received.store(expected+1, std::memory_order_release);
+   }
+   producer.join();
+   std::sort(latencies.begin(), latencies.end());
+}
+
+/**
+ * Single-producer/single-consumer event queue against the previous queue using critical sections.
+ * Stress test with producer and consumer threads, then add+get cost and producer to consumer latency.
+ *
+ * @return true if no items lost, duplicated or out of order
+ */
+static bool benchmarkSpscQueue() {
+
+   static SpscQueue<uint32_t, SPSC_QUEUE_SIZE>   spscQueue;
+   static LockedQueue<SPSC_QUEUE_SIZE>           lockedQueue;
+
+   uint64_t spscElapsed, lockedElapsed;
+   unsigned spscErrors   = spscStress(spscQueue, spscElapsed);
+   unsigned lockedErrors = spscStress(lockedQueue, lockedElapsed);
+
+   uint32_t item = 0;
+   uint32_t start = CycleCounter::getCount();
+   for (unsigned iteration=0; iteration<ITERATIONS; iteration++) {
+      lockedQueue.add(iteration);
+      lockedQueue.get(item);
+      sink = item;
+   }
+   uint32_t lockedTime = CycleCounter::getCount()-start;
+
+   start = CycleCounter::getCount();
+   for (unsigned iteration=0; iteration<ITERATIONS; iteration++) {
+      spscQueue.add(iteration);
+      spscQueue.get(item);
+      sink = item;
+   }
+   uint32_t spscTime = CycleCounter::getCount()-start;
+
+   std::vector<uint32_t> spscLatencies, lockedLatencies;
+   spscLatency(spscQueue, spscLatencies);
+   spscLatency(lockedQueue, lockedLatencies);
+
+   auto percentile = [](const std::vector<uint32_t> &latencies, unsigned percent) {
+      return latencies[(latencies.size()-1)*percent/100]/1000.0;
+   };
+
+   printf("Event queue (%u entries), %u items between threads, %u hardware thread(s)\n",
+         SPSC_QUEUE_SIZE, SPSC_ITEMS, std::thread::hardware_concurrency());
+   printf("   Critical section      = %.1f ns add+get, %.1f ns/item threaded, latency %.1f/%.1f us (median/99%%)\n",
+         lockedTime/(double)ITERATIONS, lockedElapsed/(double)SPSC_ITEMS,
+         percentile(lockedLatencies, 50), percentile(lockedLatencies, 99));
+   printf("   Lock-free SPSC        = %.1f ns add+get, %.1f ns/item threaded, latency %.1f/%.1f us (median/99%%)\n",
+         spscTime/(double)ITERATIONS, spscElapsed/(double)SPSC_ITEMS,
+         percentile(spscLatencies, 50), percentile(spscLatencies, 99));
+   printf("   Errors                = %u (SPSC), %u (critical section)\n", spscErrors, lockedErrors);
+
+   return (spscErrors == 0) && (lockedErrors == 0) && spscQueue.isEmpty();
+}
+
+/**
+ * Stress test of the I2C transaction queue on a simulated bus with injected NACKs and timing jitter.
+ * Main-line code queues transactions of random size as fast as the queue accepts them and
+ * completion functions queue further transactions from the I2C interrupt.
+ * Checks that every transaction completes once, in order, with its data intact and the correct result.
+ *
+ * @return true if no errors detected
+ */
+static bool benchmarkI2cQueue() {
+
+   I2c0     i2c{Oled::I2C_SPEED, I2cMode_Interrupt};
+   I2cQueue i2cQueue{i2c};
+
+   static I2cQueue *thisQueue;
+   thisQueue       = &i2cQueue;
+   queueTest.queue = &i2cQueue;
+   I2c0::setCallback([](){thisQueue->transactionComplete();});
+
+   Simulator &simulator = Simulator::instance();
+   simulator.setI2cFaults(7, 50);
+   simulator.setI2cMonitor(queueTestMonitor);
+
+   QueueProducer &mainLine = queueTest.producers[0];
+
+   srand(1);
+   uint64_t startTime         = simulator.getTime();
+   uint64_t startBytes        = simulator.getI2cBytes();
+   uint64_t queueTime         = 0;
+   while (mainLine.queued < QUEUE_TRANSACTIONS) {
+      unsigned       size = 4+(rand()%(QUEUE_MAX_SIZE-3));
+      const uint8_t *data = fillQueueBuffer(0, mainLine.queued, size);
+      uint64_t queueStart = simulator.getTime();
+      ErrorCode rc = i2cQueue.transmit(QUEUE_ADDRESS, size, data, queueTestComplete, queueContext(0, mainLine.queued));
+      queueTime += simulator.getTime()-queueStart;
+      if (rc == E_NO_ERROR) {
+         mainLine.queued++;
+         continue;
+      }
+      // Queue full - wait for a transaction to complete
+      mainLine.rejected++;
+      i2cQueue.waitWhileBusy();
+   }
+   i2cQueue.waitUntilIdle();
+   uint64_t elapsed = simulator.getTime()-startTime;
+   uint64_t bytes   = simulator.getI2cBytes()-startBytes;
+
+   simulator.setI2cMonitor(nullptr);
+   simulator.setI2cFaults(0, 0);
+   I2c0::setCallback(nullptr);
+
+   const QueueProducer &followUp = queueTest.producers[1];
+   unsigned lost = (mainLine.queued-mainLine.completed)+(followUp.queued-followUp.completed);
+
+   printf("I2C transaction queue (%u entries), %u transactions + %u queued from completions\n",
+         I2cQueue::QUEUE_SIZE, mainLine.queued, followUp.queued);
+   printf("   Bus utilisation       = %.1f%% (%.1f s)\n", 100.0*bytes*9/400000/(elapsed*1E-6), elapsed*1E-6);
+   printf("   Time per transaction  = %.1f us queueing (main-line), %.1f us on bus\n",
+         queueTime/(double)(mainLine.queued+mainLine.rejected), bytes*9/0.4/(mainLine.queued+followUp.queued));
+   printf("   Queue full            = %u rejected (main), %u rejected (completions), high water %u\n",
+         mainLine.rejected, followUp.rejected, i2cQueue.getHighWater());
+   printf("   NACKs                 = %u on bus, %u reported\n", queueTest.busErrors, queueTest.reportedErrors);
+   printf("   Errors                = %u lost, %u out of order, %u corrupted, %u mismatched\n",
+         lost, queueTest.outOfOrder, queueTest.corrupted, queueTest.mismatched);
+
+   return (lost == 0) && (queueTest.outOfOrder == 0) && (queueTest.corrupted == 0) && (queueTest.mismatched == 0) &&
+         (queueTest.busErrors == queueTest.reportedErrors) && (queueTest.busErrors > 0) &&
+         (followUp.queued > 0) && (i2cQueue.getHighWater() == I2cQueue::QUEUE_SIZE) && i2cQueue.isIdle();
+}
+
+/// Encoder phases used by the software decoder under test (spare port E pins)
+using TestPhases     = GpioFieldTable_T<GpioEInfo, 1, 0, ActiveLow>;
+
+/// Hardware decoder under test (spare port A pins, PHA = bit 0, PHB = bit 1)
+using TestFtmDecoder = FtmQuadDecoder_T<GpioAInfo, 0, 1>;
+
+/// Number of phase changes in random edge trace
+static constexpr unsigned ENCODER_STEPS = 200000;
+
+/// Detents in long fast rotation (wraps the 16-bit FTM counter)
+static constexpr unsigned ENCODER_SPIN_DETENTS = 20000;
+
+/**
+ * Recorded encoder edge trace (active-high phases, B:A as read by QuadPhases).
+ * Slow rotation with contact bounce on most edges, a half detent and return,
+ * then rotation the other way (net -1 detent).
+ */
+static const uint8_t recordedTrace[] = {
+      0b00, 0b01, 0b00, 0b01, 0b11, 0b01, 0b11, 0b10, 0b11, 0b10, 0b00, 0b10, 0b00,   // +1 with bounce
+      0b01, 0b11, 0b10, 0b00,                                                         // +1
+      0b01, 0b00, 0b01, 0b11, 0b10, 0b00,                                             // +1 with bounce
+      0b01, 0b11, 0b01, 0b00,                                                         // Half detent and back
+      0b10, 0b11, 0b10, 0b11, 0b01, 0b00, 0b01, 0b00,                                 // -1 with bounce
+      0b10, 0b11, 0b01, 0b00,                                                         // -1
+      0b10, 0b11, 0b10, 0b00,                                                         // Half detent and back
+      0b10, 0b11, 0b01, 0b11, 0b01, 0b00,                                             // -1 with bounce
+      0b10, 0b11, 0b01, 0b00,                                                         // -1
+};
+
+/**
+ * Replays encoder edge traces through the pin interrupt and FTM quadrature decoders.
+ *
+ * Both decoders see the same phase changes on separate simulated ports.
+ * The FTM decoder is polled at random intervals as SwitchPolling would.
+ * Positions must agree whenever the encoder rests at a detent.
+ *
+ * @return true if no errors detected
+ */
+static bool benchmarkQuadDecoder() {
+
+   PinIrqQuadDecoder_T<TestPhases>      pinIrqDecoder;
+   HardwareQuadDecoder_T<TestFtmDecoder> ftmDecoder;
+
+   // Encoder at rest (phases inactive = high)
+   SimulatedPort &pinIrqPort = TestPhases::port();
+   SimulatedPort &ftmPort    = TestFtmDecoder::port();
+   pinIrqPort.setInputs(TestPhases::BITMASK, TestPhases::BITMASK);
+   ftmPort.setInputs(0b11, 0b11);
+
+   pinIrqDecoder.initialise();
+   ftmDecoder.initialise();
+
+   unsigned pinInterrupts = 0;
+   unsigned detents       = 0;
+   unsigned mismatches    = 0;
+   unsigned phases        = 0;
+
+   // Apply phase change to both decoders and check positions at detents
+   auto setPhases = [&](unsigned newPhases, bool poll) {
+      phases = newPhases&0b11;
+      // Phases are active-low
+      if (pinIrqPort.setInputs(TestPhases::BITMASK, (~phases<<TestPhases::RIGHT)&TestPhases::BITMASK)) {
+         pinInterrupts++;
+      }
+      ftmPort.setInputs(0b11, ~phases&0b11);
+      if (poll || (phases == 0)) {
+         int ftmPosition = ftmDecoder.getPosition();
+         if (phases == 0) {
+            detents++;
+            if (ftmPosition != pinIrqDecoder.getPosition()) {
+               if (mismatches++ < 5) {
+                  printf("   Mismatch at detent %u: pin IRQ = %d, FTM = %d\n", detents, pinIrqDecoder.getPosition(), ftmPosition);
+               }
+            }
+         }
+      }
+   };
+
+   // Recorded trace
+   for (uint8_t recordedPhases:recordedTrace) {
+      setPhases(recordedPhases, true);
+   }
+   int recordedPosition = pinIrqDecoder.getPosition();
+
+   // Random walk using valid (Gray code) transitions with bounce and changes of direction
+   static constexpr uint8_t sequence[] = {0b00, 0b01, 0b11, 0b10};
+   srand(2);
+   unsigned step      = 0;
+   int      direction = 1;
+   for (unsigned count=0; count<ENCODER_STEPS; count++) {
+      int choice = rand()%16;
+      if (choice == 0) {
+         // Change direction
+         direction = -direction;
+      }
+      else if (choice == 1) {
+         // Bounce on next edge
+         setPhases(sequence[(step+direction)&3], false);
+      }
+      step = (step+direction)&3;
+      setPhases(sequence[step], (rand()%8) == 0);
+   }
+
+   // Fast spin in one direction
+   int spinStart = pinIrqDecoder.getPosition();
+   for (unsigned count=0; count<4*ENCODER_SPIN_DETENTS; count++) {
+      step = (step+1)&3;
+      setPhases(sequence[step], (count%64) == 0);
+   }
+   int spin = pinIrqDecoder.getPosition()-spinStart;
+
+   printf("Quadrature decoder (pin IRQ vs FTM), %u detents checked\n", detents);
+   printf("   Recorded trace        = %d detents\n", recordedPosition);
+   printf("   Fast spin             = %d detents (%u edges)\n", spin, 4*ENCODER_SPIN_DETENTS);
+   printf("   Pin interrupts        = %u (pin IRQ), 0 (FTM)\n", pinInterrupts);
+   printf("   Errors                = %u position mismatches\n", mismatches);
+
+   return (mismatches == 0) && (recordedPosition == -1) && (spin == (int)ENCODER_SPIN_DETENTS);
+}
+
+/// Controller updates logged by telemetry benchmark
+static constexpr unsigned TELEMETRY_UPDATES = 20000;
+
+/// Interval between bursts of frames written back-to-back (controller updates)
+static constexpr unsigned TELEMETRY_BURST_INTERVAL = 2000;
+
+/// Frames in each burst (more than fit in the UART DMA buffer)
+static constexpr unsigned TELEMETRY_BURST_FRAMES = 60;
+
+/**
+ * Find telemetry frames in a UART capture (as Tools/TelemetryDecoder.cpp)
+ *
+ * @param data    Capture
+ * @param size    Size of capture
+ * @param frames  Frames found with valid sync and CRC
+ */
+static void findTelemetryFrames(const uint8_t data[], size_t size, std::vector<TelemetryFrame> &frames) {
+   size_t index = 0;
+   while ((index+sizeof(TelemetryFrame)) <= size) {
+      TelemetryFrame frame;
+      memcpy(&frame, data+index, sizeof(frame));
+      const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&frame);
+      if ((frame.sync1 == TELEMETRY_SYNC1) && (frame.sync2 == TELEMETRY_SYNC2) &&
+          (telemetryCrc(bytes+TELEMETRY_CRC_START, TELEMETRY_CRC_SIZE) == frame.crc)) {
+         frames.push_back(frame);
+         index += sizeof(frame);
+      }
+      else {
+         index++;
+      }
+   }
+}
+
+/**
+ * Compares logging a controller update as a CSV text report (PidController::report())
+ * with building a binary telemetry frame, then sends frames through the UART DMA
+ * transmitter on the simulated UART and decodes the capture.
+ *
+ * Every 10 ms update is logged. Bursts of frames written back-to-back overflow
+ * the transmit buffer; the dropped frames must show as gaps in the sequence numbers
+ * and all other frames must arrive intact and in order.
+ *
+ * @return true if no errors detected
+ */
+static bool benchmarkTelemetry() {
+
+   Simulator &simulator = Simulator::instance();
+
+   // Check value for CRC-16/CCITT-FALSE
+   static const uint8_t crcCheck[] = {'1','2','3','4','5','6','7','8','9'};
+   bool crcCorrect = (telemetryCrc(crcCheck, sizeof(crcCheck)) == 0x29B1);
+
+   TipSettings tipSettings;
+   tipSettings.loadDefaultCalibration(findTip(IronType_T12));
+
+   PidController controller{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+   controller.setControlParameters(&tipSettings);
+   controller.enable();
+
+   // Heat-up from ambient with some noise
+   float temperature = 0;
+   auto update = [&](unsigned iteration) {
+      float time  = (iteration%TELEMETRY_BURST_INTERVAL)*SAMPLE_INTERVAL;
+      temperature = 350-325*expf(-time/3.0f)+((iteration*7)%5)*0.3f;
+      controller.newSample(350, temperature);
+   };
+
+   Telemetry telemetry;
+
+   // Build frame as Telemetry::logChannel()
+   auto buildFrame = [&](unsigned iteration, TelemetryFrame &frame) {
+      frame = {};
+      frame.timestamp    = iteration;
+      frame.channel      = 1;
+      frame.state        = ChannelState_active;
+      frame.coldJunction = TELEMETRY_NO_VALUE;
+      controller.getTelemetry(frame);
+      telemetry.seal(frame);
+   };
+
+   // Size of a text report
+   consoleTransmitter.initialise();
+   size_t textStart = simulator.getUartCapture().size();
+   controller.report();
+   dmaConsole.writeln();
+   dmaConsole.flushOutput();
+   long textSize = simulator.getUartCapture().size()-textStart;
+
+   uint32_t start = CycleCounter::getCount();
+   for (unsigned iteration=0; iteration<TELEMETRY_UPDATES; iteration++) {
+      update(iteration);
+   }
+   uint32_t updateTime = CycleCounter::getCount()-start;
+
+   // Lines are dropped once the transmit buffer is full so only formatting and queuing are timed
+   dmaConsole.setOverflowPolicy(OverflowPolicy_Drop);
+   start = CycleCounter::getCount();
+   for (unsigned iteration=0; iteration<TELEMETRY_UPDATES; iteration++) {
+      update(iteration);
+      controller.report();
+      dmaConsole.writeln();
+   }
+   uint32_t textTime = CycleCounter::getCount()-start;
+   dmaConsole.setOverflowPolicy(OverflowPolicy_Block);
+   dmaConsole.flushOutput();
+
+   start = CycleCounter::getCount();
+   for (unsigned iteration=0; iteration<TELEMETRY_UPDATES; iteration++) {
+      TelemetryFrame frame;
+      update(iteration);
+      buildFrame(iteration, frame);
+      sink = frame.crc;
+   }
+   uint32_t binaryTime = CycleCounter::getCount()-start;
+
+   // Send frames through UART DMA transmitter
+   consoleTransmitter.initialise();
+   size_t   captureStart = simulator.getUartCapture().size();
+   uint64_t startTime    = simulator.getTime();
+   uint64_t startBytes   = simulator.getUartBytes();
+
+   std::vector<TelemetryFrame> sent;
+   unsigned dropped       = 0;
+   unsigned bursts        = 0;
+   float    maximumError  = 0;
+   for (unsigned iteration=0; iteration<TELEMETRY_UPDATES; iteration++) {
+      update(iteration);
+      unsigned frames = 1;
+      if ((iteration%TELEMETRY_BURST_INTERVAL) == TELEMETRY_BURST_INTERVAL/2) {
+         frames = TELEMETRY_BURST_FRAMES;
+         bursts++;
+      }
+      for (unsigned count=0; count<frames; count++) {
+         TelemetryFrame frame;
+         buildFrame(iteration, frame);
+         maximumError = std::max(maximumError, fabsf(frame.measured/(float)TELEMETRY_TEMPERATURE_SCALE-temperature));
+         if (consoleTransmitter.write(reinterpret_cast<const uint8_t *>(&frame), sizeof(frame))) {
+            sent.push_back(frame);
+         }
+         else {
+            dropped++;
+         }
+      }
+      simulator.delay(SAMPLE_INTERVAL);
+   }
+   // Allow transmission to complete
+   simulator.delay(0.1);
+   uint64_t elapsed = simulator.getTime()-startTime;
+   uint64_t bytes   = simulator.getUartBytes()-startBytes;
+
+   const std::vector<uint8_t> &capture = simulator.getUartCapture();
+   std::vector<TelemetryFrame> received;
+   findTelemetryFrames(capture.data()+captureStart, capture.size()-captureStart, received);
+
+   unsigned corrupted = 0;
+   unsigned lost      = 0;
+   for (unsigned index=0; index<std::min(sent.size(), received.size()); index++) {
+      if (memcmp(&sent[index], &received[index], sizeof(TelemetryFrame)) != 0) {
+         corrupted++;
+      }
+      if (index > 0) {
+         lost += static_cast<uint16_t>(received[index].sequence-received[index-1].sequence-1);
+      }
+   }
+
+   double updateOnly = updateTime/(double)TELEMETRY_UPDATES;
+   double text       = textTime/(double)TELEMETRY_UPDATES-updateOnly;
+   double binary     = binaryTime/(double)TELEMETRY_UPDATES-updateOnly;
+
+   printf("PID telemetry (text report vs binary frame), %u controller updates\n", TELEMETRY_UPDATES);
+   printf("   Text report           = %.1f ns, %ld bytes (%.0f us on UART)\n", text, textSize, (double)textSize*Simulator::UART_BYTE_US);
+   printf("   Binary frame + CRC    = %.1f ns, %u bytes (%u us on UART)\n", binary, (unsigned)sizeof(TelemetryFrame), (unsigned)sizeof(TelemetryFrame)*Simulator::UART_BYTE_US);
+   printf("   Speed-up              = %.1f\n",    text/binary);
+   printf("   UART utilisation      = %.1f%% (every update, %u bursts of %u frames)\n",
+         100.0*bytes*Simulator::UART_BYTE_US/elapsed, bursts, TELEMETRY_BURST_FRAMES);
+   printf("   Frames                = %u sent, %u received, %u dropped, %u missing from sequence\n",
+         (unsigned)sent.size(), (unsigned)received.size(), dropped, lost);
+   printf("   Errors                = %u corrupted, maximum quantisation error %.3f C, CRC check %s\n",
+         corrupted, maximumError, crcCorrect?"ok":"FAILED");
+
+   return crcCorrect && (corrupted == 0) && (received.size() == sent.size()) && (dropped > 0) && (lost == dropped) &&
+         (maximumError <= 0.5f/TELEMETRY_TEMPERATURE_SCALE+0.001f);
+}
+
+/// Lines written by each console benchmark test
+static constexpr unsigned CONSOLE_LINES = 2000;
+
+/// Interval between a long line and the lines between (lines)
+static constexpr unsigned CONSOLE_LONG_LINE_INTERVAL = 50;
+
+/// Interval between lines for overflow test (faster than the UART can send them)
+static constexpr float CONSOLE_LINE_INTERVAL = 1_ms;
+
+/**
+ * Collects formatted output as console would transmit it
+ */
+class ExpectedConsole : public FormattedIO {
+public:
+   std::string text;
+
+protected:
+   virtual void _writeChar(char ch) override {
+      text += ch;
+      if (ch == '\n') {
+         text += '\r';
+      }
+   }
+};
+
+/**
+ * Write a line in the style of StepResponseDriver::run()
+ *
+ * @param io         Where to write
+ * @param line       Line number
+ * @param longLines  Periodically write a line longer than DmaConsole::LINE_SIZE
+ */
+static void writeConsoleLine(FormattedIO &io, unsigned line, bool longLines) {
+   if (longLines && ((line%CONSOLE_LONG_LINE_INTERVAL) == 0)) {
+      io.write("Calibration ");
+      for (unsigned count=0; count<20; count++) {
+         io.write(", ").write(line+count);
+      }
+      io.writeln();
+      return;
+   }
+   io.setWidth(4).setPadding(Padding_LeadingSpaces);
+   io.setFloatFormat(1, Padding_LeadingSpaces, 3);
+   io.write(line*0.1f).write(", ").write(line%40).write(", ").writeln(25+(line%3000)*0.1f);
+   io.resetFormat();
+}
+
+/**
+ * Compares diagnostic output through DmaConsole with the blocking console.
+ *
+ * With OverflowPolicy_Block the output must arrive complete and unchanged.
+ * With OverflowPolicy_Drop lines are written faster than the UART can send
+ * them; only whole lines may be lost and the caller must never wait.
+ *
+ * @return true if no errors detected
+ */
+static bool benchmarkDmaConsole() {
+
+   Simulator &simulator = Simulator::instance();
+
+   // Blocking - all output delivered
+   ExpectedConsole expected;
+   for (unsigned line=0; line<CONSOLE_LINES; line++) {
+      writeConsoleLine(expected, line, true);
+   }
+
+   consoleTransmitter.initialise();
+   dmaConsole.setOverflowPolicy(OverflowPolicy_Block);
+   unsigned droppedBefore = consoleTransmitter.getDropped();
+   size_t   captureStart  = simulator.getUartCapture().size();
+   uint64_t startTime     = simulator.getTime();
+   for (unsigned line=0; line<CONSOLE_LINES; line++) {
+      writeConsoleLine(dmaConsole, line, true);
+   }
+   uint64_t blockedTime = simulator.getTime()-startTime;
+   dmaConsole.flushOutput();
+
+   const std::vector<uint8_t> &capture = simulator.getUartCapture();
+   std::string received(capture.begin()+captureStart, capture.end());
+   bool     blockCorrect  = (received == expected.text) && (consoleTransmitter.getDropped() == droppedBefore);
+   uint64_t consoleTime   = expected.text.size()*Simulator::UART_BYTE_US;
+   unsigned blockBytes    = received.size();
+
+   // Drop - lines written every 1 ms
+   expected.text.clear();
+   std::vector<std::string> lines;
+   for (unsigned line=0; line<CONSOLE_LINES; line++) {
+      writeConsoleLine(expected, line, false);
+      lines.push_back(expected.text);
+      expected.text.clear();
+   }
+   dmaConsole.setOverflowPolicy(OverflowPolicy_Drop);
+   droppedBefore = consoleTransmitter.getDropped();
+   captureStart  = simulator.getUartCapture().size();
+
+   uint32_t writeTime = 0;
+   uint32_t worstTime = 0;
+   for (unsigned line=0; line<CONSOLE_LINES; line++) {
+      uint32_t start = CycleCounter::getCount();
+      writeConsoleLine(dmaConsole, line, false);
+      uint32_t time = CycleCounter::getCount()-start;
+      writeTime += time;
+      worstTime  = std::max(worstTime, time);
+      simulator.delay(CONSOLE_LINE_INTERVAL);
+   }
+   dmaConsole.flushOutput();
+   dmaConsole.setOverflowPolicy(OverflowPolicy_Block);
+   unsigned dropped = consoleTransmitter.getDropped()-droppedBefore;
+
+   // Each received line must be the next or a later line
+   received.assign(capture.begin()+captureStart, capture.end());
+   unsigned receivedLines = 0;
+   unsigned partial       = 0;
+   unsigned nextLine      = 0;
+   size_t   index         = 0;
+   while (index < received.size()) {
+      while ((nextLine < CONSOLE_LINES) && (received.compare(index, lines[nextLine].size(), lines[nextLine]) != 0)) {
+         nextLine++;
+      }
+      if (nextLine == CONSOLE_LINES) {
+         partial++;
+         break;
+      }
+      index += lines[nextLine++].size();
+      receivedLines++;
+   }
+   size_t lineSize = lines[CONSOLE_LINES/2].size();
+
+   printf("DMA console (blocking UART console vs DmaConsole), %u lines\n", CONSOLE_LINES);
+   printf("   Block policy          = %u bytes, caller waited %.1f ms (console %.1f ms), output %s\n",
+         blockBytes, blockedTime/1000.0, consoleTime/1000.0,
+         blockCorrect?"identical":"DIFFERENT");
+   printf("   Drop policy           = %.1f ns per line, worst %.1f us (console %u us for %u bytes)\n",
+         writeTime/(double)CONSOLE_LINES, worstTime/1000.0, (unsigned)(lineSize*Simulator::UART_BYTE_US), (unsigned)lineSize);
+   printf("   Lines                 = %u written, %u received, %u dropped, %u corrupted\n",
+         CONSOLE_LINES, receivedLines, dropped, partial);
+
+   return blockCorrect && (blockedTime < consoleTime) && (partial == 0) && (dropped > 0) &&
+         ((receivedLines+dropped) == CONSOLE_LINES);
+}
+
+/// Measurement sequences recorded before the flight recorder is frozen
+static constexpr unsigned FLIGHT_SEQUENCES = 1000;
+
+/// Measurement sequences after freeze (must not be recorded)
+static constexpr unsigned FLIGHT_EXTRA_SEQUENCES = 100;
+
+/// Flight recorder tested (static storage as .noinit)
+static FlightRecorder testRecorder;
+
+/**
+ * Raw conversion result used for test
+ *
+ * @param sequence   Sequence number
+ * @param conversion Index of conversion in sequence
+ */
+static uint16_t flightResult(unsigned sequence, unsigned conversion) {
+   return (sequence*7+conversion*1000)&0xFFFF;
+}
+
+/**
+ * Record one measurement sequence as Control::adcHandler() does
+ *
+ * @param schedule  Schedule giving conversions
+ * @param sequence  Sequence number (used as timestamp)
+ * @param freezeAt  Conversion to trigger an overload before (>= length => none)
+ */
+static void recordSequence(const MeasurementSchedule &schedule, unsigned sequence, unsigned freezeAt) {
+   testRecorder.startSequence(sequence&0xFFFF);
+   for (unsigned conversion=0; schedule.sequence[conversion] != MuxSelect_Complete; conversion++) {
+      if (conversion == freezeAt) {
+         testRecorder.freeze(FlightRecorderTrigger_Overload, sequence);
+      }
+      testRecorder.addConversion(schedule.sequence[conversion], flightResult(sequence, conversion));
+   }
+   testRecorder.endSequence(sequence, channels[1], channels[2]);
+}
+
+/**
+ * Checks the flight recorder keeps the last FlightRecorder::SIZE-1 complete sequences
+ * when frozen part way through a sequence, ignores later sequences and is not
+ * reported after power-on (random contents).
+ * The cost of recording in the ADC interrupt is compared with formatting the
+ * same information as a console report.
+ *
+ * @return true if no errors detected
+ */
+static bool benchmarkFlightRecorder() {
+
+   // Both channels T12
+   ScheduleSelection selection = MeasurementSchedule::getToolSelection(IronType_T12, true);
+   const MeasurementSchedule &schedule = MeasurementSchedule::getSchedule(selection, selection);
+   unsigned length = 0;
+   while (schedule.sequence[length] != MuxSelect_Complete) {
+      length++;
+   }
+
+   // Power-on i.e. random RAM
+   memset(static_cast<void*>(&testRecorder), 0xA5, sizeof(testRecorder));
+   bool powerOnIgnored = !testRecorder.isValid() && !testRecorder.isFrozen();
+
+   testRecorder.initialise();
+   uint32_t start = CycleCounter::getCount();
+   for (unsigned sequence=0; sequence<FLIGHT_SEQUENCES; sequence++) {
+      recordSequence(schedule, sequence, length);
+   }
+   uint32_t recordTime = CycleCounter::getCount()-start;
+   bool recordingNotFrozen = testRecorder.isValid() && !testRecorder.isFrozen();
+
+   // Freeze part way through a sequence then continue as after an overload
+   recordSequence(schedule, FLIGHT_SEQUENCES, length/2);
+   for (unsigned sequence=FLIGHT_SEQUENCES+1; sequence<FLIGHT_SEQUENCES+FLIGHT_EXTRA_SEQUENCES; sequence++) {
+      recordSequence(schedule, sequence, length);
+   }
+
+   // Check records are the last complete sequences before the freeze
+   unsigned errors = 0;
+   unsigned count  = testRecorder.getCount();
+   for (unsigned index=0; index<count; index++) {
+      const FlightRecord &record = testRecorder.getRecord(index);
+      unsigned sequence = FLIGHT_SEQUENCES-count+index;
+      bool ok = (record.timestamp == sequence) && (record.chipTemperature == sequence) && (record.count == length) &&
+                (record.state[0] == channels[1].getState()) && (record.temperature[1] == channels[2].getCurrentTemperature());
+      for (unsigned conversion=0; ok && (conversion<length); conversion++) {
+         ok = (record.conversions[conversion] == schedule.sequence[conversion]) &&
+              (record.results[conversion] == flightResult(sequence, conversion));
+      }
+      if (!ok) {
+         errors++;
+      }
+   }
+
+   // Report at boot
+   ExpectedConsole report;
+   start = CycleCounter::getCount();
+   testRecorder.report(report);
+   uint32_t reportTime = CycleCounter::getCount()-start;
+   unsigned lines = std::count(report.text.begin(), report.text.end(), '\n');
+   bool reportCorrect = (lines == count+2) && (report.text.find("\r-10,") != std::string::npos) &&
+         (report.text.find("Overload at half-cycle 1000,") != std::string::npos);
+
+   double perSequence = recordTime/(double)FLIGHT_SEQUENCES;
+   double perRecord   = reportTime/(double)count;
+   double bytes       = report.text.size()/(double)(count+2);
+
+   printf("Flight recorder (ADC interrupt recording vs console report), %u sequences of %u conversions\n",
+         FLIGHT_SEQUENCES+FLIGHT_EXTRA_SEQUENCES, length);
+   printf("   Recording             = %.1f ns per sequence (%u bytes per record, %u records)\n",
+         perSequence, (unsigned)sizeof(FlightRecord), FlightRecorder::SIZE);
+   printf("   Console report        = %.1f ns per record, %.0f bytes (%.0f us on UART)\n",
+         perRecord, bytes, bytes*Simulator::UART_BYTE_US);
+   printf("   Frozen                = %u records kept, %u errors, report %s, power-on %s\n",
+         count, errors, reportCorrect?"ok":"WRONG", powerOnIgnored?"ignored":"REPORTED");
+
+   return powerOnIgnored && recordingNotFrozen && testRecorder.isFrozen() && (count == FlightRecorder::SIZE-1) &&
+         (errors == 0) && reportCorrect;
+}
+
+/**
+ * Load applied to the tip while the controller regulates
+ */
+struct LoadProfile {
+   const char *name;          // Description
+   float       initial;       // Initial tip temperature (C)
+   float       target;        // Target temperature after start (C)
+   float       load;          // Load applied from start (W/K)
+   float       duration;      // Duration of load or target change (s)
+};
+
+/// Load profiles (each starts at the end of a 30 s settling period at 350 C unless starting cold)
+static const LoadProfile loadProfiles[] = {
+      {"Heat-up 25->350 C",       25,   350,  0.0,   0.0},
+      {"Target 350->400 C",       350,  400,  0.0,   0.0},
+      {"Joint 0.1 W/K 15 s",      350,  350,  0.1,  15.0},
+      {"Large 0.3 W/K 5 s",       350,  350,  0.3,   5.0},
+      {"Wiping 0.5 W/K 1 s",      350,  350,  0.5,   1.0},
+};
+
+/**
+ * Response of a controller to a load profile
+ */
+struct LoadResponse {
+   float minimum     = 1000;  // Minimum tip temperature after start (C)
+   float overshoot   = 0;     // Maximum tip temperature above target after load removed (C)
+   float recovery    = 0;     // Time from start until tip stays within 2 C of target (s)
+   float absError    = 0;     // Integral of |error| from start (C.s)
+};
+
+/**
+ * Run a controller against the T12 thermal model for a load profile
+ *
+ * The measurement is the exponential average used for the thermocouple
+ * (ThermocoupleAverage<20>) of the tip temperature with noise, updated every
+ * half-cycle. The controller is run every CONTROL_INTERVAL and the drive is
+ * applied each half-cycle as by T12::getDrive().
+ *
+ * @param controller  Controller to use
+ * @param profile     Load profile to apply
+ * @param plant       Thermal model to use (copied)
+ *
+ * @return Response of controller
+ */
+static LoadResponse runLoadProfile(Controller &controller, const LoadProfile &profile,
+      const ThermalModel &plant = ThermalModel(ThermalModel::ToolType_T12)) {
+
+   static constexpr float    SETTLE_TIME   = 30.0;
+   static constexpr float    RUN_TIME      = 40.0;
+   static constexpr float    RECOVERY_BAND = 2.0;
+   static constexpr unsigned AVERAGE       = 20;
+   static constexpr unsigned STEPS_PER_UPDATE = round(CONTROL_INTERVAL/SAMPLE_INTERVAL);
+
+   ThermalModel model(plant);
+   LoadResponse response;
+
+   controller.enable(false);
+   controller.setDutyCycle(0);
+   controller.setInterval(CONTROL_INTERVAL);
+   controller.enable();
+
+   float    measured = 25;
+   float    target   = profile.initial;
+   unsigned seed     = 1;
+   float    start    = (profile.initial > 100)?SETTLE_TIME:0;
+   float    end      = start+profile.duration;
+
+   for (unsigned step=0; step*SAMPLE_INTERVAL<(start+RUN_TIME); step++) {
+      float time = step*SAMPLE_INTERVAL;
+      if (time >= start) {
+         target = profile.target;
+      }
+      model.setLoad(((time >= start) && (time < end))?profile.load:0);
+
+      // Drive for half-cycle
+      controller.advance();
+      model.advance(SAMPLE_INTERVAL, controller.isOn(), VoltageSelect_24V);
+
+      // Measurement with +/-0.5 C noise
+      seed = seed*1103515245+12345;
+      float noise = (int((seed>>16)%101)-50)/100.0f;
+      measured += (model.getTemperature()+noise-measured)/AVERAGE;
+
+      if ((step%STEPS_PER_UPDATE) == 0) {
+         controller.setDutyCycle(round(controller.newSample(target, measured)));
+      }
+      if (time < start) {
+         continue;
+      }
+      float error = model.getTemperature()-target;
+      response.minimum   = std::min(response.minimum, model.getTemperature());
+      response.absError += fabsf(error)*SAMPLE_INTERVAL;
+      if (time >= end) {
+         response.overshoot = std::max(response.overshoot, error);
+      }
+      if (fabsf(error) > RECOVERY_BAND) {
+         response.recovery = time-start+SAMPLE_INTERVAL;
+      }
+   }
+   return response;
+}
+
+/**
+ * Compares the PredictiveController with the PidController (T12 default settings)
+ * on the T12 thermal model for the same load profiles.
+ * The predictive controller should recover from large loads faster with less overshoot.
+ *
+ * @return true if the predictive controller is no worse on recovery and overshoot for loads
+ */
+static bool benchmarkPredictiveController() {
+
+   TipSettings tipSettings;
+   tipSettings.loadDefaultCalibration(findTip(IronType_T12));
+
+   PidController        pid{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+   PredictiveController predictive{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY, 24*24/8.5};
+   pid.setControlParameters(&tipSettings);
+   predictive.setControlParameters(&tipSettings);
+
+   bool success = true;
+
+   printf("Predictive controller (PID vs model based control of T12, C=%.1f J/K, G=%.3f W/K)\n",
+         tipSettings.getThermalMass(), tipSettings.getThermalLoss());
+   printf("   %-22s  %-29s %-29s\n", "", "PID", "Predictive");
+   printf("   %-22s  %5s %5s %6s %7s   %5s %5s %6s %7s\n", "Profile",
+         "Min", "Over", "Recov", "|Err|", "Min", "Over", "Recov", "|Err|");
+   for (const LoadProfile &profile:loadProfiles) {
+      LoadResponse p = runLoadProfile(pid, profile);
+      LoadResponse m = runLoadProfile(predictive, profile);
+
+      printf("   %-22s  %5.1f %5.1f %5.1fs %7.1f   %5.1f %5.1f %5.1fs %7.1f\n", profile.name,
+            p.minimum, p.overshoot, p.recovery, p.absError,
+            m.minimum, m.overshoot, m.recovery, m.absError);
+
+      if (profile.load > 0) {
+         success = success && (m.recovery <= p.recovery) && (m.overshoot <= p.overshoot+0.5);
+      }
+   }
+   printf("   (Min = lowest tip temperature, Over = overshoot after load (C), Recov = time to stay within 2 C)\n");
+   return success;
+}
+
+/**
+ * Capture a step response of the T12 thermal model as done by StepResponseDriver::run()
+ *
+ * @param[out] samples    Temperatures (0.1 C) at StepResponseDriver::CAPTURE_INTERVAL
+ * @param[out] stepStart  Index of first sample with drive applied
+ * @param[out] stepEnd    Index of first sample after drive removed
+ * @param[in]  drive      Drive to apply (%)
+ *
+ * @return Number of samples
+ */
+static unsigned captureStepResponse(uint16_t samples[], unsigned &stepStart, unsigned &stepEnd, unsigned drive) {
+
+   static constexpr unsigned AVERAGE          = 20;
+   static constexpr unsigned STEPS_PER_SAMPLE = round(StepResponseDriver::CAPTURE_INTERVAL/SAMPLE_INTERVAL);
+   static constexpr unsigned INITIAL_SAMPLES  = 20;
+   static constexpr unsigned DRIVING_SAMPLES  = 400;
+   static constexpr unsigned COOLING_SAMPLES  = 150;
+
+   ThermalModel model(ThermalModel::ToolType_T12);
+
+   // Used for PWM of drive as in fixed power mode
+   PidController pwm{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+   pwm.enable(false);
+
+   float    measured = 25;
+   unsigned seed     = 1;
+   unsigned count    = 0;
+
+   stepStart = INITIAL_SAMPLES;
+   stepEnd   = INITIAL_SAMPLES+DRIVING_SAMPLES;
+
+   for (unsigned step=0; count<(stepEnd+COOLING_SAMPLES); step++) {
+      if ((step%STEPS_PER_SAMPLE) == 0) {
+         if ((count >= stepStart) && (count < stepEnd) && (measured >= StepResponseDriver::MAX_TEMPERATURE)) {
+            stepEnd = count;
+         }
+         samples[count++] = round(10*measured);
+         pwm.setDutyCycle(((count > stepStart) && (count <= stepEnd))?drive:0);
+      }
+      pwm.advance();
+      model.advance(SAMPLE_INTERVAL, pwm.isOn(), VoltageSelect_24V);
+
+      // Measurement with +/-0.5 C noise
+      seed = seed*1103515245+12345;
+      float noise = (int((seed>>16)%101)-50)/100.0f;
+      measured += (model.getTemperature()+noise-measured)/AVERAGE;
+   }
+   return count;
+}
+
+/**
+ * Identifies a FOPDT model from a step response of the T12 thermal model
+ * and compares the PidController with the SIMC gains calculated from it
+ * against the default T12 settings for the same load profiles.
+ *
+ * @return true if the model is within 10% of the thermal model and the
+ *         calculated gains recover from loads no slower than the defaults
+ */
+static bool benchmarkStepIdentification() {
+
+   static constexpr unsigned DRIVE            = 30;
+   static constexpr float    MAXIMUM_ERROR    = 0.1;
+
+   static uint16_t samples[StepResponseDriver::MAX_SAMPLES];
+
+   // Expected from thermal model (T12 on 24V)
+   const float maximumPower = 24*24/8.5;
+   const float expectedGain = maximumPower/(100*0.025);
+   const float expectedTau  = 2.0/0.025;
+
+   unsigned stepStart, stepEnd;
+   unsigned count = captureStepResponse(samples, stepStart, stepEnd, DRIVE);
+
+   FopdtModel model;
+   uint32_t start = CycleCounter::getCount();
+   bool identified = StepResponseDriver::identify(samples, count, stepStart, stepEnd, DRIVE, model);
+   uint32_t identifyTime = CycleCounter::getCount()-start;
+
+   if (!identified) {
+      printf("Step identification: FAILED to identify model\n");
+      return false;
+   }
+   PidGains gains = StepResponseDriver::calculatePidGains(model);
+
+   TipSettings defaultSettings;
+   defaultSettings.loadDefaultCalibration(findTip(IronType_T12));
+
+   TipSettings tunedSettings;
+   tunedSettings.loadDefaultCalibration(findTip(IronType_T12));
+   tunedSettings.setPidControlValues(gains);
+
+   PidController defaultPid{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+   PidController tunedPid{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+   defaultPid.setControlParameters(&defaultSettings);
+   tunedPid.setControlParameters(&tunedSettings);
+
+   float gainError = fabsf(model.gain-expectedGain)/expectedGain;
+   float tauError  = fabsf(model.timeConstant-expectedTau)/expectedTau;
+
+   printf("Step identification (FOPDT fit of T12 step response, %u samples, %u%% drive for %.1f s)\n",
+         count, DRIVE, (stepEnd-stepStart)*StepResponseDriver::CAPTURE_INTERVAL);
+   printf("   Model                 = K %.2f C/%% (%.1f%% error), Tau %.1f s (%.1f%% error), Theta %.1f s, Ambient %.1f C\n",
+         model.gain, 100*gainError, model.timeConstant, 100*tauError, model.deadTime, model.ambient);
+   printf("   Identification        = %.1f us (host)\n", identifyTime/1e3);
+   printf("   SIMC gains            = Kp %.2f, Ki %.3f, Kd %.2f, iLimit %.1f (default Kp %.2f, Ki %.3f, Kd %.2f, iLimit %.1f)\n",
+         gains.kp, gains.ki, gains.kd, gains.iLimit,
+         defaultSettings.getKp(CalibrationIndex_325), defaultSettings.getKi(CalibrationIndex_325),
+         defaultSettings.getKd(CalibrationIndex_325), defaultSettings.getILimit(CalibrationIndex_325));
+
+   bool success = (gainError <= MAXIMUM_ERROR) && (tauError <= MAXIMUM_ERROR);
+
+   printf("   %-22s  %-29s %-29s\n", "", "Default PID", "SIMC PID");
+   printf("   %-22s  %5s %5s %6s %7s   %5s %5s %6s %7s\n", "Profile",
+         "Min", "Over", "Recov", "|Err|", "Min", "Over", "Recov", "|Err|");
+   for (const LoadProfile &profile:loadProfiles) {
+      LoadResponse d = runLoadProfile(defaultPid, profile);
+      LoadResponse t = runLoadProfile(tunedPid, profile);
+
+      printf("   %-22s  %5.1f %5.1f %5.1fs %7.1f   %5.1f %5.1f %5.1fs %7.1f\n", profile.name,
+            d.minimum, d.overshoot, d.recovery, d.absError,
+            t.minimum, t.overshoot, t.recovery, t.absError);
+
+      if (profile.load > 0) {
+         success = success && (t.recovery <= d.recovery) && (t.absError <= d.absError);
+      }
+   }
+   return success;
+}
+
+/**
+ * Run the relay autotuner against a thermal model from its current temperature
+ *
+ * The measurement and controller updates are as for runLoadProfile().
+ *
+ * @param autotuner  Autotuner to use
+ * @param model      Thermal model to use (left at temperature reached)
+ * @param voltage    Heater supply
+ * @param target     Temperature to tune at (C)
+ *
+ * @return Time taken (s)
+ */
+static float runAutotune(RelayAutotuneController &autotuner, ThermalModel &model, VoltageSelection voltage, float target) {
+
+   static constexpr float    RUN_TIME         = 90.0;
+   static constexpr unsigned AVERAGE          = 20;
+   static constexpr unsigned STEPS_PER_UPDATE = round(CONTROL_INTERVAL/SAMPLE_INTERVAL);
+
+   autotuner.enable(false);
+   autotuner.setDutyCycle(0);
+   autotuner.setInterval(CONTROL_INTERVAL);
+   autotuner.enable();
+
+   float    measured = model.getTemperature();
+   unsigned seed     = 1;
+   float    time     = 0;
+
+   for (unsigned step=0; (time<RUN_TIME) && !autotuner.isFinished(); step++) {
+      time = step*SAMPLE_INTERVAL;
+
+      // Drive for half-cycle
+      autotuner.advance();
+      model.advance(SAMPLE_INTERVAL, autotuner.isOn(), voltage);
+
+      // Measurement with +/-0.5 C noise
+      seed = seed*1103515245+12345;
+      float noise = (int((seed>>16)%101)-50)/100.0f;
+      measured += (model.getTemperature()+noise-measured)/AVERAGE;
+
+      if ((step%STEPS_PER_UPDATE) == 0) {
+         autotuner.setDutyCycle(round(autotuner.newSample(target, measured)));
+      }
+   }
+   autotuner.enable(false);
+   return time;
+}
+
+/**
+ * Runs the relay autotuner on the thermal model of each single heater tool.
+ * The PidController with the gains for the T12 is compared with the default
+ * T12 settings for the same load profiles.
+ *
+ * @return true if each tool is tuned in under 30 s (from cold, including heating to target) and
+ *         the calculated gains recover from loads with no more integrated error than the defaults
+ */
+static bool benchmarkRelayAutotune() {
+
+   static constexpr float TARGET       = RelayAutotuneController::TUNING_TEMPERATURE;
+   static constexpr float MAXIMUM_TIME = 30.0;
+
+   static const struct {
+      ThermalModel::ToolType toolType;
+      VoltageSelection       voltage;
+   } autotuneTools[] = {
+         {ThermalModel::ToolType_T12,    VoltageSelect_24V},
+         {ThermalModel::ToolType_Weller, VoltageSelect_24V},
+         {ThermalModel::ToolType_JBC,    VoltageSelect_12V},
+   };
+
+   bool success = true;
+
+   printf("Relay autotune (Astrom-Hagglund limit cycle at %.0f C, Tyreus-Luyben PI)\n", TARGET);
+
+   PidGains t12Gains = {0, 0, 0, 0};
+
+   for (const auto &tool:autotuneTools) {
+      RelayAutotuneController autotuner{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+      ThermalModel model(tool.toolType);
+      float time = runAutotune(autotuner, model, tool.voltage, TARGET);
+
+      if (autotuner.getState() != AutotuneState_Complete) {
+         printf("   %-6s                = FAILED after %.1f s\n", model.getName(), time);
+         success = false;
+         continue;
+      }
+      PidGains gains = autotuner.calculatePidGains();
+      printf("   %-6s                = %4.1f s (%4.1f s heating + %4.1f s relay at %3.0f C), Ku %6.2f, Tu %4.2f s, Hold %4.1f%% => Kp %5.2f, Ki %5.3f, iLimit %4.1f\n",
+            model.getName(), autotuner.getTotalTime(), autotuner.getHeatingTime(), autotuner.getRelayTime(), autotuner.getTuneTemperature(),
+            autotuner.getUltimateGain(), autotuner.getUltimatePeriod(), autotuner.getHoldingOutput(), gains.kp, gains.ki, gains.iLimit);
+      success = success && (autotuner.getTotalTime() < MAXIMUM_TIME);
+      if (tool.toolType == ThermalModel::ToolType_T12) {
+         t12Gains = gains;
+      }
+   }
+
+   TipSettings defaultSettings;
+   defaultSettings.loadDefaultCalibration(findTip(IronType_T12));
+
+   TipSettings tunedSettings;
+   tunedSettings.loadDefaultCalibration(findTip(IronType_T12));
+   tunedSettings.setPidControlValues(t12Gains);
+
+   PidController defaultPid{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+   PidController tunedPid{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+   defaultPid.setControlParameters(&defaultSettings);
+   tunedPid.setControlParameters(&tunedSettings);
+
+   printf("   %-22s  %-29s %-29s\n", "", "Default PID", "Autotuned PID");
+   printf("   %-22s  %5s %5s %6s %7s   %5s %5s %6s %7s\n", "Profile",
+         "Min", "Over", "Recov", "|Err|", "Min", "Over", "Recov", "|Err|");
+   for (const LoadProfile &profile:loadProfiles) {
+      LoadResponse d = runLoadProfile(defaultPid, profile);
+      LoadResponse t = runLoadProfile(tunedPid, profile);
+
+      printf("   %-22s  %5.1f %5.1f %5.1fs %7.1f   %5.1f %5.1f %5.1fs %7.1f\n", profile.name,
+            d.minimum, d.overshoot, d.recovery, d.absError,
+            t.minimum, t.overshoot, t.recovery, t.absError);
+
+      if (profile.load > 0) {
+         success = success && (t.absError <= d.absError);
+      }
+   }
+   return success;
+}
+
+/// Increase in T12 heater resistance with temperature used for gain scheduling (per K)
+static constexpr float SCHEDULE_HEATER_COEFFICIENT = 0.001;
+
+/// Increase in T12 loss with temperature used for gain scheduling (per K)
+static constexpr float SCHEDULE_LOSS_COEFFICIENT   = 0.002;
+
+/// Load profiles across the calibration range (each starts after settling at initial temperature)
+static const LoadProfile rangeProfiles[] = {
+      {"Heat-up 25->400 C",       25,   400,  0.0,   0.0},
+      {"Target 250->400 C",       250,  400,  0.0,   0.0},
+      {"Joint 250 C",             250,  250,  0.1,  15.0},
+      {"Joint 325 C",             325,  325,  0.1,  15.0},
+      {"Joint 400 C",             400,  400,  0.1,  15.0},
+      {"Large 250 C",             250,  250,  0.3,   5.0},
+      {"Large 325 C",             325,  325,  0.3,   5.0},
+      {"Large 400 C",             400,  400,  0.3,   5.0},
+};
+
+/**
+ * Get controller output from telemetry terms
+ *
+ * @param frame Telemetry frame
+ *
+ * @return Output before limiting (%)
+ */
+static float telemetryOutput(const TelemetryFrame &frame) {
+   return float(frame.proportional+frame.integral-frame.differential)/TELEMETRY_PERCENT_SCALE;
+}
+
+/**
+ * Compares the PidController with gains scheduled on the target temperature against
+ * single sets of gains on a T12 thermal model where the heater resistance and loss
+ * increase with temperature (so the plant gain and time constant fall).
+ *
+ * The gains for each band are from the relay autotuner at the band temperature.
+ * The gain margin (Ku/Kp) is reported for each band when using the single set
+ * tuned at each band and when scheduled.
+ * The single set tuned at 250 C (lowest Ku) is the only one keeping the
+ * tuning margin at all bands and is compared with the scheduled gains.
+ *
+ * @return true if the scheduled gains keep the tuning margin at all bands, have no more
+ *         integrated error than the single set for any profile and less for loads,
+ *         and a change of band is bumpless
+ */
+static bool benchmarkGainScheduling() {
+
+   // Tyreus-Luyben gain margin
+   static constexpr float TUNING_MARGIN = 3.2;
+
+   ThermalModel plant(ThermalModel::ToolType_T12);
+   plant.setTemperatureCoefficients(SCHEDULE_HEATER_COEFFICIENT, SCHEDULE_LOSS_COEFFICIENT);
+
+   TipSettings singleSettings;
+   singleSettings.loadDefaultCalibration(findTip(IronType_T12));
+
+   TipSettings scheduledSettings;
+   scheduledSettings.loadDefaultCalibration(findTip(IronType_T12));
+
+   printf("Gain scheduling (T12 with heater +%.1f%%/K, loss +%.1f%%/K, relay autotune at each band)\n",
+         100*SCHEDULE_HEATER_COEFFICIENT, 100*SCHEDULE_LOSS_COEFFICIENT);
+
+   float ultimateGain[CalibrationIndex_Number];
+   float holdingOutput[CalibrationIndex_Number];
+
+   // Bands are tuned in turn heating upwards as Menus::autotunePid()
+   ThermalModel tuningModel(plant);
+
+   for (CalibrationIndex index=CalibrationIndex_250; index<CalibrationIndex_Number; ++index) {
+      const unsigned temperature = TipSettings::getCalibrationTemperature(index);
+
+      RelayAutotuneController autotuner{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+      runAutotune(autotuner, tuningModel, VoltageSelect_24V, temperature);
+      if (autotuner.getState() != AutotuneState_Complete) {
+         printf("   Band %u C            = FAILED to autotune\n", temperature);
+         return false;
+      }
+      PidGains gains = autotuner.calculatePidGains();
+      printf("   Band %u C            = Ku %6.2f, Tu %4.2f s, Hold %4.1f%% => Kp %5.2f, Ki %5.3f, iLimit %4.1f\n",
+            temperature, autotuner.getUltimateGain(), autotuner.getUltimatePeriod(), autotuner.getHoldingOutput(),
+            gains.kp, gains.ki, gains.iLimit);
+
+      ultimateGain[index]  = autotuner.getUltimateGain();
+      holdingOutput[index] = autotuner.getHoldingOutput();
+      scheduledSettings.setPidControlValues(index, gains);
+   }
+   singleSettings.setPidControlValues(scheduledSettings.getPidGains(CalibrationIndex_250));
+
+   bool success = true;
+
+   // Gain margin at each band for each single set and when scheduled
+   for (CalibrationIndex tuned=CalibrationIndex_250; tuned<=CalibrationIndex_Number; ++tuned) {
+      if (tuned < CalibrationIndex_Number) {
+         printf("   Margin single %u C   =", TipSettings::getCalibrationTemperature(tuned));
+      }
+      else {
+         printf("   Margin scheduled      =");
+      }
+      for (CalibrationIndex index=CalibrationIndex_250; index<CalibrationIndex_Number; ++index) {
+         float kp     = scheduledSettings.getKp((tuned < CalibrationIndex_Number)?tuned:index);
+         float margin = ultimateGain[index]/kp;
+         printf(" %4.2f @%u C", margin, TipSettings::getCalibrationTemperature(index));
+         if (tuned == CalibrationIndex_Number) {
+            success = success && (margin >= 0.99*TUNING_MARGIN);
+         }
+      }
+      printf("\n");
+   }
+
+   PidController singlePid{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+   PidController scheduledPid{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+   singlePid.setControlParameters(&singleSettings);
+   scheduledPid.setControlParameters(&scheduledSettings);
+
+   // Bumpless transfer - change band while holding a load at 250 C (output not saturated)
+   static constexpr float MAXIMUM_BUMP = 0.3;
+
+   runLoadProfile(scheduledPid, {"Bumpless", 250, 250, 0.2, 40.0}, plant);
+   TelemetryFrame before, after;
+   scheduledPid.getTelemetry(before);
+   const float beforeKp = scheduledPid.getKp();
+   scheduledPid.scheduleGains(400);
+   scheduledPid.getTelemetry(after);
+
+   // Output for the same error with the new gains (proportional term is not updated until next sample)
+   const float proportionalChange = (scheduledPid.getKp()-beforeKp)*scheduledPid.getError();
+   const float bump = fabsf(telemetryOutput(after)+proportionalChange-telemetryOutput(before));
+   const float bumplessError = scheduledPid.getError();
+   success = success && (bump <= MAXIMUM_BUMP);
+
+   // No transfer while saturated - change band while recovering from a large load at 250 C
+   runLoadProfile(scheduledPid, {"Saturated", 250, 250, 0.3, 40.0}, plant);
+   scheduledPid.getTelemetry(before);
+   scheduledPid.scheduleGains(400);
+   scheduledPid.getTelemetry(after);
+   const float saturatedError = scheduledPid.getError();
+   success = success && (after.integral == before.integral);
+
+   // Cost of scheduling on change of target
+   static constexpr unsigned SCHEDULE_ITERATIONS = 100000;
+   uint32_t start = CycleCounter::getCount();
+   for (unsigned iteration=0; iteration<SCHEDULE_ITERATIONS; iteration++) {
+      scheduledPid.scheduleGains(200+(iteration%250));
+   }
+   uint32_t scheduleTime = CycleCounter::getCount()-start;
+   scheduledPid.setControlParameters(&scheduledSettings);
+
+   printf("   Band change 250->400  = %.2f%% output step at %.1f C error (%.1f%% without integral transfer)\n",
+         bump, bumplessError, fabsf(proportionalChange));
+   printf("   Band change saturated = integral %s at %.1f C error\n",
+         (after.integral == before.integral)?"unchanged":"CHANGED", saturatedError);
+   printf("   Schedule update       = %.1f ns (host, on change of target only)\n", float(scheduleTime)/SCHEDULE_ITERATIONS);
+   printf("   %-22s  %-29s %-29s\n", "", "Single (250 C) PID", "Scheduled PID");
+   printf("   %-22s  %5s %5s %6s %7s   %5s %5s %6s %7s\n", "Profile",
+         "Min", "Over", "Recov", "|Err|", "Min", "Over", "Recov", "|Err|");
+
+   float singleTotal    = 0;
+   float scheduledTotal = 0;
+   for (const LoadProfile &profile:rangeProfiles) {
+      LoadResponse f = runLoadProfile(singlePid, profile, plant);
+      LoadResponse g = runLoadProfile(scheduledPid, profile, plant);
+
+      printf("   %-22s  %5.1f %5.1f %5.1fs %7.1f   %5.1f %5.1f %5.1fs %7.1f\n", profile.name,
+            f.minimum, f.overshoot, f.recovery, f.absError,
+            g.minimum, g.overshoot, g.recovery, g.absError);
+
+      success = success && (g.absError <= 1.01*f.absError);
+      if (profile.load > 0) {
+         singleTotal    += f.absError;
+         scheduledTotal += g.absError;
+      }
+   }
+   printf("   Load |Err|            = %.1f single, %.1f scheduled (%.1f%% less)\n",
+         singleTotal, scheduledTotal, 100*(singleTotal-scheduledTotal)/singleTotal);
+
+   // Overshoot when heating to 400 C is from the 400 C band gains (not scheduling)
+   // The single (250 C) set does not overshoot as its integral limit is below the output to hold 400 C
+   TipSettings single400Settings;
+   single400Settings.loadDefaultCalibration(findTip(IronType_T12));
+   single400Settings.setPidControlValues(scheduledSettings.getPidGains(CalibrationIndex_400));
+
+   PidController single400Pid{CONTROL_INTERVAL, MIN_DUTY, MAX_DUTY};
+   single400Pid.setControlParameters(&single400Settings);
+
+   for (const LoadProfile &profile:{rangeProfiles[0], rangeProfiles[1]}) {
+      LoadResponse s = runLoadProfile(single400Pid, profile, plant);
+      LoadResponse g = runLoadProfile(scheduledPid, profile, plant);
+      printf("   %-22s= %.1f C overshoot single (400 C), %.1f C scheduled\n", profile.name, s.overshoot, g.overshoot);
+      success = success && (g.overshoot <= s.overshoot+0.2);
+   }
+   runLoadProfile(singlePid, rangeProfiles[1], plant);
+   printf("   Single (250 C) @400 C = %.1f C below target (iLimit %.1f%% < %.1f%% to hold)\n",
+         singlePid.getError(), singleSettings.getILimit(CalibrationIndex_400), holdingOutput[CalibrationIndex_400]);
+
+   return success && (scheduledTotal < singleTotal);
+}
+
+bool runBenchmarks() {
+   bool success = true;
+
+   success = benchmarkMeasurementSchedule() && success;
+   success = benchmarkTemperatureConversion() && success;
+   success = benchmarkThermistorTable() && success;
+   success = benchmarkGlyphs() && success;
+   success = benchmarkBlit() && success;
+   success = benchmarkDisplayRefresh() && success;
+   success = benchmarkChannelView() && success;
+   success = benchmarkI2cQueue() && success;
+   success = benchmarkSpscQueue() && success;
+   success = benchmarkQuadDecoder() && success;
+   success = benchmarkTelemetry() && success;
+   success = benchmarkDmaConsole() && success;
+   success = benchmarkFlightRecorder() && success;
+   success = benchmarkPredictiveController() && success;
+   success = benchmarkStepIdentification() && success;
+   success = benchmarkRelayAutotune() && success;
+   success = benchmarkGainScheduling() && success;
+
+   return success;
+}
+
+} // End namespace Simulation
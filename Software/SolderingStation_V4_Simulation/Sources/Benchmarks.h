@@ -0,0 +1,26 @@
+/*
+ * Benchmarks.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef SOURCES_BENCHMARKS_H_
+#define SOURCES_BENCHMARKS_H_
+
+namespace Simulation {
+
+/**
+ * Run host benchmarks of firmware code paths.
+ * Each benchmark compares the previous implementation against the current one
+ * and checks they produce the same results.
+ *
+ * Times are host times (ns) as measured by USBDM::CycleCounter.
+ *
+ * @return true if all results match
+ */
+bool runBenchmarks();
+
+} // End namespace Simulation
+
+#endif /* SOURCES_BENCHMARKS_H_ */
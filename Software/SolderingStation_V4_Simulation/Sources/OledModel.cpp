@@ -0,0 +1,100 @@
+/*
+ * OledModel.cpp
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#include "OledModel.h"
+
+using namespace USBDM;
+
+namespace Simulation {
+
+/// Control byte - Co=0, D/C=1: Byte(s) are graphic data until I2C stop
+static constexpr uint8_t MULTIPLE_GDRAM = 0b01000000;
+
+/**
+ * Get number of argument bytes following a command
+ *
+ * @param command Command byte
+ *
+ * @return Number of argument bytes
+ */
+static unsigned argumentCount(uint8_t command) {
+   switch(command) {
+      case SSD1306_COLUMNADDR:
+      case SSD1306_PAGEADDR:
+         return 2;
+      case SSD1306_MEMORYMODE:
+      case SSD1306_SETCONTRAST:
+      case SSD1306_CHARGEPUMP:
+      case SSD1306_SETMULTIPLEX:
+      case SSD1306_SETDISPLAYOFFSET:
+      case SSD1306_SETDISPLAYCLOCKDIV:
+      case SSD1306_SETPRECHARGE:
+      case SSD1306_SETCOMPINS:
+      case SSD1306_SETVCOMDETECT:
+         return 1;
+      default:
+         return 0;
+   }
+}
+
+void OledModel::commands(uint16_t size, const uint8_t data[]) {
+   for (unsigned index=0; index<size;) {
+      uint8_t  command = data[index++];
+      unsigned count   = argumentCount(command);
+      if ((index+count) > size) {
+         breakpoint("Incomplete OLED command");
+      }
+      switch(command) {
+         case SSD1306_COLUMNADDR:
+            fColumnStart = data[index]   % Oled::WIDTH;
+            fColumnEnd   = data[index+1] % Oled::WIDTH;
+            fColumn      = fColumnStart;
+            break;
+         case SSD1306_PAGEADDR:
+            fPageStart   = data[index]   % Oled::NUM_PAGES;
+            fPageEnd     = data[index+1] % Oled::NUM_PAGES;
+            fPage        = fPageStart;
+            break;
+         case SSD1306_MEMORYMODE:
+            if (data[index] != 0) {
+               breakpoint("Only horizontal addressing is modelled");
+            }
+            break;
+         default:
+            break;
+      }
+      index += count;
+   }
+}
+
+void OledModel::writeRam(uint16_t size, const uint8_t data[]) {
+   fDataBytes += size;
+   for (unsigned index=0; index<size; index++) {
+      fRam[(fPage*Oled::WIDTH)+fColumn] = data[index];
+
+      // Horizontal addressing - wraps within window
+      if (fColumn != fColumnEnd) {
+         fColumn = (fColumn+1) % Oled::WIDTH;
+         continue;
+      }
+      fColumn = fColumnStart;
+      fPage   = (fPage != fPageEnd)?((fPage+1) % Oled::NUM_PAGES):fPageStart;
+   }
+}
+
+void OledModel::transaction(uint8_t address, uint16_t size, const uint8_t data[]) {
+   if ((address != Oled::I2C_ADDRESS) || (size == 0)) {
+      return;
+   }
+   if (data[0] == MULTIPLE_GDRAM) {
+      writeRam(size-1, data+1);
+   }
+   else {
+      commands(size-1, data+1);
+   }
+}
+
+} // End namespace Simulation
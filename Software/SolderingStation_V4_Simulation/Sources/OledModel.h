@@ -0,0 +1,88 @@
+/*
+ * OledModel.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef SOURCES_OLEDMODEL_H_
+#define SOURCES_OLEDMODEL_H_
+
+#include <stdint.h>
+#include "oled.h"
+
+namespace Simulation {
+
+/**
+ * Model of the SSD1306 OLED controller on the I2C bus.
+ *
+ * Only the display RAM and horizontal addressing mode are modelled.
+ * This allows the image on the display to be compared with the firmware frame buffer.
+ */
+class OledModel {
+
+public:
+   /// Size of display RAM
+   static constexpr unsigned RAM_SIZE = USBDM::Oled::IMAGE_DATA_SIZE;
+
+private:
+   /// Display RAM (page/column order)
+   uint8_t  fRam[RAM_SIZE] = {0};
+
+   /// Column window
+   uint8_t  fColumnStart = 0;
+   uint8_t  fColumnEnd   = USBDM::Oled::WIDTH-1;
+
+   /// Page window
+   uint8_t  fPageStart   = 0;
+   uint8_t  fPageEnd     = USBDM::Oled::NUM_PAGES-1;
+
+   /// Current RAM location
+   uint8_t  fColumn      = 0;
+   uint8_t  fPage        = 0;
+
+   /// Number of display RAM bytes written
+   uint64_t fDataBytes   = 0;
+
+   /**
+    * Execute command sequence
+    *
+    * @param size    Number of bytes
+    * @param data    Command bytes
+    */
+   void commands(uint16_t size, const uint8_t data[]);
+
+   /**
+    * Write to display RAM
+    *
+    * @param size    Number of bytes
+    * @param data    Data bytes
+    */
+   void writeRam(uint16_t size, const uint8_t data[]);
+
+public:
+   /**
+    * Process I2C transaction
+    *
+    * @param address I2C address (8-bit form)
+    * @param size    Number of bytes
+    * @param data    Bytes transmitted (control byte followed by commands or data)
+    */
+   void transaction(uint8_t address, uint16_t size, const uint8_t data[]);
+
+   /**
+    * Get display RAM
+    *
+    * @return Display RAM contents (page/column order, as frame buffer)
+    */
+   const uint8_t *getRam() const {
+      return fRam;
+   }
+
+   /// Number of display RAM bytes written
+   uint64_t getDataBytes() const { return fDataBytes; }
+};
+
+} // End namespace Simulation
+
+#endif /* SOURCES_OLEDMODEL_H_ */
@@ -0,0 +1,114 @@
+/*
+ * SimulatedHardware.cpp
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ *
+ * Host definitions for objects provided by the USBDM library on the target
+ * (see hardware.cpp, usbdmError.cpp, console.cpp).
+ */
+#include <stdio.h>
+#include "hardware.h"
+
+namespace USBDM {
+
+/// Simulated ports A-E (inputs pulled-up)
+SimulatedPort simulatedPorts[5] = {
+      {0, 0xFFFFFFFF, 0, nullptr},
+      {0, 0xFFFFFFFF, 0, nullptr},
+      {0, 0xFFFFFFFF, 0, nullptr},
+      {0, 0xFFFFFFFF, 0, nullptr},
+      {0, 0xFFFFFFFF, 0, nullptr},
+};
+
+/// Channel 1 drive (Bit Field)
+const GpioFieldTable_T<GpioCInfo, 2, 1, ActiveLow>    ch1Drive;
+
+/// Channel 1 selected LED
+const GpioTable_T<GpioCInfo, 0, ActiveHigh>           ch1SelectedLed;
+
+/// Channel 2 selected LED
+const GpioTable_T<GpioCInfo, 6, ActiveHigh>           ch2SelectedLed;
+
+/// Channel 2 drive (Bit Field)
+const GpioFieldTable_T<GpioCInfo, 4, 3, ActiveLow>    ch2Drive;
+
+/// Channel 1 voltage select (Bit Field)
+const GpioFieldTable_T<GpioDInfo, 7, 6, ActiveLow>    ch1VoltageSelect;
+
+/// Channel 2 voltage select (Bit Field)
+const GpioFieldTable_T<GpioDInfo, 5, 4, ActiveLow>    ch2VoltageSelect;
+
+/** Last error set by USBDM code */
+volatile ErrorCode errorCode = E_NO_ERROR;
+
+/// Console instance
+Console console;
+
+void mapAllPins() {
+}
+
+/**
+ * Get error message from error code or last error if not provided
+ *
+ * @param[in]   err Error code
+ *
+ * @return Pointer to static string
+ */
+const char *getErrorMessage(ErrorCode err) {
+   static const char *messages[] {
+         "No error",
+         "General error",
+         "Too small",
+         "Too large",
+         "Illegal parameter",
+         "Call-back not installed",
+         "Flash initialisation failed",
+         "ADC Calibration failed",
+         "Illegal processor run-mode transition",
+         "Failed communication",
+         "I2C No acknowledge",
+         "I2C Lost arbitration for bus",
+         "Program has terminated",
+         "Clock initialisation failed",
+         "Callback already installed",
+         "Failed resource allocation",
+   };
+   if (err>=(sizeof(messages)/sizeof(messages[0]))) {
+      return "Unknown error";
+   }
+   return messages[err];
+}
+
+/**
+ * Print simple log message
+ *
+ * @param msg Message to print
+ */
+void log_error(const char *msg) {
+   fprintf(stderr, "%s\n", msg);
+}
+
+/**
+ * Abort program execution with message
+ *
+ * @param msg  Message to print
+ */
+void abort(const char *msg) {
+   log_error(msg);
+   __BKPT();
+}
+
+/**
+ * Check for error code being set (drastically!)
+ * This routine does not return if there is an error
+ */
+ErrorCode checkError() {
+   if (errorCode != E_NO_ERROR) {
+      log_error(getErrorMessage());
+      __BKPT();
+   }
+   return errorCode;
+}
+
+} // End namespace USBDM
@@ -0,0 +1,446 @@
+/*
+ * Simulator.cpp
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#include <stdio.h>
+#include <math.h>
+#include "hardware.h"
+#include "wdog.h"
+#include "i2c.h"
+#include "lptmr.h"
+#include "dma.h"
+#include "Simulator.h"
+
+using namespace USBDM;
+
+namespace Simulation {
+
+Simulator::Simulator() {
+   schedule(EventSource_ZeroCrossing, ZERO_CROSSING_INTERVAL_US);
+}
+
+Simulator &Simulator::instance() {
+   static Simulator simulator;
+   return simulator;
+}
+
+void Simulator::schedule(EventSource source, uint64_t time) {
+   fEvents.push(Event{time, fSequence++, source, ++fGeneration[source]});
+}
+
+uint64_t Simulator::nextEventTime() {
+   while (!fEvents.empty()) {
+      const Event &event = fEvents.top();
+      if (event.generation == fGeneration[event.source]) {
+         return event.time;
+      }
+      // Cancelled or re-scheduled
+      fEvents.pop();
+   }
+   return NEVER;
+}
+
+void Simulator::dispatch(EventSource source) {
+
+   fInterrupt = true;
+   fInterruptCount++;
+
+   if (source != EventSource_Scenario) {
+      fWoken = true;
+   }
+
+   switch(source) {
+      case EventSource_ZeroCrossing:
+         recordHalfCycle();
+         schedule(source, fTime+ZERO_CROSSING_INTERVAL_US);
+         zeroCrossing();
+         break;
+
+      case EventSource_Pit0:
+      case EventSource_Pit1:
+      case EventSource_Pit2:
+      case EventSource_Pit3: {
+         unsigned pitChannel = source-EventSource_Pit0;
+         if (fPitPeriod[pitChannel] != 0) {
+            schedule(source, fTime+fPitPeriod[pitChannel]);
+         }
+         Pit::irqHandler(pitChannel);
+      }
+      break;
+
+      case EventSource_Adc:
+         fLastAdcComplete = fTime;
+         fHalfCycleConversions++;
+         Adc0::irqHandler(fAdcResult, fAdcChannel);
+         break;
+
+      case EventSource_I2c: {
+         // Data is examined at completion to catch the firmware changing it while in use
+         ErrorCode result = E_NO_ERROR;
+         if ((fI2cNackInterval != 0) && ((fI2cTransactions%fI2cNackInterval) == 0)) {
+            result = E_NO_ACK;
+         }
+         else {
+            fOled.transaction(fI2cAddress, fI2cSize, fI2cData);
+         }
+         if (fI2cMonitor) {
+            fI2cMonitor(fI2cAddress, fI2cSize, fI2cData, result);
+         }
+         I2c0::irqHandler(result);
+      }
+      break;
+
+      case EventSource_UartDma: {
+         static void (*const handlers[])() = {
+               Dma0::irqHandler<0>, Dma0::irqHandler<1>, Dma0::irqHandler<2>, Dma0::irqHandler<3>,
+         };
+         // Data is examined at completion to catch the firmware changing it while in use
+         fUartCapture.insert(fUartCapture.end(), fUartData, fUartData+fUartSize);
+         fUartBytes += fUartSize;
+         fUartBusy   = false;
+         handlers[fUartDmaChannel]();
+      }
+      break;
+
+      case EventSource_Watchdog:
+         Wdog::irqHandler();
+         break;
+
+      case EventSource_Lptmr:
+         schedule(source, fTime+fLptmrPeriod);
+         Lptmr0::irqHandler();
+         break;
+
+      case EventSource_Scenario: {
+         auto it = fActions.begin();
+         Action action = it->second;
+         fActions.erase(it);
+         if (!fActions.empty()) {
+            schedule(source, fActions.begin()->first);
+         }
+         action();
+      }
+      break;
+
+      default:
+         break;
+   }
+   fInterrupt = false;
+}
+
+void Simulator::advanceTo(uint64_t time) {
+   for(;;) {
+      uint64_t due = nextEventTime();
+      if (due > time) {
+         break;
+      }
+      if (due > fTime) {
+         fTime = due;
+      }
+      if (fTime >= fEndTime) {
+         throw Finished();
+      }
+      EventSource source = fEvents.top().source;
+      fEvents.pop();
+      dispatch(source);
+   }
+   if (time > fTime) {
+      fTime = time;
+   }
+}
+
+void Simulator::recordHalfCycle() {
+   if (fHalfCycleConversions > 0) {
+      HalfCycleStatistics &stats = fHalfCycleStatistics;
+      uint32_t used = fLastAdcComplete - fLastZeroCrossing;
+      stats.count++;
+      stats.totalUsed          += used;
+      stats.maximumUsed         = std::max(stats.maximumUsed, used);
+      stats.conversions        += fHalfCycleConversions;
+      stats.maximumConversions  = std::max(stats.maximumConversions, fHalfCycleConversions);
+   }
+   fLastZeroCrossing     = fTime;
+   fHalfCycleConversions = 0;
+}
+
+void Simulator::reportHalfCycleUsage() const {
+   const HalfCycleStatistics &stats = fHalfCycleStatistics;
+   if (stats.count == 0) {
+      return;
+   }
+   double averageUsed        = stats.totalUsed/(double)stats.count;
+   double averageConversions = stats.conversions/(double)stats.count;
+   double timePerConversion  = stats.totalUsed/(double)stats.conversions;
+   uint32_t headroom         = ZERO_CROSSING_INTERVAL_US-stats.maximumUsed;
+
+   printf("Half-cycle used (avg) = %.0f us (%.1f%%)\n", averageUsed, 100*averageUsed/ZERO_CROSSING_INTERVAL_US);
+   printf("Half-cycle used (max) = %u us (%.1f%%)\n",   stats.maximumUsed, 100.0*stats.maximumUsed/ZERO_CROSSING_INTERVAL_US);
+   printf("Half-cycle headroom   = %u us\n",            headroom);
+   printf("Conversions/half-cycle= %.1f (max %u)\n",    averageConversions, stats.maximumConversions);
+   printf("Extra conversions     = %.0f (at %.0f us each)\n", headroom/timePerConversion, timePerConversion);
+}
+
+void Simulator::zeroCrossing() {
+
+   // Drive and voltage present during the half-cycle just completed
+   fTools[0].advance(ZERO_CROSSING_INTERVAL_US/1000000.0, ch1Drive.readState(), ch1VoltageSelect.readState());
+   fTools[1].advance(ZERO_CROSSING_INTERVAL_US/1000000.0, ch2Drive.readState(), ch2VoltageSelect.readState());
+
+   Cmp0::irqHandler(CmpEvent_Falling);
+}
+
+uint32_t Simulator::sampleAdc(int adcChannel) {
+
+   constexpr float ADC_MAXIMUM = FixedGainAdc::getSingleEndedMaximum(ADC_RESOLUTION);
+
+   float voltage = 0;
+
+   if (adcChannel == ChipTemperatureAdcChannel::CHANNEL) {
+      // Internal sensor: V = 0.719 - 1.715 mV/K above 25C
+      voltage = 0.719 - (CHIP_TEMPERATURE-25)*0.001715;
+   }
+   else if (adcChannel == FixedGainAdcChannel::CHANNEL) {
+      uint8_t mux = AmplifierControl::readState();
+      float   inputVoltage = 0;
+      if (!Clamp::readState()) {
+         const ThermalModel &tool = fTools[(mux&CHANNEL_MASK)?0:1];
+         inputVoltage = tool.getInputVoltage((mux&AB_MASK)?SubChannelNum_B:SubChannelNum_A, mux&BIAS_MASK);
+      }
+      float ratio = (mux&GAIN_BOOST_MASK)?LOW_GAIN_MEASUREMENT_RATIO_BOOST_ON:LOW_GAIN_MEASUREMENT_RATIO_BOOST_OFF;
+      voltage = inputVoltage/ratio;
+   }
+   int result = static_cast<int>(roundf((voltage/ADC_REF_VOLTAGE)*ADC_MAXIMUM));
+
+   if (fAdcNoise != 0) {
+      // Deterministic LCG so runs are repeatable
+      fNoiseSeed = fNoiseSeed*1664525U + 1013904223U;
+      result += static_cast<int>((fNoiseSeed>>16)%(2*fAdcNoise+1)) - static_cast<int>(fAdcNoise);
+   }
+   return std::clamp(result, 0, static_cast<int>(ADC_MAXIMUM));
+}
+
+void Simulator::startAdcConversion(int adcChannel) {
+   fAdcChannel = adcChannel;
+   fAdcResult  = sampleAdc(adcChannel);
+   schedule(EventSource_Adc, fTime+ADC_CONVERSION_US);
+}
+
+void Simulator::startPit(unsigned pitChannel, uint32_t microseconds, bool periodic) {
+   fPitPeriod[pitChannel] = periodic?microseconds:0;
+   schedule(static_cast<EventSource>(EventSource_Pit0+pitChannel), fTime+microseconds);
+}
+
+void Simulator::stopPit(unsigned pitChannel) {
+   // Invalidate any queued timeout
+   fPitPeriod[pitChannel] = 0;
+   fGeneration[EventSource_Pit0+pitChannel]++;
+}
+
+void Simulator::startLowPowerTimer(uint32_t microseconds) {
+   fLptmrPeriod = microseconds;
+   schedule(EventSource_Lptmr, fTime+microseconds);
+}
+
+void Simulator::stopLowPowerTimer() {
+   fGeneration[EventSource_Lptmr]++;
+}
+
+void Simulator::waitForInterrupt() {
+   if (fInterrupt) {
+      breakpoint("WFI in interrupt handler");
+   }
+   // Scenario actions only wake the processor if they cause a pin-change interrupt
+   fWoken = false;
+   while (!fWoken) {
+      uint64_t due = nextEventTime();
+      if (due == NEVER) {
+         breakpoint("WFI with no interrupts pending");
+      }
+      advanceTo(due);
+   }
+   fWakeups++;
+}
+
+void Simulator::preemptionPoint() {
+   if (fInterrupt) {
+      return;
+   }
+   advanceTo(fTime+1);
+}
+
+void Simulator::delay(float seconds) {
+   uint64_t time = fTime + static_cast<uint64_t>(seconds*1000000);
+   if (fInterrupt) {
+      // Interrupts are not taken during a delay in a handler
+      fTime = time;
+      return;
+   }
+   advanceTo(time);
+}
+
+/**
+ * Time to transfer over I2C
+ *
+ * @param size Number of data bytes
+ *
+ * @return Time in microseconds - 9 clocks per byte (including address) at 400 kHz
+ */
+static uint64_t i2cTransferTime(uint16_t size) {
+   return ((size+1)*9*1000000ULL)/400000;
+}
+
+void Simulator::i2cTransmit(uint8_t address, uint16_t size, const uint8_t data[]) {
+   fI2cTransactions++;
+   fI2cBytes += size+1;
+   fOled.transaction(address, size, data);
+
+   delay(i2cTransferTime(size)/1000000.0);
+}
+
+void Simulator::i2cStartTransmit(uint8_t address, uint16_t size, const uint8_t data[]) {
+   fI2cTransactions++;
+   fI2cBytes += size+1;
+
+   fI2cAddress = address;
+   fI2cSize    = size;
+   fI2cData    = data;
+
+   uint64_t jitter = 0;
+   if (fI2cJitter != 0) {
+      fI2cSeed = fI2cSeed*1664525U + 1013904223U;
+      jitter   = (fI2cSeed>>16)%(fI2cJitter+1);
+   }
+   schedule(EventSource_I2c, fTime+i2cTransferTime(size)+jitter);
+}
+
+void Simulator::uartDmaStartTransmit(unsigned dmaChannel, uint16_t size, const uint8_t data[]) {
+   if (fUartBusy) {
+      breakpoint("UART DMA transfer started while busy");
+   }
+   if (dmaChannel > 3) {
+      breakpoint("DMA channel not simulated");
+   }
+   fUartBusy       = true;
+   fUartDmaChannel = dmaChannel;
+   fUartSize       = size;
+   fUartData       = data;
+   schedule(EventSource_UartDma, fTime+size*UART_BYTE_US);
+}
+
+void Simulator::updateWatchdog() {
+   if (Wdog::timeout > 0) {
+      schedule(EventSource_Watchdog, fLastWatchdogRefresh + static_cast<uint64_t>(Wdog::timeout*1000000));
+   }
+}
+
+void Simulator::watchdogRefresh() {
+   fLastWatchdogRefresh = fTime;
+   updateWatchdog();
+}
+
+void Simulator::addAction(double seconds, Action action) {
+   uint64_t time = static_cast<uint64_t>(seconds*1000000);
+   bool     first = fActions.empty() || (time < fActions.begin()->first);
+   fActions.emplace(time, action);
+   if (first) {
+      schedule(EventSource_Scenario, time);
+   }
+}
+
+void Simulator::setPortInputs(SimulatedPort &port, uint32_t mask, uint32_t value) {
+   if (port.setInputs(mask, value)) {
+      fWoken = true;
+   }
+}
+
+void Simulator::pressButton(double seconds, uint32_t bitMask, double duration) {
+   // Buttons are active-low
+   addAction(seconds,          [this, bitMask](){ setPortInputs(simulatedPorts[GpioDInfo::portIndex], bitMask, 0); });
+   addAction(seconds+duration, [this, bitMask](){ setPortInputs(simulatedPorts[GpioDInfo::portIndex], bitMask, bitMask); });
+}
+
+void Simulator::rotateEncoder(double seconds, int detents, double detentTime) {
+   // Active encoder phases for one detent (increment)
+   static constexpr uint32_t phases[] = {0b01, 0b11, 0b10, 0b00};
+
+   const double STEP = detentTime/4;
+
+   for (int detent=0; detent<abs(detents); detent++) {
+      for (unsigned step=0; step<4; step++) {
+         uint32_t phase = (detents>0)?phases[step]:(phases[(2-step)&3]);
+         // Encoder phases are active-low
+         addAction(seconds, [this, phase](){
+            setPortInputs(simulatedPorts[GpioBInfo::portIndex], QuadPhases::BITMASK, (~phase<<QuadPhases::RIGHT)&QuadPhases::BITMASK);
+         });
+         seconds += STEP;
+      }
+   }
+}
+
+/*
+ * Hooks used by the peripheral stubs
+ */
+uint64_t getTimeInMicroseconds() {
+   return Simulator::instance().getTime();
+}
+
+void startAdcConversion(int adcChannel) {
+   Simulator::instance().startAdcConversion(adcChannel);
+}
+
+void startOneShot(unsigned pitChannel, uint32_t microseconds) {
+   Simulator::instance().startPit(pitChannel, microseconds, false);
+}
+
+void startPeriodic(unsigned pitChannel, uint32_t microseconds) {
+   Simulator::instance().startPit(pitChannel, microseconds, true);
+}
+
+void stopPit(unsigned pitChannel) {
+   Simulator::instance().stopPit(pitChannel);
+}
+
+void startLowPowerTimer(uint32_t microseconds) {
+   Simulator::instance().startLowPowerTimer(microseconds);
+}
+
+void stopLowPowerTimer() {
+   Simulator::instance().stopLowPowerTimer();
+}
+
+void waitForInterrupt() {
+   Simulator::instance().waitForInterrupt();
+}
+
+void preemptionPoint() {
+   Simulator::instance().preemptionPoint();
+}
+
+void delay(float seconds) {
+   Simulator::instance().delay(seconds);
+}
+
+void i2cTransmit(uint8_t address, uint16_t size, const uint8_t data[]) {
+   Simulator::instance().i2cTransmit(address, size, data);
+}
+
+void i2cStartTransmit(uint8_t address, uint16_t size, const uint8_t data[]) {
+   Simulator::instance().i2cStartTransmit(address, size, data);
+}
+
+void uartDmaStartTransmit(unsigned dmaChannel, uint16_t size, const uint8_t data[]) {
+   Simulator::instance().uartDmaStartTransmit(dmaChannel, size, data);
+}
+
+void watchdogRefresh() {
+   Simulator::instance().watchdogRefresh();
+}
+
+void breakpoint(const char *reason) {
+   fprintf(stderr, "Break-point at %.6f s: %s\n", Simulator::instance().getSeconds(), reason);
+   throw BreakpointHit{reason};
+}
+
+} // End namespace Simulation
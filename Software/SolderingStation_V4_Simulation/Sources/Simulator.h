@@ -0,0 +1,441 @@
+/*
+ * Simulator.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef SOURCES_SIMULATOR_H_
+#define SOURCES_SIMULATOR_H_
+
+#include <stdint.h>
+#include <functional>
+#include <map>
+#include <queue>
+#include <vector>
+#include "ThermalModel.h"
+#include "OledModel.h"
+
+namespace Simulation {
+
+/**
+ * Thrown to end the simulation when the end time is reached
+ */
+struct Finished {};
+
+/**
+ * Thrown when the firmware executes a break-point
+ */
+struct BreakpointHit {
+   const char *reason;
+};
+
+/**
+ * Discrete-event simulation of the soldering station hardware.
+ *
+ * Interrupt sources (zero-crossing comparator, PIT, ADC, I2C, UART DMA, watchdog, scenario) are
+ * placed in a time ordered queue and executed in microsecond order.
+ * Events with the same time are executed in the order they were scheduled.
+ *
+ * Simulated time is advanced only by:
+ * - The firmware waiting for an interrupt (Smc::enterWaitMode())
+ * - Busy-wait delays and I2C transfers
+ * - Pre-emption points (end of critical sections) which advance time by 1 us
+ *
+ * Interrupt handlers are executed atomically i.e. they are not pre-empted and do not take time.
+ */
+class Simulator {
+
+public:
+   /// Type for scenario actions
+   using Action = std::function<void()>;
+
+   /// Type for observer of completed I2C transactions (address, size, data, result)
+   using I2cMonitor = std::function<void(uint8_t, uint16_t, const uint8_t[], USBDM::ErrorCode)>;
+
+   /// Half-cycle of rectified mains (us)
+   static constexpr uint32_t ZERO_CROSSING_INTERVAL_US = 10000;
+
+   /// Time taken by a (hardware averaged) ADC conversion (us)
+   static constexpr uint32_t ADC_CONVERSION_US = 40;
+
+   /// Simulated temperature of the microcontroller (Celsius)
+   static constexpr float CHIP_TEMPERATURE = 30.0;
+
+   /// Time to transmit a byte over the console UART (us) - 10 bits at 115200 baud
+   static constexpr uint32_t UART_BYTE_US = 87;
+
+private:
+   /**
+    * Sources of events
+    */
+   enum EventSource : uint8_t {
+      EventSource_ZeroCrossing,
+      EventSource_Pit0,
+      EventSource_Pit1,
+      EventSource_Pit2,
+      EventSource_Pit3,
+      EventSource_Adc,
+      EventSource_I2c,
+      EventSource_UartDma,
+      EventSource_Watchdog,
+      EventSource_Lptmr,
+      EventSource_Scenario,
+      EventSource_Count,
+   };
+
+   /**
+    * Timestamped event in queue
+    */
+   struct Event {
+      uint64_t    time;         // Time event is due (us)
+      uint64_t    sequence;     // Order of scheduling - breaks ties so dispatch order is deterministic
+      EventSource source;       // Source of event
+      uint32_t    generation;   // Generation of source when scheduled - stale events are discarded
+
+      /// Ordering for min-heap (std::priority_queue is a max-heap)
+      bool operator<(const Event &other) const {
+         if (time != other.time) {
+            return time > other.time;
+         }
+         return sequence > other.sequence;
+      }
+   };
+
+   /**
+    * Statistics on use of each half-cycle by the measurement sequence
+    */
+   struct HalfCycleStatistics {
+      uint64_t count              = 0;   // Number of half-cycles measured
+      uint64_t totalUsed          = 0;   // Total time used (us)
+      uint32_t maximumUsed        = 0;   // Maximum time used in a half-cycle (us)
+      uint64_t conversions        = 0;   // Total ADC conversions
+      uint32_t maximumConversions = 0;   // Maximum ADC conversions in a half-cycle
+   };
+
+   /// Indicates no event
+   static constexpr uint64_t NEVER = UINT64_MAX;
+
+   /// Current time (us)
+   uint64_t fTime = 0;
+
+   /// Time to stop simulation (us)
+   uint64_t fEndTime = NEVER;
+
+   /// Pending events
+   std::priority_queue<Event> fEvents;
+
+   /// Sequence number for next event scheduled
+   uint64_t fSequence = 0;
+
+   /// Current generation of each source. Re-scheduling or cancelling a source invalidates queued events.
+   uint32_t fGeneration[EventSource_Count] = {0};
+
+   /// Time of last zero-crossing (us)
+   uint64_t fLastZeroCrossing = 0;
+
+   /// Time of last ADC conversion complete in this half-cycle (us)
+   uint64_t fLastAdcComplete = 0;
+
+   /// ADC conversions completed in this half-cycle
+   uint32_t fHalfCycleConversions = 0;
+
+   /// Use of half-cycles by measurement sequence
+   HalfCycleStatistics fHalfCycleStatistics;
+
+   /// Period for PIT channels (0 => one-shot)
+   uint32_t fPitPeriod[4] = {0};
+
+   /// Period of low power timer (us)
+   uint32_t fLptmrPeriod = 0;
+
+   /// Indicates an interrupt has occurred that would wake the processor from WFI
+   bool fWoken = false;
+
+   /// Number of times the processor has woken from WFI
+   uint64_t fWakeups = 0;
+
+   /// Channel being converted by ADC
+   int fAdcChannel = 0;
+
+   /// Result of ADC conversion in progress
+   uint32_t fAdcResult = 0;
+
+   /// Time of last watchdog refresh (us)
+   uint64_t fLastWatchdogRefresh = 0;
+
+   /// Indicates an interrupt handler is executing
+   bool fInterrupt = false;
+
+   /// Scenario actions ordered by time (the earliest is queued as an event)
+   std::multimap<uint64_t, Action> fActions;
+
+   /// Tools for each channel (index 0 => channel 1)
+   ThermalModel fTools[2];
+
+   /// Amplitude of noise added to ADC conversions (LSBs)
+   unsigned fAdcNoise = 0;
+
+   /// State of noise generator
+   uint32_t fNoiseSeed = 12345;
+
+   /// Number of bytes transmitted over I2C
+   uint64_t fI2cBytes = 0;
+
+   /// Number of I2C transactions
+   uint64_t fI2cTransactions = 0;
+
+   /// Transaction in progress (started by i2cStartTransmit())
+   uint8_t        fI2cAddress = 0;
+   uint16_t       fI2cSize    = 0;
+   const uint8_t *fI2cData    = nullptr;
+
+   /// Every n-th transaction is not acknowledged (0 => no faults)
+   unsigned fI2cNackInterval = 0;
+
+   /// Maximum random extra time added to each transaction (us)
+   unsigned fI2cJitter = 0;
+
+   /// State of I2C fault generator
+   uint32_t fI2cSeed = 54321;
+
+   /// Observer of completed I2C transactions
+   I2cMonitor fI2cMonitor;
+
+   /// OLED on I2C bus
+   OledModel fOled;
+
+   /// UART DMA transfer in progress (started by uartDmaStartTransmit())
+   bool           fUartBusy       = false;
+   unsigned       fUartDmaChannel = 0;
+   uint16_t       fUartSize       = 0;
+   const uint8_t *fUartData       = nullptr;
+
+   /// Number of bytes transmitted over the console UART by DMA
+   uint64_t fUartBytes = 0;
+
+   /// Data transmitted over the console UART by DMA
+   std::vector<uint8_t> fUartCapture;
+
+   /// Number of interrupts executed
+   uint64_t fInterruptCount = 0;
+
+   /**
+    * Schedule an event.
+    * Any event already queued for the source is cancelled.
+    *
+    * @param source  Source of event
+    * @param time    Time event is due (us)
+    */
+   void schedule(EventSource source, uint64_t time);
+
+   /**
+    * Cancel any queued event for a source
+    *
+    * @param source  Source of event
+    */
+   void cancel(EventSource source) {
+      fGeneration[source]++;
+   }
+
+   /**
+    * Discard stale events from the head of the queue
+    *
+    * @return Time next event is due (NEVER if none)
+    */
+   uint64_t nextEventTime();
+
+   /**
+    * Execute a single event
+    *
+    * @param source Source of event
+    */
+   void dispatch(EventSource source);
+
+   /**
+    * Record use of half-cycle by measurement sequence
+    */
+   void recordHalfCycle();
+
+   /**
+    * Execute events in order until the given time
+    *
+    * @param time Time to advance to (us)
+    */
+   void advanceTo(uint64_t time);
+
+   /**
+    * Determine the result of an ADC conversion from the current hardware state
+    *
+    * @param adcChannel ADC channel being converted
+    *
+    * @return Conversion result
+    */
+   uint32_t sampleAdc(int adcChannel);
+
+   /**
+    * Mains zero-crossing.
+    * Advances the tools by a half-cycle using the drive present during that half-cycle.
+    */
+   void zeroCrossing();
+
+   /**
+    * Update due time for watchdog
+    */
+   void updateWatchdog();
+
+public:
+   Simulator();
+
+   /**
+    * Get the simulator instance
+    */
+   static Simulator &instance();
+
+   /**
+    * Get the current simulated time
+    *
+    * @return Time in microseconds
+    */
+   uint64_t getTime() const {
+      return fTime;
+   }
+
+   /**
+    * Get the current simulated time
+    *
+    * @return Time in seconds
+    */
+   double getSeconds() const {
+      return fTime/1000000.0;
+   }
+
+   /**
+    * Set time the simulation finishes
+    *
+    * @param seconds Time in seconds
+    */
+   void setEndTime(double seconds) {
+      fEndTime = static_cast<uint64_t>(seconds*1000000);
+   }
+
+   /**
+    * Get tool on a channel
+    *
+    * @param channel Channel number (1 or 2)
+    */
+   ThermalModel &getTool(unsigned channel) {
+      return fTools[channel-1];
+   }
+
+   /**
+    * Set amplitude of noise added to ADC conversions
+    *
+    * @param lsbs Amplitude (+/- LSBs)
+    */
+   void setAdcNoise(unsigned lsbs) {
+      fAdcNoise = lsbs;
+   }
+
+   /**
+    * Add a scenario action.
+    * Actions are executed in interrupt context at the given time.
+    *
+    * @param seconds Time to execute action
+    * @param action  Action to execute
+    */
+   void addAction(double seconds, Action action);
+
+   /**
+    * Add actions to press and release a button
+    *
+    * @param seconds     Time of press
+    * @param bitMask     Button mask in port D
+    * @param duration    How long to hold the button (s)
+    */
+   void pressButton(double seconds, uint32_t bitMask, double duration);
+
+   /**
+    * Add actions to rotate the encoder by whole detents
+    *
+    * @param seconds     Time of first step
+    * @param detents     Number of detents to move (+ve => increment)
+    * @param detentTime  Time for each detent (4 steps)
+    */
+   void rotateEncoder(double seconds, int detents, double detentTime=0.008);
+
+   /// Number of bytes transmitted over I2C
+   uint64_t getI2cBytes() const { return fI2cBytes; }
+
+   /// Number of I2C transactions
+   uint64_t getI2cTransactions() const { return fI2cTransactions; }
+
+   /// OLED on I2C bus
+   const OledModel &getOled() const { return fOled; }
+
+   /// Number of bytes transmitted over the console UART by DMA
+   uint64_t getUartBytes() const { return fUartBytes; }
+
+   /// Data transmitted over the console UART by DMA
+   const std::vector<uint8_t> &getUartCapture() const { return fUartCapture; }
+
+   /**
+    * Inject faults into non-blocking I2C transactions
+    *
+    * @param nackInterval  Every n-th transaction fails with E_NO_ACK (0 => none)
+    * @param jitterUs      Maximum random extra time added to each transaction (us)
+    */
+   void setI2cFaults(unsigned nackInterval, unsigned jitterUs) {
+      fI2cNackInterval = nackInterval;
+      fI2cJitter       = jitterUs;
+   }
+
+   /**
+    * Set observer called as each non-blocking I2C transaction completes (before the I2C interrupt)
+    *
+    * @param monitor Function to call (empty => none)
+    */
+   void setI2cMonitor(I2cMonitor monitor) {
+      fI2cMonitor = monitor;
+   }
+
+   /// Number of interrupts executed
+   uint64_t getInterruptCount() const { return fInterruptCount; }
+
+   /// Number of times the processor has woken from WFI
+   uint64_t getWakeups() const { return fWakeups; }
+
+   /**
+    * Change input pins on a port as done by a scenario action.
+    * A pin-change interrupt (if enabled) wakes the processor.
+    *
+    * @param port    Port to change
+    * @param mask    Pins being changed
+    * @param value   New value for pins
+    */
+   void setPortInputs(USBDM::SimulatedPort &port, uint32_t mask, uint32_t value);
+
+   /**
+    * Report use of each half-cycle by the measurement sequence
+    * i.e. time from zero-crossing to the last ADC conversion completing
+    */
+   void reportHalfCycleUsage() const;
+
+   // Implementation of hooks - see SimulatedHardware.h
+   void startAdcConversion(int adcChannel);
+   void startPit(unsigned pitChannel, uint32_t microseconds, bool periodic);
+   void stopPit(unsigned pitChannel);
+   void startLowPowerTimer(uint32_t microseconds);
+   void stopLowPowerTimer();
+   void waitForInterrupt();
+   void preemptionPoint();
+   void delay(float seconds);
+   void i2cTransmit(uint8_t address, uint16_t size, const uint8_t data[]);
+   void i2cStartTransmit(uint8_t address, uint16_t size, const uint8_t data[]);
+   void uartDmaStartTransmit(unsigned dmaChannel, uint16_t size, const uint8_t data[]);
+   void watchdogRefresh();
+};
+
+} // End namespace Simulation
+
+#endif /* SOURCES_SIMULATOR_H_ */
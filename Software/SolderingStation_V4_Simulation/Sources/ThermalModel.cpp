@@ -0,0 +1,153 @@
+/*
+ * ThermalModel.cpp
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+#include <math.h>
+#include <strings.h>
+#include "ThermalModel.h"
+
+namespace Simulation {
+
+/**
+ * Tool parameters
+ *
+ * Thermal values are estimates from heat-up time and idle power of real tools.
+ * Sensor characteristics match the default calibration in T12.h, Weller.h, Jbc.h, AttenTweezers.h
+ */
+const ThermalModel::Parameters ThermalModel::parameters[] = {
+      //  Name       Rid     Rheater  C     G      N  Sensor                    CJ     Calibration (Celsius, mV or ohms)
+      {"None",       0,      0,       1.0,  1.0,   0, SensorType_None,          false, {{0,0},{1,1},{2,2},{3,3}}},
+      {"T12",     2200,      8.5,     2.0,  0.025, 1, SensorType_Thermocouple,  true,  {{0,0},{215,4.7},{290,6.1},{363,7.7}}},
+      {"Weller", 10000,     11.0,     4.0,  0.030, 1, SensorType_Ptc,           false, {{0,22},{250,37.78},{325,40.83},{400,43.37}}},
+      {"JBC",     3300,      3.5,     0.8,  0.020, 1, SensorType_Thermocouple,  false, {{0,0},{250,1.0},{325,2.0},{400,3.0}}},
+      {"Atten",   5600,      3.3,     1.2,  0.020, 2, SensorType_Thermocouple,  false, {{0,0},{250,5.6},{325,7.3},{400,7.9}}},
+};
+
+ThermalModel::ThermalModel(ToolType toolType, float ambient) : fAmbient(ambient) {
+   setTool(toolType);
+}
+
+bool ThermalModel::findTool(const char *name, ToolType &toolType) {
+   for (unsigned index=0; index<sizeof(parameters)/sizeof(parameters[0]); index++) {
+      if (strcasecmp(name, parameters[index].name) == 0) {
+         toolType = static_cast<ToolType>(index);
+         return true;
+      }
+   }
+   return false;
+}
+
+void ThermalModel::setTool(ToolType toolType) {
+   fParameters = &parameters[toolType];
+   for (unsigned heater=0; heater<MAX_HEATERS; heater++) {
+      fTemperature[heater] = fAmbient;
+      fPower[heater]       = 0;
+   }
+}
+
+float ThermalModel::interpolate(float x, unsigned xIndex, unsigned yIndex) const {
+   const float (&table)[4][2] = fParameters->calibration;
+
+   unsigned index;
+   for (index=1; index<3; index++) {
+      if (x < table[index][xIndex]) {
+         break;
+      }
+   }
+   const float x0 = table[index-1][xIndex];
+   const float y0 = table[index-1][yIndex];
+   const float x1 = table[index][xIndex];
+   const float y1 = table[index][yIndex];
+
+   return y0 + (y1-y0)*(x-x0)/(x1-x0);
+}
+
+float ThermalModel::getThermocoupleVoltage(float temperature) const {
+   if (fParameters->hasColdJunction) {
+      // Thermocouple measures relative to handle (at ambient)
+      temperature -= fAmbient;
+   }
+   return interpolate(temperature, 0, 1)/1000;
+}
+
+float ThermalModel::getNtcResistance(float temperature) {
+   // Inverse of 1/T = A + B.ln(R) + C.ln(R)^2 used in ThermistorMF58Average
+   constexpr float A_constant = 1.80554E-03;
+   constexpr float B_constant = 8.15458E-05;
+   constexpr float C_constant = 9.43826E-06;
+
+   constexpr float CelsiusToKelvin = 274.15;
+
+   float reciprocalTemperature = 1/(temperature+CelsiusToKelvin);
+
+   float discriminant = B_constant*B_constant - 4*C_constant*(A_constant-reciprocalTemperature);
+   float logR         = (-B_constant + sqrtf(discriminant))/(2*C_constant);
+
+   return expf(logR);
+}
+
+void ThermalModel::advance(float seconds, unsigned drive, unsigned voltageSelect) {
+
+   float voltage = 0;
+   switch(voltageSelect) {
+      case VoltageSelect_12V: voltage = 12.0; break;
+      case VoltageSelect_24V: voltage = 24.0; break;
+      default:                voltage = 0.0;  break;
+   }
+   for (unsigned heater=0; heater<MAX_HEATERS; heater++) {
+      fPower[heater] = 0;
+      if (heater >= fParameters->numHeaters) {
+         continue;
+      }
+      const float rise = fTemperature[heater]-fAmbient;
+
+      // Single heater tools use either drive output
+      bool on = (fParameters->numHeaters == 1)?(drive != 0):(drive & (1<<heater));
+      if (on) {
+         fPower[heater] = voltage*voltage/(fParameters->heaterResistance*(1+fHeaterCoefficient*rise));
+      }
+      // Exact solution of first-order system over interval with constant power (and conductance)
+      float conductance  = fParameters->conductance*(1+fLossCoefficient*rise) + fLoad/fParameters->numHeaters;
+      float steadyState  = fAmbient + fPower[heater]/conductance;
+      float decay        = expf(-seconds*conductance/fParameters->heatCapacity);
+
+      fTemperature[heater] = steadyState + (fTemperature[heater]-steadyState)*decay;
+      fEnergy += fPower[heater]*seconds;
+   }
+}
+
+float ThermalModel::getInputVoltage(SubChannelNum subChannel, bool bias) const {
+
+   if (fParameters->sensorType == SensorType_None) {
+      // Open circuit
+      return bias?BIAS_VOLTAGE:0.0;
+   }
+   if (bias) {
+      if (subChannel == SubChannelNum_A) {
+         // Tool identification resistor
+         return getDividerVoltage(fParameters->idResistor);
+      }
+      if (fParameters->sensorType == SensorType_Ptc) {
+         return getDividerVoltage(interpolate(fTemperature[0], 0, 1));
+      }
+      if (fParameters->hasColdJunction) {
+         return getDividerVoltage(getNtcResistance(fAmbient));
+      }
+      // Open circuit
+      return BIAS_VOLTAGE;
+   }
+   if (fParameters->sensorType != SensorType_Thermocouple) {
+      return 0.0;
+   }
+   if (subChannel == SubChannelNum_A) {
+      return getThermocoupleVoltage(fTemperature[0]);
+   }
+   if (fParameters->numHeaters > 1) {
+      return getThermocoupleVoltage(fTemperature[1]);
+   }
+   return 0.0;
+}
+
+} // End namespace Simulation
@@ -0,0 +1,243 @@
+/*
+ * ThermalModel.h
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ */
+
+#ifndef SOURCES_THERMALMODEL_H_
+#define SOURCES_THERMALMODEL_H_
+
+#include "Peripherals.h"
+
+namespace Simulation {
+
+/**
+ * Model of a soldering tool plugged into a channel.
+ *
+ * - Heater(s) are represented by a first-order thermal plant:\n
+ *      C.dT/dt = P - (G+Gload).(T-Tambient)
+ * - Optionally the heater resistance and loss increase linearly with temperature
+ *   (setTemperatureCoefficients()) so the plant gain and time constant fall at high temperatures.
+ * - Sensors (ID resistor, thermocouple, NTC, PTC) are represented by the voltage
+ *   presented to the measurement multiplexor.
+ *
+ * Sensor characteristics are the inverse of the default tip calibration used
+ * by the firmware so an un-calibrated tip reads the true temperature.
+ */
+class ThermalModel {
+
+public:
+   /**
+    * Tool types that may be simulated
+    */
+   enum ToolType {
+      ToolType_None,    //!< No tool present
+      ToolType_T12,     //!< Hakko T12 cartridge
+      ToolType_Weller,  //!< Weller WT50 (PTC sensor)
+      ToolType_JBC,     //!< JBC C210 cartridge
+      ToolType_Atten,   //!< Atten tweezers (two heaters)
+   };
+
+   /// Maximum number of heaters in a tool
+   static constexpr unsigned MAX_HEATERS = 2;
+
+private:
+   /**
+    * Sensor used for tip temperature
+    */
+   enum SensorType {
+      SensorType_None,
+      SensorType_Thermocouple,   // Thermocouple on sub-channel A (and B for 2nd heater)
+      SensorType_Ptc,            // PTC on sub-channel B measured with bias
+   };
+
+   /**
+    * Description of a tool
+    */
+   struct Parameters {
+      const char  *name;                  // Name for reporting
+      float        idResistor;            // ID resistor (ohms)
+      float        heaterResistance;      // Resistance of each heater (ohms)
+      float        heatCapacity;          // Thermal mass of each heater+tip (J/K)
+      float        conductance;           // Loss to ambient of each heater+tip (W/K)
+      unsigned     numHeaters;            // Number of heaters/sensors
+      SensorType   sensorType;            // Tip sensor type
+      bool         hasColdJunction;       // Uses NTC on sub-channel B for cold junction
+      float        calibration[4][2];     // Sensor characteristic (Celsius, mV or ohms)
+   };
+
+   /// Parameters for each tool type
+   static const Parameters parameters[];
+
+   /// Current tool
+   const Parameters *fParameters;
+
+   /// Ambient temperature (Celsius)
+   float fAmbient;
+
+   /// Extra load conductance e.g. soldering a joint (W/K)
+   float fLoad = 0;
+
+   /// Increase in heater resistance with temperature (per K above ambient)
+   float fHeaterCoefficient = 0;
+
+   /// Increase in loss to ambient with temperature e.g. radiation (per K above ambient)
+   float fLossCoefficient = 0;
+
+   /// Temperature of each heater (Celsius)
+   float fTemperature[MAX_HEATERS];
+
+   /// Power applied to each heater in last interval (W)
+   float fPower[MAX_HEATERS] = {0};
+
+   /// Total energy supplied to tool (J)
+   double fEnergy = 0;
+
+   /**
+    * Piece-wise linear interpolation through the sensor characteristic
+    *
+    * @param x        Value to interpolate
+    * @param xIndex   Column for x
+    * @param yIndex   Column for y
+    *
+    * @return Interpolated value (extrapolated from last segment)
+    */
+   float interpolate(float x, unsigned xIndex, unsigned yIndex) const;
+
+   /**
+    * Get thermocouple EMF for given tip temperature
+    *
+    * @param temperature Tip temperature (Celsius)
+    *
+    * @return EMF in volts
+    */
+   float getThermocoupleVoltage(float temperature) const;
+
+   /**
+    * Get NTC resistance for given temperature
+    *
+    * @param temperature Handle temperature (Celsius)
+    *
+    * @return Resistance in ohms
+    */
+   static float getNtcResistance(float temperature);
+
+   /**
+    * Get voltage at bias divider
+    *
+    * @param resistance Resistance being measured
+    *
+    * @return Voltage in volts
+    */
+   static float getDividerVoltage(float resistance) {
+      return BIAS_VOLTAGE*resistance/(BIAS_RESISTOR_VALUE+resistance);
+   }
+
+public:
+   /**
+    * Constructor
+    *
+    * @param toolType   Tool to simulate
+    * @param ambient    Ambient temperature (Celsius)
+    */
+   ThermalModel(ToolType toolType=ToolType_None, float ambient=25.0);
+
+   /**
+    * Change tool.
+    * Tool starts at ambient temperature.
+    *
+    * @param toolType   Tool to simulate
+    */
+   void setTool(ToolType toolType);
+
+   /**
+    * Set extra load on tip e.g. when soldering a joint
+    *
+    * @param conductance Load as conductance to ambient (W/K)
+    */
+   void setLoad(float conductance) {
+      fLoad = conductance;
+   }
+
+   /**
+    * Set variation of heater resistance and loss with temperature.
+    * Both are zero (linear plant) by default.
+    *
+    * @param heaterCoefficient  Increase in heater resistance (per K above ambient)
+    * @param lossCoefficient    Increase in loss to ambient (per K above ambient)
+    */
+   void setTemperatureCoefficients(float heaterCoefficient, float lossCoefficient) {
+      fHeaterCoefficient = heaterCoefficient;
+      fLossCoefficient   = lossCoefficient;
+   }
+
+   /**
+    * Advance the model in time
+    *
+    * @param seconds        Time interval
+    * @param drive          Drive bits for heaters (active high, bit n => heater n)
+    * @param voltageSelect  Voltage selection for channel (VoltageSelection)
+    */
+   void advance(float seconds, unsigned drive, unsigned voltageSelect);
+
+   /**
+    * Get voltage presented to measurement multiplexor
+    *
+    * @param subChannel  Sub-channel being measured
+    * @param bias        Whether bias is applied
+    *
+    * @return Voltage in volts
+    */
+   float getInputVoltage(SubChannelNum subChannel, bool bias) const;
+
+   /**
+    * Get name of tool
+    */
+   const char *getName() const {
+      return fParameters->name;
+   }
+
+   /**
+    * Find tool type from name (case insensitive)
+    *
+    * @param[in]  name      Name of tool e.g. "T12"
+    * @param[out] toolType  Tool type found
+    *
+    * @return true if found
+    */
+   static bool findTool(const char *name, ToolType &toolType);
+
+   /**
+    * Get temperature of a heater
+    *
+    * @param heater Heater number
+    *
+    * @return Temperature in Celsius
+    */
+   float getTemperature(unsigned heater=0) const {
+      return fTemperature[heater];
+   }
+
+   /**
+    * Get total power applied in last interval
+    *
+    * @return Power in watts
+    */
+   float getPower() const {
+      return fPower[0]+fPower[1];
+   }
+
+   /**
+    * Get total energy supplied to tool
+    *
+    * @return Energy in joules
+    */
+   double getEnergy() const {
+      return fEnergy;
+   }
+};
+
+} // End namespace Simulation
+
+#endif /* SOURCES_THERMALMODEL_H_ */
@@ -0,0 +1,407 @@
+/*
+ ============================================================================
+ * @file    main.cpp (SolderingStation_V4_Simulation)
+ * @brief   Host simulation of the soldering station
+ *
+ * Runs the unmodified control, display and menu code of the V4 firmware
+ * against a simulated thermal plant in simulated time.
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ ============================================================================
+ */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <chrono>
+#include "hardware.h"
+#include "Display.h"
+#include "SwitchPolling.h"
+#include "Channels.h"
+#include "Control.h"
+#include "NonvolatileSettings.h"
+#include "ExecutionTiming.h"
+#include "UartDmaTransmitter.h"
+#include "DmaConsole.h"
+#include "FlightRecorder.h"
+#include "Simulator.h"
+#include "Benchmarks.h"
+
+using namespace USBDM;
+using namespace Simulation;
+
+/// Information about tips
+Tips tips;
+
+/// Non-volatile storage (simulated FlexRAM)
+NonvolatileSettings nvinit;
+
+/// Channel interface and state
+Channels       channels;
+
+/// Polls the switches and the set-back switches
+SwitchPolling  switchPolling;
+
+/// Main control class
+Control        control;
+
+/// Handles the OLED display
+Display        display;
+
+/// Transmits console data (telemetry and reports) using DMA
+UartDmaTransmitter consoleTransmitter;
+
+/// Console for diagnostic reports (waits for space rather than losing report lines)
+DmaConsole dmaConsole(consoleTransmitter, OverflowPolicy_Block);
+
+/// Flight recorder for control loop (survives reset)
+__attribute__ ((section(".noinit")))
+FlightRecorder flightRecorder;
+
+/// Use PredictiveController for all tips (ControlMode_Predictive)
+static bool predictiveControl = false;
+
+void initialise() {
+   // As at boot (.noinit is cleared on the host so there is never a recording to report)
+   flightRecorder.initialise();
+
+   if (predictiveControl) {
+      // As if selected in the Control Mode menu
+      for (unsigned index=0; index<TipSettings::NUM_TIP_SETTINGS; index++) {
+         tips.getTip(index)->setControlMode(ControlMode_Predictive);
+      }
+   }
+
+   consoleTransmitter.initialise();
+   display.initialise();
+   control.initialise();
+   switchPolling.initialise();
+}
+
+/**
+ * Statistics gathered while running scenario
+ */
+struct Statistics {
+   double   timeToTarget    = -1;    // Time to first get within 5C of target (s)
+   float    maximum         = 0;     // Maximum tip temperature (C)
+   float    minimumLoaded   = 1000;  // Minimum tip temperature while loaded (C)
+   float    afterLoad       = 0;     // Maximum tip temperature in 30 s after load removed (C)
+   float    atSetback       = 0;     // Tip temperature during set-back (C)
+   float    atEnd           = 0;     // Tip temperature at end (C)
+   double   idleTime        = 0;     // Time with both channels off and display off (s)
+   uint64_t idleWakeups     = 0;     // Processor wake-ups during idleTime
+};
+
+static Statistics statistics;
+
+/// Print CSV trace every second
+static bool doTrace = false;
+
+/// Tool on channel 2
+static ThermalModel::ToolType ch2Tool = ThermalModel::ToolType_None;
+
+/// Run idle scenario
+static bool idleScenario = false;
+
+/// File to write console UART (telemetry) capture to (nullptr => none)
+static const char *telemetryFilename = nullptr;
+
+/// Time to trigger the over-current comparator (s, <0 => none)
+static double overloadTime = -1;
+
+/**
+ * Fast spin of the encoder added to scenario
+ */
+struct Flick {
+   const char *name;          // Description
+   double      start;         // Time of first detent (s)
+   int         detents;       // Detents to move
+   int         before;        // Channel 1 target temperature before flick (C)
+   int         after;         // Channel 1 target temperature after flick (C)
+   uint64_t    i2cBefore;     // I2C transactions before flick
+   uint64_t    i2cAfter;      // I2C transactions after flick
+};
+
+/// Flicks of the encoder (--flick)
+static Flick flicks[] = {
+      {"Flick down", 200.0, -40, 0, 0, 0, 0},
+      {"Flick up",   202.0,  40, 0, 0, 0, 0},
+};
+
+/// Add encoder flicks to scenario
+static bool doFlicks = false;
+
+/**
+ * Periodic monitoring of channel 1
+ * Executed every 100 ms of simulated time.
+ */
+static void monitor() {
+   Simulator   &simulator = Simulator::instance();
+   ThermalModel &tool     = simulator.getTool(1);
+   Channel      &ch       = channels[1];
+   double        now      = simulator.getSeconds();
+   float         tipTemp  = tool.getTemperature();
+
+   statistics.maximum = std::max(statistics.maximum, tipTemp);
+   if ((statistics.timeToTarget < 0) && (ch.getState() == ChannelState_active) &&
+       (fabsf(tipTemp - ch.getTargetTemperature()) < 5)) {
+      statistics.timeToTarget = now;
+   }
+   if ((now >= 120) && (now < 135)) {
+      statistics.minimumLoaded = std::min(statistics.minimumLoaded, tipTemp);
+   }
+   if ((now >= 135) && (now < 165)) {
+      statistics.afterLoad = std::max(statistics.afterLoad, tipTemp);
+   }
+   if ((now >= 399.9) && (now < 400.05)) {
+      statistics.atSetback = tipTemp;
+   }
+   statistics.atEnd = tipTemp;
+
+   // Wake-ups while idle are attributed to the preceding monitor interval
+   static uint64_t lastWakeups = 0;
+   static bool     lastIdle    = false;
+   uint64_t wakeups = simulator.getWakeups();
+   if (lastIdle) {
+      statistics.idleTime    += 0.1;
+      statistics.idleWakeups += wakeups-lastWakeups;
+   }
+   lastWakeups = wakeups;
+   lastIdle    = !channels[1].isRunning() && !channels[2].isRunning() && !control.isDisplayInUse();
+
+   static unsigned count = 0;
+   if (doTrace && ((count++ % 10) == 0)) {
+      printf("%.1f,%s,%d,%.1f,%.1f,%.1f\n",
+            now, ch.getStateName(), ch.getTargetTemperature(), ch.getCurrentTemperature(), tipTemp, tool.getPower());
+   }
+   simulator.addAction(now+0.1, monitor);
+}
+
+/**
+ * Set up the 10 minute scenario
+ *
+ * - T12 tip on channel 1, channel 2 empty (or --ch2 tool)
+ * - Channel 1 (and 2) enabled by holding Ch1 (Ch2) button
+ * - Heat up to default preset
+ * - Soldering load applied for 15 s at 120 s
+ * - Channel idles into set-back after 300 s
+ * - User wakes the channel with the encoder at 420 s
+ *
+ * @param simulator Simulator to configure
+ */
+static void setupScenario(Simulator &simulator) {
+   simulator.getTool(1).setTool(ThermalModel::ToolType_T12);
+   simulator.getTool(2).setTool(ch2Tool);
+
+   // Hold Ch1 button => enable channel
+   simulator.pressButton(1.0, Ch1Button::BITMASK, 1.5);
+
+   if (ch2Tool != ThermalModel::ToolType_None) {
+      simulator.pressButton(3.0, Ch2Button::BITMASK, 1.5);
+   }
+
+   // Soldering a joint
+   simulator.addAction(120.0, [&simulator](){ simulator.getTool(1).setLoad(0.1); });
+   simulator.addAction(135.0, [&simulator](){ simulator.getTool(1).setLoad(0.0); });
+
+   if (doFlicks) {
+      // Spin the encoder at 125 detents/s and record the target temperature either side
+      for (Flick &flick:flicks) {
+         simulator.addAction(flick.start-0.5, [&simulator, &flick](){
+            flick.before    = channels[1].getTargetTemperature();
+            flick.i2cBefore = simulator.getI2cTransactions();
+         });
+         simulator.rotateEncoder(flick.start, flick.detents);
+         simulator.addAction(flick.start+1.0, [&simulator, &flick](){
+            flick.after    = channels[1].getTargetTemperature();
+            flick.i2cAfter = simulator.getI2cTransactions();
+         });
+      }
+   }
+
+   // Wake from set-back
+   simulator.rotateEncoder(420.0, 1);
+   simulator.rotateEncoder(420.5, -1);
+
+   simulator.addAction(0.1, monitor);
+   simulator.setEndTime(600.0);
+}
+
+/**
+ * Set up the 20 minute idle scenario
+ *
+ * - T12 tip on channel 1, channel 2 empty (or --ch2 tool)
+ * - Both channels left off so the display turns off after 300 s
+ * - User wakes the display with the encoder at 900 s
+ *
+ * @param simulator Simulator to configure
+ */
+static void setupIdleScenario(Simulator &simulator) {
+   simulator.getTool(1).setTool(ThermalModel::ToolType_T12);
+   simulator.getTool(2).setTool(ch2Tool);
+
+   // Wake display
+   simulator.rotateEncoder(900.0, 1);
+
+   simulator.addAction(0.1, monitor);
+   simulator.setEndTime(1200.0);
+}
+
+/**
+ * Report flight recorder as at next boot
+ * The records are written to the console (--console)
+ */
+static void postMortem() {
+   if (!flightRecorder.isFrozen()) {
+      return;
+   }
+   unsigned count = flightRecorder.getCount();
+   printf("Flight recorder       = %u records from %.2f to %.2f s\n", count,
+         flightRecorder.getRecord(0).timestamp*SAMPLE_INTERVAL, flightRecorder.getRecord(count-1).timestamp*SAMPLE_INTERVAL);
+   flightRecorder.report(console);
+}
+
+/**
+ * Print usage
+ */
+static void usage(const char *name) {
+   fprintf(stderr,
+         "Usage: %s [--trace] [--console] [--noise <lsbs>] [--ch2 <tool>] [--alternate] [--idle] [--flick] [--telemetry <file>] [--overload <time>] [--predictive] [--benchmark]\n"
+         "   --trace      Print CSV trace of channel 1 every second\n"
+         "   --console    Send firmware console output to stderr\n"
+         "   --noise      Add +/- noise to ADC conversions\n"
+         "   --ch2        Tool on channel 2 (None, T12, Weller, JBC, Atten)\n"
+         "   --alternate  Measure channels on alternate half-cycles only\n"
+         "   --idle       Run idle scenario (channels off, display turns off) instead of soldering scenario\n"
+         "   --flick      Spin the encoder quickly down then up at 200 s\n"
+         "   --telemetry  Write binary telemetry sent by UART DMA to file (see TelemetryDecoder)\n"
+         "   --overload   Trigger the over-current comparator at time (s) and report the flight recorder\n"
+         "   --predictive Use the model based PredictiveController instead of PID for all tips\n"
+         "   --benchmark  Run host benchmarks of firmware code paths instead of the scenario\n",
+         name);
+}
+
+int main(int argc, char *argv[]) {
+
+   Simulator &simulator = Simulator::instance();
+
+   for (int index=1; index<argc; index++) {
+      if (strcmp(argv[index], "--trace") == 0) {
+         doTrace = true;
+      }
+      else if (strcmp(argv[index], "--console") == 0) {
+         console.setStream(stderr);
+      }
+      else if (strcmp(argv[index], "--benchmark") == 0) {
+         return runBenchmarks()?EXIT_SUCCESS:EXIT_FAILURE;
+      }
+      else if ((strcmp(argv[index], "--noise") == 0) && (index+1<argc)) {
+         simulator.setAdcNoise(atoi(argv[++index]));
+      }
+      else if ((strcmp(argv[index], "--ch2") == 0) && (index+1<argc) &&
+               ThermalModel::findTool(argv[++index], ch2Tool)) {
+      }
+      else if (strcmp(argv[index], "--alternate") == 0) {
+         control.setMeasurementMode(MeasurementMode_Alternate);
+      }
+      else if (strcmp(argv[index], "--idle") == 0) {
+         idleScenario = true;
+      }
+      else if (strcmp(argv[index], "--flick") == 0) {
+         doFlicks = true;
+      }
+      else if ((strcmp(argv[index], "--telemetry") == 0) && (index+1<argc)) {
+         telemetryFilename = argv[++index];
+      }
+      else if ((strcmp(argv[index], "--overload") == 0) && (index+1<argc)) {
+         overloadTime = atof(argv[++index]);
+      }
+      else if (strcmp(argv[index], "--predictive") == 0) {
+         predictiveControl = true;
+      }
+      else {
+         usage(argv[0]);
+         return EXIT_FAILURE;
+      }
+   }
+   if (idleScenario) {
+      setupIdleScenario(simulator);
+   }
+   else {
+      setupScenario(simulator);
+   }
+
+   if (overloadTime >= 0) {
+      simulator.addAction(overloadTime, [](){ OverCurrentComparator::irqHandler(CmpEvent_Rising); });
+   }
+   if (doTrace) {
+      printf("Time,State,Target,Measured,Actual,Power\n");
+   }
+   auto startTime = std::chrono::steady_clock::now();
+
+   try {
+      initialise();
+      control.eventLoop();
+   }
+   catch (Finished &) {
+   }
+   catch (BreakpointHit &) {
+      postMortem();
+      return EXIT_FAILURE;
+   }
+   std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - startTime;
+
+   const ThermalModel &tool = simulator.getTool(1);
+
+   printf("Simulated time        = %.1f s\n",  simulator.getSeconds());
+   printf("Wall time             = %.3f s\n",  wallTime.count());
+   printf("Tool                  = %s\n",      tool.getName());
+   printf("Channel 2 tool        = %s\n",      simulator.getTool(2).getName());
+   printf("Control mode          = %s\n",      predictiveControl?"Predictive":"PID");
+   printf("Measurement mode      = %s\n",      (control.getMeasurementMode() == MeasurementMode_Interleaved)?"Interleaved":"Alternate");
+   printf("Time to target        = %.1f s\n",  statistics.timeToTarget);
+   printf("Maximum temperature   = %.1f C\n",  statistics.maximum);
+   printf("Minimum under load    = %.1f C\n",  statistics.minimumLoaded);
+   printf("Maximum after load    = %.1f C\n",  statistics.afterLoad);
+   printf("Set-back temperature  = %.1f C\n",  statistics.atSetback);
+   printf("Final temperature     = %.1f C\n",  statistics.atEnd);
+   printf("Energy                = %.0f J\n",  tool.getEnergy());
+   printf("Interrupts            = %llu\n",    (unsigned long long)simulator.getInterruptCount());
+   printf("Wake-ups              = %llu (%.0f per hour)\n",
+         (unsigned long long)simulator.getWakeups(), simulator.getWakeups()*3600/simulator.getSeconds());
+   if (statistics.idleTime > 0) {
+      printf("Idle wake-ups         = %.0f per hour (%.0f s idle)\n",
+            statistics.idleWakeups*3600/statistics.idleTime, statistics.idleTime);
+   }
+   printf("I2C transactions      = %llu\n",    (unsigned long long)simulator.getI2cTransactions());
+   printf("I2C bytes             = %llu\n",    (unsigned long long)simulator.getI2cBytes());
+   if (doFlicks && !idleScenario) {
+      for (const Flick &flick:flicks) {
+         printf("%-22s= %d detents, %d -> %d C, %llu I2C transactions\n",
+               flick.name, flick.detents, flick.before, flick.after,
+               (unsigned long long)(flick.i2cAfter-flick.i2cBefore));
+      }
+   }
+   printf("UART DMA bytes        = %llu (%.1f%% of UART time)\n", (unsigned long long)simulator.getUartBytes(),
+         simulator.getUartBytes()*Simulator::UART_BYTE_US*100.0/simulator.getTime());
+   printf("UART DMA writes lost  = %u (buffer high-water %u of %u bytes)\n",
+         consoleTransmitter.getDropped(), consoleTransmitter.getHighWater(), UartDmaTransmitter::BUFFER_SIZE);
+   if (telemetryFilename != nullptr) {
+      const std::vector<uint8_t> &capture = simulator.getUartCapture();
+      FILE *fp = fopen(telemetryFilename, "wb");
+      if ((fp == nullptr) || (fwrite(capture.data(), 1, capture.size(), fp) != capture.size())) {
+         fprintf(stderr, "Failed to write %s\n", telemetryFilename);
+         return EXIT_FAILURE;
+      }
+      fclose(fp);
+   }
+   postMortem();
+   simulator.reportHalfCycleUsage();
+
+   // Execution times are host times (ns) as measured by std::chrono
+   Console timingReport;
+   timingReport.setStream(stdout);
+   ExecutionTiming::report(timingReport);
+
+   return EXIT_SUCCESS;
+}
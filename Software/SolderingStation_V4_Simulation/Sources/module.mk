@@ -0,0 +1,9 @@
+# Build list for Module
+# List source file to include from current directory
+
+SRC += main.cpp
+SRC += Simulator.cpp
+SRC += SimulatedHardware.cpp
+SRC += ThermalModel.cpp
+SRC += OledModel.cpp
+SRC += Benchmarks.cpp
@@ -0,0 +1,143 @@
+/*
+ ============================================================================
+ * @file    TelemetryDecoder.cpp (SolderingStation_V4_Simulation/Tools)
+ * @brief   Converts a capture of binary telemetry frames to CSV
+ *
+ * The capture is the raw byte stream from the console UART e.g. from a
+ * serial terminal logging to file or the simulator (--telemetry <file>).
+ * Frames are found by their sync bytes and CRC so console text or
+ * corrupted frames in the capture are skipped.
+ *
+ * Usage: TelemetryDecoder [capture] > telemetry.csv
+ *
+ *  Created on: 16 Oct 2026
+ *      Author: podonoghue
+ ============================================================================
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "TelemetryFrame.h"
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Frames are decoded in place (little-endian)");
+
+/**
+ * Statistics for capture
+ */
+struct Statistics {
+   unsigned long frames    = 0;   // Valid frames
+   unsigned long crcErrors = 0;   // Frames with correct sync but bad CRC
+   unsigned long lost      = 0;   // Frames missing from sequence
+   unsigned long skipped   = 0;   // Bytes not in a valid frame
+};
+
+/**
+ * Read entire file
+ *
+ * @param fp    File to read
+ * @param data  Data read
+ */
+static void readAll(FILE *fp, std::vector<uint8_t> &data) {
+   uint8_t buffer[4096];
+   size_t  size;
+   while ((size = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+      data.insert(data.end(), buffer, buffer+size);
+   }
+}
+
+/**
+ * Write frame as CSV line
+ *
+ * @param frame Frame to write
+ */
+static void writeFrame(const TelemetryFrame &frame) {
+   printf("%.2f,%u,%u,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,",
+         frame.timestamp*(TELEMETRY_TIMESTAMP_US/1000000.0),
+         frame.channel,
+         frame.state,
+         frame.target/(double)TELEMETRY_TEMPERATURE_SCALE,
+         frame.measured/(double)TELEMETRY_TEMPERATURE_SCALE,
+         frame.proportional/(double)TELEMETRY_PERCENT_SCALE,
+         frame.integral/(double)TELEMETRY_PERCENT_SCALE,
+         frame.differential/(double)TELEMETRY_PERCENT_SCALE,
+         frame.duty/(double)TELEMETRY_PERCENT_SCALE);
+   if (frame.coldJunction != TELEMETRY_NO_VALUE) {
+      printf("%.2f", frame.coldJunction/(double)TELEMETRY_COLD_JUNCTION_SCALE);
+   }
+   printf("\n");
+}
+
+/**
+ * Decode frames in capture
+ *
+ * @param data       Capture
+ * @param statistics Statistics for capture
+ */
+static void decode(const std::vector<uint8_t> &data, Statistics &statistics) {
+
+   bool     first            = true;
+   uint16_t expectedSequence = 0;
+
+   size_t index = 0;
+   while (index < data.size()) {
+      if ((data[index] != TELEMETRY_SYNC1) ||
+          ((index+1) >= data.size()) || (data[index+1] != TELEMETRY_SYNC2) ||
+          ((index+sizeof(TelemetryFrame)) > data.size())) {
+         statistics.skipped++;
+         index++;
+         continue;
+      }
+      TelemetryFrame frame;
+      memcpy(&frame, data.data()+index, sizeof(frame));
+      const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&frame);
+      if (telemetryCrc(bytes+TELEMETRY_CRC_START, TELEMETRY_CRC_SIZE) != frame.crc) {
+         // Not a frame or corrupted - re-synchronise at next byte
+         statistics.crcErrors++;
+         statistics.skipped++;
+         index++;
+         continue;
+      }
+      if (!first) {
+         statistics.lost += static_cast<uint16_t>(frame.sequence-expectedSequence);
+      }
+      first            = false;
+      expectedSequence = frame.sequence+1;
+      statistics.frames++;
+      writeFrame(frame);
+      index += sizeof(frame);
+   }
+}
+
+int main(int argc, char *argv[]) {
+
+   FILE *fp = stdin;
+   if (argc > 2) {
+      fprintf(stderr, "Usage: %s [capture] > telemetry.csv\n", argv[0]);
+      return EXIT_FAILURE;
+   }
+   if (argc == 2) {
+      fp = fopen(argv[1], "rb");
+      if (fp == nullptr) {
+         fprintf(stderr, "Failed to open %s\n", argv[1]);
+         return EXIT_FAILURE;
+      }
+   }
+   std::vector<uint8_t> data;
+   readAll(fp, data);
+   if (fp != stdin) {
+      fclose(fp);
+   }
+
+   Statistics statistics;
+
+   printf("Time,Channel,State,Target,Measured,P,I,D,Duty,ColdJunction\n");
+   decode(data, statistics);
+
+   fprintf(stderr, "Frames        = %lu\n", statistics.frames);
+   fprintf(stderr, "CRC errors    = %lu\n", statistics.crcErrors);
+   fprintf(stderr, "Frames lost   = %lu\n", statistics.lost);
+   fprintf(stderr, "Bytes skipped = %lu\n", statistics.skipped);
+
+   return EXIT_SUCCESS;
+}